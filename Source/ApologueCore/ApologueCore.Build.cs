@@ -39,6 +39,8 @@ public class ApologueCore : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"Json",
+				"Projects",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
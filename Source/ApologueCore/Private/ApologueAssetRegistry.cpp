@@ -0,0 +1,149 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "ApologueAssetRegistry.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Event/ApologueEvent.h"
+#include "Flag/ApologueFlag.h"
+#include "Stat/ApologueStat.h"
+
+const FName UApologueAssetRegistry::PreloadBundle(TEXT("Preload"));
+
+namespace ApologueAssetRegistry
+{
+	TArray<TPair<FPrimaryAssetType, UClass*>, TInlineAllocator<3>> GetAssetTypes()
+	{
+		return {
+			{UApologueEvent::PrimaryAssetType, UApologueEvent::StaticClass()},
+			{UApologueStat::PrimaryAssetType, UApologueStat::StaticClass()},
+			{UApologueFlag::PrimaryAssetType, UApologueFlag::StaticClass()}
+		};
+	}
+}
+
+void UApologueAssetRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Engine subsystems start before the asset manager exists
+	UAssetManager::CallOrRegister_OnAssetManagerCreated(FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &ThisClass::ScanForAssets));
+}
+
+void UApologueAssetRegistry::Deinitialize()
+{
+	if (PreloadHandle.IsValid())
+	{
+		PreloadHandle->CancelHandle();
+		PreloadHandle.Reset();
+	}
+
+	ResolvedAssets.Reset();
+	OnPreloaded.Clear();
+
+	Super::Deinitialize();
+}
+
+void UApologueAssetRegistry::ScanForAssets()
+{
+	UAssetManager& AssetManager = UAssetManager::Get();
+
+	// Native classes only, scanned without blocking where the asset registry is still gathering
+	AssetManager.PushBulkScanning();
+	for (const TPair<FPrimaryAssetType, UClass*>& AssetType : ApologueAssetRegistry::GetAssetTypes())
+	{
+		AssetManager.ScanPathsForPrimaryAssets(AssetType.Key, ScanPaths, AssetType.Value, false, false, false);
+	}
+	AssetManager.PopBulkScanning();
+
+	if (bPreloadOnStartup)
+	{
+		AssetManager.CallOrRegister_OnCompletedInitialScan(FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &ThisClass::Preload));
+	}
+}
+
+void UApologueAssetRegistry::Preload()
+{
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager)
+	{
+		return;
+	}
+
+	TArray<FPrimaryAssetId> AssetIds;
+	for (const TPair<FPrimaryAssetType, UClass*>& AssetType : ApologueAssetRegistry::GetAssetTypes())
+	{
+		AssetManager->GetPrimaryAssetIdList(AssetType.Key, AssetIds);
+	}
+
+	PreloadHandle = AssetManager->LoadPrimaryAssets(AssetIds, {PreloadBundle}, FStreamableDelegate::CreateUObject(this, &ThisClass::HandlePreloaded),
+	                                                FStreamableManager::AsyncLoadHighPriority);
+
+	// No handle means there was nothing left to load
+	if (!PreloadHandle.IsValid())
+	{
+		HandlePreloaded();
+	}
+}
+
+void UApologueAssetRegistry::WaitUntilPreloaded(const float TimeoutSeconds)
+{
+	if (PreloadHandle.IsValid())
+	{
+		PreloadHandle->WaitUntilComplete(TimeoutSeconds);
+	}
+}
+
+FDelegateHandle UApologueAssetRegistry::CallOrRegister_OnPreloaded(FSimpleMulticastDelegate::FDelegate&& Delegate)
+{
+	if (bIsPreloaded)
+	{
+		Delegate.ExecuteIfBound();
+		return FDelegateHandle();
+	}
+
+	return OnPreloaded.Add(MoveTemp(Delegate));
+}
+
+void UApologueAssetRegistry::HandlePreloaded()
+{
+	if (const UAssetManager* AssetManager = UAssetManager::GetIfInitialized())
+	{
+		TArray<UObject*> Assets;
+		for (const TPair<FPrimaryAssetType, UClass*>& AssetType : ApologueAssetRegistry::GetAssetTypes())
+		{
+			AssetManager->GetPrimaryAssetObjectList(AssetType.Key, Assets);
+		}
+
+		for (UObject* Asset : Assets)
+		{
+			CacheResolved(Asset);
+		}
+	}
+
+	// A later Preload only adds to the cache
+	if (!bIsPreloaded)
+	{
+		bIsPreloaded = true;
+		OnPreloaded.Broadcast();
+		OnPreloaded.Clear();
+	}
+}
+
+void UApologueAssetRegistry::CacheResolved(UObject* Asset)
+{
+	ResolvedAssets.Add(FSoftObjectPath(Asset), Asset);
+
+	// The classes of the Preload bundle
+	if (const UApologueEvent* Event = Cast<UApologueEvent>(Asset))
+	{
+		for (const FSoftObjectPath& ClassPath : {Event->GetListenerClass().ToSoftObjectPath(), Event->GetContextClass().ToSoftObjectPath()})
+		{
+			if (UObject* Class = ClassPath.ResolveObject())
+			{
+				ResolvedAssets.Add(ClassPath, Class);
+			}
+		}
+	}
+}
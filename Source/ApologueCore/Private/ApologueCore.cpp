@@ -4,6 +4,8 @@
 
 #define LOCTEXT_NAMESPACE "FApologueCoreModule"
 
+DEFINE_LOG_CATEGORY(LogApologueCore);
+
 void FApologueCoreModule::StartupModule()
 {
 }
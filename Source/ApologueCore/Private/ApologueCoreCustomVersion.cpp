@@ -0,0 +1,10 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "ApologueCoreCustomVersion.h"
+
+#include "Serialization/CustomVersion.h"
+
+const FGuid FApologueCoreCustomVersion::GUID(0x84640CF5, 0x559040F3, 0x8F15E7CB, 0x8C59BD19);
+
+FCustomVersionRegistration GRegisterApologueCoreCustomVersion(FApologueCoreCustomVersion::GUID, FApologueCoreCustomVersion::LatestVersion, TEXT("ApologueCore"));
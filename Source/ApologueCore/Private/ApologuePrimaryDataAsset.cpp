@@ -0,0 +1,17 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "ApologuePrimaryDataAsset.h"
+
+FPrimaryAssetId UApologuePrimaryDataAsset::GetPrimaryAssetId() const
+{
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return Super::GetPrimaryAssetId();
+	}
+
+	// Assets created at runtime share the transient package, or are nested in another object, and go by their full path
+	const UPackage* Package = GetPackage();
+	const bool bIsPackageAsset = GetOuter() == Package && Package != GetTransientPackage();
+	return FPrimaryAssetId(GetApologueAssetType(), bIsPackageAsset ? Package->GetFName() : FName(GetPathName()));
+}
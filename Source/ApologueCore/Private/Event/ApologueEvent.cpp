@@ -2,3 +2,74 @@
 
 
 #include "Event/ApologueEvent.h"
+
+#include "UObject/UObjectIterator.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "ApologueEvent"
+
+const FPrimaryAssetType UApologueEvent::PrimaryAssetType(TEXT("ApologueEvent"));
+
+void UApologueEvent::RefreshAncestors()
+{
+	Ancestors.Reset();
+	for (const UApologueEvent* Ancestor = Parent; Ancestor && Ancestor != this; Ancestor = Ancestor->Parent)
+	{
+		const FSoftObjectPath AncestorPath(Ancestor);
+		if (Ancestors.Contains(AncestorPath))
+		{
+			break;
+		}
+
+		Ancestors.Add(AncestorPath);
+	}
+}
+
+void UApologueEvent::PostLoad()
+{
+	Super::PostLoad();
+
+	RefreshAncestors();
+}
+
+#if WITH_EDITOR
+void UApologueEvent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Every descendant's ancestors change with this event's parent
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UApologueEvent, Parent))
+	{
+		for (TObjectIterator<UApologueEvent> It; It; ++It)
+		{
+			It->RefreshAncestors();
+		}
+	}
+}
+
+EDataValidationResult UApologueEvent::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+
+	TSet<const UApologueEvent*> Visited;
+	Visited.Add(this);
+	for (const UApologueEvent* Ancestor = Parent; Ancestor; Ancestor = Ancestor->Parent)
+	{
+		bool bIsAlreadyVisited;
+		Visited.Add(Ancestor, &bIsAlreadyVisited);
+		if (bIsAlreadyVisited)
+		{
+			Context.AddError(FText::Format(LOCTEXT("ParentLoop", "The parents of {0} loop back to {1}."), FText::FromString(GetName()),
+			                               FText::FromString(Ancestor->GetName())));
+			return EDataValidationResult::Invalid;
+		}
+	}
+
+	return Result;
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,166 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Event/ApologueEventArena.h"
+
+#include "ApologueEventStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scratch Blocks Allocated"), STAT_ApologueEvent_NumScratchBlocks, STATGROUP_ApologueEvent);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Scratch Peak Bytes"), STAT_ApologueEvent_ScratchPeakBytes, STATGROUP_ApologueEvent);
+
+namespace ApologueEventArena
+{
+	thread_local FApologueEventArena* CurrentArena = nullptr;
+}
+
+FApologueEventArena::FApologueEventArena(const int64 InBlockSize)
+	: BlockSize(FMath::Max<int64>(InBlockSize, 1024))
+{
+}
+
+FApologueEventArena::~FApologueEventArena()
+{
+	check(NumOpenScopes == 0);
+
+	for (const FBlock& Block : Blocks)
+	{
+		FMemory::Free(Block.Memory);
+	}
+}
+
+FApologueEventArena::FScope::FScope(FApologueEventArena& InArena)
+	: Arena(InArena)
+	, PreviousArena(ApologueEventArena::CurrentArena)
+	, Block(InArena.CurrentBlock)
+	, Offset(InArena.CurrentOffset)
+{
+	++Arena.NumOpenScopes;
+	ApologueEventArena::CurrentArena = &Arena;
+}
+
+FApologueEventArena::FScope::~FScope()
+{
+	Arena.CurrentBlock = Block;
+	Arena.CurrentOffset = Offset;
+	--Arena.NumOpenScopes;
+	ApologueEventArena::CurrentArena = PreviousArena;
+}
+
+FApologueEventArena* FApologueEventArena::GetCurrent()
+{
+	return ApologueEventArena::CurrentArena;
+}
+
+void* FApologueEventArena::Allocate(const int64 Size, const uint32 Alignment)
+{
+	check(Size > 0);
+
+	while (true)
+	{
+		if (CurrentBlock < Blocks.Num())
+		{
+			const FBlock& Block = Blocks[CurrentBlock];
+			uint8* Pointer = Align(Block.Memory + CurrentOffset, Alignment);
+			const int64 Start = Pointer - Block.Memory;
+			if (Start + Size <= Block.Size)
+			{
+				CurrentOffset = Start + Size;
+				PeakBytesUsed = FMath::Max(PeakBytesUsed, GetNumBytesUsed());
+				return Pointer;
+			}
+
+			// Blocks past the current one are empty, and kept from earlier scopes
+			if (CurrentBlock + 1 < Blocks.Num())
+			{
+				++CurrentBlock;
+				CurrentOffset = 0;
+				continue;
+			}
+		}
+
+		AddBlock(Size + Alignment);
+		CurrentBlock = Blocks.Num() - 1;
+		CurrentOffset = 0;
+	}
+}
+
+void* FApologueEventArena::Reallocate(void* Pointer, const int64 OldSize, const int64 NewSize, const uint32 Alignment, const int64 NumBytesToCopy)
+{
+	if (Pointer && CurrentBlock < Blocks.Num())
+	{
+		const FBlock& Block = Blocks[CurrentBlock];
+		uint8* const BytePointer = static_cast<uint8*>(Pointer);
+		const int64 Start = BytePointer - Block.Memory;
+		if (BytePointer >= Block.Memory && Start + OldSize == CurrentOffset && Start + NewSize <= Block.Size)
+		{
+			CurrentOffset = Start + NewSize;
+			PeakBytesUsed = FMath::Max(PeakBytesUsed, GetNumBytesUsed());
+			return Pointer;
+		}
+	}
+
+	void* NewPointer = Allocate(NewSize, Alignment);
+	if (Pointer && NumBytesToCopy > 0)
+	{
+		FMemory::Memcpy(NewPointer, Pointer, NumBytesToCopy);
+	}
+
+	return NewPointer;
+}
+
+void FApologueEventArena::Free(void* Pointer, const int64 Size)
+{
+	if (CurrentBlock >= Blocks.Num())
+	{
+		return;
+	}
+
+	const FBlock& Block = Blocks[CurrentBlock];
+	uint8* const BytePointer = static_cast<uint8*>(Pointer);
+	if (BytePointer >= Block.Memory && BytePointer - Block.Memory + Size == CurrentOffset)
+	{
+		CurrentOffset = BytePointer - Block.Memory;
+	}
+}
+
+void FApologueEventArena::Reset()
+{
+	check(NumOpenScopes == 0);
+
+	SET_DWORD_STAT(STAT_ApologueEvent_ScratchPeakBytes, PeakBytesUsed);
+
+	if (Blocks.Num() > 1)
+	{
+		for (const FBlock& Block : Blocks)
+		{
+			FMemory::Free(Block.Memory);
+		}
+
+		Blocks.Reset();
+		AddBlock(PeakBytesUsed);
+	}
+
+	CurrentBlock = 0;
+	CurrentOffset = 0;
+	PeakBytesUsed = 0;
+}
+
+int64 FApologueEventArena::GetNumBytesUsed() const
+{
+	int64 NumBytesUsed = CurrentOffset;
+	for (int32 Index = 0; Index < CurrentBlock && Index < Blocks.Num(); ++Index)
+	{
+		NumBytesUsed += Blocks[Index].Size;
+	}
+
+	return NumBytesUsed;
+}
+
+void FApologueEventArena::AddBlock(const int64 MinSize)
+{
+	FBlock& Block = Blocks.AddDefaulted_GetRef();
+	Block.Size = FMath::Max(BlockSize, MinSize);
+	Block.Memory = static_cast<uint8*>(FMemory::Malloc(Block.Size, MinAlignment));
+
+	INC_DWORD_STAT(STAT_ApologueEvent_NumScratchBlocks);
+}
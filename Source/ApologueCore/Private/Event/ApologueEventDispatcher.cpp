@@ -0,0 +1,645 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Event/ApologueEventDispatcher.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
+#include "ApologueAssetRegistry.h"
+#include "Engine/Engine.h"
+#include "Event/ApologueEvent.h"
+#include "Event/ApologueEventContext.h"
+#include "Event/ApologueEventListenerInterface.h"
+#include "Event/ApologueEventSortHandler.h"
+#include "ApologueEventStats.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_CYCLE_STAT(TEXT("Dispatch Queued"), STAT_ApologueEvent_DispatchQueued, STATGROUP_ApologueEvent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Broadcasts Dispatched"), STAT_ApologueEvent_NumDispatched, STATGROUP_ApologueEvent);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued Broadcasts Carried Over"), STAT_ApologueEvent_NumCarriedOver, STATGROUP_ApologueEvent);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Budget Overrun (ms)"), STAT_ApologueEvent_OverrunMs, STATGROUP_ApologueEvent);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Budget Overruns"), STAT_ApologueEvent_NumOverruns, STATGROUP_ApologueEvent);
+DECLARE_CYCLE_STAT(TEXT("Compact Dead Callbacks"), STAT_ApologueEvent_CompactDeadCallbacks, STATGROUP_ApologueEvent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dead Callbacks Compacted"), STAT_ApologueEvent_NumCompacted, STATGROUP_ApologueEvent);
+
+namespace ApologueEventDispatcher
+{
+	/**
+	 * Resolves through the asset registry, whose cache holds preloaded events that may not yet be reachable through
+	 * their soft pointers. Costs a subsystem fetch and a map lookup, so each broadcast resolves its event only once.
+	 */
+	const UApologueEvent* FindEvent(const TSoftObjectPtr<UApologueEvent>& Event)
+	{
+		if (const UApologueAssetRegistry* AssetRegistry = GEngine ? GEngine->GetEngineSubsystem<UApologueAssetRegistry>() : nullptr)
+		{
+			return AssetRegistry->Find(Event);
+		}
+
+		return Event.Get();
+	}
+}
+
+FApologueEventDispatcher::FApologueEventDispatcher()
+{
+	GarbageCollectHandle = FCoreUObjectDelegates::GarbageCollectComplete.AddRaw(this, &FApologueEventDispatcher::UnregisterUnreachableListeners);
+}
+
+FApologueEventDispatcher::~FApologueEventDispatcher()
+{
+	FCoreUObjectDelegates::GarbageCollectComplete.Remove(GarbageCollectHandle);
+}
+
+bool FApologueEventDispatcher::RegisterListener(UObject* Listener)
+{
+	if (!Listener || !Listener->Implements<UApologueEventListenerInterface>())
+	{
+		return false;
+	}
+
+	const FObjectKey ListenerKey(Listener);
+	if (Listeners.Contains(ListenerKey))
+	{
+		return false;
+	}
+
+	// Gathered first, as the listener may register others and reallocate the map
+	TArray<FApologueEventCallbackParam> CallbackParams;
+	IApologueEventListenerInterface::Execute_EventListener_GetCallbacks(Listener, CallbackParams);
+
+	FListener& RegisteredListener = Listeners.Add(ListenerKey);
+	RegisteredListener.Slot = AllocateSlot(ListenerKey);
+
+	for (const FApologueEventCallbackParam& CallbackParam : CallbackParams)
+	{
+		if (!CallbackParam.IsValid())
+		{
+			continue;
+		}
+
+		FRegisteredCallback RegisteredCallback;
+		RegisteredCallback.Listener = ListenerKey;
+		RegisteredCallback.Callback = CallbackParam.Callback;
+		RegisteredCallback.Slot = RegisteredListener.Slot;
+		RegisteredCallback.Generation = ListenerSlots[RegisteredListener.Slot].Generation;
+		RegisteredCallback.Priority = CallbackParam.Priority;
+		RegisteredCallback.SubPriority = CallbackParam.SubPriority;
+		RegisteredCallback.Sequence = NextSequence++;
+
+		if (CallbackParam.Callback.GetUObject() == Listener)
+		{
+			UFunction* Function = Listener->FindFunction(CallbackParam.Callback.GetFunctionName());
+			if (Function && Function->ParmsSize == sizeof(const UApologueEventContext*))
+			{
+				RegisteredCallback.Target = Listener;
+				RegisteredCallback.Function = Function;
+			}
+		}
+
+		const FSoftObjectPath EventPath = CallbackParam.Event.ToSoftObjectPath();
+		RegisteredListener.Callbacks.Emplace(EventPath, RegisteredCallback);
+
+		// Insert after every callback of equal priority so that ties keep registration order
+		TArray<FRegisteredCallback>& Callbacks = CallbacksByEvent.FindOrAdd(EventPath).Callbacks;
+		const int32 Index = Algo::UpperBound(Callbacks, RegisteredCallback, &FApologueEventDispatcher::HasHigherPriority);
+		Callbacks.Insert(MoveTemp(RegisteredCallback), Index);
+	}
+
+	return true;
+}
+
+void FApologueEventDispatcher::UnregisterListener(const UObject* Listener)
+{
+	UnregisterListener(FObjectKey(Listener));
+}
+
+void FApologueEventDispatcher::UnregisterListener(const FObjectKey& ListenerKey)
+{
+	FListener Listener;
+	if (!Listeners.RemoveAndCopyValue(ListenerKey, Listener))
+	{
+		return;
+	}
+
+	SpatialGrid.RemoveLocation(ListenerKey);
+
+	// The listener's callbacks stay in the event lists until compacted, but no longer match the slot
+	FListenerSlot& Slot = ListenerSlots[Listener.Slot];
+	Slot.Listener = FObjectKey();
+	++Slot.Generation;
+	Slot.NextFree = FirstFreeSlot;
+	FirstFreeSlot = Listener.Slot;
+
+	// Counted per event first, as compacting an event removes all of the listener's callbacks for it at once
+	TArray<TPair<FSoftObjectPath, int32>, TInlineAllocator<8>> NumDeadByEvent;
+	for (const TPair<FSoftObjectPath, FRegisteredCallback>& ListenerCallback : Listener.Callbacks)
+	{
+		TPair<FSoftObjectPath, int32>* EventNumDead = NumDeadByEvent.FindByPredicate([&ListenerCallback](const TPair<FSoftObjectPath, int32>& Pair)
+		{
+			return Pair.Key == ListenerCallback.Key;
+		});
+
+		if (EventNumDead)
+		{
+			++EventNumDead->Value;
+		}
+		else
+		{
+			NumDeadByEvent.Emplace(ListenerCallback.Key, 1);
+		}
+	}
+
+	for (const TPair<FSoftObjectPath, int32>& EventNumDead : NumDeadByEvent)
+	{
+		FEventCallbacks* EventCallbacks = CallbacksByEvent.Find(EventNumDead.Key);
+		if (!EventCallbacks)
+		{
+			continue;
+		}
+
+		// Compacting once half a list is dead keeps churn from growing it, at a constant cost per unregistration
+		EventCallbacks->NumDead += EventNumDead.Value;
+		if (EventCallbacks->NumDead * 2 < EventCallbacks->Callbacks.Num())
+		{
+			DirtyEvents.Add(EventNumDead.Key);
+			continue;
+		}
+
+		Compact(*EventCallbacks);
+		DirtyEvents.Remove(EventNumDead.Key);
+		if (EventCallbacks->Callbacks.IsEmpty())
+		{
+			CallbacksByEvent.Remove(EventNumDead.Key);
+		}
+	}
+}
+
+void FApologueEventDispatcher::RefreshListener(UObject* Listener)
+{
+	const FVector* Location = FindListenerLocation(Listener);
+	const TOptional<FVector> OldLocation = Location ? TOptional<FVector>(*Location) : NullOpt;
+
+	UnregisterListener(Listener);
+	if (RegisterListener(Listener) && OldLocation.IsSet())
+	{
+		SpatialGrid.SetLocation(FObjectKey(Listener), OldLocation.GetValue());
+	}
+}
+
+bool FApologueEventDispatcher::IsListenerRegistered(const UObject* Listener) const
+{
+	return Listeners.Contains(FObjectKey(Listener));
+}
+
+int32 FApologueEventDispatcher::GetNumListeners() const
+{
+	return Listeners.Num();
+}
+
+int32 FApologueEventDispatcher::GetNumCallbacks(const TSoftObjectPtr<UApologueEvent>& Event) const
+{
+	const FEventCallbacks* EventCallbacks = CallbacksByEvent.Find(Event.ToSoftObjectPath());
+	return EventCallbacks ? EventCallbacks->Callbacks.Num() - EventCallbacks->NumDead : 0;
+}
+
+int32 FApologueEventDispatcher::Broadcast(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context) const
+{
+	return BroadcastResolved(Event, ApologueEventDispatcher::FindEvent(Event), Context);
+}
+
+int32 FApologueEventDispatcher::Broadcast(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context,
+                                          const FApologueEventScope& Scope) const
+{
+	return BroadcastResolved(Event, ApologueEventDispatcher::FindEvent(Event), Context, Scope);
+}
+
+int32 FApologueEventDispatcher::BroadcastResolved(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEvent* EventPtr,
+                                                  const UApologueEventContext* Context) const
+{
+	FApologueEventArena::FScope ScratchScope(ScratchArena);
+
+	TArray<FSoftObjectPath, TInlineAllocator<8>> EventPaths;
+	GetEventPaths(Event, EventPtr, EventPaths);
+
+	TArray<const TArray<FRegisteredCallback>*, TInlineAllocator<8>> Lists;
+	for (const FSoftObjectPath& EventPath : EventPaths)
+	{
+		if (const FEventCallbacks* EventCallbacks = CallbacksByEvent.Find(EventPath))
+		{
+			Lists.Add(&EventCallbacks->Callbacks);
+		}
+	}
+
+	if (Lists.IsEmpty())
+	{
+		return 0;
+	}
+
+	// Callbacks may register or unregister listeners, so run from a copy
+	FCallbackList Callbacks;
+	if (Lists.Num() == 1)
+	{
+		Callbacks.Append(*Lists[0]);
+	}
+	else
+	{
+		MergeCallbacks(Lists, Callbacks);
+	}
+
+	return InvokeCallbacks(EventPtr, Context, Callbacks);
+}
+
+int32 FApologueEventDispatcher::BroadcastResolved(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEvent* EventPtr,
+                                                  const UApologueEventContext* Context, const FApologueEventScope& Scope) const
+{
+	if (Scope.IsEverywhere())
+	{
+		return BroadcastResolved(Event, EventPtr, Context);
+	}
+
+	FApologueEventArena::FScope ScratchScope(ScratchArena);
+
+	TArray<FSoftObjectPath, TInlineAllocator<8>> EventPaths;
+	GetEventPaths(Event, EventPtr, EventPaths);
+	EventPaths.RemoveAll([this](const FSoftObjectPath& EventPath)
+	{
+		return !CallbacksByEvent.Contains(EventPath);
+	});
+
+	if (EventPaths.IsEmpty())
+	{
+		return 0;
+	}
+
+	FCallbackList Callbacks;
+	SpatialGrid.ForEachInScope(Scope, [this, &EventPaths, &Callbacks](const FObjectKey& Listener)
+	{
+		for (const TPair<FSoftObjectPath, FRegisteredCallback>& ListenerCallback : Listeners.FindChecked(Listener).Callbacks)
+		{
+			if (EventPaths.Contains(ListenerCallback.Key))
+			{
+				Callbacks.Add(ListenerCallback.Value);
+			}
+		}
+	});
+
+	// The same order as an unscoped broadcast
+	Algo::Sort(Callbacks, &FApologueEventDispatcher::RunsBefore);
+
+	return InvokeCallbacks(EventPtr, Context, Callbacks);
+}
+
+int32 FApologueEventDispatcher::BroadcastOrEnqueue(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context,
+                                                   const FApologueEventScope& Scope)
+{
+	const UApologueEvent* EventPtr = ApologueEventDispatcher::FindEvent(Event);
+	const EApologueEventPriority Priority = EventPtr ? EventPtr->GetPriority() : EApologueEventPriority::Critical;
+	if (Priority == EApologueEventPriority::Critical || Priority >= EApologueEventPriority::MAX)
+	{
+		return BroadcastResolved(Event, EventPtr, Context, Scope);
+	}
+
+	FQueuedBroadcast& QueuedBroadcast = QueuedBroadcasts[static_cast<int32>(Priority)].AddDefaulted_GetRef();
+	QueuedBroadcast.Event = Event;
+	QueuedBroadcast.Context = Context;
+	QueuedBroadcast.Scope = Scope;
+	return 0;
+}
+
+FApologueEventDispatchStats FApologueEventDispatcher::DispatchQueued(const double BudgetSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ApologueEvent_DispatchQueued);
+
+	FApologueEventDispatchStats Stats;
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	// Broadcasts before each queue's head have run; queues are compacted once at the end
+	int32 Heads[UE_ARRAY_COUNT(QueuedBroadcasts)] = {};
+	while (true)
+	{
+		int32 QueueIndex = 0;
+		while (QueueIndex < UE_ARRAY_COUNT(QueuedBroadcasts) && Heads[QueueIndex] == QueuedBroadcasts[QueueIndex].Num())
+		{
+			++QueueIndex;
+		}
+
+		if (QueueIndex == UE_ARRAY_COUNT(QueuedBroadcasts))
+		{
+			break;
+		}
+
+		if (Stats.NumDispatched > 0 && FPlatformTime::Seconds() - StartSeconds >= BudgetSeconds)
+		{
+			break;
+		}
+
+		// Moved out first, as the callbacks may queue more broadcasts and reallocate the queue
+		const FQueuedBroadcast QueuedBroadcast = MoveTemp(QueuedBroadcasts[QueueIndex][Heads[QueueIndex]++]);
+		Broadcast(QueuedBroadcast.Event, QueuedBroadcast.Context, QueuedBroadcast.Scope);
+		++Stats.NumDispatched;
+	}
+
+	Stats.Seconds = FPlatformTime::Seconds() - StartSeconds;
+	Stats.OverrunSeconds = FMath::Max(0.0, Stats.Seconds - BudgetSeconds);
+
+	for (int32 QueueIndex = 0; QueueIndex < UE_ARRAY_COUNT(QueuedBroadcasts); ++QueueIndex)
+	{
+		QueuedBroadcasts[QueueIndex].RemoveAt(0, Heads[QueueIndex], EAllowShrinking::No);
+		Stats.NumCarriedOver += QueuedBroadcasts[QueueIndex].Num();
+	}
+
+	INC_DWORD_STAT_BY(STAT_ApologueEvent_NumDispatched, Stats.NumDispatched);
+	SET_DWORD_STAT(STAT_ApologueEvent_NumCarriedOver, Stats.NumCarriedOver);
+	if (Stats.OverrunSeconds > 0.0)
+	{
+		INC_FLOAT_STAT_BY(STAT_ApologueEvent_OverrunMs, Stats.OverrunSeconds * 1000.0);
+		INC_DWORD_STAT(STAT_ApologueEvent_NumOverruns);
+	}
+
+	return Stats;
+}
+
+int32 FApologueEventDispatcher::GetNumQueued() const
+{
+	int32 NumQueued = 0;
+	for (const TArray<FQueuedBroadcast>& Queue : QueuedBroadcasts)
+	{
+		NumQueued += Queue.Num();
+	}
+
+	return NumQueued;
+}
+
+bool FApologueEventDispatcher::SetListenerLocation(const UObject* Listener, const FVector& Location)
+{
+	const FObjectKey ListenerKey(Listener);
+	if (!Listeners.Contains(ListenerKey))
+	{
+		return false;
+	}
+
+	SpatialGrid.SetLocation(ListenerKey, Location);
+	return true;
+}
+
+void FApologueEventDispatcher::ClearListenerLocation(const UObject* Listener)
+{
+	SpatialGrid.RemoveLocation(FObjectKey(Listener));
+}
+
+const FVector* FApologueEventDispatcher::FindListenerLocation(const UObject* Listener) const
+{
+	return SpatialGrid.FindLocation(FObjectKey(Listener));
+}
+
+int32 FApologueEventDispatcher::CompactDeadCallbacks(const int32 MaxEvents)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ApologueEvent_CompactDeadCallbacks);
+
+	int32 NumRemoved = 0;
+	int32 NumEvents = 0;
+	for (auto It = DirtyEvents.CreateIterator(); It && NumEvents < MaxEvents; ++It, ++NumEvents)
+	{
+		if (FEventCallbacks* EventCallbacks = CallbacksByEvent.Find(*It))
+		{
+			NumRemoved += Compact(*EventCallbacks);
+			if (EventCallbacks->Callbacks.IsEmpty())
+			{
+				CallbacksByEvent.Remove(*It);
+			}
+		}
+
+		It.RemoveCurrent();
+	}
+
+	INC_DWORD_STAT_BY(STAT_ApologueEvent_NumCompacted, NumRemoved);
+	return NumRemoved;
+}
+
+int32 FApologueEventDispatcher::GetNumDeadCallbacks() const
+{
+	int32 NumDead = 0;
+	for (const TPair<FSoftObjectPath, FEventCallbacks>& EventCallbacks : CallbacksByEvent)
+	{
+		NumDead += EventCallbacks.Value.NumDead;
+	}
+
+	return NumDead;
+}
+
+void FApologueEventDispatcher::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (TArray<FQueuedBroadcast>& Queue : QueuedBroadcasts)
+	{
+		for (FQueuedBroadcast& QueuedBroadcast : Queue)
+		{
+			Collector.AddReferencedObject(QueuedBroadcast.Context);
+		}
+	}
+}
+
+int32 FApologueEventDispatcher::AllocateSlot(const FObjectKey& Listener)
+{
+	int32 Index = FirstFreeSlot;
+	if (Index == INDEX_NONE)
+	{
+		Index = ListenerSlots.AddDefaulted();
+	}
+	else
+	{
+		FirstFreeSlot = ListenerSlots[Index].NextFree;
+	}
+
+	FListenerSlot& Slot = ListenerSlots[Index];
+	Slot.Listener = Listener;
+	Slot.NextFree = INDEX_NONE;
+	return Index;
+}
+
+void FApologueEventDispatcher::UnregisterUnreachableListeners()
+{
+	// Once per collection rather than once per callback per broadcast
+	TArray<FObjectKey> Unreachable;
+	for (const TPair<FObjectKey, FListener>& Listener : Listeners)
+	{
+		if (!Listener.Key.ResolveObjectPtr())
+		{
+			Unreachable.Add(Listener.Key);
+		}
+	}
+
+	for (const FObjectKey& ListenerKey : Unreachable)
+	{
+		UnregisterListener(ListenerKey);
+	}
+}
+
+int32 FApologueEventDispatcher::Compact(FEventCallbacks& EventCallbacks) const
+{
+	const int32 NumRemoved = EventCallbacks.Callbacks.RemoveAll([this](const FRegisteredCallback& Callback)
+	{
+		return !IsCurrent(Callback);
+	});
+
+	EventCallbacks.NumDead = 0;
+	return NumRemoved;
+}
+
+bool FApologueEventDispatcher::HasHigherPriority(const FRegisteredCallback& A, const FRegisteredCallback& B)
+{
+	return A.Priority == B.Priority ? A.SubPriority > B.SubPriority : A.Priority > B.Priority;
+}
+
+bool FApologueEventDispatcher::RunsBefore(const FRegisteredCallback& A, const FRegisteredCallback& B)
+{
+	if (A.Priority != B.Priority || A.SubPriority != B.SubPriority)
+	{
+		return HasHigherPriority(A, B);
+	}
+
+	return A.Sequence < B.Sequence;
+}
+
+void FApologueEventDispatcher::GetEventPaths(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEvent* EventPtr,
+                                             TArray<FSoftObjectPath, TInlineAllocator<8>>& OutPaths)
+{
+	OutPaths.Reset();
+	OutPaths.Add(Event.ToSoftObjectPath());
+
+	// Ancestors are only known once the event is loaded
+	if (EventPtr)
+	{
+		OutPaths.Append(EventPtr->GetAncestors());
+	}
+}
+
+void FApologueEventDispatcher::MergeCallbacks(const TConstArrayView<const TArray<FRegisteredCallback>*> Lists, FCallbackList& OutCallbacks)
+{
+	int32 NumCallbacks = 0;
+	for (const TArray<FRegisteredCallback>* List : Lists)
+	{
+		NumCallbacks += List->Num();
+	}
+
+	OutCallbacks.Reset(NumCallbacks);
+
+	// Hierarchies are shallow, so the next callback is picked from the heads of the lists directly
+	TArray<int32, TInlineAllocator<8>> Heads;
+	Heads.SetNumZeroed(Lists.Num());
+	for (int32 Index = 0; Index < NumCallbacks; ++Index)
+	{
+		int32 Best = INDEX_NONE;
+		for (int32 ListIndex = 0; ListIndex < Lists.Num(); ++ListIndex)
+		{
+			if (Heads[ListIndex] < Lists[ListIndex]->Num()
+				&& (Best == INDEX_NONE || RunsBefore((*Lists[ListIndex])[Heads[ListIndex]], (*Lists[Best])[Heads[Best]])))
+			{
+				Best = ListIndex;
+			}
+		}
+
+		OutCallbacks.Add((*Lists[Best])[Heads[Best]++]);
+	}
+}
+
+void FApologueEventDispatcher::SortListeners(UApologueEventSortHandler& SortHandler, FCallbackList& Callbacks) const
+{
+	// The handler may broadcast, and sort, again before returning
+	if (SortScratch.Num() <= SortDepth)
+	{
+		SortScratch.Add(new TArray<UObject*>());
+	}
+
+	TArray<UObject*>& SortedListeners = SortScratch[SortDepth];
+	SortedListeners.Reset();
+	for (const FRegisteredCallback& Callback : Callbacks)
+	{
+		if (UObject* Listener = Callback.Listener.ResolveObjectPtr())
+		{
+			SortedListeners.AddUnique(Listener);
+		}
+	}
+
+	{
+		TGuardValue<int32> DepthGuard(SortDepth, SortDepth + 1);
+		SortHandler.Sort(SortedListeners);
+	}
+
+	// Sorted by listener for binary search, in place of a map that would allocate
+	TArray<TPair<FObjectKey, int32>, FApologueEventArenaAllocator> ListenerOrder;
+	ListenerOrder.Reserve(SortedListeners.Num());
+	for (int32 Index = 0; Index < SortedListeners.Num(); ++Index)
+	{
+		ListenerOrder.Emplace(FObjectKey(SortedListeners[Index]), Index);
+	}
+
+	Algo::SortBy(ListenerOrder, &TPair<FObjectKey, int32>::Key);
+
+	const auto GetOrder = [&ListenerOrder](const FObjectKey& Listener)
+	{
+		const int32 Index = Algo::LowerBoundBy(ListenerOrder, Listener, &TPair<FObjectKey, int32>::Key);
+		return Index < ListenerOrder.Num() && ListenerOrder[Index].Key == Listener ? ListenerOrder[Index].Value : MAX_int32;
+	};
+
+	Algo::StableSort(Callbacks, [&GetOrder](const FRegisteredCallback& A, const FRegisteredCallback& B)
+	{
+		if (A.Priority != B.Priority || A.SubPriority != B.SubPriority)
+		{
+			return HasHigherPriority(A, B);
+		}
+
+		return GetOrder(A.Listener) < GetOrder(B.Listener);
+	});
+}
+
+int32 FApologueEventDispatcher::InvokeCallbacks(const UApologueEvent* EventPtr, const UApologueEventContext* Context, FCallbackList& Callbacks) const
+{
+	if (EventPtr)
+	{
+		if (UApologueEventSortHandler* SortHandler = EventPtr->GetSortHandler())
+		{
+			SortListeners(*SortHandler, Callbacks);
+		}
+	}
+
+	int32 NumInvoked = 0;
+	for (const FRegisteredCallback& Callback : Callbacks)
+	{
+		if (Context && Context->IsCanceled())
+		{
+			break;
+		}
+
+		// Also skips listeners unregistered earlier in this broadcast
+		if (!IsCurrent(Callback))
+		{
+			continue;
+		}
+
+		if (Callback.Function)
+		{
+			// A current slot means the target was not collected, but objects destroyed since the last collection keep
+			// theirs. Their flag is mirrored next to the vtable ProcessEvent reads anyway, so checking it costs nothing.
+			if (Callback.Target->HasAnyFlags(RF_MirroredGarbage))
+			{
+				continue;
+			}
+
+			const UApologueEventContext* Parms = Context;
+			Callback.Target->ProcessEvent(Callback.Function, &Parms);
+		}
+		// Callbacks on other objects have no slot for their target, so they go through the delegate's weak pointer
+		else if (Callback.Callback.IsBound())
+		{
+			Callback.Callback.Execute(Context);
+		}
+		else
+		{
+			continue;
+		}
+
+		++NumInvoked;
+	}
+
+	return NumInvoked;
+}
@@ -0,0 +1,94 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Event/ApologueEventIngress.h"
+
+#include "Event/ApologueEvent.h"
+#include "ApologueEventStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ingress Broadcasts Drained"), STAT_ApologueEvent_NumIngressDrained, STATGROUP_ApologueEvent);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ingress Broadcasts Dropped"), STAT_ApologueEvent_NumIngressDropped, STATGROUP_ApologueEvent);
+
+FApologueEventIngress::FApologueEventIngress(const int32 InCapacity)
+	: Capacity(FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2)))
+	, Mask(Capacity - 1)
+{
+	Slots = MakeUnique<FSlot[]>(Capacity);
+	for (int32 Index = 0; Index < Capacity; ++Index)
+	{
+		Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+	}
+}
+
+bool FApologueEventIngress::Push(const FSoftObjectPath& Event, const FMakeContextFunction MakeContext, const void* Payload, const int32 PayloadSize)
+{
+	// Vyukov's bounded queue: claim a position whose slot has been popped, write it, then publish it through its sequence
+	uint64 Position = PushPosition.load(std::memory_order_relaxed);
+	FSlot* Slot;
+	while (true)
+	{
+		Slot = &Slots[Position & Mask];
+		const int64 Lag = static_cast<int64>(Slot->Sequence.load(std::memory_order_acquire) - Position);
+		if (Lag == 0)
+		{
+			if (PushPosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (Lag < 0)
+		{
+			// The slot still holds the broadcast from a lap ago
+			NumDropped.fetch_add(1, std::memory_order_relaxed);
+			INC_DWORD_STAT(STAT_ApologueEvent_NumIngressDropped);
+			return false;
+		}
+		else
+		{
+			Position = PushPosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	// Asset paths have no sub-path, so this copies names and never allocates
+	Slot->Event = Event;
+	Slot->MakeContext = MakeContext;
+	if (PayloadSize > 0)
+	{
+		FMemory::Memcpy(Slot->Payload, Payload, PayloadSize);
+	}
+
+	Slot->Sequence.store(Position + 1, std::memory_order_release);
+	return true;
+}
+
+int32 FApologueEventIngress::Drain(UObject* Outer, const int32 MaxCount,
+                                   const TFunctionRef<void(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context)>& Sink)
+{
+	check(IsInGameThread());
+
+	int32 NumDrained = 0;
+	while (NumDrained < MaxCount)
+	{
+		FSlot& Slot = Slots[PopPosition & Mask];
+		if (Slot.Sequence.load(std::memory_order_acquire) != PopPosition + 1)
+		{
+			// Empty, or the next push has claimed its slot but not finished writing it
+			break;
+		}
+
+		const TSoftObjectPtr<UApologueEvent> Event(Slot.Event);
+		const FMakeContextFunction MakeContext = Slot.MakeContext;
+		Slot.Event.Reset();
+
+		// Contexts are made before the slot is released, as they read its payload
+		const UApologueEventContext* Context = MakeContext ? MakeContext(Outer, Slot.Payload) : nullptr;
+		Slot.Sequence.store(PopPosition + Capacity, std::memory_order_release);
+		++PopPosition;
+		++NumDrained;
+
+		Sink(Event, Context);
+	}
+
+	INC_DWORD_STAT_BY(STAT_ApologueEvent_NumIngressDrained, NumDrained);
+	return NumDrained;
+}
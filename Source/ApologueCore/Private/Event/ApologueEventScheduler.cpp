@@ -0,0 +1,257 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Event/ApologueEventScheduler.h"
+
+#include "Event/ApologueEvent.h"
+#include "Event/ApologueEventContext.h"
+#include "ApologueEventStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Advance Scheduler"), STAT_ApologueEvent_AdvanceScheduler, STATGROUP_ApologueEvent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Broadcasts Due"), STAT_ApologueEvent_NumDue, STATGROUP_ApologueEvent);
+
+FApologueEventScheduler::FApologueEventScheduler(const double InTickSeconds)
+	: TickSeconds(InTickSeconds > 0.0 ? InTickSeconds : 1.0 / 60.0)
+{
+	for (int32& Slot : Slots)
+	{
+		Slot = INDEX_NONE;
+	}
+}
+
+FApologueEventTimerHandle FApologueEventScheduler::Schedule(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context,
+                                                             const double DelaySeconds, const double PeriodSeconds)
+{
+	int32 Index = FirstFree;
+	if (Index != INDEX_NONE)
+	{
+		FirstFree = Entries[Index].Next;
+	}
+	else
+	{
+		Index = Entries.AddDefaulted();
+	}
+
+	FEntry& Entry = Entries[Index];
+	Entry.Event = Event;
+	Entry.Context = Context;
+	Entry.DueTick = CurrentTick + FMath::Max<uint64>(1, SecondsToTicks(DelaySeconds));
+	Entry.PeriodTicks = PeriodSeconds > 0.0 ? FMath::Max<uint64>(1, SecondsToTicks(PeriodSeconds)) : 0;
+	Entry.Serial = NextSerial++;
+	if (NextSerial == 0)
+	{
+		NextSerial = 1;
+	}
+
+	Link(Index);
+	++NumScheduled;
+
+	FApologueEventTimerHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = Entry.Serial;
+	return Handle;
+}
+
+void FApologueEventScheduler::Cancel(FApologueEventTimerHandle& Handle)
+{
+	if (FindEntry(Handle))
+	{
+		Unlink(Handle.Index);
+		Free(Handle.Index);
+	}
+
+	Handle.Invalidate();
+}
+
+bool FApologueEventScheduler::IsScheduled(const FApologueEventTimerHandle& Handle) const
+{
+	return FindEntry(Handle) != nullptr;
+}
+
+double FApologueEventScheduler::GetTimeRemaining(const FApologueEventTimerHandle& Handle) const
+{
+	const FEntry* Entry = FindEntry(Handle);
+	if (!Entry)
+	{
+		return -1.0;
+	}
+
+	return FMath::Max(0.0, (Entry->DueTick - CurrentTick) * TickSeconds - PendingSeconds);
+}
+
+int32 FApologueEventScheduler::Advance(const double DeltaSeconds,
+                                       const TFunctionRef<void(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context)>& Sink)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ApologueEvent_AdvanceScheduler);
+
+	PendingSeconds += FMath::Max(0.0, DeltaSeconds);
+	const uint64 NumTicks = static_cast<uint64>(PendingSeconds / TickSeconds);
+	PendingSeconds -= NumTicks * TickSeconds;
+
+	int32 NumDue = 0;
+	for (uint64 Tick = 0; Tick < NumTicks; ++Tick)
+	{
+		if (NumScheduled == 0)
+		{
+			// Nothing can fall due, so the wheel only needs its position
+			CurrentTick += NumTicks - Tick;
+			break;
+		}
+
+		++CurrentTick;
+
+		// Higher levels first, so that entries they move down can move again within the same tick
+		for (int32 Level = NumLevels - 1; Level > 0; --Level)
+		{
+			if ((CurrentTick & ((1ull << (Level * SlotBits)) - 1)) == 0)
+			{
+				Cascade(Level);
+			}
+		}
+
+		int32& Head = Slots[CurrentTick & (NumSlots - 1)];
+		for (int32 Index = Head; Index != INDEX_NONE; Index = Entries[Index].Next)
+		{
+			Expiring.Emplace(Index, Entries[Index].Serial);
+			Entries[Index].Slot = INDEX_NONE;
+		}
+		Head = INDEX_NONE;
+
+		for (const TPair<int32, uint32>& Pair : Expiring)
+		{
+			// Cancelled by an earlier broadcast of the batch
+			if (Entries[Pair.Key].Serial != Pair.Value)
+			{
+				continue;
+			}
+
+			const TSoftObjectPtr<UApologueEvent> Event = Entries[Pair.Key].Event;
+			const UApologueEventContext* Context = Entries[Pair.Key].Context;
+
+			// Rescheduled before broadcasting, so a callback cancelling it finds it in the wheel
+			if (Entries[Pair.Key].PeriodTicks > 0)
+			{
+				Entries[Pair.Key].DueTick += Entries[Pair.Key].PeriodTicks;
+				Link(Pair.Key);
+			}
+			else
+			{
+				Free(Pair.Key);
+			}
+
+			++NumDue;
+			Sink(Event, Context);
+		}
+
+		Expiring.Reset();
+	}
+
+	INC_DWORD_STAT_BY(STAT_ApologueEvent_NumDue, NumDue);
+	return NumDue;
+}
+
+void FApologueEventScheduler::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.Serial != 0)
+		{
+			Collector.AddReferencedObject(Entry.Context);
+		}
+	}
+}
+
+uint64 FApologueEventScheduler::SecondsToTicks(const double Seconds) const
+{
+	return static_cast<uint64>(FMath::CeilToDouble(FMath::Max(0.0, Seconds) / TickSeconds));
+}
+
+const FApologueEventScheduler::FEntry* FApologueEventScheduler::FindEntry(const FApologueEventTimerHandle& Handle) const
+{
+	if (!Handle.IsValid() || !Entries.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+
+	const FEntry& Entry = Entries[Handle.Index];
+	return Entry.Serial == Handle.Serial ? &Entry : nullptr;
+}
+
+void FApologueEventScheduler::Link(const int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	const uint64 Delta = Entry.DueTick - CurrentTick;
+
+	int32 Level = 0;
+	while (Level < NumLevels - 1 && Delta >= (1ull << ((Level + 1) * SlotBits)))
+	{
+		++Level;
+	}
+
+	// Past the top level's reach, wait in its last slot before the due time and move down from there
+	const int32 Shift = Level * SlotBits;
+	const uint64 MaxDelta = (1ull << (Shift + SlotBits)) - (1ull << Shift);
+	const uint64 SlotTick = CurrentTick + FMath::Min(Delta, MaxDelta);
+
+	Entry.Slot = Level * NumSlots + static_cast<int32>((SlotTick >> Shift) & (NumSlots - 1));
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Slots[Entry.Slot];
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Index;
+	}
+	Slots[Entry.Slot] = Index;
+}
+
+void FApologueEventScheduler::Unlink(const int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	if (Entry.Slot == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		Slots[Entry.Slot] = Entry.Next;
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+
+	Entry.Slot = INDEX_NONE;
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+}
+
+void FApologueEventScheduler::Free(const int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	Entry.Event.Reset();
+	Entry.Context = nullptr;
+	Entry.Serial = 0;
+	Entry.Next = FirstFree;
+	FirstFree = Index;
+	--NumScheduled;
+}
+
+void FApologueEventScheduler::Cascade(const int32 Level)
+{
+	const int32 Shift = Level * SlotBits;
+	int32& Head = Slots[Level * NumSlots + static_cast<int32>((CurrentTick >> Shift) & (NumSlots - 1))];
+
+	int32 Index = Head;
+	Head = INDEX_NONE;
+	while (Index != INDEX_NONE)
+	{
+		const int32 Next = Entries[Index].Next;
+		Link(Index);
+		Index = Next;
+	}
+}
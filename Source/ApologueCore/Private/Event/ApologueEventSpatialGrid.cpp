@@ -0,0 +1,199 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Event/ApologueEventSpatialGrid.h"
+
+#include "ApologueEventStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spatial Query"), STAT_ApologueEvent_SpatialQuery, STATGROUP_ApologueEvent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spatial Cells Visited"), STAT_ApologueEvent_NumCellsVisited, STATGROUP_ApologueEvent);
+
+FApologueEventScope FApologueEventScope::Sphere(const FVector& Center, const double Radius)
+{
+	FApologueEventScope Scope;
+	Scope.Shape = EShape::Sphere;
+	Scope.Center = Center;
+	Scope.RadiusSquared = FMath::Square(FMath::Max(0.0, Radius));
+	Scope.Bounds = FBox::BuildAABB(Center, FVector(FMath::Max(0.0, Radius)));
+	return Scope;
+}
+
+FApologueEventScope FApologueEventScope::Box(const FBox& Box)
+{
+	FApologueEventScope Scope;
+	Scope.Shape = EShape::Box;
+	Scope.Bounds = Box;
+	return Scope;
+}
+
+bool FApologueEventScope::Contains(const FVector& Location) const
+{
+	switch (Shape)
+	{
+	case EShape::Sphere:
+		return FVector::DistSquared(Center, Location) <= RadiusSquared;
+
+	case EShape::Box:
+		return Bounds.IsValid && Bounds.IsInsideOrOn(Location);
+
+	default:
+		return true;
+	}
+}
+
+FApologueEventSpatialGrid::FApologueEventSpatialGrid(const double InCellSize)
+	: CellSize(FMath::Max(1.0, InCellSize))
+{
+}
+
+void FApologueEventSpatialGrid::SetLocation(const FObjectKey& Listener, const FVector& Location)
+{
+	if (FVector* OldLocation = Locations.Find(Listener))
+	{
+		if (GetCell(*OldLocation) == GetCell(Location))
+		{
+			// Moving within a cell only updates the copy in it
+			for (FCellEntry& Entry : Cells.FindChecked(GetCell(Location)))
+			{
+				if (Entry.Listener == Listener)
+				{
+					Entry.Location = Location;
+					break;
+				}
+			}
+		}
+		else
+		{
+			RemoveFromCell(Listener, *OldLocation);
+			AddToCell(Listener, Location);
+		}
+
+		*OldLocation = Location;
+		return;
+	}
+
+	Locations.Add(Listener, Location);
+	AddToCell(Listener, Location);
+}
+
+bool FApologueEventSpatialGrid::RemoveLocation(const FObjectKey& Listener)
+{
+	FVector Location;
+	if (!Locations.RemoveAndCopyValue(Listener, Location))
+	{
+		return false;
+	}
+
+	RemoveFromCell(Listener, Location);
+	return true;
+}
+
+const FVector* FApologueEventSpatialGrid::FindLocation(const FObjectKey& Listener) const
+{
+	return Locations.Find(Listener);
+}
+
+void FApologueEventSpatialGrid::SetCellSize(const double InCellSize)
+{
+	CellSize = FMath::Max(1.0, InCellSize);
+
+	Cells.Reset();
+	for (const TPair<FObjectKey, FVector>& Pair : Locations)
+	{
+		AddToCell(Pair.Key, Pair.Value);
+	}
+}
+
+void FApologueEventSpatialGrid::ForEachInScope(const FApologueEventScope& Scope, const TFunctionRef<void(const FObjectKey& Listener)>& Visitor) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ApologueEvent_SpatialQuery);
+
+	const FBox& Bounds = Scope.GetBounds();
+	if (!Bounds.IsValid || Cells.IsEmpty())
+	{
+		return;
+	}
+
+	const FIntVector MinCell = GetCell(Bounds.Min);
+	const FIntVector MaxCell = GetCell(Bounds.Max);
+
+	const auto VisitCell = [&Scope, &Visitor](const TArray<FCellEntry>& Entries)
+	{
+		for (const FCellEntry& Entry : Entries)
+		{
+			if (Scope.Contains(Entry.Location))
+			{
+				Visitor(Entry.Listener);
+			}
+		}
+	};
+
+	// In doubles, as the count overflows 64 bits for bounds spanning the whole range
+	const double NumCellsInBounds = (static_cast<double>(MaxCell.X) - MinCell.X + 1.0)
+		* (static_cast<double>(MaxCell.Y) - MinCell.Y + 1.0)
+		* (static_cast<double>(MaxCell.Z) - MinCell.Z + 1.0);
+
+	if (NumCellsInBounds > Cells.Num())
+	{
+		INC_DWORD_STAT_BY(STAT_ApologueEvent_NumCellsVisited, Cells.Num());
+		for (const TPair<FIntVector, TArray<FCellEntry>>& Cell : Cells)
+		{
+			const FIntVector& Key = Cell.Key;
+			if (Key.X >= MinCell.X && Key.X <= MaxCell.X && Key.Y >= MinCell.Y && Key.Y <= MaxCell.Y && Key.Z >= MinCell.Z && Key.Z <= MaxCell.Z)
+			{
+				VisitCell(Cell.Value);
+			}
+		}
+
+		return;
+	}
+
+	INC_DWORD_STAT_BY(STAT_ApologueEvent_NumCellsVisited, static_cast<uint32>(NumCellsInBounds));
+	// In int64, as cells clamped to MAX_int32 would overflow the increment
+	for (int64 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+	{
+		for (int64 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int64 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				if (const TArray<FCellEntry>* Entries = Cells.Find(FIntVector(static_cast<int32>(X), static_cast<int32>(Y), static_cast<int32>(Z))))
+				{
+					VisitCell(*Entries);
+				}
+			}
+		}
+	}
+}
+
+FIntVector FApologueEventSpatialGrid::GetCell(const FVector& Location) const
+{
+	// Clamped so that far-off locations share the outermost cells rather than overflowing
+	const auto GetCoordinate = [this](const double Value)
+	{
+		return static_cast<int32>(FMath::Clamp(FMath::FloorToDouble(Value / CellSize), static_cast<double>(MIN_int32), static_cast<double>(MAX_int32)));
+	};
+
+	return FIntVector(GetCoordinate(Location.X), GetCoordinate(Location.Y), GetCoordinate(Location.Z));
+}
+
+void FApologueEventSpatialGrid::AddToCell(const FObjectKey& Listener, const FVector& Location)
+{
+	FCellEntry& Entry = Cells.FindOrAdd(GetCell(Location)).AddDefaulted_GetRef();
+	Entry.Listener = Listener;
+	Entry.Location = Location;
+}
+
+void FApologueEventSpatialGrid::RemoveFromCell(const FObjectKey& Listener, const FVector& Location)
+{
+	const FIntVector Cell = GetCell(Location);
+	TArray<FCellEntry>& Entries = Cells.FindChecked(Cell);
+	Entries.RemoveAllSwap([&Listener](const FCellEntry& Entry)
+	{
+		return Entry.Listener == Listener;
+	});
+
+	if (Entries.IsEmpty())
+	{
+		Cells.Remove(Cell);
+	}
+}
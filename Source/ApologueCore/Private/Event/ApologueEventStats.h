@@ -0,0 +1,7 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Apologue Event"), STATGROUP_ApologueEvent, STATCAT_Advanced);
@@ -0,0 +1,119 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Event/ApologueEventSubsystem.h"
+
+#include "Engine/Level.h"
+#include "Engine/World.h"
+
+void FApologueEventIngressTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                                     const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->DrainIngress();
+	}
+}
+
+FString FApologueEventIngressTickFunction::DiagnosticMessage()
+{
+	return TEXT("FApologueEventIngressTickFunction");
+}
+
+void UApologueEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Ingress = MakeUnique<FApologueEventIngress>(IngressCapacity);
+	Scheduler = FApologueEventScheduler(ScheduleTickMs / 1000.0);
+	Dispatcher.SetCellSize(ListenerCellSize);
+}
+
+void UApologueEventSubsystem::Deinitialize()
+{
+	if (IngressTickFunction.IsTickFunctionRegistered())
+	{
+		IngressTickFunction.UnRegisterTickFunction();
+	}
+
+	Super::Deinitialize();
+}
+
+void UApologueEventSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	IngressTickFunction.Subsystem = this;
+	IngressTickFunction.TickGroup = IngressTickGroup;
+	IngressTickFunction.bCanEverTick = true;
+	IngressTickFunction.bStartWithTickEnabled = true;
+	IngressTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+int32 UApologueEventSubsystem::DrainIngress()
+{
+	return Ingress->Drain(this, Ingress->GetCapacity(), [this](const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context)
+	{
+		Dispatcher.BroadcastOrEnqueue(Event, Context);
+	});
+}
+
+void UApologueEventSubsystem::RegisterListener(const TScriptInterface<IApologueEventListenerInterface>& Listener)
+{
+	Dispatcher.RegisterListener(Listener.GetObject());
+}
+
+void UApologueEventSubsystem::UnregisterListener(const TScriptInterface<IApologueEventListenerInterface>& Listener)
+{
+	Dispatcher.UnregisterListener(Listener.GetObject());
+}
+
+void UApologueEventSubsystem::RefreshListener(const TScriptInterface<IApologueEventListenerInterface>& Listener)
+{
+	Dispatcher.RefreshListener(Listener.GetObject());
+}
+
+void UApologueEventSubsystem::SetListenerLocation(const TScriptInterface<IApologueEventListenerInterface>& Listener, const FVector& Location)
+{
+	Dispatcher.SetListenerLocation(Listener.GetObject(), Location);
+}
+
+void UApologueEventSubsystem::ClearListenerLocation(const TScriptInterface<IApologueEventListenerInterface>& Listener)
+{
+	Dispatcher.ClearListenerLocation(Listener.GetObject());
+}
+
+void UApologueEventSubsystem::EventBroadcaster_BroadcastEvent_Implementation(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context)
+{
+	Dispatcher.BroadcastOrEnqueue(Event, Context);
+}
+
+void UApologueEventSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	UApologueEventSubsystem* This = CastChecked<UApologueEventSubsystem>(InThis);
+	This->Dispatcher.AddReferencedObjects(Collector);
+	This->Scheduler.AddReferencedObjects(Collector);
+}
+
+void UApologueEventSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Broadcasts falling due join the queue ahead of this frame's dispatch
+	Scheduler.Advance(DeltaTime, [this](const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context)
+	{
+		Dispatcher.BroadcastOrEnqueue(Event, Context);
+	});
+
+	LastDispatchStats = Dispatcher.DispatchQueued(FrameBudgetMs / 1000.0);
+
+	Dispatcher.CompactDeadCallbacks(CompactEventsPerFrame);
+	Dispatcher.ResetScratch();
+}
+
+TStatId UApologueEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UApologueEventSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,6 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Flag/ApologueFlag.h"
+
+const FPrimaryAssetType UApologueFlag::PrimaryAssetType(TEXT("ApologueFlag"));
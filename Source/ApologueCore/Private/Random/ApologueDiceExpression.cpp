@@ -0,0 +1,347 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Random/ApologueDiceExpression.h"
+
+namespace ApologueDiceExpression
+{
+	/**
+	 * Reads the digits at Position into OutValue, failing past MAX_int32.
+	 *
+	 * @return Whether there was at least one digit.
+	 */
+	bool ReadNumber(const FString& Text, int32& Position, int64& OutValue, bool& bOutOverflowed)
+	{
+		const int32 Start = Position;
+		OutValue = 0;
+		while (Position < Text.Len() && FChar::IsDigit(Text[Position]))
+		{
+			OutValue = OutValue * 10 + (Text[Position] - TEXT('0'));
+			bOutOverflowed |= OutValue > MAX_int32;
+			OutValue = FMath::Min<int64>(OutValue, MAX_int32 + 1ll);
+			++Position;
+		}
+
+		return Position > Start;
+	}
+
+	/**
+	 * Reads a finite real number at Position into OutValue.
+	 */
+	bool ReadReal(const FString& Text, int32& Position, double& OutValue)
+	{
+		const TCHAR* Start = *Text + Position;
+		TCHAR* End = nullptr;
+		OutValue = FCString::Strtod(Start, &End);
+		Position += static_cast<int32>(End - Start);
+		return End > Start && FMath::IsFinite(OutValue);
+	}
+
+	/**
+	 * Skips Word at Position, ignoring case.
+	 *
+	 * @return Whether Word was there.
+	 */
+	bool SkipWord(const FString& Text, int32& Position, const TCHAR* Word)
+	{
+		const int32 Length = FCString::Strlen(Word);
+		if (FCString::Strnicmp(*Text + Position, Word, Length) != 0)
+		{
+			return false;
+		}
+
+		Position += Length;
+		return true;
+	}
+
+	/**
+	 * Reads the arguments and closing parenthesis of a distribution term.
+	 */
+	bool ReadDistribution(const FString& Text, int32& Position, FApologueDistributionTerm& OutTerm, bool& bOutOverflowed)
+	{
+		if (OutTerm.Distribution == EApologueDiceDistribution::Normal)
+		{
+			if (!ReadReal(Text, Position, OutTerm.Mean) || !SkipWord(Text, Position, TEXT(","))
+				|| !ReadReal(Text, Position, OutTerm.StandardDeviation))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			int64 Trials;
+			if (!ReadNumber(Text, Position, Trials, bOutOverflowed) || !SkipWord(Text, Position, TEXT(","))
+				|| !ReadReal(Text, Position, OutTerm.Probability))
+			{
+				return false;
+			}
+
+			OutTerm.Trials = static_cast<int32>(Trials);
+		}
+
+		return SkipWord(Text, Position, TEXT(")")) && OutTerm.IsValid();
+	}
+
+	/**
+	 * Finds the range of a term's draws before it is subtracted.
+	 */
+	void GetDrawRange(const FApologueDistributionTerm& Term, int64& OutMin, int64& OutMax)
+	{
+		if (Term.Distribution == EApologueDiceDistribution::Binomial)
+		{
+			OutMin = 0;
+			OutMax = Term.Trials;
+		}
+		else if (Term.StandardDeviation > 0.0)
+		{
+			// Unbounded but for the clamp
+			OutMin = MIN_int32;
+			OutMax = MAX_int32;
+		}
+		else
+		{
+			OutMin = OutMax = static_cast<int64>(FMath::Clamp<double>(FMath::RoundToDouble(Term.Mean), MIN_int32, MAX_int32));
+		}
+	}
+
+	/**
+	 * @return The shortest of a few precisions that reads back as Value.
+	 */
+	FString FormatReal(const double Value)
+	{
+		FString Result = FString::Printf(TEXT("%.15g"), Value);
+		if (FCString::Atod(*Result) != Value)
+		{
+			Result = FString::Printf(TEXT("%.17g"), Value);
+		}
+
+		return Result;
+	}
+}
+
+bool FApologueDistributionTerm::IsValid() const
+{
+	if (Distribution == EApologueDiceDistribution::Normal)
+	{
+		return FMath::IsFinite(Mean) && FMath::IsFinite(StandardDeviation) && StandardDeviation >= 0.0;
+	}
+
+	return Trials >= 0 && Probability >= 0.0 && Probability <= 1.0;
+}
+
+int64 FApologueDistributionTerm::GetMin() const
+{
+	int64 Min, Max;
+	ApologueDiceExpression::GetDrawRange(*this, Min, Max);
+	return bIsSubtracted ? -Max : Min;
+}
+
+int64 FApologueDistributionTerm::GetMax() const
+{
+	int64 Min, Max;
+	ApologueDiceExpression::GetDrawRange(*this, Min, Max);
+	return bIsSubtracted ? -Min : Max;
+}
+
+double FApologueDistributionTerm::GetMean() const
+{
+	const double DrawMean = Distribution == EApologueDiceDistribution::Normal ? Mean : Trials * Probability;
+	return bIsSubtracted ? -DrawMean : DrawMean;
+}
+
+bool FApologueDiceExpression::Parse(const FString& Notation, FApologueDiceExpression& OutExpression)
+{
+	using namespace ApologueDiceExpression;
+
+	FString Text;
+	Text.Reserve(Notation.Len());
+	for (const TCHAR Character : Notation)
+	{
+		if (!FChar::IsWhitespace(Character))
+		{
+			Text.AppendChar(Character);
+		}
+	}
+
+	if (Text.IsEmpty())
+	{
+		return false;
+	}
+
+	FApologueDiceExpression Expression;
+	int64 Modifier = 0;
+	bool bOverflowed = false;
+
+	int32 Position = 0;
+	while (Position < Text.Len())
+	{
+		int64 Sign = 1;
+		if (Text[Position] == TEXT('+') || Text[Position] == TEXT('-'))
+		{
+			Sign = Text[Position] == TEXT('-') ? -1 : 1;
+			++Position;
+		}
+		else if (Position > 0)
+		{
+			// Terms are joined by signs
+			return false;
+		}
+
+		const bool bIsNormal = SkipWord(Text, Position, TEXT("normal("));
+		if (bIsNormal || SkipWord(Text, Position, TEXT("binomial(")))
+		{
+			FApologueDistributionTerm& Term = Expression.Distributions.AddDefaulted_GetRef();
+			Term.Distribution = bIsNormal ? EApologueDiceDistribution::Normal : EApologueDiceDistribution::Binomial;
+			Term.bIsSubtracted = Sign < 0;
+			if (!ReadDistribution(Text, Position, Term, bOverflowed) || bOverflowed)
+			{
+				return false;
+			}
+
+			continue;
+		}
+
+		int64 Number;
+		const bool bHasNumber = ReadNumber(Text, Position, Number, bOverflowed);
+
+		if (Position < Text.Len() && FChar::ToLower(Text[Position]) == TEXT('d'))
+		{
+			++Position;
+
+			int64 Sides;
+			if (Position < Text.Len() && Text[Position] == TEXT('%'))
+			{
+				Sides = 100;
+				++Position;
+			}
+			else if (!ReadNumber(Text, Position, Sides, bOverflowed) || Sides < 1)
+			{
+				return false;
+			}
+
+			FApologueDiceTerm& Term = Expression.Dice.AddDefaulted_GetRef();
+			Term.Count = static_cast<int32>(Sign * (bHasNumber ? Number : 1));
+			Term.Sides = static_cast<int32>(Sides);
+		}
+		else if (bHasNumber)
+		{
+			Modifier += Sign * Number;
+			bOverflowed |= Modifier > MAX_int32 || Modifier < MIN_int32;
+		}
+		else
+		{
+			return false;
+		}
+
+		if (bOverflowed)
+		{
+			return false;
+		}
+	}
+
+	Expression.Modifier = static_cast<int32>(Modifier);
+	OutExpression = MoveTemp(Expression);
+	return true;
+}
+
+int64 FApologueDiceExpression::GetMin() const
+{
+	int64 Min = Modifier;
+	for (const FApologueDiceTerm& Term : Dice)
+	{
+		if (Term.Sides >= 1)
+		{
+			Min += Term.Count < 0 ? static_cast<int64>(Term.Count) * Term.Sides : Term.Count;
+		}
+	}
+
+	for (const FApologueDistributionTerm& Term : Distributions)
+	{
+		if (Term.IsValid())
+		{
+			Min += Term.GetMin();
+		}
+	}
+
+	return Min;
+}
+
+int64 FApologueDiceExpression::GetMax() const
+{
+	int64 Max = Modifier;
+	for (const FApologueDiceTerm& Term : Dice)
+	{
+		if (Term.Sides >= 1)
+		{
+			Max += Term.Count < 0 ? Term.Count : static_cast<int64>(Term.Count) * Term.Sides;
+		}
+	}
+
+	for (const FApologueDistributionTerm& Term : Distributions)
+	{
+		if (Term.IsValid())
+		{
+			Max += Term.GetMax();
+		}
+	}
+
+	return Max;
+}
+
+double FApologueDiceExpression::GetMean() const
+{
+	double Mean = Modifier;
+	for (const FApologueDiceTerm& Term : Dice)
+	{
+		if (Term.Sides >= 1)
+		{
+			Mean += Term.Count * (Term.Sides + 1.0) * 0.5;
+		}
+	}
+
+	for (const FApologueDistributionTerm& Term : Distributions)
+	{
+		if (Term.IsValid())
+		{
+			Mean += Term.GetMean();
+		}
+	}
+
+	return Mean;
+}
+
+FString FApologueDiceExpression::ToString() const
+{
+	FString Result;
+	for (const FApologueDiceTerm& Term : Dice)
+	{
+		if (Term.Count < 0)
+		{
+			Result += FString::Printf(TEXT("-%lldd%d"), -static_cast<int64>(Term.Count), Term.Sides);
+		}
+		else
+		{
+			Result += FString::Printf(Result.IsEmpty() ? TEXT("%dd%d") : TEXT("+%dd%d"), Term.Count, Term.Sides);
+		}
+	}
+
+	for (const FApologueDistributionTerm& Term : Distributions)
+	{
+		Result += Term.bIsSubtracted ? TEXT("-") : Result.IsEmpty() ? TEXT("") : TEXT("+");
+		if (Term.Distribution == EApologueDiceDistribution::Normal)
+		{
+			Result += FString::Printf(TEXT("normal(%s,%s)"), *ApologueDiceExpression::FormatReal(Term.Mean), *ApologueDiceExpression::FormatReal(Term.StandardDeviation));
+		}
+		else
+		{
+			Result += FString::Printf(TEXT("binomial(%d,%s)"), Term.Trials, *ApologueDiceExpression::FormatReal(Term.Probability));
+		}
+	}
+
+	if (Modifier != 0 || Result.IsEmpty())
+	{
+		Result += FString::Printf(Modifier < 0 || Result.IsEmpty() ? TEXT("%d") : TEXT("+%d"), Modifier);
+	}
+
+	return Result;
+}
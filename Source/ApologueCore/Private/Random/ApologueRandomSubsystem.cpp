@@ -0,0 +1,34 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Random/ApologueRandomSubsystem.h"
+
+#include "Hash/CityHash.h"
+
+void UApologueRandomSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	WorldRandom.Initialize();
+}
+
+void UApologueRandomSubsystem::SetWorldSeed(const uint64 Seed)
+{
+	check(IsInGameThread());
+
+	WorldRandom.Initialize(Seed);
+}
+
+uint64 UApologueRandomSubsystem::MakeTaskKey(const FStringView TaskName)
+{
+	// Hashed as UTF-8, since TCHAR differs in size between platforms
+	const FTCHARToUTF8 Utf8Name(TaskName.GetData(), TaskName.Len());
+	return CityHash64(Utf8Name.Get(), Utf8Name.Length());
+}
+
+void UApologueRandomSubsystem::K2_SetWorldSeed(const FString& Seed)
+{
+	check(IsInGameThread());
+
+	WorldRandom.Initialize(Seed);
+}
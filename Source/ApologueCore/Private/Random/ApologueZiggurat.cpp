@@ -0,0 +1,207 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Random/ApologueZiggurat.h"
+
+// Marsaglia and Tsang's construction for 256 layers of equal area, with R = 3.6541528853610088 and a layer area of
+// 0.00492867323397465524494; K and W are scaled for 52 bit magnitudes
+const uint64 FApologueZiggurat::NormalK[FApologueZiggurat::NumLayers] = {
+	0x000EF33D8025EF67ull, 0x0000000000000000ull, 0x000C08BE98FBC670ull, 0x000DA354FABD812Bull,
+	0x000E51F67EC1EEDFull, 0x000EB255E9D3F777ull, 0x000EEF4B817ECAB3ull, 0x000F19470AFA44A7ull,
+	0x000F37ED61FFCB14ull, 0x000F4F469561255Aull, 0x000F61A5E41BA395ull, 0x000F707A755396A2ull,
+	0x000F7CB2EC28449Aull, 0x000F86F10C6357D1ull, 0x000F8FA6578325DDull, 0x000F9724C74DD0DAull,
+	0x000F9DA907DBF508ull, 0x000FA360F581FA71ull, 0x000FA86FDE5B4BF7ull, 0x000FACF160D354DBull,
+	0x000FB0FB6718B90Eull, 0x000FB49F8D5374C5ull, 0x000FB7EC2366FE77ull, 0x000FBAECE9A1E50Cull,
+	0x000FBDAB9D040BEEull, 0x000FC03060FF6C57ull, 0x000FC2821037A248ull, 0x000FC4A67AE25BD1ull,
+	0x000FC6A2977AEE2Full, 0x000FC87AA92896A4ull, 0x000FCA325E4BDE85ull, 0x000FCBCCE902231Aull,
+	0x000FCD4D12F839C4ull, 0x000FCEB54D8FEC99ull, 0x000FD007BF1DC930ull, 0x000FD1464DD6C4E5ull,
+	0x000FD272A8E2F450ull, 0x000FD38E4FF0C91Eull, 0x000FD49A9990B479ull, 0x000FD598B8920F53ull,
+	0x000FD689C08E99ECull, 0x000FD76EA9C8E831ull, 0x000FD848547B08E8ull, 0x000FD9178BAD2C8Bull,
+	0x000FD9DD07A7ADD2ull, 0x000FDA9970105E8Bull, 0x000FDB4D5DC02E1Full, 0x000FDBF95C5BFCD1ull,
+	0x000FDC9DEBB99A7Dull, 0x000FDD3B8118729Dull, 0x000FDDD288342F90ull, 0x000FDE6364369F63ull,
+	0x000FDEEE708D514Full, 0x000FDF7401A6B42Eull, 0x000FDFF46599ED3Full, 0x000FE06FE4BC24F2ull,
+	0x000FE0E6C225A259ull, 0x000FE1593C28B84Cull, 0x000FE1C78CBC3F99ull, 0x000FE231E9DB1CA9ull,
+	0x000FE29885DA1B92ull, 0x000FE2FB8FB54186ull, 0x000FE35B33558D4Aull, 0x000FE3B799D0002Aull,
+	0x000FE410E99EAD7Eull, 0x000FE46746D47734ull, 0x000FE4BAD34C095Bull, 0x000FE50BAED29524ull,
+	0x000FE559F74EBC76ull, 0x000FE5A5C8E41211ull, 0x000FE5EF3E138689ull, 0x000FE6366FD91078ull,
+	0x000FE67B75C6D578ull, 0x000FE6BE661E11AAull, 0x000FE6FF55E5F4F2ull, 0x000FE73E5900A702ull,
+	0x000FE77B823E9E39ull, 0x000FE7B6E37070A1ull, 0x000FE7F08D774243ull, 0x000FE8289053F08Cull,
+	0x000FE85EFB35173Aull, 0x000FE893DC840864ull, 0x000FE8C741F0CEBCull, 0x000FE8F9387D4EF6ull,
+	0x000FE929CC879B1Dull, 0x000FE95909D388EBull, 0x000FE986FB939AA1ull, 0x000FE9B3AC714865ull,
+	0x000FE9DF2694B6D5ull, 0x000FEA0973ABE67Bull, 0x000FEA329CF166A4ull, 0x000FEA5AAB32952Dull,
+	0x000FEA81A6D57419ull, 0x000FEAA797DE1CEFull, 0x000FEACC85F3D91Full, 0x000FEAF07865E63Cull,
+	0x000FEB13762FEC12ull, 0x000FEB3585FE2A4Bull, 0x000FEB56AE3162B4ull, 0x000FEB76F4E284F9ull,
+	0x000FEB965FE62013ull, 0x000FEBB4F4CF9D7Cull, 0x000FEBD2B8F449CFull, 0x000FEBEFB16E2E3Dull,
+	0x000FEC0BE31EBDE8ull, 0x000FEC2752B15A14ull, 0x000FEC42049DAFD3ull, 0x000FEC5BFD29F196ull,
+	0x000FEC75406CEEF4ull, 0x000FEC8DD2500CB4ull, 0x000FECA5B6911F10ull, 0x000FECBCF0C427FEull,
+	0x000FECD38454FB15ull, 0x000FECE97488C8B3ull, 0x000FECFEC47F91B7ull, 0x000FED1377358528ull,
+	0x000FED278F844903ull, 0x000FED3B10242F4Cull, 0x000FED4DFBAD586Eull, 0x000FED605498C3DDull,
+	0x000FED721D414FE8ull, 0x000FED8357E4A982ull, 0x000FED9406A42CC8ull, 0x000FEDA42B85B704ull,
+	0x000FEDB3C8746AB3ull, 0x000FEDC2DF416652ull, 0x000FEDD171A46E52ull, 0x000FEDDF813C8AD3ull,
+	0x000FEDED0F90997Full, 0x000FEDFA1E0FD414ull, 0x000FEE06AE124BC4ull, 0x000FEE12C0D95A06ull,
+	0x000FEE1E579006E0ull, 0x000FEE29734B6524ull, 0x000FEE34150AE4BBull, 0x000FEE3E3DB89B3Cull,
+	0x000FEE47EE2982F3ull, 0x000FEE51271DB086ull, 0x000FEE59E9407F41ull, 0x000FEE623528B42Dull,
+	0x000FEE6A0B5897F1ull, 0x000FEE716C3E077Aull, 0x000FEE7858327B81ull, 0x000FEE7ECF7B06B9ull,
+	0x000FEE84D2484AB2ull, 0x000FEE8A60B66343ull, 0x000FEE8F7ACCC851ull, 0x000FEE94207E25DAull,
+	0x000FEE9851A829EAull, 0x000FEE9C0E13485Bull, 0x000FEE9F557273F3ull, 0x000FEEA22762CCAEull,
+	0x000FEEA4836B42ABull, 0x000FEEA668FC2D71ull, 0x000FEEA7D76ED6F9ull, 0x000FEEA8CE04FA0Aull,
+	0x000FEEA94BE8333Bull, 0x000FEEA95029640Full, 0x000FEEA8D9C0075Dull, 0x000FEEA7E7897654ull,
+	0x000FEEA678481D24ull, 0x000FEEA48AA29E83ull, 0x000FEEA21D22E4D9ull, 0x000FEE9F2E352024ull,
+	0x000FEE9BBC26AF2Eull, 0x000FEE97C524F2E4ull, 0x000FEE93473C0A39ull, 0x000FEE8E40557515ull,
+	0x000FEE88AE369C79ull, 0x000FEE828E7F3DFDull, 0x000FEE7BDEA7B887ull, 0x000FEE749BFF37FFull,
+	0x000FEE6CC3A9BD5Eull, 0x000FEE64529E007Eull, 0x000FEE5B45A32889ull, 0x000FEE51994E57B6ull,
+	0x000FEE474A0006CFull, 0x000FEE3C53E12C4Full, 0x000FEE30B2E02AD7ull, 0x000FEE2462AD8205ull,
+	0x000FEE175EB83C5Aull, 0x000FEE09A22A1447ull, 0x000FEDFB27E349CCull, 0x000FEDEBEA76216Cull,
+	0x000FEDDBE422047Eull, 0x000FEDCB0ECE39D3ull, 0x000FEDB964042CF4ull, 0x000FEDA6DCE938C9ull,
+	0x000FED937237E98Dull, 0x000FED7F1C38A836ull, 0x000FED69D2B9C02Bull, 0x000FED538D06ADFFull,
+	0x000FED3C41DEA422ull, 0x000FED23E76A2FD7ull, 0x000FED0A732FE643ull, 0x000FECEFDA07FE34ull,
+	0x000FECD4100EB7B8ull, 0x000FECB708956EB4ull, 0x000FEC98B61230C1ull, 0x000FEC790A0DA978ull,
+	0x000FEC57F50F31FEull, 0x000FEC356686C961ull, 0x000FEC114CB4B335ull, 0x000FEBEB948E6FD0ull,
+	0x000FEBC429A0B691ull, 0x000FEB9AF5EE0CDCull, 0x000FEB6FE1C98542ull, 0x000FEB42D3AD1F9Eull,
+	0x000FEB13B00B2D4Bull, 0x000FEAE2591A02E9ull, 0x000FEAAEAE992257ull, 0x000FEA788D8EE326ull,
+	0x000FEA3FCFFD73E5ull, 0x000FEA044C8DD9F6ull, 0x000FE9C5D62F563Bull, 0x000FE9843BA947A3ull,
+	0x000FE93F471D4729ull, 0x000FE8F6BD76C5D6ull, 0x000FE8AA5DC4E8E6ull, 0x000FE859E07AB1EAull,
+	0x000FE804F690A940ull, 0x000FE7AB488233BFull, 0x000FE74C751F6AA5ull, 0x000FE6E8102AA202ull,
+	0x000FE67DA0B6ABD8ull, 0x000FE60C9F38307Eull, 0x000FE5947338F742ull, 0x000FE51470977280ull,
+	0x000FE48BD436F458ull, 0x000FE3F9BFFD1E37ull, 0x000FE35D35EEB19Bull, 0x000FE2B5122FE4FCull,
+	0x000FE20003995557ull, 0x000FE13C82788314ull, 0x000FE068C4EE67AFull, 0x000FDF82B02B71AAull,
+	0x000FDE87C57EFEAAull, 0x000FDD7509C63BFDull, 0x000FDC46E529BF13ull, 0x000FDAF8F82E0282ull,
+	0x000FD985E1B2BA75ull, 0x000FD7E6EF48CF03ull, 0x000FD613ADBD650Bull, 0x000FD40149E2F012ull,
+	0x000FD1A1A7B4C7ACull, 0x000FCEE204761F9Eull, 0x000FCBA8D85E11B1ull, 0x000FC7D26ECD2D22ull,
+	0x000FC32B2F1E22EDull, 0x000FBD6581C0B83Aull, 0x000FB606C4005434ull, 0x000FAC40582A2873ull,
+	0x000F9E971E014597ull, 0x000F89FA48A41DFCull, 0x000F66C5F7F0302Cull, 0x000F1A5A4B331C4Aull
+};
+
+const double FApologueZiggurat::NormalW[FApologueZiggurat::NumLayers] = {
+	0x1.f493b7815d97fp-51, 0x1.b8d0be3fdf5cep-55, 0x1.250af3c2c5b64p-54, 0x1.57cb938443b28p-54,
+	0x1.801fce82fa6dep-54, 0x1.a230c2e4cd096p-54, 0x1.c004d2f3861d9p-54, 0x1.dac2f5a747258p-54,
+	0x1.f32482d4cd5acp-54, 0x1.04d32278ebba2p-53, 0x1.0f5053b025d38p-53, 0x1.192a69741366dp-53,
+	0x1.227a28f7a1aeap-53, 0x1.2b52e3863d876p-53, 0x1.33c3fc05791ebp-53, 0x1.3bd9ec1a2b125p-53,
+	0x1.439ef8dff9b4bp-53, 0x1.4b1bb363dfe9fp-53, 0x1.52575621ad36cp-53, 0x1.59580a707ce90p-53,
+	0x1.60231cfd97ee5p-53, 0x1.66bd261a37c39p-53, 0x1.6d2a29200056cp-53, 0x1.736dad346f8a3p-53,
+	0x1.798ad10b32a73p-53, 0x1.7f845ad46f53ep-53, 0x1.855cc53430a72p-53, 0x1.8b1649e7b7694p-53,
+	0x1.90b2ea94ecf94p-53, 0x1.96347822c1ee7p-53, 0x1.9b9c98e38c543p-53, 0x1.a0eccdca4a728p-53,
+	0x1.a62676d77cd56p-53, 0x1.ab4ad6e10162cp-53, 0x1.b05b16d136c99p-53, 0x1.b558487427a26p-53,
+	0x1.ba4368e529f37p-53, 0x1.bf1d62abf822fp-53, 0x1.c3e70f9594eefp-53, 0x1.c8a13a5323b5cp-53,
+	0x1.cd4c9fe722686p-53, 0x1.d1e9f0e80b743p-53, 0x1.d679d29e41f0bp-53, 0x1.dafce0023b8bfp-53,
+	0x1.df73aa9f1764ep-53, 0x1.e3debb5d2edfap-53, 0x1.e83e9337a6efdp-53, 0x1.ec93abdf982cap-53,
+	0x1.f0de784f06222p-53, 0x1.f51f654d8f684p-53, 0x1.f956d9e87d7aap-53, 0x1.fd8537dfa2ea9p-53,
+	0x1.00d56e04234eap-52, 0x1.02e40f5398f98p-52, 0x1.04eea9e16a5fap-52, 0x1.06f565b72a00ep-52,
+	0x1.08f869071f408p-52, 0x1.0af7d84bc610fp-52, 0x1.0cf3d664bcc7bp-52, 0x1.0eec84b160867p-52,
+	0x1.10e20329515e9p-52, 0x1.12d4707310fb9p-52, 0x1.14c3e9f8e913cp-52, 0x1.16b08bfc42019p-52,
+	0x1.189a71a78da30p-52, 0x1.1a81b51ee6d84p-52, 0x1.1c666f8f82ac8p-52, 0x1.1e48b93e0d42bp-52,
+	0x1.2028a9940a09ep-52, 0x1.2206572c4c6e8p-52, 0x1.23e1d7de9c31ep-52, 0x1.25bb40ca96bfap-52,
+	0x1.2792a661dd37dp-52, 0x1.29681c719d719p-52, 0x1.2b3bb62b82ed7p-52, 0x1.2d0d862e1b850p-52,
+	0x1.2edd9e8cba98bp-52, 0x1.30ac10d6e48d5p-52, 0x1.3278ee1f4b92ep-52, 0x1.3444470265e9fp-52,
+	0x1.360e2baca52d3p-52, 0x1.37d6abe055868p-52, 0x1.399dd6fb2b262p-52, 0x1.3b63bbfb83d01p-52,
+	0x1.3d28698561ddep-52, 0x1.3eebede725a80p-52, 0x1.40ae571e09e71p-52, 0x1.426fb2da6745ap-52,
+	0x1.44300e83c30a1p-52, 0x1.45ef773cac75ap-52, 0x1.47adf9e66c333p-52, 0x1.496ba32488f2bp-52,
+	0x1.4b287f6024159p-52, 0x1.4ce49acb311d8p-52, 0x1.4ea001638a601p-52, 0x1.505abef5e555ep-52,
+	0x1.5214df20a8b57p-52, 0x1.53ce6d56a664bp-52, 0x1.558774e1bb2c4p-52, 0x1.574000e555f75p-52,
+	0x1.58f81c60e8511p-52, 0x1.5aafd23241b56p-52, 0x1.5c672d17d733bp-52, 0x1.5e1e37b2f8cd1p-52,
+	0x1.5fd4fc89f5e36p-52, 0x1.618b860a31fc2p-52, 0x1.6341de8a2b0a1p-52, 0x1.64f8104b7260ap-52,
+	0x1.66ae257c99671p-52, 0x1.6864283b13136p-52, 0x1.6a1a22950b2b1p-52, 0x1.6bd01e8b343bbp-52,
+	0x1.6d8626128d352p-52, 0x1.6f3c43161f854p-52, 0x1.70f27f78b68ebp-52, 0x1.72a8e516914c6p-52,
+	0x1.745f7dc70eedcp-52, 0x1.7616535e5731fp-52, 0x1.77cd6faeff449p-52, 0x1.7984dc8babd93p-52,
+	0x1.7b3ca3c8b1409p-52, 0x1.7cf4cf3db22fbp-52, 0x1.7ead68c73dee7p-52, 0x1.80667a486ea1fp-52,
+	0x1.82200dac88676p-52, 0x1.83da2ce899f15p-52, 0x1.8594e1fd1f5bdp-52, 0x1.875036f7a7ec5p-52,
+	0x1.890c35f47f72dp-52, 0x1.8ac8e9205c043p-52, 0x1.8c865aba10c9cp-52, 0x1.8e44951446a27p-52,
+	0x1.9003a2973b58fp-52, 0x1.91c38dc288347p-52, 0x1.9384612ef0afcp-52, 0x1.954627903a28ap-52,
+	0x1.9708ebb70d5eep-52, 0x1.98ccb892e2a31p-52, 0x1.9a919933f99bfp-52, 0x1.9c5798cd5d92cp-52,
+	0x1.9e1ec2b6f7411p-52, 0x1.9fe7226fad24ap-52, 0x1.a1b0c39f93692p-52, 0x1.a37bb21a2c85bp-52,
+	0x1.a547f9e0bbb88p-52, 0x1.a715a724aa9a4p-52, 0x1.a8e4c64a0313dp-52, 0x1.aab563e9ff108p-52,
+	0x1.ac878cd5af5cep-52, 0x1.ae5b4e18bb336p-52, 0x1.b030b4fc3a11ap-52, 0x1.b207cf09a985bp-52,
+	0x1.b3e0aa0e00c00p-52, 0x1.b5bb541ce3d03p-52, 0x1.b797db93f8927p-52, 0x1.b9764f1e5f73cp-52,
+	0x1.bb56bdb85256ep-52, 0x1.bd3936b2ec0a2p-52, 0x1.bf1dc9b81ae83p-52, 0x1.c10486cec16a0p-52,
+	0x1.c2ed7e5f07a2dp-52, 0x1.c4d8c136e0d1cp-52, 0x1.c6c6608ec8705p-52, 0x1.c8b66e0eba617p-52,
+	0x1.caa8fbd36a2abp-52, 0x1.cc9e1c73bd68fp-52, 0x1.ce95e3068e037p-52, 0x1.d0906328b8f6ep-52,
+	0x1.d28db1037ef20p-52, 0x1.d48de1533c647p-52, 0x1.d691096e7f123p-52, 0x1.d8973f4d7fba5p-52,
+	0x1.daa0999206e70p-52, 0x1.dcad2f8fc490ep-52, 0x1.debd195522e36p-52, 0x1.e0d06fb49d21bp-52,
+	0x1.e2e74c4ea46f5p-52, 0x1.e501c99c1d188p-52, 0x1.e72002f97fe25p-52, 0x1.e94214b2abf0ap-52,
+	0x1.eb681c0f76f08p-52, 0x1.ed9237610a73ap-52, 0x1.efc086101eca9p-52, 0x1.f1f328ac25321p-52,
+	0x1.f42a40fb74d6dp-52, 0x1.f665f20c90168p-52, 0x1.f8a6604899782p-52, 0x1.faebb187122bfp-52,
+	0x1.fd360d22fe785p-52, 0x1.ff859c118f60bp-52, 0x1.00ed447d3a075p-51, 0x1.021a8028fc947p-51,
+	0x1.034a983a902abp-51, 0x1.047da4e3ef5c7p-51, 0x1.05b3bf6adb37ep-51, 0x1.06ed023a72668p-51,
+	0x1.082988f632e17p-51, 0x1.0969708e8a254p-51, 0x1.0aacd7571c0c4p-51, 0x1.0bf3dd1eed448p-51,
+	0x1.0d3ea34aa3d30p-51, 0x1.0e8d4cf116593p-51, 0x1.0fdffefa69fb6p-51, 0x1.1136e04207041p-51,
+	0x1.129219bbb5d35p-51, 0x1.13f1d69c4096dp-51, 0x1.1556448602e3bp-51, 0x1.16bf93b9deef3p-51,
+	0x1.182df74d21261p-51, 0x1.19a1a564eebacp-51, 0x1.1b1ad777f2f8ep-51, 0x1.1c99ca971a694p-51,
+	0x1.1e1ebfbe4ae39p-51, 0x1.1fa9fc2e2d901p-51, 0x1.213bc9d04cc81p-51, 0x1.22d477a6fd3eep-51,
+	0x1.24745a4ac9c23p-51, 0x1.261bcc77658dfp-51, 0x1.27cb2faa8592dp-51, 0x1.2982ecd770e77p-51,
+	0x1.2b437532a0a51p-51, 0x1.2d0d43196db96p-51, 0x1.2ee0db1a978f4p-51, 0x1.30becd256aeecp-51,
+	0x1.32a7b5e68a4a1p-51, 0x1.349c405ae12a1p-51, 0x1.369d27a33a83ep-51, 0x1.38ab392564108p-51,
+	0x1.3ac7570ae88f8p-51, 0x1.3cf27b31704a4p-51, 0x1.3f2dbaa60f473p-51, 0x1.417a49cb9e5d9p-51,
+	0x1.43d9815545e93p-51, 0x1.464ce44a73a15p-51, 0x1.48d62759c43bcp-51, 0x1.4b7739d6b5a27p-51,
+	0x1.4e3250dcd8902p-51, 0x1.5109f53e9ac41p-51, 0x1.54011523a7e42p-51, 0x1.571b1a94ae41bp-51,
+	0x1.5a5c08b718dd9p-51, 0x1.5dc8a243ad0fep-51, 0x1.61669cf861e4cp-51, 0x1.653ce7b006aeap-51,
+	0x1.69540be9fe5c3p-51, 0x1.6db6b8d09e232p-51, 0x1.72728f05f7a34p-51, 0x1.7799556090673p-51,
+	0x1.7d42df4d6ce8cp-51, 0x1.839030529f234p-51, 0x1.8ab0fbfaa7c14p-51, 0x1.92ee0946f4496p-51,
+	0x1.9cbee014057abp-51, 0x1.a8fdc78947759p-51, 0x1.b981f3878fdb0p-51, 0x1.d3bb48209ad33p-51
+};
+
+const double FApologueZiggurat::NormalF[FApologueZiggurat::NumLayers] = {
+	0x1.0000000000000p+0, 0x1.f446ac979f094p-1, 0x1.eb7545b6ca920p-1, 0x1.e3f11e027f080p-1,
+	0x1.dd36fa704de9dp-1, 0x1.d70920657bcf9p-1, 0x1.d144978a119e2p-1, 0x1.cbd33a8a72df1p-1,
+	0x1.c6a5ecea97884p-1, 0x1.c1b1cd9eebaefp-1, 0x1.bceeb4ee1dc87p-1, 0x1.b85653a8ff557p-1,
+	0x1.b3e3a8234dd15p-1, 0x1.af92a3f6ce8a7p-1, 0x1.ab5fef17a2509p-1, 0x1.a748bd550c9e6p-1,
+	0x1.a34aafdf5af14p-1, 0x1.9f63bee651fdcp-1, 0x1.9b9228d240685p-1, 0x1.97d4657617ac4p-1,
+	0x1.94291c21b7a4ap-1, 0x1.908f1bd317151p-1, 0x1.8d0554fe60aaap-1, 0x1.898ad48badf04p-1,
+	0x1.861ebfc37bcadp-1, 0x1.82c050f56cf71p-1, 0x1.7f6ed4b20e2cep-1, 0x1.7c29a779c685bp-1,
+	0x1.78f033ca0b0d8p-1, 0x1.75c1f0770d858p-1, 0x1.729e5f43f6d14p-1, 0x1.6f850baea7af0p-1,
+	0x1.6c7589e635a8bp-1, 0x1.696f75e513b2cp-1, 0x1.667272a92e325p-1, 0x1.637e298550c1ap-1,
+	0x1.6092498802667p-1, 0x1.5dae86f4aff6cp-1, 0x1.5ad29acc85c8bp-1, 0x1.57fe4264c8d92p-1,
+	0x1.55313f08d9e49p-1, 0x1.526b55a656cd8p-1, 0x1.4fac4e820b66ap-1, 0x1.4cf3f4f494ec3p-1,
+	0x1.4a42172dc527bp-1, 0x1.479685fdf5014p-1, 0x1.44f114a49367bp-1, 0x1.425198a355fe5p-1,
+	0x1.3fb7e99585b84p-1, 0x1.3d23e10af31a5p-1, 0x1.3a955a662cd10p-1, 0x1.380c32bda00d7p-1,
+	0x1.358848bf550ebp-1, 0x1.33097c9703a38p-1, 0x1.308fafd6438f1p-1, 0x1.2e1ac55ea3bf0p-1,
+	0x1.2baaa14d7954dp-1, 0x1.293f28e93cd1ap-1, 0x1.26d84290504f2p-1, 0x1.2475d5a90db89p-1,
+	0x1.2217ca92ff7f7p-1, 0x1.1fbe0a9929627p-1, 0x1.1d687fe54996fp-1, 0x1.1b171573fd117p-1,
+	0x1.18c9b709b3c55p-1, 0x1.16805128639dep-1, 0x1.143ad105ea9a0p-1, 0x1.11f9248311f3bp-1,
+	0x1.0fbb3a2325915p-1, 0x1.0d810104142a1p-1, 0x1.0b4a68d70d9afp-1, 0x1.091761d995d82p-1,
+	0x1.06e7dccf03c38p-1, 0x1.04bbcafa63f30p-1, 0x1.02931e18b822dp-1, 0x1.006dc85b8cac8p-1,
+	0x1.fc9778c7bbda8p-2, 0x1.f859da7a900cfp-2, 0x1.f4229cb2f7af8p-2, 0x1.eff1a717e8f9ap-2,
+	0x1.ebc6e20bd1f59p-2, 0x1.e7a236a4ec3cap-2, 0x1.e3838ea5f9b89p-2, 0x1.df6ad47763a0ep-2,
+	0x1.db57f320b56b6p-2, 0x1.d74ad6426de39p-2, 0x1.d3436a1021086p-2, 0x1.cf419b4ae5b75p-2,
+	0x1.cb45573c0a84ep-2, 0x1.c74e8bb00d7cep-2, 0x1.c35d26f1d2cbfp-2, 0x1.bf7117c616a1fp-2,
+	0x1.bb8a4d6716d9ap-2, 0x1.b7a8b78071324p-2, 0x1.b3cc462b331d2p-2, 0x1.aff4e9ea1855ap-2,
+	0x1.ac2293a5f5aa5p-2, 0x1.a85534aa4d889p-2, 0x1.a48cbea20c056p-2, 0x1.a0c9239468445p-2,
+	0x1.9d0a55e1e93e5p-2, 0x1.995048418c0ccp-2, 0x1.959aedbe09f98p-2, 0x1.91ea39b33cb1bp-2,
+	0x1.8e3e1fcb9f119p-2, 0x1.8a9693fde918bp-2, 0x1.86f38a8ac5ab8p-2, 0x1.8354f7faa0ddbp-2,
+	0x1.7fbad11b8d913p-2, 0x1.7c250aff414b1p-2, 0x1.78939af9252ebp-2, 0x1.7506769c7b1edp-2,
+	0x1.717d93ba9614cp-2, 0x1.6df8e86124caap-2, 0x1.6a786ad88de21p-2, 0x1.66fc11a25cbe2p-2,
+	0x1.6383d377be515p-2, 0x1.600fa7480d2c8p-2, 0x1.5c9f84376c244p-2, 0x1.5933619d6eebep-2,
+	0x1.55cb3703d0100p-2, 0x1.5266fc2533bedp-2, 0x1.4f06a8ebf6d92p-2, 0x1.4baa357109ca2p-2,
+	0x1.485199fad6ad4p-2, 0x1.44fccefc324fep-2, 0x1.41abcd1357a19p-2, 0x1.3e5e8d08ed2dbp-2,
+	0x1.3b1507cf143aep-2, 0x1.37cf368081379p-2, 0x1.348d125f9d19ep-2, 0x1.314e94d5af62fp-2,
+	0x1.2e13b77210766p-2, 0x1.2adc73e963fddp-2, 0x1.27a8c414db11ep-2, 0x1.2478a1f17de89p-2,
+	0x1.214c079f7cc9ep-2, 0x1.1e22ef6188116p-2, 0x1.1afd539c2f050p-2, 0x1.17db2ed5454e8p-2,
+	0x1.14bc7bb34ee67p-2, 0x1.11a134fcf2423p-2, 0x1.0e895598709c4p-2, 0x1.0b74d88b242dap-2,
+	0x1.0863b8f904336p-2, 0x1.0555f2242e9d9p-2, 0x1.024b7f6c7747ep-2, 0x1.fe88b89df93c5p-3,
+	0x1.f88108cb83235p-3, 0x1.f27fe6ce998d2p-3, 0x1.ec854a4c99c44p-3, 0x1.e6912b2283cddp-3,
+	0x1.e0a3816457184p-3, 0x1.dabc455c7900ap-3, 0x1.d4db6f8b2514fp-3, 0x1.cf00f8a5e6fccp-3,
+	0x1.c92cd9971df53p-3, 0x1.c35f0b7d89d47p-3, 0x1.bd9787abe18a1p-3, 0x1.b7d647a8731aap-3,
+	0x1.b21b452ccd13ap-3, 0x1.ac667a2571807p-3, 0x1.a6b7e0b19267ep-3, 0x1.a10f7322d7e3dp-3,
+	0x1.9b6d2bfd2fe5ap-3, 0x1.95d105f6a7c28p-3, 0x1.903afbf74fa69p-3, 0x1.8aab09192815bp-3,
+	0x1.852128a819a38p-3, 0x1.7f9d5621f7175p-3, 0x1.7a1f8d368a323p-3, 0x1.74a7c9c7ab5a6p-3,
+	0x1.6f3607e964716p-3, 0x1.69ca43e21f25cp-3, 0x1.64647a2adf19ep-3, 0x1.5f04a76f883fcp-3,
+	0x1.59aac88f31d6fp-3, 0x1.5456da9c86835p-3, 0x1.4f08dade31fc1p-3, 0x1.49c0c6cf5ce2dp-3,
+	0x1.447e9c20375d5p-3, 0x1.3f4258b6931aep-3, 0x1.3a0bfaae8d7eep-3, 0x1.34db805b4ab88p-3,
+	0x1.2fb0e847c2a65p-3, 0x1.2a8c3137a071ap-3, 0x1.256d5a2835eb7p-3, 0x1.2054625183c34p-3,
+	0x1.1b41492757d42p-3, 0x1.16340e5a82d63p-3, 0x1.112cb1da26eb9p-3, 0x1.0c2b33d5209bap-3,
+	0x1.072f94bb8bf85p-3, 0x1.0239d54067d2ap-3, 0x1.fa93ecb6b222cp-4, 0x1.f0bff29520e1cp-4,
+	0x1.e6f7bf29aa54bp-4, 0x1.dd3b56176e88fp-4, 0x1.d38abb9bd91e5p-4, 0x1.c9e5f493b740ap-4,
+	0x1.c04d0680b1015p-4, 0x1.b6bff78f2e233p-4, 0x1.ad3ece9caf633p-4, 0x1.a3c9933ea6286p-4,
+	0x1.9a604dc9d5b19p-4, 0x1.9103075a4a0abp-4, 0x1.87b1c9dbf2852p-4, 0x1.7e6ca013eefd6p-4,
+	0x1.753395aaa1176p-4, 0x1.6c06b73694a4cp-4, 0x1.62e6124854d18p-4, 0x1.59d1b577466a4p-4,
+	0x1.50c9b06fa2baep-4, 0x1.47ce1401b2213p-4, 0x1.3edef23269a86p-4, 0x1.35fc5e4d93e70p-4,
+	0x1.2d266cf9b3115p-4, 0x1.245d344dd0d96p-4, 0x1.1ba0cbe978982p-4, 0x1.12f14d0f217a2p-4,
+	0x1.0a4ed2c159629p-4, 0x1.01b979e30e49dp-4, 0x1.f262c2b6c6e41p-5, 0x1.e16d547b25194p-5,
+	0x1.d092efeadf171p-5, 0x1.bfd3e0f282a3ep-5, 0x1.af30790385f81p-5, 0x1.9ea90f9295573p-5,
+	0x1.8e3e02a68b5bbp-5, 0x1.7defb77af272dp-5, 0x1.6dbe9b398d072p-5, 0x1.5dab23cf2adddp-5,
+	0x1.4db5d0e112764p-5, 0x1.3ddf2ce98eecbp-5, 0x1.2e27ce83df497p-5, 0x1.1e9059f1f6abcp-5,
+	0x1.0f1982e968011p-5, 0x1.ff881d718a5c4p-6, 0x1.e121adb828c75p-6, 0x1.c301983cd091ap-6,
+	0x1.a529f4e22ebf8p-6, 0x1.879d1b600c10ap-6, 0x1.6a5daf40bbf82p-6, 0x1.4d6eaf2fbb064p-6,
+	0x1.30d388dab5e13p-6, 0x1.1490334603012p-6, 0x1.f152a4f72dd49p-7, 0x1.ba48d274f8facp-7,
+	0x1.841040d8da478p-7, 0x1.4eb96421acfe0p-7, 0x1.1a59229952f92p-7, 0x1.ce160f8ec6837p-8,
+	0x1.69ea8d90cb85dp-8, 0x1.08a1f03b0b205p-8, 0x1.55f9f43c1b072p-9, 0x1.4a605b6b9f70fp-10
+};
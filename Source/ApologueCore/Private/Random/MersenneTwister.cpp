@@ -0,0 +1,121 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Random/MersenneTwister.h"
+
+#include "Engine/NetSerialization.h"
+#include "Misc/Crc.h"
+
+namespace MersenneTwister
+{
+	/**
+	 * What a connection was last sent of a twister property; the base NetDeltaSerialize counts draws from.
+	 */
+	class FNetBaseState : public INetDeltaBaseState
+	{
+	public:
+		int64 InitialSeed = 0;
+		int32 StreamIndex = 0;
+		bool bIsInitialized = false;
+		uint64 DrawCount = 0;
+
+		// Stands in for the draw count, which no longer identifies the state once it is unknown
+		uint32 StateCrc = 0;
+
+		virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+		{
+			const FNetBaseState* Other = static_cast<const FNetBaseState*>(OtherState);
+			return InitialSeed == Other->InitialSeed && StreamIndex == Other->StreamIndex && bIsInitialized == Other->bIsInitialized
+				&& DrawCount == Other->DrawCount && StateCrc == Other->StateCrc;
+		}
+
+		/**
+		 * @return Whether Other follows this state by a number of draws the receiver can make.
+		 */
+		bool IsBaseOf(const FNetBaseState& Other) const
+		{
+			return bIsInitialized && Other.bIsInitialized && InitialSeed == Other.InitialSeed && StreamIndex == Other.StreamIndex
+				&& DrawCount < FMersenneTwister::UnknownDrawCount && Other.DrawCount < FMersenneTwister::UnknownDrawCount
+				&& DrawCount <= Other.DrawCount && Other.DrawCount - DrawCount <= FMersenneTwister::MaxCompactDrawCount;
+		}
+	};
+}
+
+bool FMersenneTwister::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	using namespace MersenneTwister;
+
+	if (FBitWriter* Writer = DeltaParms.Writer)
+	{
+		const TSharedRef<FNetBaseState> NewState = MakeShared<FNetBaseState>();
+		NewState->InitialSeed = InitialSeed;
+		NewState->StreamIndex = StreamIndex;
+		NewState->bIsInitialized = bIsInitialized;
+		NewState->DrawCount = Engine.GetDrawCount();
+		if (HasUnknownDrawCount())
+		{
+			const TConstArrayView<uint64> State = Engine.GetState();
+			NewState->StateCrc = FCrc::MemCrc32(State.GetData(), State.Num() * sizeof(uint64), static_cast<uint32>(Engine.GetStateIndex()));
+		}
+
+		const FNetBaseState* OldState = static_cast<const FNetBaseState*>(DeltaParms.OldState);
+		if (OldState && OldState->IsStateEqual(&NewState.Get()))
+		{
+			return false;
+		}
+
+		*DeltaParms.NewState = NewState;
+
+		uint8 bIsDelta = OldState && OldState->IsBaseOf(*NewState);
+		Writer->SerializeBits(&bIsDelta, 1);
+
+		if (!bIsDelta)
+		{
+			bool bSuccess;
+			NetSerialize(*Writer, DeltaParms.Map, bSuccess);
+			return true;
+		}
+
+		// The low byte of the base draw count catches receivers that are not at the base
+		uint64 Delta = NewState->DrawCount - OldState->DrawCount;
+		uint8 BaseCheck = static_cast<uint8>(OldState->DrawCount);
+		Writer->SerializeIntPacked64(Delta);
+		*Writer << BaseCheck;
+		return true;
+	}
+
+	if (FBitReader* Reader = DeltaParms.Reader)
+	{
+		uint8 bIsDelta = 0;
+		Reader->SerializeBits(&bIsDelta, 1);
+
+		if (!bIsDelta)
+		{
+			bool bSuccess;
+			NetSerialize(*Reader, DeltaParms.Map, bSuccess);
+			if (!bSuccess)
+			{
+				Reader->SetError();
+			}
+
+			return true;
+		}
+
+		uint64 Delta = 0;
+		uint8 BaseCheck = 0;
+		Reader->SerializeIntPacked64(Delta);
+		*Reader << BaseCheck;
+
+		if (Reader->IsError() || !bIsInitialized || HasUnknownDrawCount() || Delta > MaxCompactDrawCount
+			|| static_cast<uint8>(Engine.GetDrawCount()) != BaseCheck)
+		{
+			Reader->SetError();
+			return true;
+		}
+
+		Engine.Discard(Delta);
+		return true;
+	}
+
+	return false;
+}
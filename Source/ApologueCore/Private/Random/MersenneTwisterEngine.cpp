@@ -0,0 +1,132 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Random/MersenneTwisterEngine.h"
+
+namespace MersenneTwisterEngine
+{
+	/**
+	 * x^(2^128) mod x*P(x), where P is the characteristic polynomial of MT19937-64; bit I of the table is the
+	 * coefficient of x^I. The extra factor of x makes the jump exact for the unused low bits of the oldest word too, so
+	 * a jumped engine compares equal to one that drew 2^128 words.
+	 *
+	 * Computed offline with Berlekamp-Massey over the engine's output bits, then repeated squaring modulo x*P(x).
+	 */
+	constexpr int32 JumpPolynomialDegree = 19936;
+
+	constexpr uint64 JumpPolynomial[FMersenneTwisterEngine::StateSize] =
+	{
+		0x153FBC23409B1E30ull, 0xB8D58A2EFC1CC7BEull, 0x04CC8DF6BD5573E1ull, 0x8E1B99D6EA322754ull,
+		0x7FA5C8AB11A78ECFull, 0xA3F01992F879DC26ull, 0x77500E62929D74D1ull, 0x4C65EF439F2DCB2Aull,
+		0x731B3BD3538EEC46ull, 0x14CD564C40C9E3AEull, 0x6FF65677752268B7ull, 0xBBEA104C48EC8B8Dull,
+		0x08D3565972568EA4ull, 0x5CB79DB1F77395F2ull, 0x94F5C348A32CECACull, 0x4B58CC38B6123ED7ull,
+		0x64D191A00B3E362Cull, 0x7B051615BC105659ull, 0x2AD11E2D812E15D2ull, 0xD2551D15C944F218ull,
+		0x68374254D1F46885ull, 0x72A5FD7700E8C34Full, 0xE40B4AC61E14376Cull, 0xBB107CD0A9158CC0ull,
+		0x5028A2A3D4CE28E6ull, 0xD0815EEB2E91AA05ull, 0x29BA386F6309E7DDull, 0xA19BF128091DF643ull,
+		0xA4DDA3EA5AF247F8ull, 0x950FF2C8BC8D9F30ull, 0xC415A0871EF1AF4Eull, 0xE8859D7A5AC3264Cull,
+		0x4D58E6BED0739FE2ull, 0xB072D474E3F9602Cull, 0x93B112035CF0E33Dull, 0x90D4AF56420A0A3Dull,
+		0xCB930CDFFD09BA87ull, 0x82305413C76BA04Aull, 0x88ED61BA7DFC9075ull, 0xDEFC75A7869C145Cull,
+		0x0C16916696775659ull, 0x94A47BF0B5D3869Bull, 0x026C4476E2551799ull, 0x2B22D90027FDD747ull,
+		0xE447AF7718644777ull, 0xBB83F1C03190E0FAull, 0x932FABC717B3114Cull, 0xE0384041DBD5EAFDull,
+		0x698CA9A2304FA895ull, 0xBBB26EFF4E2F6627ull, 0x453CAB967A470645ull, 0x2A6AEFABCD19D4E9ull,
+		0x808F8D33240F6B90ull, 0x91BF46C93A4B852Bull, 0x74B6A8597100E697ull, 0xBD2A4EF239564089ull,
+		0x9917718E08EC24FAull, 0xAC9CE650DCCC5D61ull, 0x52DB4D76A2C5546Cull, 0x0123E0FC3CB90AEAull,
+		0xFE78F1E83BB93635ull, 0x4F5B739D5BA04851ull, 0xA4BF7F96E9684A89ull, 0x5464BB377A97F62Eull,
+		0x328933F006CE14BEull, 0x43E558B7D62AE5D7ull, 0xDDB0F33F21E7D8DCull, 0x52D2779DE93320D2ull,
+		0x57191C72ACFC5093ull, 0x1779384819CA00E9ull, 0x7AFCFBBE2ACAA684ull, 0x90231D57884A7544ull,
+		0xDD3FFEAD4FEEC6E3ull, 0x273584A42F1A795Dull, 0x691601338D2C7449ull, 0x8C8E419CA0529FC3ull,
+		0x373E37DD051F8B86ull, 0x27A2D7161F6D06BDull, 0x954240070472311Aull, 0x471565B60A93D2E4ull,
+		0x4FB4AD962C328135ull, 0x7B1A3A92C401E93Bull, 0xF261C3FCC82AF141ull, 0x57241AF08978F3ECull,
+		0x2C79AAA370D1BD4Full, 0xF35790A0978137D6ull, 0x38C7263C96234239ull, 0xE0A13A1DD5F852B5ull,
+		0x0734F6C962F86802ull, 0xCA52564F72F13F11ull, 0xA4BD2A9DC69A1248ull, 0x6F418A04EDB45E98ull,
+		0x764B57A0059AA71Aull, 0x926F6F5F354266DFull, 0x60C4150013CC9412ull, 0x3A14980C9D4CCD96ull,
+		0x4E5DA33944239D8Bull, 0x23F3EF6E843C729Cull, 0x389B1022DE0AC7C9ull, 0x369B29D7D285823Eull,
+		0xF556214AD63E2CD9ull, 0x90E43B9536BC15ABull, 0xA43604007E23FD84ull, 0x70EE2BD8D9E6C2AFull,
+		0x0E8B6C7A77FD426Aull, 0xED09417CE0D73CDFull, 0xA3E935E2C81A4021ull, 0x7CF2E08B288398FAull,
+		0x1E933CDE96A31115ull, 0xDB6014C3A780C561ull, 0x2BF15950B4660F9Dull, 0x50CF62EFC80A3C55ull,
+		0x448EDE02EA0783C5ull, 0x97DF0D14F64C01C7ull, 0x1353357D543368D0ull, 0x9BD1449652CDCA9Cull,
+		0x66D15AEFA7A24321ull, 0x25DD75FC7492BA9Dull, 0x468CE9A1A3874E13ull, 0x40AB9E8ED67A4AD1ull,
+		0x0BAFB4D323D02677ull, 0xF9F3D01C1F435B69ull, 0x0C4A0FA46FAC656Aull, 0xBDAC3ABDD37E4DFCull,
+		0xDF9B06EF05DB31DFull, 0xED005F00F37DAA7Bull, 0x924BE2E465B09410ull, 0x99099376EA87BE57ull,
+		0x302D8A7C49C4BE6Aull, 0xE8EFFC70541C07A5ull, 0x6E4611AD196A6EE3ull, 0xBD42CB15A52CB228ull,
+		0xCE343EE493CDEC20ull, 0x7F4231E3D20E8E72ull, 0xA2127D2ED81E4F89ull, 0x27BB32AFA1C6EF4Cull,
+		0x9D37D9F4CB87C492ull, 0xA6B7E94B15E2287Cull, 0x098B4D302E16D6E9ull, 0x12D1DA8FFBF3ADB2ull,
+		0xD5BE155BC2FC01DEull, 0x90F630B9E309715Bull, 0xBDB108B0F8DA213Cull, 0x98ED520D71F49D1Aull,
+		0x82495AACD19EB9DCull, 0x124D7478A15025B2ull, 0xA0EB607EC4087775ull, 0xCB47955EEABE0890ull,
+		0x7360A3D0E0B68B89ull, 0x25F5BEE656159D92ull, 0xEAE8434E13F985EDull, 0x04FF38722AD10A86ull,
+		0xAC7097215B434280ull, 0x3640AE9DD0687B1Aull, 0xB24209A4CE9F603Bull, 0xF03E6FD6F7A416DDull,
+		0xD31E5BCDE48672AFull, 0x2704CE60EB8429A7ull, 0xF7AEB81F8FCD00C3ull, 0x5424DBAA0B636A3Cull,
+		0xF352FE250D625A64ull, 0x9CC12556C2228F86ull, 0xEDAC0DBB94E94F51ull, 0xDD8F2B1F26762FD1ull,
+		0x5EF488076C7E957Full, 0x2B734DC8A46C3C61ull, 0x52111589EB2A22E3ull, 0xFA11C9BB843DF4BCull,
+		0x5896AC2ECF36F9D2ull, 0x66C197A7E49DBA0Aull, 0xE1EDA2CD47AEFD0Full, 0x4CAE0ACF5D5FA62Dull,
+		0xCB3E21E3F8D7C943ull, 0x351580D27B75FE44ull, 0x6CBD4B5618CBAB9Bull, 0x8E47EF0542E8A51Dull,
+		0x125ADF6B4B59B2EFull, 0x2729DC334CACFD5Bull, 0x883432A737937820ull, 0x60F002C1DCEDA4ABull,
+		0xAFED1BE46E7FD2BCull, 0xF2A3D1CCBF871115ull, 0xF85E5C5050AE7160ull, 0x777CDC44554E6D74ull,
+		0x0BCF75213E259946ull, 0x9D0714B4DB9CA29Aull, 0x370FDC4067326A6Dull, 0xFFEB713807A1CEA8ull,
+		0x7FB0A9674A53E792ull, 0x62B040005F9CE7BBull, 0x8903F6B282B67CABull, 0x3544FF158026EB52ull,
+		0xD66590248ADF92F1ull, 0x55DE1C87A2EBDF48ull, 0x40B0382287267ABAull, 0x7DFA56A6FB26180Eull,
+		0x45C32D7DC66B19CEull, 0xF5ED0EDF665034C7ull, 0xF4C7ADBE75E15DA0ull, 0x95DB8535E0BD9122ull,
+		0xC571B09620D82713ull, 0x9C21ED0E78F021F9ull, 0xD0CB50A9F9AA8DEFull, 0xBCB3368C4E9FF5B6ull,
+		0x06D8F649704939A3ull, 0x5EAA9EE186D14A54ull, 0x86D1F972FD4883D0ull, 0x63B1522F4D50D887ull,
+		0x982B2FBA1A9875A7ull, 0x7258BFD6235930EAull, 0xE4CCC8E3C2F0F70Eull, 0x9BF390D119769362ull,
+		0x1BCEA29DBD2C02BEull, 0xD9C189DB413398C0ull, 0x988AA44564F85434ull, 0x007ED1EAEEF5E20Aull,
+		0xA0685FEDE0EEC596ull, 0xFEF177E0B35A7F0Eull, 0x5006596F191EBC61ull, 0xCBA87C3E61BDBC8Aull,
+		0xFF2174049069BFCBull, 0xD7A536DDB2C4F33Full, 0xF7AECDE21FC2D977ull, 0xC121DCA3FEEF7800ull,
+		0xA90AD927D025C16Bull, 0x3EA6FEE532058E96ull, 0x9F5210DF30ACDEB9ull, 0x520E94889837BCFFull,
+		0x8C6C6A100DABDB5Bull, 0x6D2101F3FC530774ull, 0x51D535E6DC645E49ull, 0xE5E7620ED6A4941Bull,
+		0xAF8023C107046243ull, 0x62E6E40F4EA19600ull, 0x466396CE1AB8E939ull, 0x470FC344D01A2A69ull,
+		0x223011F816549F0Eull, 0x9B0A401733299C57ull, 0x6E214523AE60B334ull, 0x84C4CBE45A9B66A6ull,
+		0x630D39F922B4C0B4ull, 0xFBFA79EC2C0E1012ull, 0xE9940485EC80D5C0ull, 0x1DC1C6FB5A01F32Aull,
+		0x9CD0B7F3A578E57Full, 0x40B6CE9D50E92C04ull, 0x588B8AF39AB91D81ull, 0x8058DC2783B02DE3ull,
+		0xBB2103C504392C9Dull, 0x7264692220716211ull, 0xDB804FCDEB987BBAull, 0xABABD32A49398687ull,
+		0xE3DEE3755B4DA875ull, 0x16DE733ADB8BB721ull, 0x99476D13103FFE32ull, 0x86D2D629666CB05Bull,
+		0x9C4E62AB740CE645ull, 0xB59682265B7519FFull, 0x54DF6930E9ED43FBull, 0x33F8218861F98B68ull,
+		0x21BC749542F06516ull, 0xD5E9662B4586DF7Full, 0x465569EA0EB5CCE4ull, 0x36A484C938F0AE75ull,
+		0xC088CC5189F80399ull, 0x4BECD1A8A2280CDEull, 0x192F20A74DAC06F0ull, 0xAE766A8B287A1565ull,
+		0x036C05BA6ABFF5F3ull, 0x5FE448493D8FAF69ull, 0xA880A8FF94B90EA8ull, 0xD0EC7C6342D2B77Bull,
+		0xD187D7068A2CF90Full, 0x32523F9AD82E6693ull, 0x0F87420E87B90726ull, 0x3A745F953D8E0C35ull,
+		0x0199993C5A3D1DB4ull, 0x33E45B5766CCB1A0ull, 0xD2ABAAC1626E0B0Cull, 0xAD5C3023B061FDFBull,
+		0xF67CF6541CB66E52ull, 0xE9D9083C635A2190ull, 0x29A103E0C3B4DAC8ull, 0x75F72ADB5E7A7E46ull,
+		0xDCC943AB2EC296DAull, 0x396A079F137FF14Bull, 0x67853F3D29182EC1ull, 0x35DD3E7A7A71C780ull,
+		0xFBF82A6FA275A546ull, 0x39CC58A7583F7227ull, 0x8B1B1AEDEFEA9FEDull, 0x909F457DADA71450ull,
+		0xC02ABFCBFE3E387Aull, 0xD6871E18B79AE3C1ull, 0x9F6BAC46344F1A0Full, 0x3366CD78201ABCEDull,
+		0xA9DA4A5207175299ull, 0x030642BAF1AD5022ull, 0x5AE120669A844AB0ull, 0xD8FC12C876B5DBB7ull,
+		0x2F92B413A6FC6E34ull, 0x2F2B5A6B0F30AFF4ull, 0x89633B161FAC757Aull, 0x5E4BF21CA2B399C2ull,
+		0x5ED834F955DCF6ABull, 0xD5FDC80D6FA8E6CDull, 0xCDF09ED99544069Full, 0xFA9ADC855E53297Cull,
+		0x38FA314D5C46AB53ull, 0x94508C05DDA26A06ull, 0x7DE2DAE2AA415D2Cull, 0x0000000143ED6F2Eull,
+	};
+}
+
+void FMersenneTwisterEngine::Jump()
+{
+	using namespace MersenneTwisterEngine;
+
+	// Horner's rule: Accumulator = JumpPolynomial(F) applied to this state, F being one untempered step
+	FMersenneTwisterEngine Accumulator;
+	FMemory::Memzero(Accumulator.State, sizeof(State));
+	Accumulator.Index = Index;
+
+	for (int32 Degree = JumpPolynomialDegree; Degree >= 0; --Degree)
+	{
+		Accumulator.Step();
+
+		if ((JumpPolynomial[Degree / 64] >> (Degree % 64)) & 1)
+		{
+			// Accumulator += this state, matching words by age rather than by position in the ring
+			const int32 Offset = Index - Accumulator.Index + (Index < Accumulator.Index ? StateSize : 0);
+			for (int32 I = 0; I < StateSize - Offset; ++I)
+			{
+				Accumulator.State[I] ^= State[I + Offset];
+			}
+
+			for (int32 I = StateSize - Offset; I < StateSize; ++I)
+			{
+				Accumulator.State[I] ^= State[I + Offset - StateSize];
+			}
+		}
+	}
+
+	FMemory::Memcpy(State, Accumulator.State, sizeof(State));
+	Index = Accumulator.Index;
+	DrawCount = 0;
+}
@@ -5,6 +5,8 @@
 
 #include "Stat/ApologueStatFunction.h"
 
+const FPrimaryAssetType UApologueStat::PrimaryAssetType(TEXT("ApologueStat"));
+
 int32 UApologueStat::GetValue(const int32 BaseValue, const UApologueStatFunctionContext* Context) const
 {
 	return Function->GetValue(this, BaseValue, Context);
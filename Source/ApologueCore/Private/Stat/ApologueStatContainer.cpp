@@ -0,0 +1,157 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Stat/ApologueStatContainer.h"
+
+#include "ApologueCore.h"
+#include "Engine/World.h"
+#include "Event/ApologueEventBroadcasterInterface.h"
+#include "Stat/ApologueStatChangedEventContext.h"
+#include "Stat/ApologueStatSubsystem.h"
+
+void UApologueStatContainer::Initialize(const FApologueStatTable& InTable)
+{
+	Table = InTable;
+	DirtyStats.Init(false, Table.Num());
+	OldValues.SetNumUninitialized(Table.Num());
+}
+
+bool UApologueStatContainer::TryGet(const TSoftObjectPtr<UApologueStat>& Stat, int32& OutValue) const
+{
+	return Table.TryGet(Stat, OutValue);
+}
+
+bool UApologueStatContainer::TrySet(const TSoftObjectPtr<UApologueStat>& Stat, const int32 NewValue)
+{
+	const int32 Index = Table.IndexOf(Stat);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	SetValueAt(Index, NewValue);
+	return true;
+}
+
+bool UApologueStatContainer::TryAdd(const TSoftObjectPtr<UApologueStat>& Stat, const int32 Delta)
+{
+	const int32 Index = Table.IndexOf(Stat);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	SetValueAt(Index, Table.GetEntry(Index).Value + Delta);
+	return true;
+}
+
+bool UApologueStatContainer::HasPendingChanges() const
+{
+	// Stats set back to their old value are not reported by the flush, so they are not pending either
+	const int32 NumTracked = FMath::Min(DirtyStats.Num(), Table.Num());
+	for (TConstSetBitIterator<> It(DirtyStats); It && It.GetIndex() < NumTracked; ++It)
+	{
+		if (Table.GetEntry(It.GetIndex()).Value != OldValues[It.GetIndex()])
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UApologueStatContainer::FlushChanges()
+{
+	bIsFlushQueued = false;
+
+	TArray<FApologueStatChange> Changes;
+	ConsumeChanges(Changes);
+
+	if (Changes.IsEmpty())
+	{
+		return;
+	}
+
+	if (!ChangedEvent.IsNull())
+	{
+		UObject* Outer = GetOuter();
+		if (Outer && Outer->Implements<UApologueEventBroadcasterInterface>())
+		{
+			UApologueStatChangedEventContext* Context = NewObject<UApologueStatChangedEventContext>(this);
+			Context->Container = this;
+			Context->Changes = Changes;
+			IApologueEventBroadcasterInterface::Execute_EventBroadcaster_BroadcastEvent(Outer, ChangedEvent, Context);
+		}
+	}
+
+	OnStatsChanged.Broadcast(this, Changes);
+}
+
+void UApologueStatContainer::ConsumeChanges(TArray<FApologueStatChange>& OutChanges)
+{
+	OutChanges.Reset();
+	bHasWarnedNoWorld = false;
+
+	SyncDirtyStats();
+
+	for (TConstSetBitIterator<> It(DirtyStats); It; ++It)
+	{
+		const FApologueStatTableEntry& Entry = Table.GetEntry(It.GetIndex());
+		const int32 OldValue = OldValues[It.GetIndex()];
+		if (Entry.Value != OldValue)
+		{
+			FApologueStatChange& Change = OutChanges.AddDefaulted_GetRef();
+			Change.Stat = Entry.Stat;
+			Change.OldValue = OldValue;
+			Change.NewValue = Entry.Value;
+		}
+	}
+
+	DirtyStats.SetRange(0, DirtyStats.Num(), false);
+}
+
+void UApologueStatContainer::SetValueAt(const int32 Index, const int32 NewValue)
+{
+	const int32 OldValue = Table.GetEntry(Index).Value;
+	if (OldValue == NewValue)
+	{
+		return;
+	}
+
+	SyncDirtyStats();
+
+	if (!DirtyStats[Index])
+	{
+		DirtyStats[Index] = true;
+		OldValues[Index] = OldValue;
+	}
+
+	Table.SetValueAt(Index, NewValue);
+
+	if (!bIsFlushQueued)
+	{
+		const UWorld* World = GetWorld();
+		if (UApologueStatSubsystem* Subsystem = World ? World->GetSubsystem<UApologueStatSubsystem>() : nullptr)
+		{
+			Subsystem->QueueFlush(this);
+			bIsFlushQueued = true;
+		}
+		else if (!bHasWarnedNoWorld)
+		{
+			UE_LOG(LogApologueCore, Warning, TEXT("%s changed outside a world with a stat subsystem; its changes are delivered only when FlushChanges is called"),
+			       *GetPathName());
+			bHasWarnedNoWorld = true;
+		}
+	}
+}
+
+void UApologueStatContainer::SyncDirtyStats()
+{
+	// The table may have been loaded or edited since the last write. Entries that are still in range keep their
+	// pending changes, so that the next flush still reports them.
+	if (DirtyStats.Num() != Table.Num())
+	{
+		DirtyStats.SetNum(Table.Num(), false);
+		OldValues.SetNumZeroed(Table.Num());
+	}
+}
@@ -0,0 +1,33 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+
+#include "Stat/ApologueStatSubsystem.h"
+
+#include "Stat/ApologueStatContainer.h"
+
+void UApologueStatSubsystem::QueueFlush(UApologueStatContainer* Container)
+{
+	PendingContainers.Add(Container);
+}
+
+void UApologueStatSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Swap(PendingContainers, FlushingContainers);
+
+	for (const TWeakObjectPtr<UApologueStatContainer>& Container : FlushingContainers)
+	{
+		if (UApologueStatContainer* ContainerPtr = Container.Get())
+		{
+			ContainerPtr->FlushChanges();
+		}
+	}
+
+	FlushingContainers.Reset();
+}
+
+TStatId UApologueStatSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UApologueStatSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,105 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "UObject/PrimaryAssetId.h"
+#include "ApologueAssetRegistry.generated.h"
+
+struct FStreamableHandle;
+
+/**
+ * Finds every event, stat and flag asset under ScanPaths once the asset manager has scanned, and loads them
+ * asynchronously along with their Preload bundles, which hold the listener and context classes of events. Loaded
+ * assets stay loaded and are cached by path, so soft pointers to them resolve without loading on the game thread.
+ *
+ * Assets outside ScanPaths, or broadcast before the preload completes, still resolve lazily.
+ */
+UCLASS(Config=Game)
+class APOLOGUECORE_API UApologueAssetRegistry final : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+	// Long package paths searched for assets, such as /Game or /PluginName
+	UPROPERTY(Config)
+	TArray<FString> ScanPaths = {TEXT("/Game")};
+
+	UPROPERTY(Config)
+	bool bPreloadOnStartup = true;
+
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+
+	bool bIsPreloaded = false;
+
+	FSimpleMulticastDelegate OnPreloaded;
+
+	// Preloaded assets and the classes of their bundles
+	UPROPERTY(Transient)
+	TMap<FSoftObjectPath, TObjectPtr<UObject>> ResolvedAssets;
+
+public:
+	static const FName PreloadBundle;
+
+	// USubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Loads every event, stat and flag the asset manager knows of. Done on startup unless bPreloadOnStartup is off;
+	 * calling it again loads assets added since.
+	 */
+	void Preload();
+
+	bool IsPreloaded() const
+	{
+		return bIsPreloaded;
+	}
+
+	/**
+	 * Blocks until the preload completes, such as behind a loading screen. Does nothing if it has not started.
+	 */
+	void WaitUntilPreloaded(const float TimeoutSeconds = 0.0f);
+
+	/**
+	 * Broadcast once the preload completes, or right away for delegates added after it has.
+	 */
+	FDelegateHandle CallOrRegister_OnPreloaded(FSimpleMulticastDelegate::FDelegate&& Delegate);
+
+	/**
+	 * @return The asset from the cache, or if it is not there, the asset if it is loaded at all. Never loads.
+	 */
+	template <typename T>
+	T* Find(const TSoftObjectPtr<T>& Asset) const
+	{
+		if (const TObjectPtr<UObject>* Resolved = ResolvedAssets.Find(Asset.ToSoftObjectPath()))
+		{
+			return CastChecked<T>(*Resolved);
+		}
+
+		return Asset.Get();
+	}
+
+	template <typename T>
+	TSubclassOf<T> FindClass(const TSoftClassPtr<T>& Class) const
+	{
+		if (const TObjectPtr<UObject>* Resolved = ResolvedAssets.Find(Class.ToSoftObjectPath()))
+		{
+			return CastChecked<UClass>(*Resolved);
+		}
+
+		return Class.Get();
+	}
+
+	int32 GetNumResolved() const
+	{
+		return ResolvedAssets.Num();
+	}
+
+private:
+	void ScanForAssets();
+
+	void HandlePreloaded();
+
+	void CacheResolved(UObject* Asset);
+};
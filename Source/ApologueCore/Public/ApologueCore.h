@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+APOLOGUECORE_API DECLARE_LOG_CATEGORY_EXTERN(LogApologueCore, Log, All);
+
 class FApologueCoreModule final : public IModuleInterface
 {
 public:
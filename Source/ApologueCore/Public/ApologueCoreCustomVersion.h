@@ -0,0 +1,40 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+/**
+ * Versions of the plugin's native serialization formats. Data saved by older versions of the plugin carries no version,
+ * which loads as BeforeCustomVersionWasAdded.
+ */
+struct APOLOGUECORE_API FApologueCoreCustomVersion
+{
+	enum Type
+	{
+		// Before any version changes were made in the plugin
+		BeforeCustomVersionWasAdded = 0,
+
+		// FMersenneTwister is saved in its own portable format rather than as tagged properties or MSVC's std::mt19937_64
+		PortableMersenneTwister,
+
+		// FApologueRandomStream is saved with its engine state rather than as tagged properties
+		PortableRandomStream,
+
+		// FApologueStatTable is saved with its own serializer rather than as tagged properties
+		NativeStatTable,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	// The GUID for this custom version number
+	const static FGuid GUID;
+
+private:
+	FApologueCoreCustomVersion()
+	{
+	}
+};
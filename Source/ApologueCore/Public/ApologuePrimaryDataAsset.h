@@ -0,0 +1,26 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ApologuePrimaryDataAsset.generated.h"
+
+/**
+ * Base of the event, stat and flag assets, which the asset registry scans for by type.
+ */
+UCLASS(Abstract)
+class APOLOGUECORE_API UApologuePrimaryDataAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * One type for assets of every subclass, so that a single scan finds them all, named by package as maps are, so that
+	 * assets of the same name in different folders do not collide.
+	 */
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+protected:
+	virtual FPrimaryAssetType GetApologueAssetType() const PURE_VIRTUAL(UApologuePrimaryDataAsset::GetApologueAssetType, return FPrimaryAssetType(););
+};
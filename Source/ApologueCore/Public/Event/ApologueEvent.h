@@ -3,30 +3,84 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Engine/DataAsset.h"
+#include "ApologuePrimaryDataAsset.h"
 #include "ApologueEvent.generated.h"
 
 class UApologueEventContext;
 class UApologueEventSortHandler;
 
 /**
- * 
+ * When a broadcast through UApologueEventSubsystem runs its callbacks.
+ */
+UENUM(BlueprintType)
+enum class EApologueEventPriority : uint8
+{
+	// Runs as soon as it is broadcast
+	Critical,
+
+	// Queued and run within the frame's event budget, before every Normal and Low event
+	High,
+
+	Normal,
+
+	// Queued behind every other event; may wait several frames in a busy one
+	Low,
+
+	MAX UMETA(Hidden)
+};
+
+/**
+ * An event listeners can have callbacks for. An event may have a parent, such as FireDamage under Damage under
+ * AnyCombatEvent, and every broadcast of an event also reaches the callbacks for its ancestors.
  */
 UCLASS(BlueprintType)
-class APOLOGUECORE_API UApologueEvent : public UDataAsset
+class APOLOGUECORE_API UApologueEvent : public UApologuePrimaryDataAsset
 {
 	GENERATED_BODY()
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(AllowPrivateAccess, MustImplement="/Script/ApologueCore.ApologueEventListenerInterface"))
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(AllowPrivateAccess, MustImplement="/Script/ApologueCore.ApologueEventListenerInterface", AssetBundles="Preload"))
 	TSoftClassPtr<UObject> ListenerClass;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(AllowPrivateAccess))
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(AllowPrivateAccess, AssetBundles="Preload"))
 	TSoftClassPtr<UApologueEventContext> ContextClass;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Instanced, meta=(AllowPrivateAccess, ShowOnlyInnerProperties))
 	TObjectPtr<UApologueEventSortHandler> SortHandler;
 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(AllowPrivateAccess))
+	EApologueEventPriority Priority = EApologueEventPriority::Critical;
+
+	// Loaded with the event, so that its ancestors are known as soon as it is
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(AllowPrivateAccess))
+	TObjectPtr<UApologueEvent> Parent;
+
+	// Parent first, then its parent and so on
+	TArray<FSoftObjectPath> Ancestors;
+
 public:
+	static const FPrimaryAssetType PrimaryAssetType;
+
 	TSoftClassPtr<UObject> GetListenerClass() const { return ListenerClass; }
 	TSoftClassPtr<UApologueEventContext> GetContextClass() const { return ContextClass; }
+	UApologueEventSortHandler* GetSortHandler() const { return SortHandler; }
+	EApologueEventPriority GetPriority() const { return Priority; }
+	UApologueEvent* GetParent() const { return Parent; }
+	const TArray<FSoftObjectPath>& GetAncestors() const { return Ancestors; }
+
+	/**
+	 * Recomputes the ancestors from the chain of parents, stopping before any event that would repeat. Done on load and
+	 * whenever a parent is edited; call it after setting the parent of an event created at runtime.
+	 */
+	void RefreshAncestors();
+
+	// UObject
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
+
+protected:
+	// UApologuePrimaryDataAsset
+	virtual FPrimaryAssetType GetApologueAssetType() const override { return PrimaryAssetType; }
 };
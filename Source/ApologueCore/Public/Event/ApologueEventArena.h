@@ -0,0 +1,296 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Linear allocator for scratch memory that lives no longer than a broadcast. Memory is taken from the top of a stack of
+ * blocks and given back in bulk when the FScope that was open at the time closes, so nested broadcasts take nested
+ * scopes above their caller's. Blocks are kept between scopes, and Reset merges them into one once a frame so that a
+ * frame's worth of dispatch allocates nothing once warmed up.
+ *
+ * Game thread only. Containers use it through FApologueEventArenaAllocator.
+ */
+class APOLOGUECORE_API FApologueEventArena
+{
+public:
+	static constexpr int64 DefaultBlockSize = 64 * 1024;
+	static constexpr uint32 MinAlignment = 16;
+
+	explicit FApologueEventArena(const int64 InBlockSize = DefaultBlockSize);
+	~FApologueEventArena();
+
+	FApologueEventArena(const FApologueEventArena&) = delete;
+	FApologueEventArena& operator=(const FApologueEventArena&) = delete;
+
+	/**
+	 * Makes the arena the one FApologueEventArenaAllocator allocates from while it is open, and frees everything
+	 * allocated from it since when it closes. Containers using the arena must be declared after their scope.
+	 */
+	class FScope
+	{
+	public:
+		explicit FScope(FApologueEventArena& InArena);
+		~FScope();
+
+		FScope(const FScope&) = delete;
+		FScope& operator=(const FScope&) = delete;
+
+	private:
+		FApologueEventArena& Arena;
+		FApologueEventArena* PreviousArena;
+		int32 Block;
+		int64 Offset;
+	};
+
+	/**
+	 * @return The arena of the innermost open scope on this thread, if any.
+	 */
+	static FApologueEventArena* GetCurrent();
+
+	void* Allocate(const int64 Size, const uint32 Alignment);
+
+	/**
+	 * Grows or shrinks the allocation in place if it is the last one made, or moves it to the top otherwise, copying
+	 * the first NumBytesToCopy bytes.
+	 */
+	void* Reallocate(void* Pointer, const int64 OldSize, const int64 NewSize, const uint32 Alignment, const int64 NumBytesToCopy);
+
+	/**
+	 * Gives the memory back at once if it is the last allocation made; otherwise it is freed with its scope.
+	 */
+	void Free(void* Pointer, const int64 Size);
+
+	/**
+	 * Merges the blocks into one large enough for the most memory used at once since the last reset. No scope may be
+	 * open.
+	 */
+	void Reset();
+
+	int64 GetNumBytesUsed() const;
+
+	int64 GetPeakBytesUsed() const
+	{
+		return PeakBytesUsed;
+	}
+
+	int32 GetNumBlocks() const
+	{
+		return Blocks.Num();
+	}
+
+	int32 GetNumOpenScopes() const
+	{
+		return NumOpenScopes;
+	}
+
+private:
+	struct FBlock
+	{
+		uint8* Memory = nullptr;
+		int64 Size = 0;
+	};
+
+	void AddBlock(const int64 MinSize);
+
+	TArray<FBlock> Blocks;
+	int64 BlockSize;
+
+	// The block allocations come from and the offset of its first free byte; later blocks are empty
+	int32 CurrentBlock = 0;
+	int64 CurrentOffset = 0;
+
+	int64 PeakBytesUsed = 0;
+	int32 NumOpenScopes = 0;
+};
+
+/**
+ * Container allocator taking memory from the arena of the innermost open FApologueEventArena::FScope, or from the heap
+ * when no scope is open. An allocation stays with the arena it was made from for its lifetime.
+ *
+ * Arena containers may only grow while the scope they first allocated in is the arena's innermost one. Growing inside
+ * a nested scope would move them into memory that scope frees when it closes, which builds with checks catch.
+ */
+class FApologueEventArenaAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = false };
+	enum { RequireRangeCheck = true };
+	enum { ShrinkByDefault = false };
+
+	class ForAnyElementType
+	{
+	public:
+		ForAnyElementType() = default;
+
+		ForAnyElementType(const ForAnyElementType&) = delete;
+		ForAnyElementType& operator=(const ForAnyElementType&) = delete;
+
+		~ForAnyElementType()
+		{
+			Release();
+		}
+
+		void MoveToEmpty(ForAnyElementType& Other)
+		{
+			check(this != &Other);
+
+			Release();
+			Data = Other.Data;
+			NumBytes = Other.NumBytes;
+			Arena = Other.Arena;
+#if DO_CHECK
+			ScopeDepth = Other.ScopeDepth;
+#endif
+
+			Other.Data = nullptr;
+			Other.NumBytes = 0;
+			Other.Arena = nullptr;
+		}
+
+		FScriptContainerElement* GetAllocation() const
+		{
+			return Data;
+		}
+
+		void ResizeAllocation(const SizeType PreviousNumElements, const SizeType NumElements, const SIZE_T NumBytesPerElement)
+		{
+			ResizeAllocation(PreviousNumElements, NumElements, NumBytesPerElement, DEFAULT_ALIGNMENT);
+		}
+
+		void ResizeAllocation(const SizeType PreviousNumElements, const SizeType NumElements, const SIZE_T NumBytesPerElement, const uint32 AlignmentOfElement)
+		{
+			const int64 NewNumBytes = static_cast<int64>(NumElements) * NumBytesPerElement;
+			if (NewNumBytes == 0)
+			{
+				Release();
+				return;
+			}
+
+			if (!Data)
+			{
+				Arena = FApologueEventArena::GetCurrent();
+#if DO_CHECK
+				ScopeDepth = Arena ? Arena->GetNumOpenScopes() : 0;
+#endif
+			}
+
+			const uint32 Alignment = FMath::Max<uint32>(AlignmentOfElement, FApologueEventArena::MinAlignment);
+			if (Arena)
+			{
+				checkf(Arena->GetNumOpenScopes() == ScopeDepth,
+				       TEXT("Arena container resized with %d scopes open on its arena, but allocated with %d; declare it inside the innermost scope"),
+				       Arena->GetNumOpenScopes(), ScopeDepth);
+
+				const int64 NumBytesToCopy = static_cast<int64>(FMath::Min(PreviousNumElements, NumElements)) * NumBytesPerElement;
+				Data = static_cast<FScriptContainerElement*>(Arena->Reallocate(Data, NumBytes, NewNumBytes, Alignment, NumBytesToCopy));
+			}
+			else
+			{
+				Data = static_cast<FScriptContainerElement*>(FMemory::Realloc(Data, NewNumBytes, Alignment));
+			}
+
+			NumBytes = NewNumBytes;
+		}
+
+		SizeType CalculateSlackReserve(const SizeType NumElements, const SIZE_T NumBytesPerElement) const
+		{
+			return NumElements;
+		}
+
+		SizeType CalculateSlackReserve(const SizeType NumElements, const SIZE_T NumBytesPerElement, const uint32 AlignmentOfElement) const
+		{
+			return NumElements;
+		}
+
+		// Memory left behind by arena arrays is only reclaimed with the scope, so never shrink
+		SizeType CalculateSlackShrink(const SizeType NumElements, const SizeType NumAllocatedElements, const SIZE_T NumBytesPerElement) const
+		{
+			return NumAllocatedElements;
+		}
+
+		SizeType CalculateSlackShrink(const SizeType NumElements, const SizeType NumAllocatedElements, const SIZE_T NumBytesPerElement,
+		                              const uint32 AlignmentOfElement) const
+		{
+			return NumAllocatedElements;
+		}
+
+		SizeType CalculateSlackGrow(const SizeType NumElements, const SizeType NumAllocatedElements, const SIZE_T NumBytesPerElement) const
+		{
+			return FMath::Max(NumElements, NumAllocatedElements + NumAllocatedElements / 2 + 4);
+		}
+
+		SizeType CalculateSlackGrow(const SizeType NumElements, const SizeType NumAllocatedElements, const SIZE_T NumBytesPerElement,
+		                            const uint32 AlignmentOfElement) const
+		{
+			return CalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement);
+		}
+
+		SIZE_T GetAllocatedSize(const SizeType NumAllocatedElements, const SIZE_T NumBytesPerElement) const
+		{
+			return NumAllocatedElements * NumBytesPerElement;
+		}
+
+		bool HasAllocation() const
+		{
+			return Data != nullptr;
+		}
+
+		SizeType GetInitialCapacity() const
+		{
+			return 0;
+		}
+
+	private:
+		void Release()
+		{
+			if (!Data)
+			{
+				return;
+			}
+
+			if (Arena)
+			{
+				Arena->Free(Data, NumBytes);
+			}
+			else
+			{
+				FMemory::Free(Data);
+			}
+
+			Data = nullptr;
+			NumBytes = 0;
+			Arena = nullptr;
+		}
+
+		FScriptContainerElement* Data = nullptr;
+		int64 NumBytes = 0;
+		FApologueEventArena* Arena = nullptr;
+
+#if DO_CHECK
+		// The arena's number of open scopes when the allocation was first made
+		int32 ScopeDepth = 0;
+#endif
+	};
+
+	template <typename ElementType>
+	class ForElementType : public ForAnyElementType
+	{
+	public:
+		ElementType* GetAllocation() const
+		{
+			return reinterpret_cast<ElementType*>(ForAnyElementType::GetAllocation());
+		}
+	};
+};
+
+template <>
+struct TAllocatorTraits<FApologueEventArenaAllocator> : TAllocatorTraitsBase<FApologueEventArenaAllocator>
+{
+	enum { SupportsMove = true };
+	enum { IsZeroConstruct = true };
+	enum { SupportsElementAlignment = true };
+};
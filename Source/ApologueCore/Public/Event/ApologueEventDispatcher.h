@@ -0,0 +1,286 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueEventArena.h"
+#include "ApologueEventCallbackParam.h"
+#include "ApologueEventSpatialGrid.h"
+#include "UObject/ObjectKey.h"
+
+class UApologueEvent;
+class UApologueEventContext;
+class UApologueEventSortHandler;
+
+/**
+ * What one FApologueEventDispatcher::DispatchQueued call did.
+ */
+struct FApologueEventDispatchStats
+{
+	int32 NumDispatched = 0;
+
+	// Broadcasts left in the queue for the next call
+	int32 NumCarriedOver = 0;
+
+	double Seconds = 0.0;
+
+	// Time spent past the budget; zero if the call kept to it
+	double OverrunSeconds = 0.0;
+};
+
+/**
+ * Holds the callbacks of registered event listeners, grouped by event and kept in priority order.
+ *
+ * Callbacks run from highest to lowest Priority, then highest to lowest SubPriority. Callbacks with equal priorities
+ * run in the order the event's sort handler puts their listeners in, or in registration order if it has none.
+ * A broadcast stops as soon as its context is canceled.
+ *
+ * A broadcast of a loaded event also runs the callbacks for its ancestors, merged with its own into the order above.
+ *
+ * Broadcasts of non-critical events may be queued and dispatched later under a time budget. A queued broadcast always
+ * runs all of its callbacks at once, in the order above.
+ *
+ * Listeners may be given a location, and a broadcast limited to a scope then reaches only the located listeners in it,
+ * in the same order. Only the listeners in grid cells the scope overlaps are looked at.
+ *
+ * Each registered listener holds a slot whose generation changes when it unregisters, so a broadcast tells live
+ * callbacks from those left behind by comparing two integers. Callbacks left behind are removed later, in bulk.
+ * Listeners the garbage collector finds unreachable are unregistered after each collection.
+ *
+ * Broadcasts gather and sort their callbacks in a scratch arena, in a scope of their own so that broadcasts made by
+ * callbacks stack above their caller's. Call ResetScratch once a frame, outside any broadcast.
+ */
+class APOLOGUECORE_API FApologueEventDispatcher
+{
+	struct FRegisteredCallback
+	{
+		FObjectKey Listener;
+		FApologueCallback Callback;
+
+		// The listener's slot and its generation when the callback was registered
+		int32 Slot = INDEX_NONE;
+		uint32 Generation = 0;
+
+		// Set for callbacks on the listener itself, which is alive while its slot is current; called without the
+		// delegate's weak pointer
+		UObject* Target = nullptr;
+		UFunction* Function = nullptr;
+
+		int32 Priority = 0;
+		int32 SubPriority = 0;
+
+		// Order of registration, which breaks ties between equal priorities
+		uint64 Sequence = 0;
+	};
+
+	// Callbacks gathered by one broadcast
+	using FCallbackList = TArray<FRegisteredCallback, FApologueEventArenaAllocator>;
+
+	struct FEventCallbacks
+	{
+		TArray<FRegisteredCallback> Callbacks;
+
+		// Callbacks of unregistered listeners not yet removed
+		int32 NumDead = 0;
+	};
+
+	TMap<FSoftObjectPath, FEventCallbacks> CallbacksByEvent;
+
+	// Events with callbacks of unregistered listeners still in their lists
+	TSet<FSoftObjectPath> DirtyEvents;
+
+	struct FListenerSlot
+	{
+		FObjectKey Listener;
+		uint32 Generation = 0;
+		int32 NextFree = INDEX_NONE;
+	};
+
+	TArray<FListenerSlot> ListenerSlots;
+	int32 FirstFreeSlot = INDEX_NONE;
+
+	struct FListener
+	{
+		int32 Slot = INDEX_NONE;
+
+		// Every callback of the listener, with the event it is for
+		TArray<TPair<FSoftObjectPath, FRegisteredCallback>> Callbacks;
+	};
+
+	TMap<FObjectKey, FListener> Listeners;
+
+	FDelegateHandle GarbageCollectHandle;
+
+	mutable FApologueEventArena ScratchArena;
+
+	// Listeners passed to sort handlers, one array per nesting depth; a handler takes a TArray of its own type
+	mutable TIndirectArray<TArray<UObject*>> SortScratch;
+	mutable int32 SortDepth = 0;
+
+	uint64 NextSequence = 0;
+
+	FApologueEventSpatialGrid SpatialGrid;
+
+	struct FQueuedBroadcast
+	{
+		TSoftObjectPtr<UApologueEvent> Event;
+		TObjectPtr<const UApologueEventContext> Context;
+		FApologueEventScope Scope;
+	};
+
+	// Queued broadcasts by event priority, oldest first; the Critical queue stays empty
+	TArray<FQueuedBroadcast> QueuedBroadcasts[static_cast<int32>(EApologueEventPriority::MAX)];
+
+public:
+	FApologueEventDispatcher();
+	~FApologueEventDispatcher();
+
+	FApologueEventDispatcher(const FApologueEventDispatcher&) = delete;
+	FApologueEventDispatcher& operator=(const FApologueEventDispatcher&) = delete;
+
+	/**
+	 * Gathers the listener's callbacks through IApologueEventListenerInterface.
+	 * Call RefreshListener if the callbacks it returns change while it is registered.
+	 *
+	 * @return False if the listener does not implement IApologueEventListenerInterface or is already registered.
+	 */
+	bool RegisterListener(UObject* Listener);
+
+	/**
+	 * Unregisters the listener and forgets its location. Its callbacks stop running at once, even later in a broadcast
+	 * that is running now.
+	 */
+	void UnregisterListener(const UObject* Listener);
+
+	/**
+	 * Re-gathers the callbacks of a registered listener, keeping its location.
+	 */
+	void RefreshListener(UObject* Listener);
+
+	bool IsListenerRegistered(const UObject* Listener) const;
+
+	int32 GetNumListeners() const;
+
+	int32 GetNumCallbacks(const TSoftObjectPtr<UApologueEvent>& Event) const;
+
+	/**
+	 * Runs the callbacks for the event and its ancestors in priority order until the context is canceled.
+	 * Listeners registered by a callback receive broadcasts from the next one.
+	 *
+	 * @return The number of callbacks that ran.
+	 */
+	int32 Broadcast(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context) const;
+
+	/**
+	 * Runs, in priority order until the context is canceled, the callbacks for the event and its ancestors of the
+	 * listeners located in the scope.
+	 *
+	 * @return The number of callbacks that ran.
+	 */
+	int32 Broadcast(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context, const FApologueEventScope& Scope) const;
+
+	/**
+	 * Broadcasts critical events now and queues the others for DispatchQueued, behind every queued broadcast of the
+	 * same priority. Events that are not loaded are broadcast now, since their priority cannot be read.
+	 *
+	 * @return The number of callbacks that ran now.
+	 */
+	int32 BroadcastOrEnqueue(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context,
+	                         const FApologueEventScope& Scope = FApologueEventScope());
+
+	/**
+	 * Broadcasts queued events, highest priority first and oldest first within a priority, until BudgetSeconds have
+	 * passed. At least one broadcast runs per call so the queue always drains; the rest carry over in order. Broadcasts
+	 * queued by the callbacks run in the same call if the budget allows.
+	 */
+	FApologueEventDispatchStats DispatchQueued(const double BudgetSeconds);
+
+	int32 GetNumQueued() const;
+
+	/**
+	 * Removes the callbacks of unregistered listeners from up to MaxEvents event lists. Lists that are mostly dead
+	 * are compacted as soon as they are, so this only bounds how long the rest hold on to memory.
+	 *
+	 * @return The number of callbacks removed.
+	 */
+	int32 CompactDeadCallbacks(const int32 MaxEvents);
+
+	int32 GetNumDeadCallbacks() const;
+
+	/**
+	 * Merges the blocks of the scratch arena into one big enough for this frame's broadcasts, so that the next
+	 * frame's allocate nothing. Not during a broadcast.
+	 */
+	void ResetScratch()
+	{
+		ScratchArena.Reset();
+	}
+
+	const FApologueEventArena& GetScratchArena() const
+	{
+		return ScratchArena;
+	}
+
+	/**
+	 * Places a registered listener for scoped broadcasts, or moves it. Call again whenever the listener moves.
+	 *
+	 * @return False if the listener is not registered.
+	 */
+	bool SetListenerLocation(const UObject* Listener, const FVector& Location);
+
+	/**
+	 * Takes the listener out of scoped broadcasts; it still receives the others.
+	 */
+	void ClearListenerLocation(const UObject* Listener);
+
+	const FVector* FindListenerLocation(const UObject* Listener) const;
+
+	/**
+	 * Sets the size of the grid cells listener locations are sorted into.
+	 */
+	void SetCellSize(const double CellSize)
+	{
+		SpatialGrid.SetCellSize(CellSize);
+	}
+
+	/**
+	 * Keeps the contexts of queued broadcasts alive. Called by the owner of the dispatcher.
+	 */
+	void AddReferencedObjects(FReferenceCollector& Collector);
+
+private:
+	int32 AllocateSlot(const FObjectKey& Listener);
+
+	void UnregisterListener(const FObjectKey& ListenerKey);
+
+	void UnregisterUnreachableListeners();
+
+	bool IsCurrent(const FRegisteredCallback& Callback) const
+	{
+		return ListenerSlots[Callback.Slot].Generation == Callback.Generation;
+	}
+
+	// Removes the dead callbacks of one list; the list must then be dropped if it is empty
+	int32 Compact(FEventCallbacks& EventCallbacks) const;
+
+	static bool HasHigherPriority(const FRegisteredCallback& A, const FRegisteredCallback& B);
+
+	// Priority order with ties in registration order, which every event's list is in
+	static bool RunsBefore(const FRegisteredCallback& A, const FRegisteredCallback& B);
+
+	// Broadcast with the event already resolved, or null if it is not loaded
+	int32 BroadcastResolved(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEvent* EventPtr, const UApologueEventContext* Context) const;
+
+	int32 BroadcastResolved(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEvent* EventPtr, const UApologueEventContext* Context,
+	                        const FApologueEventScope& Scope) const;
+
+	// The event's path followed by its ancestors'
+	static void GetEventPaths(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEvent* EventPtr,
+	                          TArray<FSoftObjectPath, TInlineAllocator<8>>& OutPaths);
+
+	static void MergeCallbacks(const TConstArrayView<const TArray<FRegisteredCallback>*> Lists, FCallbackList& OutCallbacks);
+
+	void SortListeners(UApologueEventSortHandler& SortHandler, FCallbackList& Callbacks) const;
+
+	int32 InvokeCallbacks(const UApologueEvent* EventPtr, const UApologueEventContext* Context, FCallbackList& Callbacks) const;
+};
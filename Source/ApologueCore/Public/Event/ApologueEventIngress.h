@@ -0,0 +1,115 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+class UApologueEvent;
+class UApologueEventContext;
+
+/**
+ * Bounded lock-free queue through which any thread can raise events, drained in batches by one consumer on the game
+ * thread. Pushing never allocates: every slot is allocated up front and holds the event's path and a payload of up to
+ * MaxPayloadSize bytes, from which the consumer makes the event's context.
+ *
+ * A push into a full queue fails rather than waiting; the caller may retry later or drop the event.
+ */
+class APOLOGUECORE_API FApologueEventIngress
+{
+public:
+	static constexpr int32 MaxPayloadSize = 64;
+	static constexpr int32 PayloadAlignment = 16;
+
+	// Makes the context of a drained event on the game thread, with Outer as its outer
+	typedef const UApologueEventContext* (*FMakeContextFunction)(UObject* Outer, const void* Payload);
+
+	/**
+	 * @param InCapacity	Number of slots, rounded up to a power of two.
+	 */
+	explicit FApologueEventIngress(const int32 InCapacity = 4096);
+
+	FApologueEventIngress(const FApologueEventIngress&) = delete;
+	FApologueEventIngress& operator=(const FApologueEventIngress&) = delete;
+
+	/**
+	 * Queues a broadcast with no context. Safe to call from any thread.
+	 *
+	 * @return False if the queue was full.
+	 */
+	bool Push(const TSoftObjectPtr<UApologueEvent>& Event)
+	{
+		return Push(Event.ToSoftObjectPath(), nullptr, nullptr, 0);
+	}
+
+	/**
+	 * Queues a broadcast whose context MakeContextFunction(Outer, Payload) makes on the game thread. PayloadType is
+	 * copied bitwise, so it must not own memory or reference UObjects. Safe to call from any thread.
+	 *
+	 * @return False if the queue was full.
+	 */
+	template <auto MakeContextFunction, typename PayloadType>
+	bool Push(const TSoftObjectPtr<UApologueEvent>& Event, const PayloadType& Payload)
+	{
+		static_assert(std::is_trivially_copyable_v<PayloadType>, "Payloads are copied bitwise");
+		static_assert(sizeof(PayloadType) <= MaxPayloadSize, "Payload is larger than MaxPayloadSize");
+		static_assert(alignof(PayloadType) <= PayloadAlignment, "Payload is aligned more strictly than PayloadAlignment");
+
+		return Push(Event.ToSoftObjectPath(), &MakeContextFromPayload<MakeContextFunction, PayloadType>, &Payload, sizeof(PayloadType));
+	}
+
+	/**
+	 * Pops up to MaxCount broadcasts in the order their pushes completed, making their contexts and passing them to
+	 * Sink. Game thread only.
+	 *
+	 * @return The number of broadcasts popped.
+	 */
+	int32 Drain(UObject* Outer, const int32 MaxCount,
+	            const TFunctionRef<void(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context)>& Sink);
+
+	int32 GetCapacity() const
+	{
+		return Capacity;
+	}
+
+	/**
+	 * @return The number of pushes that failed because the queue was full.
+	 */
+	int64 GetNumDropped() const
+	{
+		return NumDropped.load(std::memory_order_relaxed);
+	}
+
+private:
+	struct FSlot
+	{
+		// The position of the next push the slot takes, that position + 1 once the push has finished writing
+		std::atomic<uint64> Sequence{0};
+
+		FSoftObjectPath Event;
+		FMakeContextFunction MakeContext = nullptr;
+
+		alignas(PayloadAlignment) uint8 Payload[MaxPayloadSize];
+	};
+
+	template <auto MakeContextFunction, typename PayloadType>
+	static const UApologueEventContext* MakeContextFromPayload(UObject* Outer, const void* Payload)
+	{
+		return MakeContextFunction(Outer, *static_cast<const PayloadType*>(Payload));
+	}
+
+	bool Push(const FSoftObjectPath& Event, FMakeContextFunction MakeContext, const void* Payload, const int32 PayloadSize);
+
+	TUniquePtr<FSlot[]> Slots;
+	int32 Capacity;
+	uint64 Mask;
+
+	// Claimed by producers; on its own cache line so they do not contend with the consumer
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> PushPosition{0};
+
+	alignas(PLATFORM_CACHE_LINE_SIZE) uint64 PopPosition = 0;
+
+	std::atomic<int64> NumDropped{0};
+};
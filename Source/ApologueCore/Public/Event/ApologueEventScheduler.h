@@ -0,0 +1,150 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueEventScheduler.generated.h"
+
+class UApologueEvent;
+class UApologueEventContext;
+
+/**
+ * Identifies a broadcast scheduled with FApologueEventScheduler. Stays valid for every period of a periodic broadcast.
+ */
+USTRUCT(BlueprintType)
+struct APOLOGUECORE_API FApologueEventTimerHandle
+{
+	GENERATED_BODY()
+
+	friend class FApologueEventScheduler;
+
+private:
+	UPROPERTY(Transient)
+	int32 Index = INDEX_NONE;
+
+	UPROPERTY(Transient)
+	uint32 Serial = 0;
+
+public:
+	bool IsValid() const { return Serial != 0; }
+	void Invalidate() { Serial = 0; }
+
+	friend bool operator==(const FApologueEventTimerHandle& A, const FApologueEventTimerHandle& B)
+	{
+		return A.Index == B.Index && A.Serial == B.Serial;
+	}
+
+	friend bool operator!=(const FApologueEventTimerHandle& A, const FApologueEventTimerHandle& B)
+	{
+		return !(A == B);
+	}
+};
+
+/**
+ * Delayed and periodic event broadcasts in a hierarchical timer wheel: four levels of 256 slots, each slot of a level
+ * spanning a whole turn of the level below. Scheduling and cancelling are O(1); each tick expires one slot and, every
+ * 256 ticks, moves one slot of a higher level down.
+ *
+ * Time is counted in ticks of TickSeconds, and a broadcast runs on the first tick at or after its due time. Broadcasts
+ * due on the same tick run in an unspecified but deterministic order. Periodic broadcasts are rescheduled from their
+ * due tick, so they do not drift.
+ */
+class APOLOGUECORE_API FApologueEventScheduler
+{
+public:
+	static constexpr int32 SlotBits = 8;
+	static constexpr int32 NumSlots = 1 << SlotBits;
+	static constexpr int32 NumLevels = 4;
+
+	explicit FApologueEventScheduler(const double InTickSeconds = 1.0 / 60.0);
+
+	/**
+	 * Schedules a broadcast DelaySeconds from now, repeating every PeriodSeconds if that is positive. Both are rounded up
+	 * to whole ticks, of at least one.
+	 */
+	FApologueEventTimerHandle Schedule(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context, const double DelaySeconds,
+	                                   const double PeriodSeconds = 0.0);
+
+	/**
+	 * Cancels the broadcast and invalidates the handle. Does nothing if it already ran or was cancelled.
+	 */
+	void Cancel(FApologueEventTimerHandle& Handle);
+
+	bool IsScheduled(const FApologueEventTimerHandle& Handle) const;
+
+	/**
+	 * @return Seconds until the broadcast next runs, or a negative value if it is not scheduled.
+	 */
+	double GetTimeRemaining(const FApologueEventTimerHandle& Handle) const;
+
+	/**
+	 * Moves time forward, passing every broadcast that falls due to Sink in tick order. Broadcasts scheduled by Sink
+	 * run in the same call if they fall due within it.
+	 *
+	 * @return The number of broadcasts passed to Sink.
+	 */
+	int32 Advance(const double DeltaSeconds,
+	              const TFunctionRef<void(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context)>& Sink);
+
+	int32 GetNumScheduled() const
+	{
+		return NumScheduled;
+	}
+
+	double GetTickSeconds() const
+	{
+		return TickSeconds;
+	}
+
+	/**
+	 * Keeps the contexts of scheduled broadcasts alive. Called by the owner of the scheduler.
+	 */
+	void AddReferencedObjects(FReferenceCollector& Collector);
+
+private:
+	struct FEntry
+	{
+		TSoftObjectPtr<UApologueEvent> Event;
+		TObjectPtr<const UApologueEventContext> Context;
+		uint64 DueTick = 0;
+		uint64 PeriodTicks = 0;
+
+		// Zero while the entry is free
+		uint32 Serial = 0;
+
+		// Links within a slot, or to the next free entry
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+
+		// Level * NumSlots + slot, or INDEX_NONE if in no slot
+		int32 Slot = INDEX_NONE;
+	};
+
+	uint64 SecondsToTicks(const double Seconds) const;
+
+	const FEntry* FindEntry(const FApologueEventTimerHandle& Handle) const;
+
+	void Link(const int32 Index);
+	void Unlink(const int32 Index);
+	void Free(const int32 Index);
+
+	// Moves every entry of a slot to the level below
+	void Cascade(const int32 Level);
+
+	double TickSeconds;
+
+	// Seconds passed since the last whole tick
+	double PendingSeconds = 0.0;
+
+	uint64 CurrentTick = 0;
+
+	TArray<FEntry> Entries;
+	int32 FirstFree = INDEX_NONE;
+	int32 NumScheduled = 0;
+	uint32 NextSerial = 1;
+
+	int32 Slots[NumLevels * NumSlots];
+
+	// Entries taken out of the expiring slot, with their serials at the time
+	TArray<TPair<int32, uint32>> Expiring;
+};
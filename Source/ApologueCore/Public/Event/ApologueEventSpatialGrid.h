@@ -0,0 +1,107 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Region of the world a broadcast is limited to. Listeners outside it, or without a location, do not receive the
+ * broadcast. The default scope is everywhere, which every listener is in, located or not.
+ */
+struct APOLOGUECORE_API FApologueEventScope
+{
+	static FApologueEventScope Sphere(const FVector& Center, const double Radius);
+
+	static FApologueEventScope Box(const FBox& Box);
+
+	bool IsEverywhere() const
+	{
+		return Shape == EShape::Everywhere;
+	}
+
+	bool Contains(const FVector& Location) const;
+
+	/**
+	 * @return The box around the region; not valid for everywhere.
+	 */
+	const FBox& GetBounds() const
+	{
+		return Bounds;
+	}
+
+private:
+	enum class EShape : uint8
+	{
+		Everywhere,
+		Sphere,
+		Box
+	};
+
+	EShape Shape = EShape::Everywhere;
+	FBox Bounds = FBox(ForceInit);
+	FVector Center = FVector::ZeroVector;
+	double RadiusSquared = 0.0;
+};
+
+/**
+ * Locations of listeners in a uniform grid of cubic cells, hashed by cell so that only occupied cells take memory.
+ * Finding the listeners in a scope visits only the cells its bounds overlap, or every occupied cell if there are fewer
+ * of those.
+ */
+class APOLOGUECORE_API FApologueEventSpatialGrid
+{
+public:
+	explicit FApologueEventSpatialGrid(const double InCellSize = 1000.0);
+
+	/**
+	 * Adds the listener at Location, or moves it there.
+	 */
+	void SetLocation(const FObjectKey& Listener, const FVector& Location);
+
+	/**
+	 * @return False if the listener had no location.
+	 */
+	bool RemoveLocation(const FObjectKey& Listener);
+
+	const FVector* FindLocation(const FObjectKey& Listener) const;
+
+	int32 Num() const
+	{
+		return Locations.Num();
+	}
+
+	/**
+	 * Re-sorts every listener into cells of the new size. Cells around the size of the usual broadcast radius work best.
+	 */
+	void SetCellSize(const double InCellSize);
+
+	double GetCellSize() const
+	{
+		return CellSize;
+	}
+
+	/**
+	 * Calls Visitor with every listener located in the scope, in no particular order. Not for the everywhere scope.
+	 */
+	void ForEachInScope(const FApologueEventScope& Scope, const TFunctionRef<void(const FObjectKey& Listener)>& Visitor) const;
+
+private:
+	struct FCellEntry
+	{
+		FObjectKey Listener;
+		FVector Location;
+	};
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	void AddToCell(const FObjectKey& Listener, const FVector& Location);
+	void RemoveFromCell(const FObjectKey& Listener, const FVector& Location);
+
+	double CellSize;
+
+	TMap<FObjectKey, FVector> Locations;
+
+	// Listeners with a location in each occupied cell, copied here so that queries need no other lookups
+	TMap<FIntVector, TArray<FCellEntry>> Cells;
+};
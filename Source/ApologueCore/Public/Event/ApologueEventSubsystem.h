@@ -0,0 +1,219 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueEventBroadcasterInterface.h"
+#include "ApologueEventDispatcher.h"
+#include "ApologueEventIngress.h"
+#include "ApologueEventListenerInterface.h"
+#include "ApologueEventScheduler.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ApologueEventSubsystem.generated.h"
+
+class UApologueEventSubsystem;
+
+/**
+ * Drains the event subsystem's ingress at its configured tick group.
+ */
+USTRUCT()
+struct FApologueEventIngressTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UApologueEventSubsystem* Subsystem = nullptr;
+
+	// FTickFunction
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FApologueEventIngressTickFunction> : TStructOpsTypeTraitsBase2<FApologueEventIngressTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Per-world event broadcaster. Listeners register once and receive every broadcast of the events they have callbacks for.
+ *
+ * Critical events run as soon as they are broadcast. Other events are queued and run at the end of the frame until
+ * FrameBudgetMs is spent, carrying the rest over to the next frame in order.
+ *
+ * Other threads raise events through GetIngress(), which the game thread drains once a frame at IngressTickGroup.
+ *
+ * Delayed and periodic broadcasts wait in a timer wheel and, once due, go through the same priorities and budget.
+ *
+ * Listeners given a location can also be reached by broadcasts limited to a sphere or box, such as the sound of an
+ * explosion, without visiting listeners elsewhere.
+ */
+UCLASS(Config=Game)
+class APOLOGUECORE_API UApologueEventSubsystem final : public UTickableWorldSubsystem, public IApologueEventBroadcasterInterface
+{
+	GENERATED_BODY()
+
+	FApologueEventDispatcher Dispatcher;
+
+	// Time per frame for queued events; at least one runs every frame however small it is
+	UPROPERTY(Config)
+	float FrameBudgetMs = 1.0f;
+
+	FApologueEventDispatchStats LastDispatchStats;
+
+	// Slots of the ingress, rounded up to a power of two; pushes fail while all of them are waiting to be drained
+	UPROPERTY(Config)
+	int32 IngressCapacity = 4096;
+
+	UPROPERTY(Config)
+	TEnumAsByte<ETickingGroup> IngressTickGroup = TG_PrePhysics;
+
+	TUniquePtr<FApologueEventIngress> Ingress;
+
+	FApologueEventIngressTickFunction IngressTickFunction;
+
+	// Resolution of scheduled broadcasts
+	UPROPERTY(Config)
+	float ScheduleTickMs = 1000.0f / 60.0f;
+
+	FApologueEventScheduler Scheduler;
+
+	// Size of the grid cells that listener locations are sorted into; about the usual radius of scoped broadcasts
+	UPROPERTY(Config)
+	float ListenerCellSize = 1000.0f;
+
+	// Event lists cleared of unregistered listeners' callbacks per frame
+	UPROPERTY(Config)
+	int32 CompactEventsPerFrame = 16;
+
+public:
+	// USubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Event")
+	void RegisterListener(const TScriptInterface<IApologueEventListenerInterface>& Listener);
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Event")
+	void UnregisterListener(const TScriptInterface<IApologueEventListenerInterface>& Listener);
+
+	/**
+	 * Re-gathers the callbacks of a registered listener.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Event")
+	void RefreshListener(const TScriptInterface<IApologueEventListenerInterface>& Listener);
+
+	FApologueEventDispatcher& GetDispatcher() { return Dispatcher; }
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Event")
+	void SetFrameBudget(const float Milliseconds)
+	{
+		FrameBudgetMs = FMath::Max(0.0f, Milliseconds);
+	}
+
+	UFUNCTION(BlueprintPure, Category="Apologue|Event")
+	float GetFrameBudget() const
+	{
+		return FrameBudgetMs;
+	}
+
+	UFUNCTION(BlueprintPure, Category="Apologue|Event")
+	int32 GetNumQueuedEvents() const
+	{
+		return Dispatcher.GetNumQueued();
+	}
+
+	const FApologueEventDispatchStats& GetLastDispatchStats() const { return LastDispatchStats; }
+
+	/**
+	 * Broadcasts the event after DelaySeconds of game time, then every PeriodSeconds if that is positive, until the
+	 * handle is cancelled.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Event")
+	FApologueEventTimerHandle ScheduleEvent(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context, const float DelaySeconds,
+	                                        const float PeriodSeconds = 0.0f)
+	{
+		return Scheduler.Schedule(Event, Context, DelaySeconds, PeriodSeconds);
+	}
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Event")
+	void CancelScheduledEvent(UPARAM(Ref) FApologueEventTimerHandle& Handle)
+	{
+		Scheduler.Cancel(Handle);
+	}
+
+	UFUNCTION(BlueprintPure, Category="Apologue|Event")
+	bool IsEventScheduled(const FApologueEventTimerHandle& Handle) const
+	{
+		return Scheduler.IsScheduled(Handle);
+	}
+
+	/**
+	 * Gets the seconds until the scheduled broadcast next runs, or -1 if it is not scheduled.
+	 */
+	UFUNCTION(BlueprintPure, Category="Apologue|Event")
+	float GetScheduledEventTimeRemaining(const FApologueEventTimerHandle& Handle) const
+	{
+		return Scheduler.GetTimeRemaining(Handle);
+	}
+
+	FApologueEventScheduler& GetScheduler() { return Scheduler; }
+
+	/**
+	 * Places a registered listener for broadcasts limited to an area. Call again whenever it moves.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Event")
+	void SetListenerLocation(const TScriptInterface<IApologueEventListenerInterface>& Listener, const FVector& Location);
+
+	/**
+	 * Takes the listener out of broadcasts limited to an area; it still receives the others.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Event")
+	void ClearListenerLocation(const TScriptInterface<IApologueEventListenerInterface>& Listener);
+
+	/**
+	 * Broadcasts the event to the listeners located within Radius of Center.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Event")
+	void BroadcastEventInSphere(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context, const FVector& Center, const float Radius)
+	{
+		Dispatcher.BroadcastOrEnqueue(Event, Context, FApologueEventScope::Sphere(Center, Radius));
+	}
+
+	/**
+	 * Broadcasts the event to the listeners located inside Box.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Event")
+	void BroadcastEventInBox(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context, const FBox& Box)
+	{
+		Dispatcher.BroadcastOrEnqueue(Event, Context, FApologueEventScope::Box(Box));
+	}
+
+	/**
+	 * Queue any thread may push events into. Drained broadcasts go through the same priorities and budget as
+	 * EventBroadcaster_BroadcastEvent.
+	 */
+	FApologueEventIngress& GetIngress() const { return *Ingress; }
+
+	/**
+	 * Broadcasts every event pushed into the ingress so far. Game thread only; runs every frame at IngressTickGroup.
+	 *
+	 * @return The number of events drained.
+	 */
+	int32 DrainIngress();
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// IApologueEventBroadcasterInterface
+	virtual void EventBroadcaster_BroadcastEvent_Implementation(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context) override;
+};
@@ -3,14 +3,21 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Engine/DataAsset.h"
+#include "ApologuePrimaryDataAsset.h"
 #include "ApologueFlag.generated.h"
 
 /**
  * 
  */
 UCLASS()
-class APOLOGUECORE_API UApologueFlag : public UDataAsset
+class APOLOGUECORE_API UApologueFlag : public UApologuePrimaryDataAsset
 {
 	GENERATED_BODY()
+
+public:
+	static const FPrimaryAssetType PrimaryAssetType;
+
+protected:
+	// UApologuePrimaryDataAsset
+	virtual FPrimaryAssetType GetApologueAssetType() const override { return PrimaryAssetType; }
 };
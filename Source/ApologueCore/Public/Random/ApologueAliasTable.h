@@ -0,0 +1,439 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueRandomLibrary.h"
+#include "MersenneTwister.h"
+#include "ApologueAliasTable.generated.h"
+
+/**
+ * Weighted random selection in constant time with Vose's alias method: built once from the weights in O(N), then every
+ * sample costs one bounded draw and one fraction regardless of the number of entries.
+ *
+ * Weights can be changed, added and removed individually. The table is then out of date until Rebuild(), so a batch
+ * of changes costs a single rebuild.
+ */
+USTRUCT(BlueprintType)
+struct APOLOGUECORE_API FApologueAliasTable
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY()
+	TArray<double> Weights;
+
+	// Chance of keeping each column rather than taking its alias
+	UPROPERTY()
+	TArray<double> Probabilities;
+
+	UPROPERTY()
+	TArray<int32> Aliases;
+
+	UPROPERTY()
+	double TotalWeight = 0.0;
+
+	UPROPERTY()
+	bool bIsDirty = false;
+
+public:
+	FApologueAliasTable() = default;
+
+	explicit FApologueAliasTable(const TConstArrayView<double> InWeights)
+	{
+		Build(InWeights);
+	}
+
+	/**
+	 * Replaces the weights and builds the table. Negative weights count as zero.
+	 */
+	void Build(const TConstArrayView<double> InWeights)
+	{
+		Weights.Reset(InWeights.Num());
+		TotalWeight = 0.0;
+
+		for (const double Weight : InWeights)
+		{
+			Weights.Add(FMath::Max(Weight, 0.0));
+			TotalWeight += Weights.Last();
+		}
+
+		bIsDirty = true;
+		Rebuild();
+	}
+
+	/**
+	 * Changes one weight. Takes effect on the next Rebuild().
+	 */
+	void SetWeight(const int32 Index, const double Weight)
+	{
+		check(Weights.IsValidIndex(Index));
+
+		const double ClampedWeight = FMath::Max(Weight, 0.0);
+		if (Weights[Index] != ClampedWeight)
+		{
+			TotalWeight += ClampedWeight - Weights[Index];
+			Weights[Index] = ClampedWeight;
+			bIsDirty = true;
+		}
+	}
+
+	/**
+	 * Appends a weight. Takes effect on the next Rebuild().
+	 *
+	 * @return The index of the new entry.
+	 */
+	int32 AddWeight(const double Weight)
+	{
+		const int32 Index = Weights.Add(FMath::Max(Weight, 0.0));
+		TotalWeight += Weights[Index];
+		bIsDirty = true;
+		return Index;
+	}
+
+	/**
+	 * Removes a weight, moving the last entry into its index. Takes effect on the next Rebuild().
+	 */
+	void RemoveWeightAtSwap(const int32 Index)
+	{
+		check(Weights.IsValidIndex(Index));
+
+		TotalWeight -= Weights[Index];
+		Weights.RemoveAtSwap(Index);
+		bIsDirty = true;
+	}
+
+	/**
+	 * Brings the table up to date with the weights, if any changed since the last build.
+	 */
+	void Rebuild()
+	{
+		if (!bIsDirty)
+		{
+			return;
+		}
+
+		bIsDirty = false;
+
+		const int32 Num = Weights.Num();
+		Probabilities.SetNumUninitialized(Num);
+		Aliases.SetNumUninitialized(Num);
+
+		// Sum again rather than trusting TotalWeight, which drifts after many incremental changes
+		TotalWeight = 0.0;
+		for (const double Weight : Weights)
+		{
+			TotalWeight += Weight;
+		}
+
+		if (TotalWeight <= 0.0)
+		{
+			Probabilities.Reset();
+			Aliases.Reset();
+			return;
+		}
+
+		// Weights scaled so that the average column is exactly full. Columns under 1 are taken from the front of the
+		// worklist and columns over 1 from the back.
+		const double Scale = Num / TotalWeight;
+		TArray<int32> Worklist;
+		Worklist.SetNumUninitialized(Num);
+
+		int32 SmallEnd = 0;
+		int32 LargeBegin = Num;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Probabilities[Index] = Weights[Index] * Scale;
+			if (Probabilities[Index] < 1.0)
+			{
+				Worklist[SmallEnd++] = Index;
+			}
+			else
+			{
+				Worklist[--LargeBegin] = Index;
+			}
+		}
+
+		// Each small column is topped up by a large one, which may become small in turn
+		int32 SmallBegin = 0;
+		while (SmallBegin < SmallEnd && LargeBegin < Num)
+		{
+			const int32 Small = Worklist[SmallBegin++];
+			const int32 Large = Worklist[LargeBegin];
+
+			Aliases[Small] = Large;
+			Probabilities[Large] -= 1.0 - Probabilities[Small];
+
+			if (Probabilities[Large] < 1.0)
+			{
+				++LargeBegin;
+				Worklist[SmallEnd++] = Large;
+			}
+		}
+
+		// What is left is full up to rounding error
+		for (int32 Index = SmallBegin; Index < SmallEnd; ++Index)
+		{
+			Probabilities[Worklist[Index]] = 1.0;
+			Aliases[Worklist[Index]] = Worklist[Index];
+		}
+
+		for (int32 Index = LargeBegin; Index < Num; ++Index)
+		{
+			Probabilities[Worklist[Index]] = 1.0;
+			Aliases[Worklist[Index]] = Worklist[Index];
+		}
+	}
+
+	/**
+	 * Picks an index with chance proportional to its weight, in constant time. StreamType is any type with the
+	 * FMersenneTwister interface.
+	 *
+	 * @return The picked index, or INDEX_NONE if all weights are zero or the table needs a Rebuild().
+	 */
+	template <typename StreamType>
+	int32 Sample(const StreamType& Stream) const
+	{
+		if (!ensureMsgf(!bIsDirty, TEXT("Alias table weights changed without a Rebuild()")) || Probabilities.IsEmpty())
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 Column = Stream.RandHelper(Probabilities.Num());
+		return Stream.template GetFraction<double>() < Probabilities[Column] ? Column : Aliases[Column];
+	}
+
+	FORCEINLINE int32 Num() const
+	{
+		return Weights.Num();
+	}
+
+	FORCEINLINE double GetWeight(const int32 Index) const
+	{
+		return Weights[Index];
+	}
+
+	FORCEINLINE double GetTotalWeight() const
+	{
+		return TotalWeight;
+	}
+
+	/**
+	 * @return The chance of Sample() picking Index.
+	 */
+	double GetProbability(const int32 Index) const
+	{
+		return TotalWeight > 0.0 ? Weights[Index] / TotalWeight : 0.0;
+	}
+
+	FORCEINLINE bool IsDirty() const
+	{
+		return bIsDirty;
+	}
+
+	/**
+	 * The weights are all a table needs, so a loaded table whose probabilities and aliases do not fit them is rebuilt
+	 * from them rather than reported as an error.
+	 */
+	void PostSerialize(const FArchive& Ar)
+	{
+		if (Ar.IsLoading() && !IsValid())
+		{
+			bIsDirty = true;
+			Rebuild();
+		}
+	}
+
+private:
+	bool IsValid() const
+	{
+		if (bIsDirty)
+		{
+			return true;
+		}
+
+		if (Probabilities.Num() != Aliases.Num() || (Probabilities.Num() != Weights.Num() && !Probabilities.IsEmpty()))
+		{
+			return false;
+		}
+
+		for (const int32 Alias : Aliases)
+		{
+			if (!Weights.IsValidIndex(Alias))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FApologueAliasTable> : TStructOpsTypeTraitsBase2<FApologueAliasTable>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
+};
+
+UCLASS()
+class APOLOGUECORE_API UApologueAliasTableLibrary : public UApologueRandomLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Replaces the weights of the table and builds it.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Alias Table")
+	static void BuildAliasTable(UPARAM(Ref) FApologueAliasTable& Table, const TArray<double>& Weights)
+	{
+		Table.Build(Weights);
+	}
+
+	/**
+	 * Changes one weight. The table is rebuilt by the next Sample Alias Table, so a batch of changes costs a single rebuild.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Alias Table")
+	static void SetAliasTableWeight(UPARAM(Ref) FApologueAliasTable& Table, const int32 Index, const double Weight)
+	{
+		if (!Table.Num() || Index < 0 || Index >= Table.Num())
+		{
+			ThrowBlueprintException();
+			return;
+		}
+
+		Table.SetWeight(Index, Weight);
+	}
+
+	/**
+	 * Picks an index with chance proportional to its weight, first rebuilding the table if its weights changed.
+	 *
+	 * @return The picked index, or -1 if all weights are zero.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Alias Table")
+	static int32 SampleAliasTable(UPARAM(Ref) FApologueAliasTable& Table, UPARAM(Ref) const FMersenneTwister& MersenneTwister)
+	{
+		if (EnsureInitialized(MersenneTwister))
+		{
+			Table.Rebuild();
+			return Table.Sample(MersenneTwister);
+		}
+
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Gets a random struct from the array with chance proportional to its numeric weight member. Builds a table from
+	 * the array on every call; build an alias table once to pick from the same weights repeatedly.
+	 *
+	 * @param MersenneTwister	The random stream.
+	 * @param TargetArray		The array of structs.
+	 * @param WeightMember		The name of the numeric member holding each struct's weight.
+	 * @param OutElement		The picked element.
+	 * @param OutIndex			The index of the picked element (will be -1 if the array is empty or all weights are zero).
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="Apologue|Random|Alias Table", DisplayName="Random Weighted Element in Array",
+		meta=(ArrayParm="TargetArray", ArrayTypeDependentParams="OutElement"))
+	static void RandomWeightedElementInArray(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const TArray<int32>& TargetArray, const FName WeightMember,
+	                                         int32& OutElement, int32& OutIndex)
+	{
+		// see execRandomWeightedElementInArray for implementation
+		check(0);
+	}
+
+private:
+	static void GenericRandomWeightedElement(void* TargetArray, const FArrayProperty* ArrayProperty, const FMersenneTwister* MersenneTwister,
+	                                         const FName WeightMember, void* OutElement, int32* OutIndex)
+	{
+		*OutIndex = INDEX_NONE;
+		if (!TargetArray || !MersenneTwister || !EnsureInitialized(*MersenneTwister))
+		{
+			return;
+		}
+
+		FScriptArrayHelper ArrayHelper(ArrayProperty, TargetArray);
+		const FProperty* InnerProp = ArrayProperty->Inner;
+
+		// OutElement already holds a constructed value
+		InnerProp->ClearValue(OutElement);
+
+		const FStructProperty* StructProp = CastField<FStructProperty>(InnerProp);
+		const FNumericProperty* WeightProp = StructProp ? FindWeightProperty(StructProp->Struct, WeightMember) : nullptr;
+		if (!WeightProp)
+		{
+			FFrame::KismetExecutionMessage(*FString::Printf(TEXT("Random Weighted Element in Array needs an array of structs with a numeric member named %s!"),
+			                                                *WeightMember.ToString()), ELogVerbosity::Warning);
+			return;
+		}
+
+		TArray<double> Weights;
+		Weights.Reserve(ArrayHelper.Num());
+		for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+		{
+			const void* Value = WeightProp->ContainerPtrToValuePtr<void>(ArrayHelper.GetRawPtr(Index));
+			Weights.Add(WeightProp->IsFloatingPoint()
+				            ? WeightProp->GetFloatingPointPropertyValue(Value)
+				            : static_cast<double>(WeightProp->GetSignedIntPropertyValue(Value)));
+		}
+
+		const int32 Index = FApologueAliasTable(Weights).Sample(*MersenneTwister);
+		if (Index != INDEX_NONE)
+		{
+			InnerProp->CopySingleValueToScriptVM(OutElement, ArrayHelper.GetRawPtr(Index));
+			*OutIndex = Index;
+		}
+	}
+
+	/**
+	 * Finds a numeric member by the name shown in the editor, which differs from the property name in user defined
+	 * structs.
+	 */
+	static const FNumericProperty* FindWeightProperty(const UScriptStruct* Struct, const FName WeightMember)
+	{
+		const FString MemberName = WeightMember.ToString();
+		for (TFieldIterator<FNumericProperty> It(Struct); It; ++It)
+		{
+			if (It->GetAuthoredName() == MemberName)
+			{
+				return *It;
+			}
+		}
+
+		return nullptr;
+	}
+
+	DECLARE_FUNCTION(execRandomWeightedElementInArray)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		const FMersenneTwister* MersenneTwister = reinterpret_cast<FMersenneTwister*>(Stack.MostRecentPropertyAddress);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FNameProperty, WeightMember);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		void* Result = Stack.MostRecentPropertyAddress;
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		int32* OutIndex = reinterpret_cast<int32*>(Stack.MostRecentPropertyAddress);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+			GenericRandomWeightedElement(ArrayAddr, ArrayProperty, MersenneTwister, WeightMember, Result, OutIndex);
+		P_NATIVE_END;
+	}
+};
@@ -0,0 +1,542 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueRandom.h"
+#include "ApologueRandomApi.h"
+#include "ApologueRandomEngines.h"
+#include "ApologueRandomLibrary.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "ApologueCounterRandom.generated.h"
+
+/**
+ * The draws of one (subject, step, channel) of an FApologueCounterRandom, with the same interface as FMersenneTwister.
+ *
+ * Cheap to make and meant to live on the stack for the duration of one use.
+ */
+class FApologueCounterStream : public TApologueRandomApi<FApologueCounterStream>
+{
+	mutable FApologuePhiloxEngine Engine;
+
+	// False only for streams standing in for an uninitialized source
+	bool bIsInitialized = false;
+
+public:
+	FApologueCounterStream() = default;
+
+	explicit FApologueCounterStream(const FApologuePhiloxEngine& InEngine)
+		: Engine(InEngine)
+		, bIsInitialized(true)
+	{
+	}
+
+	FORCEINLINE FApologuePhiloxEngine& GetEngine() const
+	{
+		return Engine;
+	}
+
+	FORCEINLINE bool IsInitialized() const
+	{
+		return bIsInitialized;
+	}
+
+	/**
+	 * Calls Function with the engine as its only argument.
+	 */
+	template <typename FunctionType>
+	FORCEINLINE decltype(auto) VisitEngine(FunctionType&& Function) const
+	{
+		ensure(bIsInitialized);
+		return Function(Engine);
+	}
+};
+
+/**
+ * Counter-based random source: every value is a pure function of the seed and the (subject, step, channel) it is
+ * drawn for, e.g. an entity id, a tick and a purpose. Nothing is stored per subject and draws do not depend on the
+ * order in which subjects are visited, so results are identical across threads, runs and machines.
+ *
+ * Each (subject, step, channel) has its own stream of 2^33 words. Channels use independently keyed generators.
+ */
+USTRUCT(BlueprintType, meta=(DisableSplitPin))
+struct APOLOGUECORE_API FApologueCounterRandom
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY()
+	int64 InitialSeed = 0;
+
+	UPROPERTY()
+	bool bIsInitialized = false;
+
+public:
+	/**
+	 * Initialize with a random seed.
+	 */
+	FORCEINLINE void Initialize()
+	{
+		Initialize(FApologueRandom::GenerateSeed());
+	}
+
+	FORCEINLINE void Initialize(const uint64 Seed)
+	{
+		InitialSeed = Seed;
+		bIsInitialized = true;
+	}
+
+	void Initialize(const FString& Seed)
+	{
+		uint64 ParsedSeed;
+		if (FApologueRandom::ParseSeed(Seed, ParsedSeed))
+		{
+			Initialize(ParsedSeed);
+		}
+		else
+		{
+			// Random initialization
+			Initialize();
+		}
+	}
+
+	FORCEINLINE int64 GetInitialSeed() const
+	{
+		return InitialSeed;
+	}
+
+	FORCEINLINE bool IsInitialized() const
+	{
+		return bIsInitialized;
+	}
+
+	/**
+	 * @return The draws for Subject at Step on Channel, from their first word.
+	 */
+	FORCEINLINE FApologueCounterStream At(const uint64 Subject, const uint32 Step, const uint32 Channel = 0) const
+	{
+		ensure(bIsInitialized);
+		return FApologueCounterStream(FApologuePhiloxEngine(GetKey(Channel), Subject, static_cast<uint64>(Step) << 32));
+	}
+
+	/**
+	 * @return The first word drawn for Subject at Step on Channel, without setting up a stream.
+	 */
+	FORCEINLINE uint64 GetWord(const uint64 Subject, const uint32 Step, const uint32 Channel = 0) const
+	{
+		ensure(bIsInitialized);
+
+		uint64 Block[FApologuePhiloxEngine::WordsPerBlock];
+		FApologuePhiloxEngine::Generate(GetKey(Channel), Subject, static_cast<uint64>(Step) << 32, Block);
+		return Block[0];
+	}
+
+private:
+	FORCEINLINE uint64 GetKey(const uint32 Channel) const
+	{
+		uint64 ChannelState = Channel;
+		return static_cast<uint64>(InitialSeed) ^ FApologueRandomMath::SplitMix64(ChannelState);
+	}
+};
+
+UCLASS()
+class APOLOGUECORE_API UApologueCounterRandomLibrary : public UApologueRandomLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Seeds the random source. An empty seed picks a random one.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random")
+	static void Initialize(UPARAM(Ref) FApologueCounterRandom& Random, const FString& Seed)
+	{
+		Random.Initialize(Seed);
+	}
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random")
+	static FORCEINLINE bool GetInitialSeed(UPARAM(Ref) const FApologueCounterRandom& Random, int64& InitialSeed)
+	{
+		if (!Random.IsInitialized())
+			return false;
+
+		InitialSeed = Random.GetInitialSeed();
+		return true;
+	}
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random")
+	static FORCEINLINE bool IsInitialized(UPARAM(Ref) const FApologueCounterRandom& Random)
+	{
+		return Random.IsInitialized();
+	}
+
+	/**
+	 * Obtains a random bool.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random Bool")
+	static FORCEINLINE bool RandBool(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel)
+	{
+		return GenericRandBool(At(Random, Subject, Step, Channel));
+	}
+
+	/**
+	 * Obtains a random value in [Min, Max].
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random Range (Integer)")
+	static FORCEINLINE int32 RandRange_Int32(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                         const int32 Min, const int32 Max)
+	{
+		return GenericRandRange(At(Random, Subject, Step, Channel), Min, Max);
+	}
+
+	/**
+	 * Obtains a random value in [Min, Max].
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random Range (Integer64)")
+	static FORCEINLINE int64 RandRange_Int64(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                         const int64 Min, const int64 Max)
+	{
+		return GenericRandRange(At(Random, Subject, Step, Channel), Min, Max);
+	}
+
+	/**
+	 * Obtains a random value in [Min, Max).
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random Range (Float)")
+	static FORCEINLINE double RandRange_Double(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                           const double Min, const double Max)
+	{
+		return GenericRandRange(At(Random, Subject, Step, Channel), Min, Max);
+	}
+
+	/**
+	 * Gets a random item from specified array.
+	 *
+	 * @param Random			The random source.
+	 * @param Subject			The subject to draw for.
+	 * @param Step				The step to draw for.
+	 * @param Channel			The channel to draw from.
+	 * @param TargetArray		The array.
+	 * @param OutElement		The random element from this array.
+	 * @param OutIndex			The index of random item (will be -1 if array is empty).
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="Apologue|Random|Counter Random", DisplayName="Random Element in Array",
+		meta=(ArrayParm="TargetArray", ArrayTypeDependentParams="OutElement"))
+	static FORCEINLINE void RandomElementInArray(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                             const TArray<int32>& TargetArray, int32& OutElement, int32& OutIndex)
+	{
+		// see execRandomElementInArray for implementation
+		check(0);
+	}
+
+	/**
+	 * Shuffles the specified array.
+	 *
+	 * @param Random			The random source.
+	 * @param Subject			The subject to draw for.
+	 * @param Step				The step to draw for.
+	 * @param Channel			The channel to draw from.
+	 * @param TargetArray		The array.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="Apologue|Random|Counter Random", meta=(ArrayParm="TargetArray", Keywords="random"))
+	static FORCEINLINE void ShuffleArray(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                     const TArray<int32>& TargetArray)
+	{
+		// see execShuffleArray for implementation
+		check(0);
+	}
+
+	/**
+	 * Moves a random sample of Count elements, in random order, to the front of the array. Costs O(Count) rather than
+	 * a full shuffle.
+	 *
+	 * @param Random			The random source.
+	 * @param Subject			The subject to draw for.
+	 * @param Step				The step to draw for.
+	 * @param Channel			The channel to draw from.
+	 * @param TargetArray		The array.
+	 * @param Count				The number of elements to sample.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="Apologue|Random|Counter Random", meta=(ArrayParm="TargetArray", Keywords="random sample"))
+	static FORCEINLINE void PartialShuffleArray(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                            const TArray<int32>& TargetArray, const int32 Count)
+	{
+		// see execPartialShuffleArray for implementation
+		check(0);
+	}
+
+	/**
+	 * Picks Count distinct indices in [0, Num) in random order, in O(Count).
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", meta=(Keywords="random sample"))
+	static FORCEINLINE TArray<int32> SampleIndices(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                               const int32 Num, const int32 Count)
+	{
+		return GenericSampleIndices(At(Random, Subject, Step, Channel), Num, Count);
+	}
+
+	/**
+	 * Obtains a random value in [0.0, 1.0).
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random")
+	static FORCEINLINE double RandomFraction(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel)
+	{
+		return GenericRandomFraction(At(Random, Subject, Step, Channel));
+	}
+
+	/**
+	 * Obtains a normally distributed value.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", meta=(Keywords="gaussian"))
+	static FORCEINLINE double RandomNormal(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                       const double Mean = 0.0, const double StandardDeviation = 1.0)
+	{
+		return GenericRandomNormal(At(Random, Subject, Step, Channel), Mean, StandardDeviation);
+	}
+
+	/**
+	 * Obtains an exponentially distributed value, such as the time until an event that happens Rate times per unit of
+	 * time on average.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random")
+	static FORCEINLINE double RandomExponential(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                            const double Rate = 1.0)
+	{
+		return GenericRandomExponential(At(Random, Subject, Step, Channel), Rate);
+	}
+
+	/**
+	 * Obtains a Poisson distributed count, such as the number of events in a span in which Mean of them happen on
+	 * average.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random")
+	static FORCEINLINE int64 RandomPoisson(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                       const double Mean)
+	{
+		return GenericRandomPoisson(At(Random, Subject, Step, Channel), Mean);
+	}
+
+	/**
+	 * Obtains the number of successes in Trials trials that each succeed with the given probability.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random")
+	static FORCEINLINE int32 RandomBinomial(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                        const int32 Trials, const double Probability)
+	{
+		return GenericRandomBinomial(At(Random, Subject, Step, Channel), Trials, Probability);
+	}
+
+	/**
+	 * Returns a random vector of unit size.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random")
+	static FORCEINLINE FVector RandomUnitVector(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel)
+	{
+		return GenericRandomUnitVector(At(Random, Subject, Step, Channel));
+	}
+
+	/**
+	 * Returns a random 2D point in a unit circle.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random Point in Unit Circle")
+	static FORCEINLINE FVector2D RandomPointInUnitCircle(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel)
+	{
+		return GenericRandomPointInUnitCircle(At(Random, Subject, Step, Channel));
+	}
+
+	/**
+	 * Returns a random 3D point in a unit sphere.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random Point in Unit Sphere")
+	static FORCEINLINE FVector RandomPointInUnitSphere(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel)
+	{
+		return GenericRandomPointInUnitSphere(At(Random, Subject, Step, Channel));
+	}
+
+	/**
+	 * Returns a random point in a bounding box.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random Point in Bounding Box")
+	static FORCEINLINE FVector RandomPointInBoundingBox(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                                    const FVector& Center, const FVector& HalfSize)
+	{
+		return GenericRandomPointInBoundingBox(At(Random, Subject, Step, Channel), Center, HalfSize);
+	}
+
+	/**
+	 * Returns a random point in a box.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random Point in Box")
+	static FORCEINLINE FVector RandomPointInBox(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                            const FBox& Box)
+	{
+		return GenericRandomPointInBox(At(Random, Subject, Step, Channel), Box);
+	}
+
+	/**
+	 * Returns a random unit vector, uniformly distributed, within the specified cone.
+	 *
+	 * @param Random The random source.
+	 * @param Subject The subject to draw for.
+	 * @param Step The step to draw for.
+	 * @param Channel The channel to draw from.
+	 * @param Direction The center direction of the cone.
+	 * @param HalfAngle Half-angle of cone, in degrees.
+	 * @return Normalized vector within the specified cone.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random Cone")
+	static FORCEINLINE FVector RandomCone(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                      const FVector& Direction, const double HalfAngle)
+	{
+		return GenericRandomCone(At(Random, Subject, Step, Channel), Direction, HalfAngle);
+	}
+
+	/**
+	 * Returns a random unit vector, uniformly distributed, within the specified cone.
+	 *
+	 * @param Random The random source.
+	 * @param Subject The subject to draw for.
+	 * @param Step The step to draw for.
+	 * @param Channel The channel to draw from.
+	 * @param Direction The center direction of the cone.
+	 * @param HalfAngle Half-angle of cone, in degrees.
+	 * @param VerticalHalfAngle Vertical half-angle of cone, in degrees.
+	 * @return Normalized vector within the specified cone.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random Cone with Vertical Half Angle")
+	static FORCEINLINE FVector GetConeWithVertical(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                               const FVector& Direction, const double HalfAngle, const double VerticalHalfAngle)
+	{
+		return GenericRandomCone(At(Random, Subject, Step, Channel), Direction, HalfAngle, VerticalHalfAngle);
+	}
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random from Fraction (Integer)")
+	static FORCEINLINE int32 RandomFromFraction_Int32(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                                  const int32 Numerator, const int32 Denominator)
+	{
+		return GenericRandomFromFraction(At(Random, Subject, Step, Channel), Numerator, Denominator);
+	}
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Counter Random", DisplayName="Random from Fraction (Integer64)")
+	static FORCEINLINE int64 RandomFromFraction_Int64(UPARAM(Ref) const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel,
+	                                                  const int64 Numerator, const int64 Denominator)
+	{
+		return GenericRandomFromFraction(At(Random, Subject, Step, Channel), Numerator, Denominator);
+	}
+
+private:
+	/**
+	 * The stream of an uninitialized source is left uninitialized, for the Generic helpers to report.
+	 */
+	static FORCEINLINE FApologueCounterStream At(const FApologueCounterRandom& Random, const int64 Subject, const int32 Step, const int32 Channel)
+	{
+		if (!Random.IsInitialized())
+		{
+			return FApologueCounterStream();
+		}
+
+		return Random.At(static_cast<uint64>(Subject), static_cast<uint32>(Step), static_cast<uint32>(Channel));
+	}
+
+	DECLARE_FUNCTION(execRandomElementInArray)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		const FApologueCounterRandom* Random = reinterpret_cast<FApologueCounterRandom*>(Stack.MostRecentPropertyAddress);
+
+		P_GET_PROPERTY(FInt64Property, Subject);
+		P_GET_PROPERTY(FIntProperty, Step);
+		P_GET_PROPERTY(FIntProperty, Channel);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		void* Result = Stack.MostRecentPropertyAddress;
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		int32* OutIndex = reinterpret_cast<int32*>(Stack.MostRecentPropertyAddress);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+			if (Random && EnsureInitialized(*Random))
+			{
+				FApologueCounterStream Stream = At(*Random, Subject, Step, Channel);
+				GenericRandArray(ArrayAddr, ArrayProperty, &Stream, Result, OutIndex);
+			}
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execShuffleArray)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		const FApologueCounterRandom* Random = reinterpret_cast<FApologueCounterRandom*>(Stack.MostRecentPropertyAddress);
+
+		P_GET_PROPERTY(FInt64Property, Subject);
+		P_GET_PROPERTY(FIntProperty, Step);
+		P_GET_PROPERTY(FIntProperty, Channel);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+			if (Random && EnsureInitialized(*Random))
+			{
+				MARK_PROPERTY_DIRTY(Stack.Object, ArrayProperty);
+				FApologueCounterStream Stream = At(*Random, Subject, Step, Channel);
+				GenericShuffleArray(ArrayAddr, ArrayProperty, &Stream);
+			}
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execPartialShuffleArray)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		const FApologueCounterRandom* Random = reinterpret_cast<FApologueCounterRandom*>(Stack.MostRecentPropertyAddress);
+
+		P_GET_PROPERTY(FInt64Property, Subject);
+		P_GET_PROPERTY(FIntProperty, Step);
+		P_GET_PROPERTY(FIntProperty, Channel);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, Count);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+			if (Random && EnsureInitialized(*Random))
+			{
+				MARK_PROPERTY_DIRTY(Stack.Object, ArrayProperty);
+				FApologueCounterStream Stream = At(*Random, Subject, Step, Channel);
+				GenericShuffleArray(ArrayAddr, ArrayProperty, &Stream, Count);
+			}
+		P_NATIVE_END;
+	}
+};
@@ -0,0 +1,226 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueRandomLibrary.h"
+#include "MersenneTwister.h"
+#include "ApologueDiceExpression.generated.h"
+
+/**
+ * A group of identical dice in a dice expression.
+ */
+USTRUCT(BlueprintType)
+struct APOLOGUECORE_API FApologueDiceTerm
+{
+	GENERATED_BODY()
+
+	// Number of dice; negative to subtract them
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice")
+	int32 Count = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice", meta=(ClampMin=1))
+	int32 Sides = 6;
+};
+
+UENUM(BlueprintType)
+enum class EApologueDiceDistribution : uint8
+{
+	// normal(mean, sd), rounded to the nearest integer
+	Normal,
+
+	// binomial(n, p)
+	Binomial,
+};
+
+/**
+ * A draw from a distribution in a dice expression, clamped to the int32 range.
+ */
+USTRUCT(BlueprintType)
+struct APOLOGUECORE_API FApologueDistributionTerm
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice")
+	EApologueDiceDistribution Distribution = EApologueDiceDistribution::Normal;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice", meta=(EditCondition="Distribution == EApologueDiceDistribution::Normal", EditConditionHides))
+	double Mean = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice", meta=(ClampMin=0, EditCondition="Distribution == EApologueDiceDistribution::Normal", EditConditionHides))
+	double StandardDeviation = 1.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice", meta=(ClampMin=0, EditCondition="Distribution == EApologueDiceDistribution::Binomial", EditConditionHides))
+	int32 Trials = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice", meta=(ClampMin=0, ClampMax=1, EditCondition="Distribution == EApologueDiceDistribution::Binomial", EditConditionHides))
+	double Probability = 0.5;
+
+	// Subtracts the draw instead of adding it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice")
+	bool bIsSubtracted = false;
+
+	/**
+	 * @return Whether the parameters describe a distribution; invalid terms are left out of the expression.
+	 */
+	bool IsValid() const;
+
+	template <typename StreamType>
+	int64 Draw(const StreamType& Stream) const
+	{
+		double Value;
+		if (Distribution == EApologueDiceDistribution::Normal)
+		{
+			Value = FMath::RoundToDouble(Stream.GetNormal(Mean, StandardDeviation));
+		}
+		else
+		{
+			Value = Stream.GetBinomial(Trials, Probability);
+		}
+
+		const int64 Clamped = static_cast<int64>(FMath::Clamp<double>(Value, MIN_int32, MAX_int32));
+		return bIsSubtracted ? -Clamped : Clamped;
+	}
+
+	int64 GetMin() const;
+
+	int64 GetMax() const;
+
+	double GetMean() const;
+};
+
+/**
+ * Dice notation such as "3d6+2", "1d20-1d4+1" or "normal(10,2.5)+binomial(5,0.3)", parsed once so that rolling costs
+ * no string work. Every dice term is rolled with FApologueRandom::RollDice, which takes one word per four dice of up
+ * to 65536 sides. Distribution terms are drawn after the dice, in order.
+ *
+ * StreamType is any type with the FMersenneTwister interface.
+ */
+USTRUCT(BlueprintType)
+struct APOLOGUECORE_API FApologueDiceExpression
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice")
+	TArray<FApologueDiceTerm> Dice;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice")
+	TArray<FApologueDistributionTerm> Distributions;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dice")
+	int32 Modifier = 0;
+
+	/**
+	 * Parses terms of the form NdS, dS, Nd%, normal(Mean,StandardDeviation), binomial(Trials,Probability) or a
+	 * constant, joined by + and -, ignoring whitespace and case.
+	 *
+	 * @return Whether Notation was valid; OutExpression is unchanged otherwise.
+	 */
+	static bool Parse(const FString& Notation, FApologueDiceExpression& OutExpression);
+
+	template <typename StreamType>
+	int64 Roll(const StreamType& Stream) const
+	{
+		int64 Total = Modifier;
+		for (const FApologueDiceTerm& Term : Dice)
+		{
+			if (Term.Sides < 1)
+			{
+				continue;
+			}
+
+			// MIN_int32 has no int32 magnitude, so its last die is rolled apart
+			const int64 Sum = Term.Count == MIN_int32
+				? Stream.RollDice(MAX_int32, Term.Sides) + Stream.RollDice(1, Term.Sides)
+				: Stream.RollDice(FMath::Abs(Term.Count), Term.Sides);
+			Total += Term.Count < 0 ? -Sum : Sum;
+		}
+
+		for (const FApologueDistributionTerm& Term : Distributions)
+		{
+			if (Term.IsValid())
+			{
+				Total += Term.Draw(Stream);
+			}
+		}
+
+		return Total;
+	}
+
+	int64 GetMin() const;
+
+	int64 GetMax() const;
+
+	double GetMean() const;
+
+	/**
+	 * @return The expression in dice notation, which Parse() reads back.
+	 */
+	FString ToString() const;
+};
+
+UCLASS()
+class APOLOGUECORE_API UApologueDiceLibrary : public UApologueRandomLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Parses dice notation such as "3d6+2".
+	 *
+	 * @return Whether the notation was valid.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Dice")
+	static bool ParseDiceExpression(const FString& Notation, FApologueDiceExpression& OutExpression)
+	{
+		return FApologueDiceExpression::Parse(Notation, OutExpression);
+	}
+
+	/**
+	 * Rolls every die of the expression and adds the modifier.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Dice")
+	static int64 RollDiceExpression(const FApologueDiceExpression& Expression, UPARAM(Ref) const FMersenneTwister& MersenneTwister)
+	{
+		if (EnsureInitialized(MersenneTwister))
+		{
+			return Expression.Roll(MersenneTwister);
+		}
+
+		return 0;
+	}
+
+	/**
+	 * Rolls Count dice with Sides faces each.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Dice")
+	static int64 RollDice(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const int32 Count = 1, const int32 Sides = 6)
+	{
+		if (!EnsureInitialized(MersenneTwister))
+		{
+			return 0;
+		}
+
+		if (Count < 0 || Sides < 1)
+		{
+			ThrowBlueprintException();
+			return 0;
+		}
+
+		return MersenneTwister.RollDice(Count, Sides);
+	}
+
+	UFUNCTION(BlueprintPure, Category="Apologue|Random|Dice")
+	static void GetDiceExpressionRange(const FApologueDiceExpression& Expression, int64& OutMin, int64& OutMax, double& OutMean)
+	{
+		OutMin = Expression.GetMin();
+		OutMax = Expression.GetMax();
+		OutMean = Expression.GetMean();
+	}
+
+	UFUNCTION(BlueprintPure, Category="Apologue|Random|Dice", meta=(DisplayName="To String (Dice Expression)", CompactNodeTitle="->", BlueprintAutocast))
+	static FString Conv_DiceExpressionToString(const FApologueDiceExpression& Expression)
+	{
+		return Expression.ToString();
+	}
+};
@@ -0,0 +1,1351 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include <random>
+
+#include "CoreMinimal.h"
+#include "ApologueRandomEngines.h"
+#include "ApologueZiggurat.h"
+#include "Internationalization/Regex.h"
+
+/**
+ * Random algorithms shared by every random stream, written against any UniformRandomBitGenerator producing 64-bit
+ * words (FMersenneTwisterEngine and the engines in ApologueRandomEngines.h).
+ *
+ * The algorithms are the plugin's own rather than the standard library distributions, whose output differs between
+ * standard library implementations. Only integer arithmetic and exact floating point operations are involved in
+ * drawing bits, bools, integers, integer ranges and fractions, so a seed produces the same values for those on every
+ * platform. Floating point ranges scale a fraction and may be contracted into a fused multiply-add. The geometric, normal, exponential, Poisson and binomial draws also go through the platform's transcendental
+ * functions (FMath::Loge, Exp, Cos, SinCos, Pow) and are subject to the compiler contracting multiplies and adds into
+ * fused operations, so their values may differ in the last bits between platforms, and a rejection sampler can then
+ * take a different branch and consume a different number of words. The Fill functions produce
+ * the same values as the matching scalar function called for each element, except FillBools which packs 64 bools
+ * per word.
+ */
+struct FApologueRandom
+{
+	/**
+	 * @return A seed from the hardware random source.
+	 */
+	static uint64 GenerateSeed()
+	{
+		// hardware randomization
+		// TODO: Is this the best way to handle this across all devices?
+		std::random_device RandomDevice;
+		return RandomDevice();
+	}
+
+	/**
+	 * Converts a user facing seed string to a seed. Integer strings are used as is, anything else is hashed.
+	 *
+	 * @return False if Seed is empty and a random seed should be used instead.
+	 */
+	static bool ParseSeed(const FString& Seed, uint64& OutSeed)
+	{
+		if (Seed.IsEmpty())
+		{
+			return false;
+		}
+
+		// Explicitly check for 0 because it is the fail value of FCString::Strtoi64() and we don't want any false negatives.
+		const FRegexPattern ZeroPattern(TEXT(R"(^(\+|-)?0+$)"));
+		FRegexMatcher ZeroMatcher(ZeroPattern, Seed);
+		if (ZeroMatcher.FindNext())
+		{
+			OutSeed = 0;
+			return true;
+		}
+
+		const int64 IntSeed = FCString::Strtoi64(*Seed, nullptr, 10);
+		if (IntSeed != 0 && IntSeed != -1)
+		{
+			OutSeed = IntSeed;
+			return true;
+		}
+
+		OutSeed = GetTypeHash(Seed);
+		return true;
+	}
+
+	/**
+	 * Seeds Engine as substream StreamIndex of Seed: the engine seeded with Seed and then jumped StreamIndex times,
+	 * so substreams of one seed never overlap. Costs one Jump() per index.
+	 */
+	template <typename EngineType>
+	static void SeedSubstream(EngineType& Engine, const uint64 Seed, const int32 StreamIndex)
+	{
+		check(StreamIndex >= 0);
+
+		Engine.Seed(Seed);
+		for (int32 I = 0; I < StreamIndex; ++I)
+		{
+			Engine.Jump();
+		}
+	}
+
+	/**
+	 * SFC64 has no jump, so its substreams are seeded with a hash of Seed and StreamIndex instead. They are very
+	 * unlikely to overlap within any practical number of draws, but unlike the other engines that is not guaranteed.
+	 */
+	static void SeedSubstream(FApologueSFC64Engine& Engine, const uint64 Seed, const int32 StreamIndex)
+	{
+		check(StreamIndex >= 0);
+
+		if (StreamIndex == 0)
+		{
+			Engine.Seed(Seed);
+			return;
+		}
+
+		uint64 Mix = Seed ^ (static_cast<uint64>(StreamIndex) * 0xD1342543DE82EF95ull);
+		Engine.Seed(FApologueRandomMath::SplitMix64(Mix));
+	}
+
+	/**
+	 * Moves Engine from the start of substream StreamIndex - 1 of Seed to the start of substream StreamIndex, for
+	 * deriving consecutive substreams without starting from the seed every time.
+	 */
+	template <typename EngineType>
+	static FORCEINLINE void NextSubstream(EngineType& Engine, const uint64 Seed, const int32 StreamIndex)
+	{
+		Engine.Jump();
+	}
+
+	static FORCEINLINE void NextSubstream(FApologueSFC64Engine& Engine, const uint64 Seed, const int32 StreamIndex)
+	{
+		SeedSubstream(Engine, Seed, StreamIndex);
+	}
+
+	/**
+	 * @return A random number in [0..A).
+	 */
+	template <typename T, typename EngineType>
+	static FORCEINLINE typename TEnableIf<TIsArithmetic<T>::Value && !TIsFloatingPoint<T>::Value, T>::Type
+	RandHelper(EngineType& Engine, const T A)
+	{
+		return RandomRange<T>(Engine, 0, A - 1);
+	}
+
+	/**
+	 * @return A random floating point value in [Min, Max), from one engine word.
+	 */
+	template <typename T, typename EngineType>
+	static FORCEINLINE typename TEnableIf<TIsFloatingPoint<T>::Value, T>::Type
+	RandomRange(EngineType& Engine, const T Min, const T Max)
+	{
+		return Min + (Max - Min) * GetFraction<T>(Engine);
+	}
+
+	/**
+	 * @return A random integer value in [Min, Max], from one engine word except for rare rejected draws.
+	 */
+	template <typename T, typename EngineType>
+	static FORCEINLINE typename TEnableIf<TIsArithmetic<T>::Value && !TIsFloatingPoint<T>::Value, T>::Type
+	RandomRange(EngineType& Engine, const T Min, const T Max)
+	{
+		check(Min <= Max);
+
+		// Zero when the range covers every uint64
+		const uint64 Range = static_cast<uint64>(Max) - static_cast<uint64>(Min) + 1;
+		return static_cast<T>(static_cast<uint64>(Min) + BoundedWord([&Engine] { return static_cast<uint64>(Engine()); }, Range));
+	}
+
+	/**
+	 * @return Random number in [0.0, 1.0), from the top bits of one engine word.
+	 */
+	template <typename T, typename EngineType>
+	static FORCEINLINE typename TEnableIf<TIsFloatingPoint<T>::Value, T>::Type
+	GetFraction(EngineType& Engine)
+	{
+		return WordToFraction<T>(Engine());
+	}
+
+	/**
+	 * Orthonormal frame around a cone direction, with the same axes as FRotationMatrix(Dir.Rotation()) but without
+	 * the trigonometry. Computed once per batch by the cone Fill functions.
+	 */
+	struct FConeBasis
+	{
+		FVector Forward;
+		FVector Right;
+		FVector Up;
+
+		explicit FConeBasis(const FVector& Dir)
+		{
+			Forward = Dir.GetSafeNormal();
+
+			const double HorizontalSize = FMath::Sqrt(Forward.X * Forward.X + Forward.Y * Forward.Y);
+			Right = HorizontalSize > UE_SMALL_NUMBER
+				        ? FVector(-Forward.Y / HorizontalSize, Forward.X / HorizontalSize, 0.0)
+				        : FVector::RightVector;
+			Up = Forward ^ Right;
+		}
+
+		FORCEINLINE bool IsValid() const
+		{
+			return !Forward.IsZero();
+		}
+
+		/**
+		 * @return The unit vector at polar angle acos(CosTheta) from Forward, turned by Phi from Up towards Right.
+		 */
+		FORCEINLINE FVector FromPolar(const double CosTheta, const double SinPhi, const double CosPhi) const
+		{
+			const double SinTheta = FMath::Sqrt(FMath::Max(0.0, 1.0 - CosTheta * CosTheta));
+			return Forward * CosTheta + (Up * CosPhi + Right * SinPhi) * SinTheta;
+		}
+	};
+
+	/**
+	 * @return A random unit vector, uniformly distributed on the sphere. Always uses two engine words.
+	 */
+	template <typename EngineType>
+	static FVector GetUnitVector(EngineType& Engine)
+	{
+		const double U = GetFraction<double>(Engine);
+		const double V = GetFraction<double>(Engine);
+		return UnitVectorFromFractions(U, V);
+	}
+
+	/**
+	 * @return A random point, uniformly distributed in the unit circle. Always uses two engine words.
+	 */
+	template <typename EngineType>
+	static FVector2D GetPointInUnitCircle(EngineType& Engine)
+	{
+		const double U = GetFraction<double>(Engine);
+		const double V = GetFraction<double>(Engine);
+		return PointInUnitCircleFromFractions(U, V);
+	}
+
+	/**
+	 * @return A random point, uniformly distributed in the unit sphere. Always uses three engine words.
+	 */
+	template <typename EngineType>
+	static FVector GetPointInUnitSphere(EngineType& Engine)
+	{
+		const double U = GetFraction<double>(Engine);
+		const double V = GetFraction<double>(Engine);
+		const double W = GetFraction<double>(Engine);
+		return PointInUnitSphereFromFractions(U, V, W);
+	}
+
+	template <typename EngineType>
+	static FVector GetPointInBox(EngineType& Engine, const FBox& Box)
+	{
+		// Evaluated in order so the result doesn't depend on the compiler's argument evaluation order
+		const double X = RandomRange(Engine, Box.Min.X, Box.Max.X);
+		const double Y = RandomRange(Engine, Box.Min.Y, Box.Max.Y);
+		const double Z = RandomRange(Engine, Box.Min.Z, Box.Max.Z);
+		return FVector(X, Y, Z);
+	}
+
+	/**
+	 * @return A random unit vector, uniformly distributed, within the cone around Dir with the given half-angle in radians.
+	 * Uses two engine words, or none if the cone is empty.
+	 */
+	template <typename EngineType>
+	static FVector GetCone(EngineType& Engine, const FVector& Dir, const double ConeHalfAngleRad)
+	{
+		const FConeBasis Basis(Dir);
+		if (ConeHalfAngleRad > 0.0 && Basis.IsValid())
+		{
+			const double U = GetFraction<double>(Engine);
+			const double V = GetFraction<double>(Engine);
+			return ConeVectorFromFractions(Basis, FMath::Cos(ConeHalfAngleRad), U, V);
+		}
+
+		return Basis.Forward;
+	}
+
+	/**
+	 * @return A random unit vector within the elliptical cone around Dir with the given half-angles in radians. Uses two
+	 * engine words, or none if the cone is empty.
+	 */
+	template <typename EngineType>
+	static FVector GetCone(EngineType& Engine, const FVector& Dir, const double HorizontalConeHalfAngleRad, const double VerticalConeHalfAngleRad)
+	{
+		const FConeBasis Basis(Dir);
+		if (VerticalConeHalfAngleRad > 0.0 && HorizontalConeHalfAngleRad > 0.0 && Basis.IsValid())
+		{
+			const double U = GetFraction<double>(Engine);
+			const double V = GetFraction<double>(Engine);
+			return EllipticalConeVectorFromFractions(Basis, HorizontalConeHalfAngleRad, VerticalConeHalfAngleRad, U, V);
+		}
+
+		return Basis.Forward;
+	}
+
+	/**
+	 * Fills Values with random unit vectors. Draws the same values as calling GetUnitVector for each one.
+	 */
+	template <typename EngineType>
+	static void FillUnitVectors(EngineType& Engine, const TArrayView<FVector> Values)
+	{
+		FillFromFractions<2>(Engine, Values, [](const double* Fractions)
+		{
+			return UnitVectorFromFractions(Fractions[0], Fractions[1]);
+		});
+	}
+
+	/**
+	 * Fills Values with random points in the unit circle. Draws the same values as calling GetPointInUnitCircle for each one.
+	 */
+	template <typename EngineType>
+	static void FillPointsInUnitCircle(EngineType& Engine, const TArrayView<FVector2D> Values)
+	{
+		FillFromFractions<2>(Engine, Values, [](const double* Fractions)
+		{
+			return PointInUnitCircleFromFractions(Fractions[0], Fractions[1]);
+		});
+	}
+
+	/**
+	 * Fills Values with random points in the unit sphere. Draws the same values as calling GetPointInUnitSphere for each one.
+	 */
+	template <typename EngineType>
+	static void FillPointsInUnitSphere(EngineType& Engine, const TArrayView<FVector> Values)
+	{
+		FillFromFractions<3>(Engine, Values, [](const double* Fractions)
+		{
+			return PointInUnitSphereFromFractions(Fractions[0], Fractions[1], Fractions[2]);
+		});
+	}
+
+	/**
+	 * Fills Values with random unit vectors within a cone, computing its basis once for the batch. Draws the same
+	 * values as calling GetCone for each one.
+	 */
+	template <typename EngineType>
+	static void FillCone(EngineType& Engine, const TArrayView<FVector> Values, const FVector& Dir, const double ConeHalfAngleRad)
+	{
+		const FConeBasis Basis(Dir);
+		if (ConeHalfAngleRad <= 0.0 || !Basis.IsValid())
+		{
+			for (FVector& Value : Values)
+			{
+				Value = Basis.Forward;
+			}
+
+			return;
+		}
+
+		const double CosHalfAngle = FMath::Cos(ConeHalfAngleRad);
+		FillFromFractions<2>(Engine, Values, [&Basis, CosHalfAngle](const double* Fractions)
+		{
+			return ConeVectorFromFractions(Basis, CosHalfAngle, Fractions[0], Fractions[1]);
+		});
+	}
+
+	/**
+	 * Fills Values with random unit vectors within an elliptical cone, computing its basis once for the batch. Draws
+	 * the same values as calling GetCone for each one.
+	 */
+	template <typename EngineType>
+	static void FillCone(EngineType& Engine, const TArrayView<FVector> Values, const FVector& Dir, const double HorizontalConeHalfAngleRad,
+	                     const double VerticalConeHalfAngleRad)
+	{
+		const FConeBasis Basis(Dir);
+		if (VerticalConeHalfAngleRad <= 0.0 || HorizontalConeHalfAngleRad <= 0.0 || !Basis.IsValid())
+		{
+			for (FVector& Value : Values)
+			{
+				Value = Basis.Forward;
+			}
+
+			return;
+		}
+
+		FillFromFractions<2>(Engine, Values, [&Basis, HorizontalConeHalfAngleRad, VerticalConeHalfAngleRad](const double* Fractions)
+		{
+			return EllipticalConeVectorFromFractions(Basis, HorizontalConeHalfAngleRad, VerticalConeHalfAngleRad, Fractions[0], Fractions[1]);
+		});
+	}
+
+	template <typename T, typename EngineType>
+	static FORCEINLINE typename TEnableIf<TIsArithmetic<T>::Value && !TIsFloatingPoint<T>::Value, bool>::Type
+	RandomFromFraction(EngineType& Engine, const T Numerator, const T Denominator)
+	{
+		return RandHelper(Engine, Denominator) < Numerator;
+	}
+
+	/**
+	 * @return A normally distributed value, from one engine word in about 99% of draws. A 256 layer ziggurat over the
+	 * constant tables of FApologueZiggurat.
+	 */
+	template <typename EngineType>
+	static double GetNormal(EngineType& Engine, const double Mean = 0.0, const double StandardDeviation = 1.0)
+	{
+		return Mean + StandardDeviation * GetStandardNormal(Engine);
+	}
+
+	template <typename EngineType>
+	static double GetStandardNormal(EngineType& Engine)
+	{
+		for (;;)
+		{
+			// 8 bits of layer, 1 of sign and 52 of magnitude
+			const uint64 Word = Engine();
+			const int32 Layer = static_cast<int32>(Word & 0xFF);
+			const bool bIsNegative = (Word >> 8 & 1) != 0;
+			const uint64 Magnitude = Word >> 9 & 0x000FFFFFFFFFFFFFull;
+			const double X = static_cast<double>(Magnitude) * FApologueZiggurat::NormalW[Layer];
+
+			if (Magnitude < FApologueZiggurat::NormalK[Layer])
+			{
+				return bIsNegative ? -X : X;
+			}
+
+			if (Layer == 0)
+			{
+				// Marsaglia's method for the tail beyond R
+				for (;;)
+				{
+					const double TailX = -LogFraction(Engine) / FApologueZiggurat::NormalR;
+					const double TailY = -LogFraction(Engine);
+					if (TailY + TailY > TailX * TailX)
+					{
+						return bIsNegative ? -(FApologueZiggurat::NormalR + TailX) : FApologueZiggurat::NormalR + TailX;
+					}
+				}
+			}
+
+			const double UpperF = FApologueZiggurat::NormalF[Layer - 1];
+			const double LowerF = FApologueZiggurat::NormalF[Layer];
+			if (LowerF + GetFraction<double>(Engine) * (UpperF - LowerF) < FMath::Exp(-0.5 * X * X))
+			{
+				return bIsNegative ? -X : X;
+			}
+		}
+	}
+
+	/**
+	 * @return An exponentially distributed value with the given rate, by inversion from one engine word.
+	 */
+	template <typename EngineType>
+	static double GetExponential(EngineType& Engine, const double Rate = 1.0)
+	{
+		check(Rate > 0.0)
+
+		return -LogFraction(Engine) / Rate;
+	}
+
+	/**
+	 * Constants of a Poisson distribution, computed once per batch by FillPoisson.
+	 */
+	struct FPoissonSetup
+	{
+		double Mean;
+		double LogMean = 0.0;
+		double ExpNegativeMean = 0.0;
+		double A = 0.0;
+		double B = 0.0;
+		double LogInvAlpha = 0.0;
+		double AcceptBound = 0.0;
+
+		explicit FPoissonSetup(const double InMean)
+			: Mean(InMean)
+		{
+			check(Mean >= 0.0)
+
+			if (UsesRejection())
+			{
+				// Constants of Hoermann's transformed rejection with squeeze
+				LogMean = FMath::Loge(Mean);
+				B = 0.931 + 2.53 * FMath::Sqrt(Mean);
+				A = -0.059 + 0.02483 * B;
+				LogInvAlpha = FMath::Loge(1.1239 + 1.1328 / (B - 3.4));
+				AcceptBound = 0.9277 - 3.6224 / (B - 2.0);
+			}
+			else
+			{
+				ExpNegativeMean = FMath::Exp(-Mean);
+			}
+		}
+
+		FORCEINLINE bool UsesRejection() const
+		{
+			return Mean >= 10.0;
+		}
+	};
+
+	/**
+	 * @return A Poisson distributed count with the given mean. Multiplies uniforms below a mean of 10, and above it
+	 * uses Hoermann's PTRS, which takes about 2.3 words per count whatever the mean.
+	 */
+	template <typename EngineType>
+	static int64 GetPoisson(EngineType& Engine, const double Mean)
+	{
+		return GetPoisson(Engine, FPoissonSetup(Mean));
+	}
+
+	template <typename EngineType>
+	static int64 GetPoisson(EngineType& Engine, const FPoissonSetup& Setup)
+	{
+		if (Setup.Mean == 0.0)
+		{
+			return 0;
+		}
+
+		if (!Setup.UsesRejection())
+		{
+			int64 Count = 0;
+			double Product = GetFraction<double>(Engine);
+			while (Product > Setup.ExpNegativeMean)
+			{
+				++Count;
+				Product *= GetFraction<double>(Engine);
+			}
+
+			return Count;
+		}
+
+		for (;;)
+		{
+			const double U = GetFraction<double>(Engine) - 0.5;
+			const double V = GetFraction<double>(Engine);
+			const double US = 0.5 - FMath::Abs(U);
+			const int64 Count = static_cast<int64>(FMath::FloorToDouble((2.0 * Setup.A / US + Setup.B) * U + Setup.Mean + 0.43));
+
+			if (US >= 0.07 && V <= Setup.AcceptBound)
+			{
+				return Count;
+			}
+
+			if (Count < 0 || (US < 0.013 && V > US))
+			{
+				continue;
+			}
+
+			// log(0) is -inf, which accepts
+			if (FMath::Loge(V) + Setup.LogInvAlpha - FMath::Loge(Setup.A / (US * US) + Setup.B)
+				<= -Setup.Mean + Count * Setup.LogMean - LogGamma(static_cast<double>(Count + 1)))
+			{
+				return Count;
+			}
+		}
+	}
+
+	/**
+	 * Constants of a binomial distribution, computed once per batch by FillBinomial.
+	 */
+	struct FBinomialSetup
+	{
+		int32 Trials;
+
+		// Probability of the rarer outcome, counted instead when it is failure
+		double P;
+		double Q;
+		bool bIsFlipped;
+
+		// Inversion
+		double QPowTrials = 0.0;
+		double InversionBound = 0.0;
+
+		// BTPE
+		int64 Mode = 0;
+		double NPQ = 0.0;
+		double XM = 0.0;
+		double XL = 0.0;
+		double XR = 0.0;
+		double C = 0.0;
+		double LambdaL = 0.0;
+		double LambdaR = 0.0;
+		double P1 = 0.0;
+		double P2 = 0.0;
+		double P3 = 0.0;
+		double P4 = 0.0;
+
+		FBinomialSetup(const int32 InTrials, const double Probability)
+			: Trials(InTrials)
+		{
+			check(Trials >= 0)
+
+			const double ClampedProbability = FMath::Clamp(Probability, 0.0, 1.0);
+			bIsFlipped = ClampedProbability > 0.5;
+			P = bIsFlipped ? 1.0 - ClampedProbability : ClampedProbability;
+			Q = 1.0 - P;
+
+			if (!UsesRejection())
+			{
+				const double Mean = Trials * P;
+				QPowTrials = FMath::Exp(Trials * FMath::Loge(Q));
+				InversionBound = FMath::Min(static_cast<double>(Trials), Mean + 10.0 * FMath::Sqrt(Mean * Q + 1.0));
+				return;
+			}
+
+			// Kachitvichyanukul and Schmeiser's triangle, parallelograms and exponential tails
+			const double FM = Trials * P + P;
+			Mode = static_cast<int64>(FMath::FloorToDouble(FM));
+			NPQ = Trials * P * Q;
+			P1 = FMath::FloorToDouble(2.195 * FMath::Sqrt(NPQ) - 4.6 * Q) + 0.5;
+			XM = Mode + 0.5;
+			XL = XM - P1;
+			XR = XM + P1;
+			C = 0.134 + 20.5 / (15.3 + Mode);
+
+			const double AL = (FM - XL) / (FM - XL * P);
+			LambdaL = AL * (1.0 + AL / 2.0);
+			const double AR = (XR - FM) / (XR * Q);
+			LambdaR = AR * (1.0 + AR / 2.0);
+
+			P2 = P1 * (1.0 + 2.0 * C);
+			P3 = P2 + C / LambdaL;
+			P4 = P3 + C / LambdaR;
+		}
+
+		FORCEINLINE bool UsesRejection() const
+		{
+			return Trials * P > 30.0;
+		}
+	};
+
+	/**
+	 * @return The number of successes in Trials trials of the given probability. Inverts the distribution while the
+	 * mean of the rarer outcome is at most 30, and above it uses Kachitvichyanukul and Schmeiser's BTPE, whose cost
+	 * does not grow with Trials.
+	 */
+	template <typename EngineType>
+	static int32 GetBinomial(EngineType& Engine, const int32 Trials, const double Probability)
+	{
+		return GetBinomial(Engine, FBinomialSetup(Trials, Probability));
+	}
+
+	template <typename EngineType>
+	static int32 GetBinomial(EngineType& Engine, const FBinomialSetup& Setup)
+	{
+		if (Setup.Trials == 0 || Setup.P == 0.0)
+		{
+			return Setup.bIsFlipped ? Setup.Trials : 0;
+		}
+
+		const int64 Count = Setup.UsesRejection() ? BinomialBTPE(Engine, Setup) : BinomialInversion(Engine, Setup);
+		return static_cast<int32>(Setup.bIsFlipped ? Setup.Trials - Count : Count);
+	}
+
+	/**
+	 * @return The sum of Count dice with Sides faces each. Up to four dice share one word while the product of their
+	 * ranges fits in 64 bits, as in ShuffleSwaps.
+	 */
+	template <typename EngineType>
+	static int64 RollDice(EngineType& Engine, const int32 Count, const int32 Sides)
+	{
+		check(Count >= 0)
+		check(Sides >= 1)
+
+		if (Sides == 1)
+		{
+			return Count;
+		}
+
+		auto NextWord = [&Engine] { return static_cast<uint64>(Engine()); };
+		const uint64 Range = static_cast<uint64>(Sides);
+
+		// Faces start at one
+		int64 Sum = Count;
+		int32 Remaining = Count;
+
+		if (Range <= (1ull << 16))
+		{
+			const uint64 Ranges[4] = {Range, Range, Range, Range};
+			uint64 Faces[4];
+			for (; Remaining >= 4; Remaining -= 4)
+			{
+				BoundedWords(NextWord, Ranges, Faces);
+				Sum += static_cast<int64>(Faces[0] + Faces[1] + Faces[2] + Faces[3]);
+			}
+		}
+
+		const uint64 Ranges[2] = {Range, Range};
+		uint64 Faces[2];
+		for (; Remaining >= 2; Remaining -= 2)
+		{
+			BoundedWords(NextWord, Ranges, Faces);
+			Sum += static_cast<int64>(Faces[0] + Faces[1]);
+		}
+
+		if (Remaining > 0)
+		{
+			Sum += static_cast<int64>(BoundedWord(NextWord, Range));
+		}
+
+		return Sum;
+	}
+
+	/**
+	 * Fills Values with normally distributed values. Draws the same values as calling GetNormal for each one.
+	 */
+	template <typename T, typename EngineType>
+	static typename TEnableIf<TIsFloatingPoint<T>::Value>::Type
+	FillNormal(EngineType& Engine, const TArrayView<T> Values, const double Mean = 0.0, const double StandardDeviation = 1.0)
+	{
+		for (T& Value : Values)
+		{
+			Value = static_cast<T>(Mean + StandardDeviation * GetStandardNormal(Engine));
+		}
+	}
+
+	/**
+	 * Fills Values with exponentially distributed values. Draws the same values as calling GetExponential for each one.
+	 */
+	template <typename T, typename EngineType>
+	static typename TEnableIf<TIsFloatingPoint<T>::Value>::Type
+	FillExponential(EngineType& Engine, const TArrayView<T> Values, const double Rate = 1.0)
+	{
+		check(Rate > 0.0)
+
+		FillFromFractions<1>(Engine, Values, [Rate](const double* Fractions)
+		{
+			return static_cast<T>(-FMath::Loge(1.0 - Fractions[0]) / Rate);
+		});
+	}
+
+	/**
+	 * Fills Values with Poisson distributed counts, with the constants of the distribution computed once. Draws the
+	 * same values as calling GetPoisson for each one.
+	 */
+	template <typename T, typename EngineType>
+	static typename TEnableIf<TIsIntegral<T>::Value>::Type
+	FillPoisson(EngineType& Engine, const TArrayView<T> Values, const double Mean)
+	{
+		const FPoissonSetup Setup(Mean);
+		for (T& Value : Values)
+		{
+			Value = static_cast<T>(GetPoisson(Engine, Setup));
+		}
+	}
+
+	/**
+	 * Fills Values with binomially distributed counts, with the constants of the distribution computed once. Draws
+	 * the same values as calling GetBinomial for each one.
+	 */
+	template <typename T, typename EngineType>
+	static typename TEnableIf<TIsIntegral<T>::Value>::Type
+	FillBinomial(EngineType& Engine, const TArrayView<T> Values, const int32 Trials, const double Probability)
+	{
+		const FBinomialSetup Setup(Trials, Probability);
+		for (T& Value : Values)
+		{
+			Value = static_cast<T>(GetBinomial(Engine, Setup));
+		}
+	}
+
+	// Number of words generated at a time by the Fill functions
+	static constexpr int32 FillChunkSize = 256;
+
+	/**
+	 * Fills Words with the engine's next words.
+	 */
+	template <typename EngineType>
+	static void FillWords(EngineType& Engine, const TArrayView<uint64> Words)
+	{
+		for (uint64& Word : Words)
+		{
+			Word = Engine();
+		}
+	}
+
+	static void FillWords(FApologueXoshiro256StarStarX4Engine& Engine, const TArrayView<uint64> Words)
+	{
+		Engine.Fill(Words);
+	}
+
+	static void FillWords(FApologuePhiloxEngine& Engine, const TArrayView<uint64> Words)
+	{
+		Engine.Fill(Words);
+	}
+
+	/**
+	 * Fills Values with random numbers in [0.0, 1.0), one word per value.
+	 */
+	template <typename T, typename EngineType>
+	static typename TEnableIf<TIsFloatingPoint<T>::Value>::Type
+	FillFraction(EngineType& Engine, const TArrayView<T> Values)
+	{
+		uint64 Words[FillChunkSize];
+		for (int32 Start = 0; Start < Values.Num(); Start += FillChunkSize)
+		{
+			const int32 Count = FMath::Min(FillChunkSize, Values.Num() - Start);
+			FillWords(Engine, MakeArrayView(Words, Count));
+
+			T* Chunk = Values.GetData() + Start;
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				Chunk[Index] = WordToFraction<T>(Words[Index]);
+			}
+		}
+	}
+
+	/**
+	 * Fills Values with random floating point values in [Min, Max), one word per value.
+	 */
+	template <typename T, typename EngineType>
+	static typename TEnableIf<TIsFloatingPoint<T>::Value>::Type
+	FillRange(EngineType& Engine, const TArrayView<T> Values, const T Min, const T Max)
+	{
+		FillFraction(Engine, Values);
+
+		const T Scale = Max - Min;
+		for (T& Value : Values)
+		{
+			Value = Min + Scale * Value;
+		}
+	}
+
+	/**
+	 * Fills Values with random integer values in [Min, Max], one word per value plus a rare extra word when a draw is
+	 * rejected to keep the distribution unbiased.
+	 */
+	template <typename T, typename EngineType>
+	static typename TEnableIf<TIsIntegral<T>::Value>::Type
+	FillRange(EngineType& Engine, const TArrayView<T> Values, const T Min, const T Max)
+	{
+		check(Min <= Max);
+
+		// Zero when the range covers every uint64
+		const uint64 Range = static_cast<uint64>(Max) - static_cast<uint64>(Min) + 1;
+
+		uint64 Words[FillChunkSize];
+		int32 NumWords = 0;
+		int32 WordIndex = 0;
+
+		for (int32 Index = 0; Index < Values.Num(); ++Index)
+		{
+			// Never generates more words than values left, so no word is skipped when the fill ends
+			auto NextWord = [&]
+			{
+				if (WordIndex == NumWords)
+				{
+					NumWords = FMath::Min(FillChunkSize, Values.Num() - Index);
+					WordIndex = 0;
+					FillWords(Engine, MakeArrayView(Words, NumWords));
+				}
+
+				return Words[WordIndex++];
+			};
+
+			Values[Index] = static_cast<T>(static_cast<uint64>(Min) + BoundedWord(NextWord, Range));
+		}
+	}
+
+	/**
+	 * Fills Values with random bools, 64 per word.
+	 */
+	template <typename EngineType>
+	static void FillBools(EngineType& Engine, const TArrayView<bool> Values)
+	{
+		uint64 Words[FillChunkSize];
+		constexpr int32 BoolsPerChunk = FillChunkSize * 64;
+
+		for (int32 Start = 0; Start < Values.Num(); Start += BoolsPerChunk)
+		{
+			const int32 Count = FMath::Min(BoolsPerChunk, Values.Num() - Start);
+			FillWords(Engine, MakeArrayView(Words, (Count + 63) / 64));
+
+			bool* Chunk = Values.GetData() + Start;
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				Chunk[Index] = (Words[Index / 64] >> (Index % 64) & 1) != 0;
+			}
+		}
+	}
+
+	/**
+	 * Lemire's nearly divisionless method: an unbiased value in [0, Range) from NextWord(), dividing only when a draw
+	 * lands in the small biased region. A Range of zero stands for 2^64.
+	 */
+	template <typename FunctionType>
+	static FORCEINLINE uint64 BoundedWord(FunctionType&& NextWord, const uint64 Range)
+	{
+		if (Range == 0)
+		{
+			return NextWord();
+		}
+
+		uint64 High;
+		uint64 Low = FApologueRandomMath::MultiplyFull(NextWord(), Range, High);
+		if (Low < Range)
+		{
+			const uint64 Threshold = (0 - Range) % Range;
+			while (Low < Threshold)
+			{
+				Low = FApologueRandomMath::MultiplyFull(NextWord(), Range, High);
+			}
+		}
+
+		return High;
+	}
+
+	/**
+	 * Unbiased values in [0, Ranges[I]) for every range from a single word, retrying only when a draw lands in the
+	 * biased region. The product of the ranges must fit in 64 bits. Generalizes BoundedWord; see Brackett-Rozinsky and
+	 * Lemire, "Batched Ranged Random Integer Generation".
+	 */
+	template <typename FunctionType, int32 NumRanges>
+	static FORCEINLINE void BoundedWords(FunctionType&& NextWord, const uint64 (&Ranges)[NumRanges], uint64 (&OutValues)[NumRanges])
+	{
+		auto Split = [&Ranges, &OutValues](uint64 Low)
+		{
+			for (int32 I = 0; I < NumRanges; ++I)
+			{
+				Low = FApologueRandomMath::MultiplyFull(Low, Ranges[I], OutValues[I]);
+			}
+
+			return Low;
+		};
+
+		uint64 Low = Split(NextWord());
+
+		uint64 Product = 1;
+		for (const uint64 Range : Ranges)
+		{
+			Product *= Range;
+		}
+
+		if (Low < Product)
+		{
+			const uint64 Threshold = (0 - Product) % Product;
+			while (Low < Threshold)
+			{
+				Low = Split(NextWord());
+			}
+		}
+	}
+
+	/**
+	 * @return The log of a random fraction in (0.0, 1.0], which is never -inf.
+	 */
+	template <typename EngineType>
+	static FORCEINLINE double LogFraction(EngineType& Engine)
+	{
+		return FMath::Loge(1.0 - GetFraction<double>(Engine));
+	}
+
+	/**
+	 * @return log(Gamma(X)) for X >= 1 from Stirling's series, so the same on every platform rather than depending on
+	 * the C library's lgamma.
+	 */
+	static double LogGamma(double X)
+	{
+		static constexpr double Coefficients[10] = {
+			8.333333333333333e-02, -2.777777777777778e-03, 7.936507936507937e-04, -5.952380952380952e-04,
+			8.417508417508418e-04, -1.917526917526918e-03, 6.410256410256410e-03, -2.955065359477124e-02,
+			1.796443723688307e-01, -1.39243221690590e+00
+		};
+
+		if (X == 1.0 || X == 2.0)
+		{
+			return 0.0;
+		}
+
+		// The series converges from 7 up, and lower values step down to X by the recurrence
+		const int32 Steps = X < 7.0 ? static_cast<int32>(7.0 - X) : 0;
+		X += Steps;
+
+		const double InvSquare = 1.0 / X * (1.0 / X);
+		double Series = Coefficients[9];
+		for (int32 Index = 8; Index >= 0; --Index)
+		{
+			Series = Series * InvSquare + Coefficients[Index];
+		}
+
+		double Result = Series / X + 0.5 * 1.8378770664093453 + (X - 0.5) * FMath::Loge(X) - X;
+		for (int32 Step = 0; Step < Steps; ++Step)
+		{
+			X -= 1.0;
+			Result -= FMath::Loge(X);
+		}
+
+		return Result;
+	}
+
+	template <typename EngineType>
+	static int64 BinomialInversion(EngineType& Engine, const FBinomialSetup& Setup)
+	{
+		int64 Count = 0;
+		double Mass = Setup.QPowTrials;
+		double U = GetFraction<double>(Engine);
+		while (U > Mass)
+		{
+			++Count;
+			if (Count > Setup.InversionBound)
+			{
+				// Lost to rounding far out in the tail; start over
+				Count = 0;
+				Mass = Setup.QPowTrials;
+				U = GetFraction<double>(Engine);
+			}
+			else
+			{
+				U -= Mass;
+				Mass = (Setup.Trials - Count + 1) * Setup.P * Mass / (Count * Setup.Q);
+			}
+		}
+
+		return Count;
+	}
+
+	template <typename EngineType>
+	static int64 BinomialBTPE(EngineType& Engine, const FBinomialSetup& Setup)
+	{
+		const int64 Trials = Setup.Trials;
+		const int64 Mode = Setup.Mode;
+
+		for (;;)
+		{
+			const double U = GetFraction<double>(Engine) * Setup.P4;
+			double V = GetFraction<double>(Engine);
+			int64 Count;
+
+			if (U <= Setup.P1)
+			{
+				// Triangle, accepted outright
+				return static_cast<int64>(FMath::FloorToDouble(Setup.XM - Setup.P1 * V + U));
+			}
+
+			if (U <= Setup.P2)
+			{
+				// Parallelograms
+				const double X = Setup.XL + (U - Setup.P1) / Setup.C;
+				V = V * Setup.C + 1.0 - FMath::Abs(Mode - X + 0.5) / Setup.P1;
+				if (V > 1.0)
+				{
+					continue;
+				}
+
+				Count = static_cast<int64>(FMath::FloorToDouble(X));
+			}
+			else if (U <= Setup.P3)
+			{
+				// Left exponential tail
+				if (V == 0.0)
+				{
+					continue;
+				}
+
+				Count = static_cast<int64>(FMath::FloorToDouble(Setup.XL + FMath::Loge(V) / Setup.LambdaL));
+				if (Count < 0)
+				{
+					continue;
+				}
+
+				V = V * (U - Setup.P2) * Setup.LambdaL;
+			}
+			else
+			{
+				// Right exponential tail
+				if (V == 0.0)
+				{
+					continue;
+				}
+
+				Count = static_cast<int64>(FMath::FloorToDouble(Setup.XR - FMath::Loge(V) / Setup.LambdaR));
+				if (Count > Trials)
+				{
+					continue;
+				}
+
+				V = V * (U - Setup.P3) * Setup.LambdaR;
+			}
+
+			const int64 Distance = FMath::Abs(Count - Mode);
+			if (Distance <= 20 || Distance >= Setup.NPQ / 2.0 - 1.0)
+			{
+				// Ratio of the probabilities of Count and Mode, built up term by term
+				const double S = Setup.P / Setup.Q;
+				const double A = S * (Trials + 1);
+				double Ratio = 1.0;
+				if (Mode < Count)
+				{
+					for (int64 I = Mode + 1; I <= Count; ++I)
+					{
+						Ratio *= A / I - S;
+					}
+				}
+				else if (Mode > Count)
+				{
+					for (int64 I = Count + 1; I <= Mode; ++I)
+					{
+						Ratio /= A / I - S;
+					}
+				}
+
+				if (V > Ratio)
+				{
+					continue;
+				}
+
+				return Count;
+			}
+
+			// Squeeze on log(V), then the exact test through Stirling's approximation
+			const double K = static_cast<double>(Distance);
+			const double Rho = K / Setup.NPQ * ((K * (K / 3.0 + 0.625) + 0.16666666666666666) / Setup.NPQ + 0.5);
+			const double T = -K * K / (2.0 * Setup.NPQ);
+			const double LogV = FMath::Loge(V);
+			if (LogV < T - Rho)
+			{
+				return Count;
+			}
+
+			if (LogV > T + Rho)
+			{
+				continue;
+			}
+
+			auto Stirling = [](const double Value)
+			{
+				const double Square = Value * Value;
+				return (13680.0 - (462.0 - (132.0 - (99.0 - 140.0 / Square) / Square) / Square) / Square) / Value / 166320.0;
+			};
+
+			const double X1 = static_cast<double>(Count + 1);
+			const double F1 = static_cast<double>(Mode + 1);
+			const double Z = static_cast<double>(Trials + 1 - Mode);
+			const double W = static_cast<double>(Trials - Count + 1);
+			const double Bound = Setup.XM * FMath::Loge(F1 / X1) + (Trials - Mode + 0.5) * FMath::Loge(Z / W)
+				+ (Count - Mode) * FMath::Loge(W * Setup.P / (X1 * Setup.Q)) + Stirling(F1) + Stirling(Z) + Stirling(X1) + Stirling(W);
+			if (LogV > Bound)
+			{
+				continue;
+			}
+
+			return Count;
+		}
+	}
+
+	/**
+	 * @return The top 53 bits of Word as a double in [0.0, 1.0), or the top 24 bits as a float.
+	 */
+	template <typename T>
+	static FORCEINLINE T WordToFraction(const uint64 Word)
+	{
+		if constexpr (std::is_same_v<T, float>)
+		{
+			return static_cast<float>(Word >> 40) * 0x1.0p-24f;
+		}
+		else
+		{
+			return static_cast<T>(static_cast<double>(Word >> 11) * 0x1.0p-53);
+		}
+	}
+
+	/**
+	 * Fills Values in chunks, making each value from FractionsPerValue consecutive fractions.
+	 */
+	template <int32 FractionsPerValue, typename EngineType, typename T, typename FunctionType>
+	static void FillFromFractions(EngineType& Engine, const TArrayView<T> Values, FunctionType&& MakeValue)
+	{
+		constexpr int32 ValuesPerChunk = FillChunkSize / FractionsPerValue;
+
+		double Fractions[ValuesPerChunk * FractionsPerValue];
+		for (int32 Start = 0; Start < Values.Num(); Start += ValuesPerChunk)
+		{
+			const int32 Count = FMath::Min(ValuesPerChunk, Values.Num() - Start);
+			FillFraction(Engine, MakeArrayView(Fractions, Count * FractionsPerValue));
+
+			T* Chunk = Values.GetData() + Start;
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				Chunk[Index] = MakeValue(Fractions + Index * FractionsPerValue);
+			}
+		}
+	}
+
+	// Uniform on the sphere: uniform height and uniform longitude (Archimedes)
+	static FORCEINLINE FVector UnitVectorFromFractions(const double U, const double V)
+	{
+		const double Z = 2.0 * U - 1.0;
+		const double Radius = FMath::Sqrt(FMath::Max(0.0, 1.0 - Z * Z));
+
+		double SinPhi, CosPhi;
+		FMath::SinCos(&SinPhi, &CosPhi, 2.0 * UE_DOUBLE_PI * V);
+		return FVector(Radius * CosPhi, Radius * SinPhi, Z);
+	}
+
+	static FORCEINLINE FVector2D PointInUnitCircleFromFractions(const double U, const double V)
+	{
+		const double Radius = FMath::Sqrt(U);
+
+		double SinPhi, CosPhi;
+		FMath::SinCos(&SinPhi, &CosPhi, 2.0 * UE_DOUBLE_PI * V);
+		return FVector2D(Radius * CosPhi, Radius * SinPhi);
+	}
+
+	static FORCEINLINE FVector PointInUnitSphereFromFractions(const double U, const double V, const double W)
+	{
+		return UnitVectorFromFractions(U, V) * FMath::Pow(W, 1.0 / 3.0);
+	}
+
+	// Uniform over the spherical cap: uniform cos(theta) in [cos(HalfAngle), 1] and uniform phi
+	static FORCEINLINE FVector ConeVectorFromFractions(const FConeBasis& Basis, const double CosHalfAngle, const double U, const double V)
+	{
+		double SinPhi, CosPhi;
+		FMath::SinCos(&SinPhi, &CosPhi, 2.0 * UE_DOUBLE_PI * V);
+		return Basis.FromPolar(1.0 - U * (1.0 - CosHalfAngle), SinPhi, CosPhi);
+	}
+
+	// The half-angle at phi is the polar radius of the ellipse with the vertical and horizontal half-angles as axes
+	static FORCEINLINE FVector EllipticalConeVectorFromFractions(const FConeBasis& Basis, const double HorizontalHalfAngle, const double VerticalHalfAngle,
+	                                                             const double U, const double V)
+	{
+		double SinPhi, CosPhi;
+		FMath::SinCos(&SinPhi, &CosPhi, 2.0 * UE_DOUBLE_PI * V);
+
+		const double HalfAngle = 1.0 / FMath::Sqrt(FMath::Square(CosPhi / VerticalHalfAngle) + FMath::Square(SinPhi / HorizontalHalfAngle));
+		return Basis.FromPolar(1.0 - U * (1.0 - FMath::Cos(HalfAngle)), SinPhi, CosPhi);
+	}
+
+	// Fisher-Yates
+	template <typename T, typename EngineType>
+	static void Shuffle(EngineType& Engine, T& List, const typename T::SizeType StartIndex = 0, typename T::SizeType EndIndex = INDEX_NONE)
+	{
+		if (EndIndex == INDEX_NONE)
+		{
+			EndIndex = List.Num();
+		}
+
+		check(StartIndex >= 0)
+		check(StartIndex <= EndIndex)
+		check(EndIndex <= List.Num())
+
+		ShuffleSwaps(Engine, StartIndex, EndIndex, EndIndex - StartIndex, [&List](const int64 IndexA, const int64 IndexB)
+		{
+			CollectionSwap(List, static_cast<typename T::SizeType>(IndexA), static_cast<typename T::SizeType>(IndexB));
+		});
+	}
+
+	/**
+	 * Moves a uniformly random sample of Count elements, in random order, to the front of List. Only the first Count
+	 * steps of a Fisher-Yates shuffle, so it costs O(Count) however long the list is.
+	 */
+	template <typename T, typename EngineType>
+	static void PartialShuffle(EngineType& Engine, T& List, const typename T::SizeType Count)
+	{
+		check(Count >= 0)
+		check(Count <= List.Num())
+
+		ShuffleSwaps(Engine, 0, List.Num(), Count, [&List](const int64 IndexA, const int64 IndexB)
+		{
+			CollectionSwap(List, static_cast<typename T::SizeType>(IndexA), static_cast<typename T::SizeType>(IndexB));
+		});
+	}
+
+	/**
+	 * Picks Count distinct indices in [0, Num) in random order, without touching the container they index. Floyd's
+	 * algorithm, O(Count) however large Num is.
+	 */
+	template <typename EngineType>
+	static void SampleIndices(EngineType& Engine, const int32 Num, const int32 Count, TArray<int32>& OutIndices)
+	{
+		check(Count >= 0)
+		check(Count <= Num)
+
+		OutIndices.Reset(Count);
+
+		TSet<int32> Picked;
+		Picked.Reserve(Count);
+		for (int32 Candidate = Num - Count; Candidate < Num; ++Candidate)
+		{
+			const int32 Index = RandomRange(Engine, 0, Candidate);
+
+			bool bIsAlreadyPicked;
+			Picked.Add(Index, &bIsAlreadyPicked);
+			if (bIsAlreadyPicked)
+			{
+				// Candidate is new, as it is above every earlier range
+				Picked.Add(Candidate);
+			}
+
+			OutIndices.Add(bIsAlreadyPicked ? Candidate : Index);
+		}
+
+		// Floyd's algorithm picks a uniform set, but not in a uniform order
+		Shuffle(Engine, OutIndices);
+	}
+
+	/**
+	 * The swaps of a Fisher-Yates shuffle of [StartIndex, EndIndex), stopping once the first Count positions are final.
+	 * Calls Swap(IndexA, IndexB) with IndexA < IndexB for every swap that moves an element.
+	 *
+	 * Consecutive steps draw their indices from one shared word while the product of their ranges fits in 64 bits, up
+	 * to four steps per word for ranges under 2^16 (Brackett-Rozinsky and Lemire's batched shuffle).
+	 */
+	template <typename EngineType, typename SwapFunctionType>
+	static void ShuffleSwaps(EngineType& Engine, const int64 StartIndex, const int64 EndIndex, const int64 Count, SwapFunctionType&& Swap)
+	{
+		auto NextWord = [&Engine] { return static_cast<uint64>(Engine()); };
+
+		// The last position is final once every position before it is
+		const int64 LastIndex = FMath::Min(StartIndex + Count, EndIndex - 1);
+
+		int64 Index = StartIndex;
+		auto Step = [&Index, &Swap](const uint64 Offset)
+		{
+			if (Offset != 0)
+			{
+				Swap(Index, Index + static_cast<int64>(Offset));
+			}
+
+			++Index;
+		};
+
+		while (Index < LastIndex)
+		{
+			const uint64 Range = static_cast<uint64>(EndIndex - Index);
+			const int64 Steps = LastIndex - Index;
+
+			if (Steps >= 4 && Range <= (1ull << 16))
+			{
+				uint64 Ranges[4] = {Range, Range - 1, Range - 2, Range - 3};
+				uint64 Offsets[4];
+				BoundedWords(NextWord, Ranges, Offsets);
+				for (const uint64 Offset : Offsets)
+				{
+					Step(Offset);
+				}
+			}
+			else if (Steps >= 3 && Range <= (1ull << 21))
+			{
+				uint64 Ranges[3] = {Range, Range - 1, Range - 2};
+				uint64 Offsets[3];
+				BoundedWords(NextWord, Ranges, Offsets);
+				for (const uint64 Offset : Offsets)
+				{
+					Step(Offset);
+				}
+			}
+			else if (Steps >= 2 && Range <= (1ull << 32))
+			{
+				uint64 Ranges[2] = {Range, Range - 1};
+				uint64 Offsets[2];
+				BoundedWords(NextWord, Ranges, Offsets);
+				Step(Offsets[0]);
+				Step(Offsets[1]);
+			}
+			else
+			{
+				Step(BoundedWord(NextWord, Range));
+			}
+		}
+	}
+
+	// Array Swap
+	template <typename T>
+	static void CollectionSwap(TArray<T>& Array, const typename TArray<T>::SizeType IndexA,
+	                           const typename TArray<T>::SizeType IndexB)
+	{
+		// ignores sanity checks in TArray::Swap()
+		Array.SwapMemory(IndexA, IndexB);
+	}
+
+	// Other Container Type Swap
+	template <typename T>
+	static void CollectionSwap(T& Collection, const typename T::SizeType IndexA, const typename T::SizeType IndexB)
+	{
+		auto Temp = MoveTempIfPossible(Collection[IndexA]);
+		Collection[IndexA] = MoveTempIfPossible(Collection[IndexB]);
+		Collection[IndexB] = MoveTempIfPossible(Temp);
+	}
+};
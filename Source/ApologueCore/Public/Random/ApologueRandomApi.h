@@ -0,0 +1,339 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueRandom.h"
+#include "Templates/Identity.h"
+
+/**
+ * The drawing interface shared by the random stream types, written once over FApologueRandom. DerivedType provides
+ * VisitEngine(Function), which calls Function with its engine as the only argument and returns what it returns.
+ */
+template <typename DerivedType>
+class TApologueRandomApi
+{
+public:
+	/**
+	 * Helper function for rand implementations.
+	 *
+	 * @return A random number in [0..A).
+	 */
+	template <typename T>
+	FORCEINLINE typename TEnableIf<TIsArithmetic<T>::Value && !TIsFloatingPoint<T>::Value, T>::Type
+	RandHelper(const T A) const
+	{
+		return CallWithEngine([A](auto& InEngine) { return FApologueRandom::RandHelper(InEngine, A); });
+	}
+
+	/**
+	 * @return A random floating point value in [Min, Max).
+	 */
+	template <typename T>
+	FORCEINLINE typename TEnableIf<TIsFloatingPoint<T>::Value, T>::Type
+	RandomRange(const T Min, const T Max) const
+	{
+		return CallWithEngine([Min, Max](auto& InEngine) { return FApologueRandom::RandomRange(InEngine, Min, Max); });
+	}
+
+	/**
+	 * @return A random integer value in [Min, Max].
+	 */
+	template <typename T>
+	FORCEINLINE typename TEnableIf<TIsArithmetic<T>::Value && !TIsFloatingPoint<T>::Value, T>::Type
+	RandomRange(const T Min, const T Max) const
+	{
+		return CallWithEngine([Min, Max](auto& InEngine) { return FApologueRandom::RandomRange(InEngine, Min, Max); });
+	}
+
+	/**
+	 * @return Random number in [0.0, 1.0).
+	 */
+	template <typename T>
+	FORCEINLINE typename TEnableIf<TIsFloatingPoint<T>::Value, T>::Type
+	GetFraction() const
+	{
+		return CallWithEngine([](auto& InEngine) { return FApologueRandom::GetFraction<T>(InEngine); });
+	}
+
+	/**
+	 * @return Random unit vector.
+	 */
+	FORCEINLINE FVector GetUnitVector() const
+	{
+		return CallWithEngine([](auto& InEngine) { return FApologueRandom::GetUnitVector(InEngine); });
+	}
+
+	/**
+	 * @return Random point in a 2D unit circle.
+	 */
+	FORCEINLINE FVector2D GetPointInUnitCircle() const
+	{
+		return CallWithEngine([](auto& InEngine) { return FApologueRandom::GetPointInUnitCircle(InEngine); });
+	}
+
+	/**
+	 * @return Random point in a 3D unit sphere.
+	 */
+	FORCEINLINE FVector GetPointInUnitSphere() const
+	{
+		return CallWithEngine([](auto& InEngine) { return FApologueRandom::GetPointInUnitSphere(InEngine); });
+	}
+
+	FORCEINLINE FVector GetPointInBoundingBox(const FVector& Center, const FVector& HalfSize) const
+	{
+		return GetPointInBox(FBox(Center - HalfSize, Center + HalfSize));
+	}
+
+	FORCEINLINE FVector GetPointInBox(const FBox& Box) const
+	{
+		return CallWithEngine([&Box](auto& InEngine) { return FApologueRandom::GetPointInBox(InEngine, Box); });
+	}
+
+	/**
+	 * Returns a random unit vector, uniformly distributed, within the specified cone.
+	 *
+	 * @param Dir The center direction of the cone.
+	 * @param ConeHalfAngleRad Half-angle of cone, in radians.
+	 * @return Normalized vector within the specified cone.
+	 */
+	FORCEINLINE FVector GetCone(const FVector& Dir, const double ConeHalfAngleRad) const
+	{
+		return CallWithEngine([&](auto& InEngine) { return FApologueRandom::GetCone(InEngine, Dir, ConeHalfAngleRad); });
+	}
+
+	/**
+	 * Returns a random unit vector, uniformly distributed, within the specified cone.
+	 *
+	 * @param Dir The center direction of the cone.
+	 * @param HorizontalConeHalfAngleRad Horizontal half-angle of cone, in radians.
+	 * @param VerticalConeHalfAngleRad Vertical half-angle of cone, in radians.
+	 * @return Normalized vector within the specified cone.
+	 */
+	FORCEINLINE FVector GetCone(const FVector& Dir, const double HorizontalConeHalfAngleRad, const double VerticalConeHalfAngleRad) const
+	{
+		return CallWithEngine([&](auto& InEngine)
+		{
+			return FApologueRandom::GetCone(InEngine, Dir, HorizontalConeHalfAngleRad, VerticalConeHalfAngleRad);
+		});
+	}
+
+	template <typename T>
+	typename TEnableIf<TIsArithmetic<T>::Value && !TIsFloatingPoint<T>::Value, bool>::Type
+	RandomFromFraction(const T Numerator, const T Denominator) const
+	{
+		return CallWithEngine([=](auto& InEngine) { return FApologueRandom::RandomFromFraction(InEngine, Numerator, Denominator); });
+	}
+
+	/**
+	 * A version of RandomFromFraction that throws an error if Numerator or Denominator is out of range.
+	 */
+	bool RandomFromFractionChecked(const int32 Numerator, const int32 Denominator) const
+	{
+		check(Numerator >= 0)
+		check(Numerator <= Denominator)
+		check(Denominator > 0)
+
+		return RandomFromFraction(Numerator, Denominator);
+	}
+
+	/**
+	 * Fills Values with random integer values in [Min, Max]. Draws the same values as calling RandomRange for each one.
+	 */
+	template <typename T>
+	typename TEnableIf<TIsIntegral<T>::Value>::Type
+	FillRange(const TArrayView<T> Values, const typename TIdentity<T>::Type Min, const typename TIdentity<T>::Type Max) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillRange(InEngine, Values, Min, Max); });
+	}
+
+	/**
+	 * Fills Values with random floating point values in [Min, Max). Draws the same values as calling RandomRange for each one.
+	 */
+	template <typename T>
+	typename TEnableIf<TIsFloatingPoint<T>::Value>::Type
+	FillRange(const TArrayView<T> Values, const typename TIdentity<T>::Type Min, const typename TIdentity<T>::Type Max) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillRange(InEngine, Values, Min, Max); });
+	}
+
+	/**
+	 * Fills Values with random numbers in [0.0, 1.0).
+	 */
+	template <typename T>
+	typename TEnableIf<TIsFloatingPoint<T>::Value>::Type
+	FillFraction(const TArrayView<T> Values) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillFraction(InEngine, Values); });
+	}
+
+	/**
+	 * Fills Values with random bools, using one engine word for every 64 of them.
+	 */
+	void FillBools(const TArrayView<bool> Values) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillBools(InEngine, Values); });
+	}
+
+	/**
+	 * Fills Values with random unit vectors. Draws the same values as calling GetUnitVector for each one.
+	 */
+	void FillUnitVectors(const TArrayView<FVector> Values) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillUnitVectors(InEngine, Values); });
+	}
+
+	/**
+	 * Fills Values with random points in the unit circle. Draws the same values as calling GetPointInUnitCircle for each one.
+	 */
+	void FillPointsInUnitCircle(const TArrayView<FVector2D> Values) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillPointsInUnitCircle(InEngine, Values); });
+	}
+
+	/**
+	 * Fills Values with random points in the unit sphere. Draws the same values as calling GetPointInUnitSphere for each one.
+	 */
+	void FillPointsInUnitSphere(const TArrayView<FVector> Values) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillPointsInUnitSphere(InEngine, Values); });
+	}
+
+	/**
+	 * Fills Values with random unit vectors within a cone, with its basis computed once for the batch. Draws the same
+	 * values as calling GetCone for each one.
+	 */
+	void FillCone(const TArrayView<FVector> Values, const FVector& Dir, const double ConeHalfAngleRad) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillCone(InEngine, Values, Dir, ConeHalfAngleRad); });
+	}
+
+	/**
+	 * Fills Values with random unit vectors within an elliptical cone, with its basis computed once for the batch.
+	 * Draws the same values as calling GetCone for each one.
+	 */
+	void FillCone(const TArrayView<FVector> Values, const FVector& Dir, const double HorizontalConeHalfAngleRad,
+	              const double VerticalConeHalfAngleRad) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillCone(InEngine, Values, Dir, HorizontalConeHalfAngleRad, VerticalConeHalfAngleRad); });
+	}
+
+	/**
+	 * @return A normally distributed value, from one word in about 99% of draws.
+	 */
+	double GetNormal(const double Mean = 0.0, const double StandardDeviation = 1.0) const
+	{
+		return CallWithEngine([&](auto& InEngine) { return FApologueRandom::GetNormal(InEngine, Mean, StandardDeviation); });
+	}
+
+	/**
+	 * @return An exponentially distributed value with the given rate.
+	 */
+	double GetExponential(const double Rate = 1.0) const
+	{
+		return CallWithEngine([&](auto& InEngine) { return FApologueRandom::GetExponential(InEngine, Rate); });
+	}
+
+	/**
+	 * @return A Poisson distributed count with the given mean.
+	 */
+	int64 GetPoisson(const double Mean) const
+	{
+		return CallWithEngine([&](auto& InEngine) { return FApologueRandom::GetPoisson(InEngine, Mean); });
+	}
+
+	/**
+	 * @return The number of successes in Trials trials of the given probability.
+	 */
+	int32 GetBinomial(const int32 Trials, const double Probability) const
+	{
+		return CallWithEngine([&](auto& InEngine) { return FApologueRandom::GetBinomial(InEngine, Trials, Probability); });
+	}
+
+	/**
+	 * @return The sum of Count dice with Sides faces each.
+	 */
+	int64 RollDice(const int32 Count, const int32 Sides) const
+	{
+		return CallWithEngine([&](auto& InEngine) { return FApologueRandom::RollDice(InEngine, Count, Sides); });
+	}
+
+	/**
+	 * Fills Values with normally distributed values. Draws the same values as calling GetNormal for each one.
+	 */
+	template <typename T>
+	void FillNormal(const TArrayView<T> Values, const double Mean = 0.0, const double StandardDeviation = 1.0) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillNormal(InEngine, Values, Mean, StandardDeviation); });
+	}
+
+	/**
+	 * Fills Values with exponentially distributed values. Draws the same values as calling GetExponential for each one.
+	 */
+	template <typename T>
+	void FillExponential(const TArrayView<T> Values, const double Rate = 1.0) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillExponential(InEngine, Values, Rate); });
+	}
+
+	/**
+	 * Fills Values with Poisson distributed counts, with the constants of the distribution computed once. Draws the
+	 * same values as calling GetPoisson for each one.
+	 */
+	template <typename T>
+	void FillPoisson(const TArrayView<T> Values, const double Mean) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillPoisson(InEngine, Values, Mean); });
+	}
+
+	/**
+	 * Fills Values with binomially distributed counts, with the constants of the distribution computed once. Draws
+	 * the same values as calling GetBinomial for each one.
+	 */
+	template <typename T>
+	void FillBinomial(const TArrayView<T> Values, const int32 Trials, const double Probability) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::FillBinomial(InEngine, Values, Trials, Probability); });
+	}
+
+	// Fisher-Yates
+	template <typename T>
+	void Shuffle(T& List, const typename T::SizeType StartIndex = 0, const typename T::SizeType EndIndex = INDEX_NONE) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::Shuffle(InEngine, List, StartIndex, EndIndex); });
+	}
+
+	/**
+	 * Moves a uniformly random sample of Count elements, in random order, to the front of List in O(Count).
+	 */
+	template <typename T>
+	void PartialShuffle(T& List, const typename T::SizeType Count) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::PartialShuffle(InEngine, List, Count); });
+	}
+
+	/**
+	 * Picks Count distinct indices in [0, Num) in random order, in O(Count).
+	 */
+	void SampleIndices(const int32 Num, const int32 Count, TArray<int32>& OutIndices) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::SampleIndices(InEngine, Num, Count, OutIndices); });
+	}
+
+	/**
+	 * The swaps of a Fisher-Yates shuffle of Num elements of any container, stopping once the first Count positions
+	 * are final. Calls Swap(IndexA, IndexB) for every swap that moves an element.
+	 */
+	template <typename SwapFunctionType>
+	void ShuffleSwaps(const int32 Num, const int32 Count, SwapFunctionType&& Swap) const
+	{
+		CallWithEngine([&](auto& InEngine) { FApologueRandom::ShuffleSwaps(InEngine, 0, Num, Count, Swap); });
+	}
+
+private:
+	template <typename FunctionType>
+	FORCEINLINE decltype(auto) CallWithEngine(FunctionType&& Function) const
+	{
+		return static_cast<const DerivedType*>(this)->VisitEngine(Forward<FunctionType>(Function));
+	}
+};
@@ -0,0 +1,799 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+#if PLATFORM_ALWAYS_HAS_AVX_2
+#include <immintrin.h>
+#endif
+
+struct FApologueRandomMath
+{
+	/**
+	 * Full 64x64 -> 128 bit multiplication.
+	 *
+	 * @return The low 64 bits of the product; the high 64 bits are written to OutHigh.
+	 */
+	static FORCEINLINE uint64 MultiplyFull(const uint64 A, const uint64 B, uint64& OutHigh)
+	{
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 Product = static_cast<unsigned __int128>(A) * B;
+		OutHigh = static_cast<uint64>(Product >> 64);
+		return static_cast<uint64>(Product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long long High;
+		const uint64 Low = _umul128(A, B, &High);
+		OutHigh = High;
+		return Low;
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+		OutHigh = __umulh(A, B);
+		return A * B;
+#else
+		const uint64 ALow = static_cast<uint32>(A), AHigh = A >> 32;
+		const uint64 BLow = static_cast<uint32>(B), BHigh = B >> 32;
+
+		const uint64 LowLow = ALow * BLow;
+		const uint64 LowHigh = ALow * BHigh;
+		const uint64 HighLow = AHigh * BLow;
+		const uint64 Middle = (LowLow >> 32) + static_cast<uint32>(LowHigh) + static_cast<uint32>(HighLow);
+
+		OutHigh = AHigh * BHigh + (LowHigh >> 32) + (HighLow >> 32) + (Middle >> 32);
+		return (Middle << 32) | static_cast<uint32>(LowLow);
+#endif
+	}
+
+	static FORCEINLINE uint64 RotateLeft(const uint64 Value, const int32 Shift)
+	{
+		return (Value << Shift) | (Value >> ((64 - Shift) & 63));
+	}
+
+	static FORCEINLINE uint64 RotateRight(const uint64 Value, const int32 Shift)
+	{
+		return (Value >> Shift) | (Value << ((64 - Shift) & 63));
+	}
+
+	/**
+	 * SplitMix64, used to expand a single seed into the state of the larger engines.
+	 */
+	static FORCEINLINE uint64 SplitMix64(uint64& InOutState)
+	{
+		uint64 Value = (InOutState += 0x9E3779B97F4A7C15ull);
+		Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+		return Value ^ (Value >> 31);
+	}
+};
+
+/**
+ * Shared plumbing of the small-state engines: four words of state, the UniformRandomBitGenerator interface and raw
+ * serialization. DerivedType provides Seed(uint64), Next() and IsValidState().
+ */
+template <typename DerivedType>
+class TApologueRandomEngineBase
+{
+public:
+	typedef uint64 result_type;
+
+	static constexpr int32 StateSize = 4;
+
+protected:
+	uint64 State[StateSize] = {};
+
+public:
+	FORCEINLINE TConstArrayView<uint64> GetState() const
+	{
+		return MakeArrayView(State, StateSize);
+	}
+
+	/**
+	 * @return False, leaving the engine untouched, if InState is not a state the engine can be in.
+	 */
+	bool SetState(const TConstArrayView<uint64> InState)
+	{
+		if (InState.Num() != StateSize)
+		{
+			return false;
+		}
+
+		DerivedType Engine;
+		FMemory::Memcpy(Engine.State, InState.GetData(), sizeof(State));
+		if (!Engine.IsValidState())
+		{
+			return false;
+		}
+
+		FMemory::Memcpy(State, InState.GetData(), sizeof(State));
+		return true;
+	}
+
+	// UniformRandomBitGenerator
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return MAX_uint64; }
+	FORCEINLINE result_type operator()() { return static_cast<DerivedType*>(this)->Next(); }
+
+	friend bool operator==(const DerivedType& A, const DerivedType& B)
+	{
+		return FMemory::Memcmp(A.State, B.State, sizeof(State)) == 0;
+	}
+
+	friend bool operator!=(const DerivedType& A, const DerivedType& B)
+	{
+		return !(A == B);
+	}
+
+	// Serialization of the raw state
+	friend FArchive& operator<<(FArchive& Ar, DerivedType& Engine)
+	{
+		for (int32 I = 0; I < StateSize; ++I)
+		{
+			Ar << Engine.State[I];
+		}
+
+		if (Ar.IsLoading() && !Engine.IsValidState())
+		{
+			Ar.SetError();
+			Engine.Seed(DerivedType::DefaultSeed);
+		}
+
+		return Ar;
+	}
+};
+
+/**
+ * xoshiro256** by Blackman and Vigna. 32 bytes of state, period 2^256 - 1.
+ */
+class FApologueXoshiro256StarStarEngine : public TApologueRandomEngineBase<FApologueXoshiro256StarStarEngine>
+{
+public:
+	static constexpr uint64 DefaultSeed = 0;
+
+	FApologueXoshiro256StarStarEngine()
+	{
+		Seed(DefaultSeed);
+	}
+
+	explicit FApologueXoshiro256StarStarEngine(const uint64 InSeed)
+	{
+		Seed(InSeed);
+	}
+
+	void Seed(uint64 InSeed)
+	{
+		for (int32 I = 0; I < StateSize; ++I)
+		{
+			State[I] = FApologueRandomMath::SplitMix64(InSeed);
+		}
+	}
+
+	FORCEINLINE uint64 Next()
+	{
+		const uint64 Result = FApologueRandomMath::RotateLeft(State[1] * 5, 7) * 9;
+		const uint64 Shifted = State[1] << 17;
+
+		State[2] ^= State[0];
+		State[3] ^= State[1];
+		State[1] ^= State[2];
+		State[0] ^= State[3];
+		State[2] ^= Shifted;
+		State[3] = FApologueRandomMath::RotateLeft(State[3], 45);
+
+		return Result;
+	}
+
+	/**
+	 * Advances the engine by 2^128 words. Jumping repeatedly from one seed gives up to 2^128 non-overlapping
+	 * substreams.
+	 */
+	void Jump()
+	{
+		static constexpr uint64 JumpPolynomial[StateSize] =
+		{
+			0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+		};
+
+		JumpBy(JumpPolynomial);
+	}
+
+	/**
+	 * Advances the engine by 2^192 words, to separate groups of Jump() substreams.
+	 */
+	void LongJump()
+	{
+		static constexpr uint64 JumpPolynomial[StateSize] =
+		{
+			0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull
+		};
+
+		JumpBy(JumpPolynomial);
+	}
+
+	bool IsValidState() const
+	{
+		return (State[0] | State[1] | State[2] | State[3]) != 0;
+	}
+
+private:
+	/**
+	 * Replaces the state with Polynomial(Next) applied to it; bit I of Polynomial is the coefficient of x^I.
+	 */
+	void JumpBy(const uint64 (&Polynomial)[StateSize])
+	{
+		uint64 Accumulator[StateSize] = {};
+		for (const uint64 Word : Polynomial)
+		{
+			for (int32 Bit = 0; Bit < 64; ++Bit)
+			{
+				if (Word & (1ull << Bit))
+				{
+					for (int32 I = 0; I < StateSize; ++I)
+					{
+						Accumulator[I] ^= State[I];
+					}
+				}
+
+				Next();
+			}
+		}
+
+		FMemory::Memcpy(State, Accumulator, sizeof(State));
+	}
+};
+
+/**
+ * PCG64 (PCG XSL RR 128/64) by O'Neill: a 128-bit LCG with a permuted output. 32 bytes of state, period 2^128.
+ *
+ * State holds the LCG state and increment as {StateHigh, StateLow, IncrementHigh, IncrementLow}.
+ */
+class FApologuePCG64Engine : public TApologueRandomEngineBase<FApologuePCG64Engine>
+{
+	static constexpr uint64 MultiplierHigh = 0x2360ED051FC65DA4ull;
+	static constexpr uint64 MultiplierLow = 0x4385DF649FCCF645ull;
+
+public:
+	static constexpr uint64 DefaultSeed = 0;
+
+	FApologuePCG64Engine()
+	{
+		Seed(DefaultSeed);
+	}
+
+	explicit FApologuePCG64Engine(const uint64 InSeed)
+	{
+		Seed(InSeed);
+	}
+
+	void Seed(uint64 InSeed)
+	{
+		const uint64 InitStateHigh = FApologueRandomMath::SplitMix64(InSeed);
+		const uint64 InitStateLow = FApologueRandomMath::SplitMix64(InSeed);
+		const uint64 SequenceHigh = FApologueRandomMath::SplitMix64(InSeed);
+		const uint64 SequenceLow = FApologueRandomMath::SplitMix64(InSeed);
+
+		// pcg_setseq_128_srandom_r
+		State[0] = 0;
+		State[1] = 0;
+		State[2] = (SequenceHigh << 1) | (SequenceLow >> 63);
+		State[3] = (SequenceLow << 1) | 1;
+
+		Step();
+		Add128(State[0], State[1], InitStateHigh, InitStateLow);
+		Step();
+	}
+
+	FORCEINLINE uint64 Next()
+	{
+		Step();
+		return FApologueRandomMath::RotateRight(State[0] ^ State[1], static_cast<int32>(State[0] >> 58));
+	}
+
+	/**
+	 * Advances the engine as if (DeltaHigh * 2^64 + DeltaLow) words had been drawn, in O(log Delta) steps.
+	 */
+	void Advance(uint64 DeltaHigh, uint64 DeltaLow)
+	{
+		// Brown, "Random Number Generation with Arbitrary Strides": accumulates Multiplier^Delta and the matching
+		// increment by repeated squaring
+		uint64 AccMultiplierHigh = 0, AccMultiplierLow = 1;
+		uint64 AccIncrementHigh = 0, AccIncrementLow = 0;
+		uint64 CurMultiplierHigh = MultiplierHigh, CurMultiplierLow = MultiplierLow;
+		uint64 CurIncrementHigh = State[2], CurIncrementLow = State[3];
+
+		while (DeltaHigh | DeltaLow)
+		{
+			if (DeltaLow & 1)
+			{
+				Multiply128(AccMultiplierHigh, AccMultiplierLow, CurMultiplierHigh, CurMultiplierLow);
+				Multiply128(AccIncrementHigh, AccIncrementLow, CurMultiplierHigh, CurMultiplierLow);
+				Add128(AccIncrementHigh, AccIncrementLow, CurIncrementHigh, CurIncrementLow);
+			}
+
+			uint64 FactorHigh = CurMultiplierHigh, FactorLow = CurMultiplierLow;
+			Add128(FactorHigh, FactorLow, 0, 1);
+			Multiply128(CurIncrementHigh, CurIncrementLow, FactorHigh, FactorLow);
+			Multiply128(CurMultiplierHigh, CurMultiplierLow, CurMultiplierHigh, CurMultiplierLow);
+
+			DeltaLow = (DeltaLow >> 1) | (DeltaHigh << 63);
+			DeltaHigh >>= 1;
+		}
+
+		Multiply128(State[0], State[1], AccMultiplierHigh, AccMultiplierLow);
+		Add128(State[0], State[1], AccIncrementHigh, AccIncrementLow);
+	}
+
+	void Advance(const uint64 Delta)
+	{
+		Advance(0, Delta);
+	}
+
+	/**
+	 * Advances the engine by 2^64 words. Jumping repeatedly from one seed gives up to 2^64 non-overlapping
+	 * substreams.
+	 */
+	void Jump()
+	{
+		Advance(1, 0);
+	}
+
+	bool IsValidState() const
+	{
+		return (State[3] & 1) != 0;
+	}
+
+private:
+	static FORCEINLINE void Add128(uint64& InOutHigh, uint64& InOutLow, const uint64 High, const uint64 Low)
+	{
+		const uint64 SumLow = InOutLow + Low;
+		InOutHigh += High + (SumLow < InOutLow ? 1 : 0);
+		InOutLow = SumLow;
+	}
+
+	// InOut = InOut * Factor, modulo 2^128
+	static FORCEINLINE void Multiply128(uint64& InOutHigh, uint64& InOutLow, const uint64 FactorHigh, const uint64 FactorLow)
+	{
+		uint64 High;
+		const uint64 Low = FApologueRandomMath::MultiplyFull(InOutLow, FactorLow, High);
+		High += InOutHigh * FactorLow + InOutLow * FactorHigh;
+
+		InOutHigh = High;
+		InOutLow = Low;
+	}
+
+	FORCEINLINE void Step()
+	{
+		// State = State * Multiplier + Increment, modulo 2^128
+		Multiply128(State[0], State[1], MultiplierHigh, MultiplierLow);
+		Add128(State[0], State[1], State[2], State[3]);
+	}
+};
+
+/**
+ * SFC64 (Small Fast Chaotic) by Doty-Humphrey. 32 bytes of state including a counter that guarantees a period of
+ * at least 2^64.
+ *
+ * State holds {A, B, C, Counter}.
+ */
+class FApologueSFC64Engine : public TApologueRandomEngineBase<FApologueSFC64Engine>
+{
+public:
+	static constexpr uint64 DefaultSeed = 0;
+
+	FApologueSFC64Engine()
+	{
+		Seed(DefaultSeed);
+	}
+
+	explicit FApologueSFC64Engine(const uint64 InSeed)
+	{
+		Seed(InSeed);
+	}
+
+	void Seed(uint64 InSeed)
+	{
+		State[0] = FApologueRandomMath::SplitMix64(InSeed);
+		State[1] = FApologueRandomMath::SplitMix64(InSeed);
+		State[2] = FApologueRandomMath::SplitMix64(InSeed);
+		State[3] = 1;
+
+		for (int32 I = 0; I < 12; ++I)
+		{
+			Next();
+		}
+	}
+
+	FORCEINLINE uint64 Next()
+	{
+		const uint64 Result = State[0] + State[1] + State[3]++;
+
+		State[0] = State[1] ^ (State[1] >> 11);
+		State[1] = State[2] + (State[2] << 3);
+		State[2] = FApologueRandomMath::RotateLeft(State[2], 24) + Result;
+
+		return Result;
+	}
+
+	bool IsValidState() const
+	{
+		return true;
+	}
+};
+
+/**
+ * Philox4x32-10 by Salmon et al.: a counter-based generator. Every 128-bit output block is a pure function of a 64-bit
+ * key and a 128-bit counter, so any block can be computed directly, in any order and on any thread, without storing
+ * state.
+ *
+ * As an engine it outputs the blocks of consecutive counters starting from the one it was given, two words per block.
+ */
+class FApologuePhiloxEngine
+{
+public:
+	typedef uint64 result_type;
+
+	static constexpr int32 WordsPerBlock = 2;
+	static constexpr uint64 DefaultSeed = 0;
+
+private:
+	static constexpr uint32 Multiplier0 = 0xD2511F53;
+	static constexpr uint32 Multiplier1 = 0xCD9E8D57;
+	static constexpr uint32 KeyIncrement0 = 0x9E3779B9;
+	static constexpr uint32 KeyIncrement1 = 0xBB67AE85;
+	static constexpr int32 NumRounds = 10;
+
+	uint64 Key = 0;
+
+	// Counter of the next block to generate
+	uint64 CounterHigh = 0;
+	uint64 CounterLow = 0;
+
+	// Output of the last block; words before BlockIndex have been drawn
+	uint64 Block[WordsPerBlock] = {};
+
+	int32 BlockIndex = WordsPerBlock;
+
+public:
+	FApologuePhiloxEngine() = default;
+
+	explicit FApologuePhiloxEngine(const uint64 InKey, const uint64 InCounterHigh = 0, const uint64 InCounterLow = 0)
+		: Key(InKey)
+		, CounterHigh(InCounterHigh)
+		, CounterLow(InCounterLow)
+	{
+	}
+
+	/**
+	 * Computes the block for Key and Counter. Word 0 holds counter and output lanes 0 and 1, word 1 lanes 2 and 3.
+	 */
+	static FORCEINLINE void Generate(const uint64 InKey, const uint64 InCounterHigh, const uint64 InCounterLow, uint64* Out)
+	{
+		uint32 Key0 = static_cast<uint32>(InKey);
+		uint32 Key1 = static_cast<uint32>(InKey >> 32);
+
+		uint32 Lane0 = static_cast<uint32>(InCounterLow);
+		uint32 Lane1 = static_cast<uint32>(InCounterLow >> 32);
+		uint32 Lane2 = static_cast<uint32>(InCounterHigh);
+		uint32 Lane3 = static_cast<uint32>(InCounterHigh >> 32);
+
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			const uint64 Product0 = static_cast<uint64>(Multiplier0) * Lane0;
+			const uint64 Product1 = static_cast<uint64>(Multiplier1) * Lane2;
+
+			Lane0 = static_cast<uint32>(Product1 >> 32) ^ Lane1 ^ Key0;
+			Lane1 = static_cast<uint32>(Product1);
+			Lane2 = static_cast<uint32>(Product0 >> 32) ^ Lane3 ^ Key1;
+			Lane3 = static_cast<uint32>(Product0);
+
+			Key0 += KeyIncrement0;
+			Key1 += KeyIncrement1;
+		}
+
+		Out[0] = (static_cast<uint64>(Lane1) << 32) | Lane0;
+		Out[1] = (static_cast<uint64>(Lane3) << 32) | Lane2;
+	}
+
+	void Seed(const uint64 InKey)
+	{
+		Key = InKey;
+		SetCounter(0, 0);
+	}
+
+	/**
+	 * Continues from the block of the given counter.
+	 */
+	void SetCounter(const uint64 InCounterHigh, const uint64 InCounterLow)
+	{
+		CounterHigh = InCounterHigh;
+		CounterLow = InCounterLow;
+		BlockIndex = WordsPerBlock;
+	}
+
+	FORCEINLINE uint64 GetKey() const
+	{
+		return Key;
+	}
+
+	FORCEINLINE uint64 Next()
+	{
+		if (BlockIndex == WordsPerBlock)
+		{
+			Generate(Key, CounterHigh, CounterLow, Block);
+			AdvanceCounter(1);
+			BlockIndex = 0;
+		}
+
+		return Block[BlockIndex++];
+	}
+
+	/**
+	 * Same as calling Next() for every word, but generates straight into Words where possible.
+	 */
+	void Fill(const TArrayView<uint64> Words)
+	{
+		const int32 Num = Words.Num();
+		int32 Index = 0;
+
+		while (Index < Num && BlockIndex < WordsPerBlock)
+		{
+			Words[Index++] = Block[BlockIndex++];
+		}
+
+		for (; Index + WordsPerBlock <= Num; Index += WordsPerBlock)
+		{
+			Generate(Key, CounterHigh, CounterLow, Words.GetData() + Index);
+			AdvanceCounter(1);
+		}
+
+		while (Index < Num)
+		{
+			Words[Index++] = Next();
+		}
+	}
+
+	/**
+	 * Advances the engine as if Count words had been drawn, in constant time.
+	 */
+	void Discard(uint64 Count)
+	{
+		while (Count > 0 && BlockIndex < WordsPerBlock)
+		{
+			++BlockIndex;
+			--Count;
+		}
+
+		AdvanceCounter(Count / WordsPerBlock);
+		if (Count % WordsPerBlock != 0)
+		{
+			Next();
+		}
+	}
+
+	// UniformRandomBitGenerator
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return MAX_uint64; }
+	FORCEINLINE result_type operator()() { return Next(); }
+
+private:
+	FORCEINLINE void AdvanceCounter(const uint64 Blocks)
+	{
+		CounterLow += Blocks;
+		CounterHigh += CounterLow < Blocks ? 1 : 0;
+	}
+};
+
+/**
+ * Four xoshiro256** generators advanced together, producing four words per step for bulk generation. Steps use AVX2
+ * when the target always has it and an equivalent scalar loop otherwise, so the output is the same on every CPU.
+ *
+ * Words are output in lane order, one step at a time. Lane 0 is seeded like FApologueXoshiro256StarStarEngine, so every
+ * fourth word matches that engine for the same seed.
+ */
+class FApologueXoshiro256StarStarX4Engine
+{
+public:
+	typedef uint64 result_type;
+
+	static constexpr int32 NumLanes = 4;
+	static constexpr uint64 DefaultSeed = 0;
+
+private:
+	// State[Word][Lane]
+	alignas(32) uint64 State[4][NumLanes];
+
+	// Output of the last step; words before BlockIndex have been drawn
+	alignas(32) uint64 Block[NumLanes];
+
+	int32 BlockIndex = NumLanes;
+
+public:
+	FApologueXoshiro256StarStarX4Engine()
+	{
+		Seed(DefaultSeed);
+	}
+
+	explicit FApologueXoshiro256StarStarX4Engine(const uint64 InSeed)
+	{
+		Seed(InSeed);
+	}
+
+	void Seed(uint64 InSeed)
+	{
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			for (int32 Word = 0; Word < 4; ++Word)
+			{
+				State[Word][Lane] = FApologueRandomMath::SplitMix64(InSeed);
+			}
+		}
+
+		FMemory::Memzero(Block, sizeof(Block));
+		BlockIndex = NumLanes;
+	}
+
+	FORCEINLINE uint64 Next()
+	{
+		if (BlockIndex == NumLanes)
+		{
+			Step(Block);
+			BlockIndex = 0;
+		}
+
+		return Block[BlockIndex++];
+	}
+
+	/**
+	 * Advances every lane by 2^128 steps, dropping any words left from the last step.
+	 */
+	void Jump()
+	{
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			FApologueXoshiro256StarStarEngine LaneEngine;
+			const uint64 LaneState[4] = { State[0][Lane], State[1][Lane], State[2][Lane], State[3][Lane] };
+			verify(LaneEngine.SetState(LaneState));
+
+			LaneEngine.Jump();
+
+			for (int32 Word = 0; Word < 4; ++Word)
+			{
+				State[Word][Lane] = LaneEngine.GetState()[Word];
+			}
+		}
+
+		BlockIndex = NumLanes;
+	}
+
+	/**
+	 * Same as calling Next() for every word, but steps straight into Words where possible.
+	 */
+	void Fill(const TArrayView<uint64> Words)
+	{
+		const int32 Num = Words.Num();
+		int32 Index = 0;
+
+		while (Index < Num && BlockIndex < NumLanes)
+		{
+			Words[Index++] = Block[BlockIndex++];
+		}
+
+		for (; Index + NumLanes <= Num; Index += NumLanes)
+		{
+			Step(Words.GetData() + Index);
+		}
+
+		while (Index < Num)
+		{
+			Words[Index++] = Next();
+		}
+	}
+
+	bool IsValidState() const
+	{
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			if ((State[0][Lane] | State[1][Lane] | State[2][Lane] | State[3][Lane]) == 0)
+			{
+				return false;
+			}
+		}
+
+		return BlockIndex >= 0 && BlockIndex <= NumLanes;
+	}
+
+	// UniformRandomBitGenerator
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return MAX_uint64; }
+	FORCEINLINE result_type operator()() { return Next(); }
+
+	friend bool operator==(const FApologueXoshiro256StarStarX4Engine& A, const FApologueXoshiro256StarStarX4Engine& B)
+	{
+		return A.BlockIndex == B.BlockIndex
+			&& FMemory::Memcmp(A.State, B.State, sizeof(State)) == 0
+			&& FMemory::Memcmp(A.Block, B.Block, sizeof(Block)) == 0;
+	}
+
+	friend bool operator!=(const FApologueXoshiro256StarStarX4Engine& A, const FApologueXoshiro256StarStarX4Engine& B)
+	{
+		return !(A == B);
+	}
+
+	// Serialization of the raw state
+	friend FArchive& operator<<(FArchive& Ar, FApologueXoshiro256StarStarX4Engine& Engine)
+	{
+		for (int32 Word = 0; Word < 4; ++Word)
+		{
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				Ar << Engine.State[Word][Lane];
+			}
+		}
+
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			Ar << Engine.Block[Lane];
+		}
+
+		Ar << Engine.BlockIndex;
+
+		if (Ar.IsLoading() && !Engine.IsValidState())
+		{
+			Ar.SetError();
+			Engine.Seed(DefaultSeed);
+		}
+
+		return Ar;
+	}
+
+private:
+	/**
+	 * Advances every lane once and writes their outputs to Out[0..NumLanes).
+	 */
+	FORCEINLINE void Step(uint64* Out)
+	{
+#if PLATFORM_ALWAYS_HAS_AVX_2
+		__m256i S0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(State[0]));
+		__m256i S1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(State[1]));
+		__m256i S2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(State[2]));
+		__m256i S3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(State[3]));
+
+		// rotl(S1 * 5, 7) * 9, without 64-bit multiplies
+		const __m256i Times5 = _mm256_add_epi64(_mm256_slli_epi64(S1, 2), S1);
+		const __m256i Rotated = _mm256_or_si256(_mm256_slli_epi64(Times5, 7), _mm256_srli_epi64(Times5, 57));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(Out), _mm256_add_epi64(_mm256_slli_epi64(Rotated, 3), Rotated));
+
+		const __m256i Shifted = _mm256_slli_epi64(S1, 17);
+		S2 = _mm256_xor_si256(S2, S0);
+		S3 = _mm256_xor_si256(S3, S1);
+		S1 = _mm256_xor_si256(S1, S2);
+		S0 = _mm256_xor_si256(S0, S3);
+		S2 = _mm256_xor_si256(S2, Shifted);
+		S3 = _mm256_or_si256(_mm256_slli_epi64(S3, 45), _mm256_srli_epi64(S3, 19));
+
+		_mm256_store_si256(reinterpret_cast<__m256i*>(State[0]), S0);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(State[1]), S1);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(State[2]), S2);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(State[3]), S3);
+#else
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			Out[Lane] = FApologueRandomMath::RotateLeft(State[1][Lane] * 5, 7) * 9;
+		}
+
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			const uint64 Shifted = State[1][Lane] << 17;
+
+			State[2][Lane] ^= State[0][Lane];
+			State[3][Lane] ^= State[1][Lane];
+			State[1][Lane] ^= State[2][Lane];
+			State[0][Lane] ^= State[3][Lane];
+			State[2][Lane] ^= Shifted;
+			State[3][Lane] = FApologueRandomMath::RotateLeft(State[3][Lane], 45);
+		}
+#endif
+	}
+};
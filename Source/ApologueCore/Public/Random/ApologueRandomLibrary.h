@@ -0,0 +1,250 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/BlueprintExceptionInfo.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "ApologueRandomLibrary.generated.h"
+
+const FName RandomAccessToEmptyArrayWarning = FName("RandomAccessToEmptyArrayWarning");
+
+/**
+ * Helpers shared by the Blueprint libraries of the random stream types. StreamType is any TApologueRandomApi with an
+ * IsInitialized() method.
+ *
+ * UFUNCTIONs cannot be templates, so each library declares its own nodes and forwards them to the Generic helpers,
+ * which hold the argument checks for all of them.
+ */
+UCLASS(Abstract)
+class APOLOGUECORE_API UApologueRandomLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+protected:
+	template <typename StreamType>
+	static bool EnsureInitialized(const StreamType& Stream)
+	{
+		if (Stream.IsInitialized())
+		{
+			return true;
+		}
+
+		ThrowBlueprintException();
+		return false;
+	}
+
+	static void ThrowBlueprintException()
+	{
+		const UObject* ActiveObject = nullptr;
+		const FBlueprintExceptionInfo Info(EBlueprintExceptionType::NonFatalError);
+		FFrame& StackFrame = *(FBlueprintContextTracker::Get().GetCurrentScriptStackWritable().Last());
+		FBlueprintCoreDelegates::ThrowScriptException(ActiveObject, StackFrame, Info);
+	}
+
+	template <typename StreamType>
+	static bool GenericRandBool(const StreamType& Stream)
+	{
+		return EnsureInitialized(Stream) && Stream.RandHelper(2) == 1;
+	}
+
+	template <typename StreamType, typename T>
+	static T GenericRandRange(const StreamType& Stream, const T Min, const T Max)
+	{
+		return EnsureInitialized(Stream) ? Stream.RandomRange(Min, Max) : T(0);
+	}
+
+	template <typename StreamType>
+	static TArray<int32> GenericSampleIndices(const StreamType& Stream, const int32 Num, const int32 Count)
+	{
+		TArray<int32> Indices;
+		if (!EnsureInitialized(Stream))
+		{
+			return Indices;
+		}
+
+		if (Num < 0 || Count < 0 || Count > Num)
+		{
+			ThrowBlueprintException();
+			return Indices;
+		}
+
+		Stream.SampleIndices(Num, Count, Indices);
+		return Indices;
+	}
+
+	template <typename StreamType>
+	static double GenericRandomFraction(const StreamType& Stream)
+	{
+		return EnsureInitialized(Stream) ? Stream.template GetFraction<double>() : 0.0;
+	}
+
+	template <typename StreamType>
+	static double GenericRandomNormal(const StreamType& Stream, const double Mean, const double StandardDeviation)
+	{
+		return EnsureInitialized(Stream) ? Stream.GetNormal(Mean, StandardDeviation) : 0.0;
+	}
+
+	template <typename StreamType>
+	static double GenericRandomExponential(const StreamType& Stream, const double Rate)
+	{
+		if (!EnsureInitialized(Stream))
+		{
+			return 0.0;
+		}
+
+		if (Rate <= 0.0)
+		{
+			ThrowBlueprintException();
+			return 0.0;
+		}
+
+		return Stream.GetExponential(Rate);
+	}
+
+	template <typename StreamType>
+	static int64 GenericRandomPoisson(const StreamType& Stream, const double Mean)
+	{
+		if (!EnsureInitialized(Stream))
+		{
+			return 0;
+		}
+
+		if (Mean < 0.0)
+		{
+			ThrowBlueprintException();
+			return 0;
+		}
+
+		return Stream.GetPoisson(Mean);
+	}
+
+	template <typename StreamType>
+	static int32 GenericRandomBinomial(const StreamType& Stream, const int32 Trials, const double Probability)
+	{
+		if (!EnsureInitialized(Stream))
+		{
+			return 0;
+		}
+
+		if (Trials < 0)
+		{
+			ThrowBlueprintException();
+			return 0;
+		}
+
+		return Stream.GetBinomial(Trials, Probability);
+	}
+
+	template <typename StreamType>
+	static FVector GenericRandomUnitVector(const StreamType& Stream)
+	{
+		return EnsureInitialized(Stream) ? Stream.GetUnitVector() : FVector::ZeroVector;
+	}
+
+	template <typename StreamType>
+	static FVector2D GenericRandomPointInUnitCircle(const StreamType& Stream)
+	{
+		return EnsureInitialized(Stream) ? Stream.GetPointInUnitCircle() : FVector2D::ZeroVector;
+	}
+
+	template <typename StreamType>
+	static FVector GenericRandomPointInUnitSphere(const StreamType& Stream)
+	{
+		return EnsureInitialized(Stream) ? Stream.GetPointInUnitSphere() : FVector::ZeroVector;
+	}
+
+	template <typename StreamType>
+	static FVector GenericRandomPointInBoundingBox(const StreamType& Stream, const FVector& Center, const FVector& HalfSize)
+	{
+		return EnsureInitialized(Stream) ? Stream.GetPointInBoundingBox(Center, HalfSize) : FVector::ZeroVector;
+	}
+
+	template <typename StreamType>
+	static FVector GenericRandomPointInBox(const StreamType& Stream, const FBox& Box)
+	{
+		return EnsureInitialized(Stream) ? Stream.GetPointInBox(Box) : FVector::ZeroVector;
+	}
+
+	/**
+	 * Takes the half-angles in degrees, as the Blueprint nodes do.
+	 */
+	template <typename StreamType>
+	static FVector GenericRandomCone(const StreamType& Stream, const FVector& Direction, const double HalfAngle)
+	{
+		return EnsureInitialized(Stream) ? Stream.GetCone(Direction, FMath::DegreesToRadians(HalfAngle)) : FVector::ZeroVector;
+	}
+
+	template <typename StreamType>
+	static FVector GenericRandomCone(const StreamType& Stream, const FVector& Direction, const double HalfAngle, const double VerticalHalfAngle)
+	{
+		if (EnsureInitialized(Stream))
+		{
+			return Stream.GetCone(Direction, FMath::DegreesToRadians(HalfAngle), FMath::DegreesToRadians(VerticalHalfAngle));
+		}
+
+		return FVector::ZeroVector;
+	}
+
+	template <typename StreamType, typename T>
+	static T GenericRandomFromFraction(const StreamType& Stream, const T Numerator, const T Denominator)
+	{
+		return EnsureInitialized(Stream) ? Stream.RandomFromFraction(Numerator, Denominator) : T(0);
+	}
+
+	template <typename StreamType>
+	// ReSharper disable CppParameterMayBeConstPtrOrRef
+	static FORCEINLINE void GenericRandArray(void* TargetArray, const FArrayProperty* ArrayProperty, StreamType* Stream, void* OutElement, int32* OutIndex)
+	// ReSharper restore CppParameterMayBeConstPtrOrRef
+	{
+		*OutIndex = INDEX_NONE;
+		if (!TargetArray || !Stream)
+		{
+			return;
+		}
+
+		FScriptArrayHelper ArrayHelper(ArrayProperty, TargetArray);
+		const FProperty* InnerProp = ArrayProperty->Inner;
+
+		if (ArrayHelper.Num() > 0)
+		{
+			const int32 Index = Stream->RandHelper(ArrayHelper.Num());
+
+			InnerProp->CopySingleValueToScriptVM(OutElement, ArrayHelper.GetRawPtr(Index));
+			*OutIndex = Index;
+			return;
+		}
+
+		FFrame::KismetExecutionMessage(*FString::Printf(TEXT("Attempted to access random index from empty array!")), ELogVerbosity::Warning, RandomAccessToEmptyArrayWarning);
+		InnerProp->ClearValue(OutElement);
+	}
+
+	/**
+	 * Shuffles the array in place, stopping once its first Count elements are a random sample. Swaps elements through
+	 * raw memory, as FScriptArrayHelper::SwapValues would, without its per-swap checks.
+	 */
+	template <typename StreamType>
+	// ReSharper disable CppParameterMayBeConstPtrOrRef
+	static FORCEINLINE void GenericShuffleArray(void* TargetArray, const FArrayProperty* ArrayProperty, StreamType* Stream, const int32 Count = MAX_int32)
+	// ReSharper restore CppParameterMayBeConstPtrOrRef
+	{
+		if (!TargetArray || !Stream)
+		{
+			return;
+		}
+
+		FScriptArrayHelper ArrayHelper(ArrayProperty, TargetArray);
+		const int32 Num = ArrayHelper.Num();
+		if (Num < 2)
+		{
+			return;
+		}
+
+		uint8* Data = ArrayHelper.GetRawPtr(0);
+		const int32 ElementSize = ArrayProperty->Inner->GetSize();
+		Stream->ShuffleSwaps(Num, FMath::Clamp(Count, 0, Num), [Data, ElementSize](const int64 IndexA, const int64 IndexB)
+		{
+			FMemory::Memswap(Data + IndexA * ElementSize, Data + IndexB * ElementSize, ElementSize);
+		});
+	}
+};
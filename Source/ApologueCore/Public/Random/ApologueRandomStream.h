@@ -0,0 +1,807 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueCoreCustomVersion.h"
+#include "ApologueRandom.h"
+#include "ApologueRandomApi.h"
+#include "ApologueRandomEngines.h"
+#include "ApologueRandomLibrary.h"
+#include "Misc/TVariant.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "ApologueRandomStream.generated.h"
+
+UENUM(BlueprintType)
+enum class EApologueRandomEngine : uint8
+{
+	// Fastest general purpose engine
+	Xoshiro256StarStar UMETA(DisplayName="xoshiro256**"),
+
+	// 128-bit LCG with a permuted output; slower than xoshiro256** but more robust to weak seeds
+	PCG64 UMETA(DisplayName="PCG64"),
+
+	// Chaotic engine with a counter that guarantees a minimum period for every seed
+	SFC64 UMETA(DisplayName="SFC64"),
+
+	MAX UMETA(Hidden)
+};
+
+
+/**
+ * Random stream with the same interface as FMersenneTwister on top of a small-state engine chosen per use site.
+ *
+ * Every engine keeps 32 bytes of state instead of the twister's 2.5 KB, so it is the better fit for structs that are
+ * instanced many times, such as per-entity streams.
+ */
+USTRUCT(BlueprintType, meta=(DisableSplitPin))
+struct APOLOGUECORE_API FApologueRandomStream
+	// Hidden from UHT, which only accepts USTRUCT bases
+#if CPP
+	: public TApologueRandomApi<FApologueRandomStream>
+#endif
+{
+	GENERATED_BODY()
+
+private:
+	// Alternatives in the same order as EApologueRandomEngine
+	typedef TVariant<FApologueXoshiro256StarStarEngine, FApologuePCG64Engine, FApologueSFC64Engine> FEngineVariant;
+
+	mutable FEngineVariant Engine;
+
+	// The seed the engine was last seeded or loaded for, to catch property writes that bypass the methods below
+	mutable int64 EngineSeed = 0;
+
+	UPROPERTY()
+	int64 InitialSeed = 0;
+
+	UPROPERTY(EditAnywhere, Category="Random Stream")
+	EApologueRandomEngine EngineType = EApologueRandomEngine::Xoshiro256StarStar;
+
+	UPROPERTY()
+	bool bIsInitialized = false;
+
+	// Substream of InitialSeed this stream draws from; non-zero for streams made by Split()
+	UPROPERTY()
+	int32 StreamIndex = 0;
+
+public:
+	FApologueRandomStream() = default;
+
+	explicit FApologueRandomStream(const EApologueRandomEngine InEngineType)
+		: EngineType(InEngineType)
+	{
+		SeedEngine(InitialSeed);
+	}
+
+	/**
+	 * Initialize with a random seed.
+	 */
+	FORCEINLINE void Initialize()
+	{
+		Initialize(FApologueRandom::GenerateSeed());
+	}
+
+	FORCEINLINE void Initialize(const uint64 Seed)
+	{
+		InitialSeed = Seed;
+		StreamIndex = 0;
+		SeedEngine(Seed);
+		bIsInitialized = true;
+	}
+
+	void Initialize(const FString& Seed)
+	{
+		uint64 ParsedSeed;
+		if (FApologueRandom::ParseSeed(Seed, ParsedSeed))
+		{
+			Initialize(ParsedSeed);
+		}
+		else
+		{
+			// Random initialization
+			Initialize();
+		}
+	}
+
+	/**
+	 * Resets the stream back to the state from the initial seed.
+	 */
+	FORCEINLINE void Reset()
+	{
+		SeedEngine(InitialSeed);
+	}
+
+	/**
+	 * Derives Num streams on the same engine that do not overlap this one or each other, for deterministic parallel
+	 * work such as one stream per ParallelFor task. They are substreams StreamIndex + 1 to StreamIndex + Num of the
+	 * initial seed, each at its start. xoshiro256** and PCG64 substreams are engine jumps apart and never overlap; SFC64
+	 * has no jump, so its substreams are seeded from a hash and are only overwhelmingly unlikely to overlap.
+	 *
+	 * Splitting a stream that came from Split() gives substreams that its later siblings already use.
+	 */
+	void Split(const int32 Num, TArray<FApologueRandomStream>& OutStreams) const
+	{
+		ensure(bIsInitialized);
+		OutStreams.Reset(Num);
+
+		FApologueRandomStream Child(*this);
+		Child.bIsInitialized = true;
+		Child.SeedEngine(InitialSeed);
+
+		for (int32 I = 1; I <= Num; ++I)
+		{
+			++Child.StreamIndex;
+			::Visit([&Child](auto& InEngine)
+			{
+				FApologueRandom::NextSubstream(InEngine, Child.InitialSeed, Child.StreamIndex);
+			}, Child.Engine);
+
+			OutStreams.Add(Child);
+		}
+	}
+
+	FORCEINLINE int64 GetInitialSeed() const
+	{
+		return InitialSeed;
+	}
+
+	FORCEINLINE int32 GetStreamIndex() const
+	{
+		return StreamIndex;
+	}
+
+	FORCEINLINE bool IsInitialized() const
+	{
+		return bIsInitialized;
+	}
+
+	FORCEINLINE EApologueRandomEngine GetEngineType() const
+	{
+		return EngineType;
+	}
+
+	/**
+	 * Switches to another engine and reseeds it with the initial seed.
+	 */
+	void SetEngineType(const EApologueRandomEngine InEngineType)
+	{
+		check(InEngineType < EApologueRandomEngine::MAX);
+
+		EngineType = InEngineType;
+		SeedEngine(InitialSeed);
+	}
+
+	void GetState(TArray<uint64>& Array) const
+	{
+		SyncEngine();
+		::Visit([&Array](const auto& InEngine)
+		{
+			const TConstArrayView<uint64> State = InEngine.GetState();
+			Array.Reset(State.Num());
+			Array.Append(State.GetData(), State.Num());
+		}, Engine);
+	}
+
+	/**
+	 * Calls Function with the engine as its only argument.
+	 */
+	template <typename FunctionType>
+	FORCEINLINE decltype(auto) VisitEngine(FunctionType&& Function) const
+	{
+		ensure(bIsInitialized);
+		SyncEngine();
+		return ::Visit(Forward<FunctionType>(Function), Engine);
+	}
+
+	// Serialization
+	friend FArchive& operator<<(FArchive& Ar, FApologueRandomStream& Stream)
+	{
+		Ar.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+
+		uint8 EngineType = static_cast<uint8>(Stream.EngineType);
+		Ar << EngineType << Stream.InitialSeed << Stream.bIsInitialized << Stream.StreamIndex;
+
+		if (Ar.IsLoading())
+		{
+			Stream.LoadEngineType(EngineType, Ar);
+		}
+		else
+		{
+			Stream.SyncEngine();
+		}
+
+		::Visit([&Ar](auto& InEngine) { Ar << InEngine; }, Stream.Engine);
+		return Ar;
+	}
+
+	bool Serialize(FArchive& Ar)
+	{
+		// Stream properties saved before the portable format were tagged; returning false loads them that way
+		Ar.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+		if (Ar.IsLoading() && Ar.CustomVer(FApologueCoreCustomVersion::GUID) < FApologueCoreCustomVersion::PortableRandomStream)
+		{
+			return false;
+		}
+
+		Ar << *this;
+		return true;
+	}
+
+	friend void operator<<(FStructuredArchive::FSlot Slot, FApologueRandomStream& Stream)
+	{
+		FArchive& UnderlyingArchive = Slot.GetUnderlyingArchive();
+		UnderlyingArchive.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+
+		FStructuredArchive::FRecord Record = Slot.EnterRecord();
+		uint8 EngineType = static_cast<uint8>(Stream.EngineType);
+		Record << SA_VALUE(TEXT("EngineType"), EngineType);
+		Record << SA_VALUE(TEXT("InitialSeed"), Stream.InitialSeed);
+		Record << SA_VALUE(TEXT("bIsInitialized"), Stream.bIsInitialized);
+		Record << SA_VALUE(TEXT("StreamIndex"), Stream.StreamIndex);
+
+		TArray<uint64> State;
+		if (!UnderlyingArchive.IsLoading())
+		{
+			Stream.GetState(State);
+		}
+
+		Record << SA_VALUE(TEXT("State"), State);
+
+		if (UnderlyingArchive.IsLoading())
+		{
+			Stream.LoadEngineType(EngineType, UnderlyingArchive);
+
+			if (!::Visit([&State](auto& InEngine) { return InEngine.SetState(State); }, Stream.Engine))
+			{
+				UnderlyingArchive.SetError();
+			}
+		}
+	}
+
+	bool Serialize(const FStructuredArchive::FSlot Slot)
+	{
+		FArchive& UnderlyingArchive = Slot.GetUnderlyingArchive();
+		UnderlyingArchive.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+		if (UnderlyingArchive.IsLoading() && UnderlyingArchive.CustomVer(FApologueCoreCustomVersion::GUID) < FApologueCoreCustomVersion::PortableRandomStream)
+		{
+			return false;
+		}
+
+		Slot << *this;
+		return true;
+	}
+
+	/**
+	 * Tagged properties held only the seed, so streams loaded from them restart their substream.
+	 */
+	void PostSerialize(const FArchive& Ar)
+	{
+		if (Ar.IsLoading() && Ar.CustomVer(FApologueCoreCustomVersion::GUID) < FApologueCoreCustomVersion::PortableRandomStream)
+		{
+			SeedEngine(InitialSeed);
+		}
+	}
+
+	/**
+	 * Replicates the engine type, seed and substream along with the 32 bytes of engine state, so the receiver draws
+	 * what the sender would draw next.
+	 *
+	 * Draws change the engine but none of the properties, so owners using the push model mark the stream dirty after
+	 * drawing from it, with MARK_PROPERTY_DIRTY_FROM_NAME.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		uint8 bNetIsInitialized = bIsInitialized;
+		Ar.SerializeBits(&bNetIsInitialized, 1);
+
+		if (!bNetIsInitialized)
+		{
+			if (Ar.IsLoading())
+			{
+				*this = FApologueRandomStream();
+			}
+
+			bOutSuccess = true;
+			return true;
+		}
+
+		uint8 NetEngineType = static_cast<uint8>(EngineType);
+		Ar << NetEngineType;
+
+		uint64 NetSeed = static_cast<uint64>(InitialSeed);
+		Ar << NetSeed;
+
+		uint32 NetStreamIndex = static_cast<uint32>(StreamIndex);
+		Ar.SerializeIntPacked(NetStreamIndex);
+
+		if (Ar.IsLoading())
+		{
+			InitialSeed = static_cast<int64>(NetSeed);
+			StreamIndex = NetStreamIndex > MAX_int32 ? -1 : static_cast<int32>(NetStreamIndex);
+			bIsInitialized = true;
+			LoadEngineType(NetEngineType, Ar);
+		}
+		else
+		{
+			SyncEngine();
+		}
+
+		::Visit([&Ar](auto& InEngine) { Ar << InEngine; }, Engine);
+
+		bOutSuccess = !Ar.IsError();
+		return true;
+	}
+
+	/**
+	 * Compares the engines too, so that replication and property comparisons see draws.
+	 */
+	bool Identical(const FApologueRandomStream* Other, uint32 PortFlags) const
+	{
+		if (EngineType != Other->EngineType || InitialSeed != Other->InitialSeed || bIsInitialized != Other->bIsInitialized
+			|| StreamIndex != Other->StreamIndex)
+		{
+			return false;
+		}
+
+		SyncEngine();
+		Other->SyncEngine();
+		return ::Visit([Other](const auto& InEngine)
+		{
+			return InEngine == Other->Engine.template Get<typename TDecay<decltype(InEngine)>::Type>();
+		}, Engine);
+	}
+
+private:
+	/**
+	 * Selects the engine for a loaded engine type and seeds it; its state is read afterwards, so the substream is not
+	 * sought out.
+	 */
+	void LoadEngineType(const uint8 InEngineType, FArchive& Ar)
+	{
+		EngineType = static_cast<EApologueRandomEngine>(InEngineType);
+		if (EngineType >= EApologueRandomEngine::MAX)
+		{
+			Ar.SetError();
+			EngineType = EApologueRandomEngine::Xoshiro256StarStar;
+		}
+
+		if (StreamIndex < 0)
+		{
+			Ar.SetError();
+			StreamIndex = 0;
+		}
+
+		EmplaceEngine(InitialSeed);
+	}
+
+	/**
+	 * Reseeds the engine if a property was written without going through the stream, e.g. the engine type in the
+	 * details panel or the seed by a text import.
+	 */
+	FORCEINLINE void SyncEngine() const
+	{
+		if (Engine.GetIndex() != static_cast<SIZE_T>(EngineType) || EngineSeed != InitialSeed)
+		{
+			SeedEngine(InitialSeed);
+		}
+	}
+
+	void SeedEngine(const uint64 Seed) const
+	{
+		EmplaceEngine(Seed);
+
+		if (StreamIndex != 0)
+		{
+			::Visit([this, Seed](auto& InEngine) { FApologueRandom::SeedSubstream(InEngine, Seed, StreamIndex); }, Engine);
+		}
+	}
+
+	void EmplaceEngine(const uint64 Seed) const
+	{
+		switch (EngineType)
+		{
+		case EApologueRandomEngine::PCG64:
+			Engine.Emplace<FApologuePCG64Engine>(Seed);
+			break;
+		case EApologueRandomEngine::SFC64:
+			Engine.Emplace<FApologueSFC64Engine>(Seed);
+			break;
+		default:
+			Engine.Emplace<FApologueXoshiro256StarStarEngine>(Seed);
+			break;
+		}
+
+		EngineSeed = static_cast<int64>(Seed);
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FApologueRandomStream> : TStructOpsTypeTraitsBase2<FApologueRandomStream>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithStructuredSerializer = true,
+		WithPostSerialize = true,
+		WithIdentical = true,
+		WithNetSerializer = true,
+	};
+};
+
+UCLASS()
+class APOLOGUECORE_API UApologueRandomStreamLibrary : public UApologueRandomLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Selects the engine and seeds it. An empty seed picks a random one.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static void Initialize(UPARAM(Ref) FApologueRandomStream& Stream, const EApologueRandomEngine EngineType, const FString& Seed)
+	{
+		if (EngineType >= EApologueRandomEngine::MAX)
+		{
+			ThrowBlueprintException();
+			return;
+		}
+
+		Stream.SetEngineType(EngineType);
+		Stream.Initialize(Seed);
+	}
+
+	/**
+	 * Resets the stream back to the state from the initial seed.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static void Reset(UPARAM(Ref) FApologueRandomStream& Stream)
+	{
+		if (EnsureInitialized(Stream))
+		{
+			Stream.Reset();
+		}
+	}
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static FORCEINLINE bool GetInitialSeed(UPARAM(Ref) const FApologueRandomStream& Stream, int64& InitialSeed)
+	{
+		if (!Stream.IsInitialized())
+			return false;
+
+		InitialSeed = Stream.GetInitialSeed();
+		return true;
+	}
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static FORCEINLINE bool GetState(UPARAM(Ref) const FApologueRandomStream& Stream, TArray<int64>& State, EApologueRandomEngine& EngineType)
+	{
+		if (!Stream.IsInitialized())
+			return false;
+
+		Stream.GetState(reinterpret_cast<TArray<uint64>&>(State));
+		EngineType = Stream.GetEngineType();
+		return true;
+	}
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static FORCEINLINE bool IsInitialized(UPARAM(Ref) const FApologueRandomStream& Stream)
+	{
+		return Stream.IsInitialized();
+	}
+
+	/**
+	 * Derives Num streams that do not overlap this one or each other, e.g. one per parallel task.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static FORCEINLINE void Split(UPARAM(Ref) const FApologueRandomStream& Stream, const int32 Num, TArray<FApologueRandomStream>& Streams)
+	{
+		Streams.Reset();
+		if (EnsureInitialized(Stream) && Num > 0)
+		{
+			Stream.Split(Num, Streams);
+		}
+	}
+
+	/**
+	 * Obtains a random bool.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random Bool")
+	static FORCEINLINE bool RandBool(UPARAM(Ref) const FApologueRandomStream& Stream)
+	{
+		return GenericRandBool(Stream);
+	}
+
+	/**
+	 * Obtains a random value in [Min, Max].
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random Range (Integer)")
+	static FORCEINLINE int32 RandRange_Int32(UPARAM(Ref) const FApologueRandomStream& Stream, const int32 Min, const int32 Max)
+	{
+		return GenericRandRange(Stream, Min, Max);
+	}
+
+	/**
+	 * Obtains a random value in [Min, Max].
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random Range (Integer64)")
+	static FORCEINLINE int64 RandRange_Int64(UPARAM(Ref) const FApologueRandomStream& Stream, const int64 Min, const int64 Max)
+	{
+		return GenericRandRange(Stream, Min, Max);
+	}
+
+	/**
+	 * Obtains a random value in [Min, Max).
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random Range (Float)")
+	static FORCEINLINE double RandRange_Double(UPARAM(Ref) const FApologueRandomStream& Stream, const double Min, const double Max)
+	{
+		return GenericRandRange(Stream, Min, Max);
+	}
+
+	/** 
+	 * Gets a random item from specified array (using random stream).
+	 * 
+	 * @param Stream			The random stream.
+	 * @param TargetArray		The array.
+	 * @param OutElement		The random element from this array.
+	 * @param OutIndex			The index of random item (will be -1 if array is empty).
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="Apologue|Random|Random Stream", DisplayName="Random Element in Array",
+		meta=(ArrayParm="TargetArray", ArrayTypeDependentParams="OutElement"))
+	static FORCEINLINE void RandomElementInArray(UPARAM(Ref) const FApologueRandomStream& Stream, const TArray<int32>& TargetArray, int32& OutElement, int32& OutIndex)
+	{
+		// see execRandomElementInArray for implementation
+		check(0)
+	}
+
+	/** 
+	 * Gets a random item from specified array (using random stream).
+	 * 
+	 * @param Stream			The random stream.
+	 * @param TargetArray		The array.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="Apologue|Random|Random Stream", meta=(ArrayParm="TargetArray", Keywords="random"))
+	static FORCEINLINE void ShuffleArray(UPARAM(Ref) const FApologueRandomStream& Stream, const TArray<int32>& TargetArray)
+	{
+		// see execShuffleArray for implementation
+		check(0);
+	}
+
+	/**
+	 * Moves a random sample of Count elements, in random order, to the front of the array. Costs O(Count) rather than
+	 * a full shuffle.
+	 *
+	 * @param Stream			The random stream.
+	 * @param TargetArray		The array.
+	 * @param Count				The number of elements to sample.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="Apologue|Random|Random Stream", meta=(ArrayParm="TargetArray", Keywords="random sample"))
+	static FORCEINLINE void PartialShuffleArray(UPARAM(Ref) const FApologueRandomStream& Stream, const TArray<int32>& TargetArray, const int32 Count)
+	{
+		// see execPartialShuffleArray for implementation
+		check(0);
+	}
+
+	/**
+	 * Picks Count distinct indices in [0, Num) in random order, in O(Count).
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", meta=(Keywords="random sample"))
+	static FORCEINLINE TArray<int32> SampleIndices(UPARAM(Ref) const FApologueRandomStream& Stream, const int32 Num, const int32 Count)
+	{
+		return GenericSampleIndices(Stream, Num, Count);
+	}
+
+	/**
+	 * Obtains a random value in [0.0, 1.0).
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static FORCEINLINE double RandomFraction(UPARAM(Ref) const FApologueRandomStream& Stream)
+	{
+		return GenericRandomFraction(Stream);
+	}
+
+	/**
+	 * Obtains a normally distributed value.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", meta=(Keywords="gaussian"))
+	static FORCEINLINE double RandomNormal(UPARAM(Ref) const FApologueRandomStream& Stream, const double Mean = 0.0, const double StandardDeviation = 1.0)
+	{
+		return GenericRandomNormal(Stream, Mean, StandardDeviation);
+	}
+
+	/**
+	 * Obtains an exponentially distributed value, such as the time until an event that happens Rate times per unit of
+	 * time on average.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static FORCEINLINE double RandomExponential(UPARAM(Ref) const FApologueRandomStream& Stream, const double Rate = 1.0)
+	{
+		return GenericRandomExponential(Stream, Rate);
+	}
+
+	/**
+	 * Obtains a Poisson distributed count, such as the number of events in a span in which Mean of them happen on
+	 * average.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static FORCEINLINE int64 RandomPoisson(UPARAM(Ref) const FApologueRandomStream& Stream, const double Mean)
+	{
+		return GenericRandomPoisson(Stream, Mean);
+	}
+
+	/**
+	 * Obtains the number of successes in Trials trials that each succeed with the given probability.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static FORCEINLINE int32 RandomBinomial(UPARAM(Ref) const FApologueRandomStream& Stream, const int32 Trials, const double Probability)
+	{
+		return GenericRandomBinomial(Stream, Trials, Probability);
+	}
+
+	/**
+	 * Returns a random vector of unit size.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream")
+	static FORCEINLINE FVector RandomUnitVector(UPARAM(Ref) const FApologueRandomStream& Stream)
+	{
+		return GenericRandomUnitVector(Stream);
+	}
+
+	/**
+	 * Returns a random 2D point in a unit circle.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random Point in Unit Circle")
+	static FORCEINLINE FVector2D RandomPointInUnitCircle(UPARAM(Ref) const FApologueRandomStream& Stream)
+	{
+		return GenericRandomPointInUnitCircle(Stream);
+	}
+
+	/**
+	 * Returns a random 3D point in a unit sphere.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random Point in Unit Sphere")
+	static FORCEINLINE FVector RandomPointInUnitSphere(UPARAM(Ref) const FApologueRandomStream& Stream)
+	{
+		return GenericRandomPointInUnitSphere(Stream);
+	}
+
+	/**
+	 * Returns a random point in a bounding box.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random Point in Bounding Box")
+	static FORCEINLINE FVector RandomPointInBoundingBox(UPARAM(Ref) const FApologueRandomStream& Stream, const FVector& Center, const FVector& HalfSize)
+	{
+		return GenericRandomPointInBoundingBox(Stream, Center, HalfSize);
+	}
+
+	/**
+	 * Returns a random point in a box.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random Point in Box")
+	static FORCEINLINE FVector RandomPointInBox(UPARAM(Ref) const FApologueRandomStream& Stream, const FBox& Box)
+	{
+		return GenericRandomPointInBox(Stream, Box);
+	}
+
+	/**
+	 * Returns a random unit vector, uniformly distributed, within the specified cone.
+	 *
+	 * @param Stream The random stream.
+	 * @param Direction The center direction of the cone.
+	 * @param HalfAngle Half-angle of cone, in degrees.
+	 * @return Normalized vector within the specified cone.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random Cone")
+	static FORCEINLINE FVector RandomCone(UPARAM(Ref) const FApologueRandomStream& Stream, const FVector& Direction, const double HalfAngle)
+	{
+		return GenericRandomCone(Stream, Direction, HalfAngle);
+	}
+
+	/**
+	 * Returns a random unit vector, uniformly distributed, within the specified cone.
+	 *
+	 * @param Stream The random stream.
+	 * @param Direction The center direction of the cone.
+	 * @param HalfAngle Half-angle of cone, in degrees.
+	 * @param VerticalHalfAngle Vertical half-angle of cone, in degrees.
+	 * @return Normalized vector within the specified cone.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random Cone with Vertical Half Angle")
+	static FORCEINLINE FVector GetConeWithVertical(UPARAM(Ref) const FApologueRandomStream& Stream, const FVector& Direction, const double HalfAngle,
+	                                               const double VerticalHalfAngle)
+	{
+		return GenericRandomCone(Stream, Direction, HalfAngle, VerticalHalfAngle);
+	}
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random from Fraction (Integer)")
+	static FORCEINLINE int32 RandomFromFraction_Int32(UPARAM(Ref) const FApologueRandomStream& Stream, const int32 Numerator, const int32 Denominator)
+	{
+		return GenericRandomFromFraction(Stream, Numerator, Denominator);
+	}
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Random Stream", DisplayName="Random from Fraction (Integer64)")
+	static FORCEINLINE int64 RandomFromFraction_Int64(UPARAM(Ref) const FApologueRandomStream& Stream, const int64 Numerator, const int64 Denominator)
+	{
+		return GenericRandomFromFraction(Stream, Numerator, Denominator);
+	}
+
+private:
+	DECLARE_FUNCTION(execRandomElementInArray)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		FApologueRandomStream* Stream = reinterpret_cast<FApologueRandomStream*>(Stack.MostRecentPropertyAddress);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		void* Result = Stack.MostRecentPropertyAddress;
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		int32* OutIndex = reinterpret_cast<int32*>(Stack.MostRecentPropertyAddress);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+			GenericRandArray(ArrayAddr, ArrayProperty, Stream, Result, OutIndex);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execShuffleArray)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		FApologueRandomStream* Stream = reinterpret_cast<FApologueRandomStream*>(Stack.MostRecentPropertyAddress);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+			MARK_PROPERTY_DIRTY(Stack.Object, ArrayProperty);
+			GenericShuffleArray(ArrayAddr, ArrayProperty, Stream);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execPartialShuffleArray)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		FApologueRandomStream* Stream = reinterpret_cast<FApologueRandomStream*>(Stack.MostRecentPropertyAddress);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, Count);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+			MARK_PROPERTY_DIRTY(Stack.Object, ArrayProperty);
+			GenericShuffleArray(ArrayAddr, ArrayProperty, Stream, Count);
+		P_NATIVE_END;
+	}
+};
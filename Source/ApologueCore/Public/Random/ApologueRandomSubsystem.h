@@ -0,0 +1,121 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueCounterRandom.h"
+#include "Async/ParallelFor.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ApologueRandomSubsystem.generated.h"
+
+/**
+ * Hands out random streams that any thread can draw from without locks. The stream for an item of a task is a pure
+ * function of the world seed, the task's key and the item's index, so results never depend on which worker ran the
+ * item or when. Workers each get their own copy of a stream, and the subsystem itself is only read after the seed is
+ * set.
+ *
+ * Results merged in item order rather than completion order are reproducible from the world seed alone.
+ */
+UCLASS()
+class APOLOGUECORE_API UApologueRandomSubsystem final : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FApologueCounterRandom WorldRandom;
+
+public:
+	// USubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/**
+	 * Replaces the world seed, which starts out random. Only on the game thread, and not while tasks are drawing.
+	 */
+	void SetWorldSeed(const uint64 Seed);
+
+	FORCEINLINE uint64 GetWorldSeed() const
+	{
+		return static_cast<uint64>(WorldRandom.GetInitialSeed());
+	}
+
+	/**
+	 * @return A key for the task of that name, the same on every run and platform.
+	 */
+	static uint64 MakeTaskKey(const FStringView TaskName);
+
+	/**
+	 * @return The counter random source of a task, whose subjects are its items.
+	 */
+	FORCEINLINE FApologueCounterRandom GetTaskRandom(const uint64 TaskKey) const
+	{
+		return MakeTaskRandom(GetWorldSeed(), TaskKey);
+	}
+
+	/**
+	 * @return The stream of one item of a task. Safe to call from any thread.
+	 */
+	FORCEINLINE FApologueCounterStream GetStream(const uint64 TaskKey, const uint64 ItemIndex = 0) const
+	{
+		return GetTaskRandom(TaskKey).At(ItemIndex, 0);
+	}
+
+	static FApologueCounterRandom MakeTaskRandom(const uint64 WorldSeed, const uint64 TaskKey)
+	{
+		uint64 TaskState = TaskKey;
+
+		FApologueCounterRandom TaskRandom;
+		TaskRandom.Initialize(WorldSeed ^ FApologueRandomMath::SplitMix64(TaskState));
+		return TaskRandom;
+	}
+
+	/**
+	 * Runs Body(Index, Stream) for every index in [0, Num) on task graph workers, each with the stream of its item.
+	 */
+	template <typename BodyType>
+	void ParallelFor(const uint64 TaskKey, const int32 Num, BodyType&& Body, const EParallelForFlags Flags = EParallelForFlags::None) const
+	{
+		const FApologueCounterRandom TaskRandom = GetTaskRandom(TaskKey);
+		::ParallelFor(Num, [&TaskRandom, &Body](const int32 Index)
+		{
+			FApologueCounterStream Stream = TaskRandom.At(Index, 0);
+			Body(Index, Stream);
+		}, Flags);
+	}
+
+	/**
+	 * Fills OutResults with Generate(Index, Stream) for every index in [0, Num), generated on task graph workers and
+	 * stored in index order, so the array is the same however the work was scheduled.
+	 */
+	template <typename ResultType, typename FunctionType>
+	void ParallelGenerate(const uint64 TaskKey, const int32 Num, TArray<ResultType>& OutResults, FunctionType&& Generate,
+	                      const EParallelForFlags Flags = EParallelForFlags::None) const
+	{
+		OutResults.SetNum(Num);
+		ResultType* Results = OutResults.GetData();
+		ParallelFor(TaskKey, Num, [Results, &Generate](const int32 Index, FApologueCounterStream& Stream)
+		{
+			Results[Index] = Generate(Index, Stream);
+		}, Flags);
+	}
+
+	/**
+	 * Seeds every task of the world. An empty seed picks a random one.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Subsystem", DisplayName="Set World Seed")
+	void K2_SetWorldSeed(const FString& Seed);
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Subsystem", DisplayName="Get World Seed")
+	int64 K2_GetWorldSeed() const
+	{
+		return WorldRandom.GetInitialSeed();
+	}
+
+	/**
+	 * Gets the counter random source of the named task, whose subjects are its items.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Subsystem", DisplayName="Get Task Random")
+	FApologueCounterRandom K2_GetTaskRandom(const FString& TaskName) const
+	{
+		return GetTaskRandom(MakeTaskKey(TaskName));
+	}
+};
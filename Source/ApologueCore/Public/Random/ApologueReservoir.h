@@ -0,0 +1,125 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform sample of Capacity elements from a sequence of unknown length, seen once, with Li's Algorithm L: after the
+ * reservoir fills, it computes how many elements to skip before the next replacement, so it draws O(Capacity * log(N /
+ * Capacity)) values rather than one per element.
+ *
+ * StreamType is any type with the FMersenneTwister interface.
+ */
+template <typename ElementType>
+class TApologueReservoir
+{
+public:
+	explicit TApologueReservoir(const int32 InCapacity)
+		: Capacity(InCapacity)
+	{
+		check(Capacity > 0)
+
+		Samples.Reserve(Capacity);
+	}
+
+	/**
+	 * Offers the next element of the sequence.
+	 *
+	 * @return Whether the element was taken into the reservoir.
+	 */
+	template <typename StreamType, typename ArgType>
+	bool Add(const StreamType& Stream, ArgType&& Element)
+	{
+		const int64 Index = NumSeen++;
+
+		if (Samples.Num() < Capacity)
+		{
+			Samples.Emplace(Forward<ArgType>(Element));
+			if (Samples.Num() == Capacity)
+			{
+				Weight = FMath::Exp(LogFraction(Stream) / Capacity);
+				ScheduleNext(Stream, Index);
+			}
+
+			return true;
+		}
+
+		if (Index != NextIndex)
+		{
+			return false;
+		}
+
+		Samples[Stream.RandHelper(Capacity)] = Forward<ArgType>(Element);
+		Weight *= FMath::Exp(LogFraction(Stream) / Capacity);
+		ScheduleNext(Stream, Index);
+		return true;
+	}
+
+	/**
+	 * @return How many of the next elements Add() will reject, which callers that can skip ahead cheaply may pass to
+	 * Skip() instead.
+	 */
+	int64 GetNumToSkip() const
+	{
+		return Samples.Num() < Capacity ? 0 : NextIndex - NumSeen;
+	}
+
+	/**
+	 * Counts Num elements as seen without offering them. Num must not exceed GetNumToSkip().
+	 */
+	void Skip(const int64 Num)
+	{
+		check(Num >= 0 && Num <= GetNumToSkip())
+
+		NumSeen += Num;
+	}
+
+	void Reset()
+	{
+		Samples.Reset();
+		NumSeen = 0;
+		NextIndex = 0;
+		Weight = 1.0;
+	}
+
+	FORCEINLINE TConstArrayView<ElementType> GetSamples() const
+	{
+		return Samples;
+	}
+
+	FORCEINLINE int32 GetCapacity() const
+	{
+		return Capacity;
+	}
+
+	FORCEINLINE int64 GetNumSeen() const
+	{
+		return NumSeen;
+	}
+
+private:
+	// The log of a fraction in (0, 1], never -inf
+	template <typename StreamType>
+	static double LogFraction(const StreamType& Stream)
+	{
+		return FMath::Loge(1.0 - Stream.template GetFraction<double>());
+	}
+
+	template <typename StreamType>
+	void ScheduleNext(const StreamType& Stream, const int64 Index)
+	{
+		// Geometric gap; a Weight of 1 divides by -inf and takes the very next element, one too small to subtract from 1
+		// never replaces again
+		const double LogRejection = FMath::Loge(1.0 - Weight);
+		const double MaxGap = static_cast<double>(MAX_int64 / 2);
+		const double Gap = LogRejection < 0.0 ? FMath::Min(FMath::FloorToDouble(LogFraction(Stream) / LogRejection), MaxGap) : MaxGap;
+		NextIndex = Index + 1 + static_cast<int64>(Gap);
+	}
+
+	TArray<ElementType> Samples;
+	int32 Capacity;
+	int64 NumSeen = 0;
+	int64 NextIndex = 0;
+	double Weight = 1.0;
+};
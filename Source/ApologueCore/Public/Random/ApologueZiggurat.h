@@ -0,0 +1,25 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Tables of the 256 layer ziggurat for the standard normal distribution. Layer I is accepted outright when a 52 bit
+ * magnitude is below NormalK[I], scaled to x by NormalW[I], and its wedge is tested against NormalF[I - 1] and
+ * NormalF[I]. Layer 0 is the base strip, whose overflow past R is the tail.
+ *
+ * The tables are constants rather than computed at startup, so every platform accepts the same layers outright. The
+ * wedge and tail tests call FMath::Exp and FMath::Loge, whose results may differ in the last bits between platforms.
+ */
+struct APOLOGUECORE_API FApologueZiggurat
+{
+	static constexpr int32 NumLayers = 256;
+
+	// Start of the tail
+	static constexpr double NormalR = 3.6541528853610088;
+
+	static const uint64 NormalK[NumLayers];
+	static const double NormalW[NumLayers];
+	static const double NormalF[NumLayers];
+};
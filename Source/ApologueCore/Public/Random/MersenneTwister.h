@@ -2,46 +2,37 @@
 
 #pragma once
 
-#include <random>
-
 #include "CoreMinimal.h"
-#include "Blueprint/BlueprintExceptionInfo.h"
-#include "Kismet/BlueprintFunctionLibrary.h"
+#include "ApologueCoreCustomVersion.h"
+#include "ApologueRandom.h"
+#include "ApologueRandomApi.h"
+#include "ApologueRandomLibrary.h"
+#include "MersenneTwisterEngine.h"
 #include "Net/Core/PushModel/PushModel.h"
 #include "MersenneTwister.generated.h"
 
-// Circle Buffer serialization
-template <class Type, size_t Nw>
-FArchive& operator<<(FArchive& Ar, std::_Circ_buf<Type, Nw>& CircleBuffer)
-{
-	for (int32 Index = 0; Index < Nw * 2; ++Index)
-	{
-		Ar << CircleBuffer._Ax[Index];
-	}
-
-	Ar << CircleBuffer._Idx;
-
-	return Ar;
-}
-
-// Circle Buffer serialization
-template <class Type, size_t Nw>
-void operator<<(FStructuredArchive::FSlot Slot, std::_Circ_buf<Type, Nw>& CircleBuffer)
-{
-	for (int32 Index = 0; Index < 2 * Nw; ++Index)
-	{
-		Slot << CircleBuffer._Ax[Index];
-	}
-
-	Slot << CircleBuffer._Idx;
-}
+class UPackageMap;
+struct FNetDeltaSerializeInfo;
 
 USTRUCT(BlueprintType, meta=(DisableSplitPin))
 struct APOLOGUECORE_API FMersenneTwister
+	// Hidden from UHT, which only accepts USTRUCT bases
+#if CPP
+	: public TApologueRandomApi<FMersenneTwister>
+#endif
 {
 	GENERATED_BODY()
 
-	typedef std::mt19937_64 FEngineType;
+	typedef FMersenneTwisterEngine FEngineType;
+
+	// Twisters with at most this many draws since seeding are serialized as their seed and draw count, and replayed
+	// when loaded by drawing that many words again. Beyond that, replaying costs more than reading the raw engine state.
+	// Split streams always store the raw state, as replaying them would also repeat their jumps.
+	static constexpr uint64 MaxCompactDrawCount = 1 << 16;
+
+	// Draw count of twisters loaded from the MSVC layout, which did not record one; far beyond any real count, so they
+	// are never written in compact form
+	static constexpr uint64 UnknownDrawCount = 1ull << 62;
 
 private:
 	mutable FEngineType Engine;
@@ -52,62 +43,39 @@ private:
 	UPROPERTY()
 	bool bIsInitialized = false;
 
+	// Substream of InitialSeed this twister draws from; non-zero for twisters made by Split()
+	UPROPERTY()
+	int32 StreamIndex = 0;
+
 public:
 	/**
 	 * Initialize with a random seed.
 	 */
 	FORCEINLINE void Initialize()
 	{
-		// hardware randomization
-		// TODO: Is this the best way to handle this across all devices?
-		std::random_device RandomDevice;
-		InitialSeed = RandomDevice();
-		Engine.seed(InitialSeed);
-		bIsInitialized = true;
+		Initialize(FApologueRandom::GenerateSeed());
 	}
 
 	FORCEINLINE void Initialize(const uint64 Seed)
 	{
 		InitialSeed = Seed;
-		Engine.seed(Seed);
+		StreamIndex = 0;
+		Engine.Seed(Seed);
 		bIsInitialized = true;
 	}
 
 	void Initialize(const FString& Seed)
 	{
-		if (Seed.IsEmpty())
-		{
-			// Random initialization
-			Initialize();
-			return;
-		}
-
-		// Explicitly check for 0 or -1 because these are potential fail values for FCString::Strtoi64() and we don't want any false negatives.
-		const FRegexPattern ZeroPattern(TEXT(R"(^(\+|-)?0+$)"));
-		FRegexMatcher ZeroMatcher(ZeroPattern, Seed);
-		if (ZeroMatcher.FindNext())
+		uint64 ParsedSeed;
+		if (FApologueRandom::ParseSeed(Seed, ParsedSeed))
 		{
-			Initialize(0);
-			return;
+			Initialize(ParsedSeed);
 		}
-
-		const FRegexPattern NegativeOnePattern(TEXT(R"(^-[0]*1$)"));
-		FRegexMatcher NegativeOneMatcher(ZeroPattern, Seed);
-		if (NegativeOneMatcher.FindNext())
+		else
 		{
-			Initialize(-1);
-			return;
-		}
-
-		const int64 IntSeed = FCString::Strtoi64(*Seed, nullptr, 10);
-		if (IntSeed != 0 && IntSeed != -1)
-		{
-			Initialize(IntSeed);
-			return;
+			// Random initialization
+			Initialize();
 		}
-
-		const uint32 HashSeed = GetTypeHash(Seed);
-		Initialize(HashSeed);
 	}
 
 	/**
@@ -116,7 +84,33 @@ public:
 	// ReSharper disable once CppMemberFunctionMayBeConst
 	FORCEINLINE void Reset()
 	{
-		Engine.seed(InitialSeed);
+		FApologueRandom::SeedSubstream(Engine, InitialSeed, StreamIndex);
+	}
+
+	/**
+	 * Derives Num twisters that never overlap this one or each other, for deterministic parallel work such as one
+	 * stream per ParallelFor task. They are substreams StreamIndex + 1 to StreamIndex + Num of the initial seed, each at
+	 * its start, and cost one engine jump apiece plus StreamIndex more when this twister was itself split off.
+	 *
+	 * Splitting a twister that came from Split() gives substreams that its later siblings already use.
+	 */
+	void Split(const int32 Num, TArray<FMersenneTwister>& OutStreams) const
+	{
+		ensure(bIsInitialized);
+		OutStreams.Reset(Num);
+
+		FEngineType ChildEngine;
+		FApologueRandom::SeedSubstream(ChildEngine, InitialSeed, StreamIndex);
+		for (int32 I = 1; I <= Num; ++I)
+		{
+			FApologueRandom::NextSubstream(ChildEngine, InitialSeed, StreamIndex + I);
+
+			FMersenneTwister& Child = OutStreams.AddDefaulted_GetRef();
+			Child.Engine = ChildEngine;
+			Child.InitialSeed = InitialSeed;
+			Child.StreamIndex = StreamIndex + I;
+			Child.bIsInitialized = true;
+		}
 	}
 
 	FORCEINLINE int64 GetInitialSeed() const
@@ -124,9 +118,22 @@ public:
 		return InitialSeed;
 	}
 
+	FORCEINLINE int32 GetStreamIndex() const
+	{
+		return StreamIndex;
+	}
+
 	FORCEINLINE int32 GetStateIndex() const
 	{
-		return Engine._Idx;
+		return Engine.GetStateIndex();
+	}
+
+	/**
+	 * @return The number of engine words drawn since the twister was initialized, reset or split off.
+	 */
+	FORCEINLINE uint64 GetDrawCount() const
+	{
+		return Engine.GetDrawCount();
 	}
 
 	FORCEINLINE bool IsInitialized() const
@@ -136,13 +143,9 @@ public:
 
 	void GetState(TArray<FEngineType::result_type>& Array) const
 	{
-		constexpr int32 StateSize = 2 * FEngineType::state_size;
-		Array.Reset(StateSize);
-
-		for (int32 Index = 0; Index < StateSize; ++Index)
-		{
-			Array.Add(Engine._Ax[Index]);
-		}
+		const TConstArrayView<FEngineType::result_type> State = Engine.GetState();
+		Array.Reset(State.Num());
+		Array.Append(State.GetData(), State.Num());
 	}
 
 	FORCEINLINE void GenerateNewSeed()
@@ -151,340 +154,350 @@ public:
 	}
 
 	/**
-	 * Helper function for rand implementations.
-	 *
-	 * @return A random number in [0..A).
-	*/
-	template <typename T>
-	FORCEINLINE typename TEnableIf<TIsArithmetic<T>::Value && !TIsFloatingPoint<T>::Value, T>::Type
-	RandHelper(const T A) const
-	{
-		ensure(bIsInitialized);
-		return RandomRange<T>(0, A - 1);
-	}
-
-	/**
-	 * @return A random floating point value in [Min, Max).
+	 * Calls Function with the engine as its only argument.
 	 */
-	template <typename T>
-	FORCEINLINE typename TEnableIf<TIsFloatingPoint<T>::Value, T>::Type
-	RandomRange(const T Min, const T Max) const
+	template <typename FunctionType>
+	FORCEINLINE decltype(auto) VisitEngine(FunctionType&& Function) const
 	{
-		ensure(bIsInitialized);
-		std::uniform_real_distribution<T> Distribution(Min, Max);
-		const T Value = Distribution(Engine);
-		return Value;
+		return Function(GetEngine());
 	}
 
-	/**
-	 * @return A random integer value in [Min, Max].
-	 */
+	// Array Swap
 	template <typename T>
-	FORCEINLINE typename TEnableIf<TIsArithmetic<T>::Value && !TIsFloatingPoint<T>::Value, T>::Type
-	RandomRange(const T Min, const T Max) const
+	static void CollectionSwap(TArray<T>& Array, const typename TArray<T>::SizeType IndexA,
+	                           const typename TArray<T>::SizeType IndexB)
 	{
-		ensure(bIsInitialized);
-		std::uniform_int_distribution<T> Distribution(Min, Max);
-		const T Value = Distribution(Engine);
-		return Value;
+		FApologueRandom::CollectionSwap(Array, IndexA, IndexB);
 	}
 
-	/**
-	 * @return Random number in [0.0, 1.0).
-	 */
+	// Other Container Type Swap
 	template <typename T>
-	FORCEINLINE typename TEnableIf<TIsFloatingPoint<T>::Value, T>::Type
-	GetFraction() const
+	static void CollectionSwap(T& Collection, const typename T::SizeType IndexA, const typename T::SizeType IndexB)
 	{
-		return RandomRange<T>(0, 1);
+		FApologueRandom::CollectionSwap(Collection, IndexA, IndexB);
 	}
 
-	/**
-	 * Returns a random vector of unit size.
-	 *
-	 * @return Random unit vector.
-	 */
-	FORCEINLINE FVector GetUnitVector() const
+	// Serialization
+	friend FArchive& operator<<(FArchive& Ar, FMersenneTwister& MersenneTwister)
 	{
-		FVector Result;
-		FVector::FReal Length;
+		Ar.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+		if (Ar.IsLoading() && Ar.CustomVer(FApologueCoreCustomVersion::GUID) < FApologueCoreCustomVersion::PortableMersenneTwister)
+		{
+			MersenneTwister.SerializeMSVCLayout(Ar);
+			return Ar;
+		}
+
+		Ar << MersenneTwister.InitialSeed << MersenneTwister.bIsInitialized << MersenneTwister.StreamIndex;
 
-		do
+		if (Ar.IsLoading() && MersenneTwister.StreamIndex < 0)
 		{
-			// Check random vectors in the unit sphere so result is statistically uniform.
-			Result.X = RandomRange(-1.0, 1.0);
-			Result.Y = RandomRange(-1.0, 1.0);
-			Result.Z = RandomRange(-1.0, 1.0);
-			Length = Result.SizeSquared();
+			Ar.SetError();
+			MersenneTwister.StreamIndex = 0;
 		}
-		while (Length > 1.f || Length < UE_KINDA_SMALL_NUMBER);
 
-		return Result.GetUnsafeNormal();
+		uint64 DrawCount = MersenneTwister.Engine.GetDrawCount();
+		bool bIsCompact = MersenneTwister.IsCompact();
+		Ar << bIsCompact;
+
+		if (bIsCompact)
+		{
+			Ar << DrawCount;
+
+			if (Ar.IsLoading() && !MersenneTwister.Replay(DrawCount))
+			{
+				Ar.SetError();
+			}
+		}
+		else
+		{
+			Ar << MersenneTwister.Engine;
+		}
+
+		return Ar;
 	}
 
-	/**
-	 * Returns a random point in a 2D unit circle.
-	 *
-	 * @return Random unit circle point.
-	 */
-	FORCEINLINE FVector2D GetPointInUnitCircle() const
+	bool Serialize(FArchive& Ar)
 	{
-		FVector2D Result;
-		FVector2D::FReal Length;
-
-		do
+		// Twister properties saved before the portable format were tagged; returning false loads them that way
+		Ar.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+		if (Ar.IsLoading() && Ar.CustomVer(FApologueCoreCustomVersion::GUID) < FApologueCoreCustomVersion::PortableMersenneTwister)
 		{
-			Result.X = RandomRange(-1.0, 1.0);
-			Result.Y = RandomRange(-1.0, 1.0);
-			Length = Result.SizeSquared();
+			return false;
 		}
-		while (Length > 1.f);
 
-		return Result;
+		Ar << *this;
+		return true;
 	}
 
-	/**
-	 * Returns a random point in a 3D unit sphere.
-	 *
-	 * @return Random unit sphere point.
-	 */
-	FORCEINLINE FVector GetPointInUnitSphere() const
+	friend void operator<<(FStructuredArchive::FSlot Slot, FMersenneTwister& MersenneTwister)
 	{
-		FVector Result;
-		FVector::FReal Length;
+		FArchive& UnderlyingArchive = Slot.GetUnderlyingArchive();
+		UnderlyingArchive.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
 
-		do
+		FStructuredArchive::FRecord Record = Slot.EnterRecord();
+		Record << SA_VALUE(TEXT("InitialSeed"), MersenneTwister.InitialSeed);
+		Record << SA_VALUE(TEXT("bIsInitialized"), MersenneTwister.bIsInitialized);
+		Record << SA_VALUE(TEXT("StreamIndex"), MersenneTwister.StreamIndex);
+
+		uint64 DrawCount = MersenneTwister.Engine.GetDrawCount();
+		Record << SA_VALUE(TEXT("DrawCount"), DrawCount);
+
+		// Left empty when the draw count is small enough to replay
+		TArray<uint64> State;
+		int32 StateIndex = 0;
+		if (!UnderlyingArchive.IsLoading() && !MersenneTwister.IsCompact())
 		{
-			Result.X = RandomRange(-1.0, 1.0);
-			Result.Y = RandomRange(-1.0, 1.0);
-			Result.Z = RandomRange(-1.0, 1.0);
-			Length = Result.SizeSquared();
+			const TConstArrayView<uint64> EngineState = MersenneTwister.Engine.GetState();
+			State.Append(EngineState.GetData(), EngineState.Num());
+			StateIndex = MersenneTwister.Engine.GetStateIndex();
 		}
-		while (Length > 1.f);
 
-		return Result;
+		Record << SA_VALUE(TEXT("State"), State);
+		Record << SA_VALUE(TEXT("StateIndex"), StateIndex);
+
+		if (UnderlyingArchive.IsLoading())
+		{
+			if (MersenneTwister.StreamIndex < 0)
+			{
+				UnderlyingArchive.SetError();
+				MersenneTwister.StreamIndex = 0;
+			}
+
+			if (State.Num() == FEngineType::StateSize && StateIndex >= 0 && StateIndex < FEngineType::StateSize)
+			{
+				MersenneTwister.Engine.SetState(State, StateIndex, DrawCount);
+			}
+			else if (!MersenneTwister.Replay(DrawCount))
+			{
+				UnderlyingArchive.SetError();
+			}
+		}
 	}
 
-	FORCEINLINE FVector GetPointInBoundingBox(const FVector& Center, const FVector& HalfSize) const
+	bool Serialize(const FStructuredArchive::FSlot Slot)
 	{
-		const FVector BoxMin = Center - HalfSize;
-		const FVector BoxMax = Center + HalfSize;
-		return GetPointInBox(FBox(BoxMin, BoxMax));
+		FArchive& UnderlyingArchive = Slot.GetUnderlyingArchive();
+		UnderlyingArchive.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+		if (UnderlyingArchive.IsLoading() && UnderlyingArchive.CustomVer(FApologueCoreCustomVersion::GUID) < FApologueCoreCustomVersion::PortableMersenneTwister)
+		{
+			return false;
+		}
+
+		Slot << *this;
+		return true;
 	}
 
-	FORCEINLINE FVector GetPointInBox(const FBox& Box) const
+	/**
+	 * Tagged properties held only the seed, so twisters loaded from them restart their stream.
+	 */
+	void PostSerialize(const FArchive& Ar)
 	{
-		return FVector(RandomRange(Box.Min.X, Box.Max.X),
-		               RandomRange(Box.Min.Y, Box.Max.Y),
-		               RandomRange(Box.Min.Z, Box.Max.Z));
+		if (Ar.IsLoading() && bIsInitialized
+			&& Ar.CustomVer(FApologueCoreCustomVersion::GUID) < FApologueCoreCustomVersion::PortableMersenneTwister)
+		{
+			Reset();
+		}
 	}
 
 	/**
-	 * Returns a random unit vector, uniformly distributed, within the specified cone.
-	 *
-	 * @param Dir The center direction of the cone.
-	 * @param ConeHalfAngleRad Half-angle of cone, in radians.
-	 * @return Normalized vector within the specified cone.
+	 * Sends the whole twister, for RPC parameters and twisters nested in other replicated structs, which have no
+	 * baseline to send a delta from. The seed and draw count are enough when the receiver can replay them cheaply, a
+	 * few bytes rather than the 2.5 KB of raw state, and a receiver already holding the same stream fast-forwards from
+	 * its own draw count rather than from the seed. Split twisters and twisters drawn from more than
+	 * MaxCompactDrawCount times since seeding send the raw state.
 	 */
-	FORCEINLINE FVector GetCone(const FVector& Dir, const double ConeHalfAngleRad) const
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 	{
-		if (ConeHalfAngleRad > 0.f)
+		uint8 bNetIsInitialized = bIsInitialized;
+		Ar.SerializeBits(&bNetIsInitialized, 1);
+
+		if (!bNetIsInitialized)
 		{
-			const double RandU = GetFraction<double>();
-			const double RandV = GetFraction<double>();
+			if (Ar.IsLoading())
+			{
+				*this = FMersenneTwister();
+			}
 
-			// Get spherical coords that have an even distribution over the unit sphere
-			// Method described at http://mathworld.wolfram.com/SpherePointPicking.html	
-			const double Theta = 2.0 * UE_DOUBLE_PI * RandU;
-			double Phi = FMath::Acos(2.0 * RandV - 1.0);
+			bOutSuccess = true;
+			return true;
+		}
 
-			// restrict phi to [0, ConeHalfAngleRad]
-			// this gives an even distribution of points on the surface of the cone
-			// centered at the origin, pointing upward (z), with the desired angle
-			Phi = FMath::Fmod(Phi, ConeHalfAngleRad);
+		uint64 NetSeed = static_cast<uint64>(InitialSeed);
+		Ar << NetSeed;
 
-			// get axes we need to rotate around
-			const FMatrix DirMat = FRotationMatrix(Dir.Rotation());
-			// note the axis translation, since we want the variation to be around X
-			const FVector DirZ = DirMat.GetUnitAxis(EAxis::X);
-			const FVector DirY = DirMat.GetUnitAxis(EAxis::Y);
+		uint32 NetStreamIndex = static_cast<uint32>(StreamIndex);
+		Ar.SerializeIntPacked(NetStreamIndex);
 
-			FVector Result = Dir.RotateAngleAxis(FMath::RadiansToDegrees(Phi), DirY);
-			Result = Result.RotateAngleAxis(FMath::RadiansToDegrees(Theta), DirZ);
+		uint64 NetDrawCount = Engine.GetDrawCount();
+		Ar.SerializeIntPacked64(NetDrawCount);
 
-			// ensure it's a unit vector (might not have been passed in that way)
-			Result = Result.GetSafeNormal();
+		uint8 bNetIsCompact = IsCompact();
+		Ar.SerializeBits(&bNetIsCompact, 1);
 
-			return Result;
+		if (!Ar.IsLoading())
+		{
+			if (!bNetIsCompact)
+			{
+				Ar << Engine;
+			}
+
+			bOutSuccess = true;
+			return true;
 		}
 
-		return Dir.GetSafeNormal();
+		if (NetStreamIndex > MAX_int32)
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return true;
+		}
+
+		const bool bHasStream = bIsInitialized && static_cast<uint64>(InitialSeed) == NetSeed && StreamIndex == static_cast<int32>(NetStreamIndex);
+		InitialSeed = static_cast<int64>(NetSeed);
+		StreamIndex = static_cast<int32>(NetStreamIndex);
+		bIsInitialized = true;
+
+		if (!bNetIsCompact)
+		{
+			Ar << Engine;
+			bOutSuccess = !Ar.IsError();
+		}
+		else if (bHasStream && Engine.GetDrawCount() <= NetDrawCount)
+		{
+			Engine.Discard(NetDrawCount - Engine.GetDrawCount());
+			bOutSuccess = true;
+		}
+		else
+		{
+			bOutSuccess = Replay(NetDrawCount);
+		}
+
+		return true;
 	}
 
 	/**
-	 * Returns a random unit vector, uniformly distributed, within the specified cone.
+	 * Replicates a twister property as the number of draws since the state the connection last acknowledged, a byte or
+	 * two per update. The whole twister is sent as by NetSerialize to new connections, when the seed or stream
+	 * changed, when the twister went back, and when more than MaxCompactDrawCount draws were made since, as the
+	 * receiver would replay them one by one.
 	 *
-	 * @param Dir The center direction of the cone.
-	 * @param HorizontalConeHalfAngleRad Horizontal half-angle of cone, in radians.
-	 * @param VerticalConeHalfAngleRad Vertical half-angle of cone, in radians.
-	 * @return Normalized vector within the specified cone.
+	 * Draws change the engine but none of the properties, so owners using the push model mark the twister dirty after
+	 * drawing from it, with MARK_PROPERTY_DIRTY_FROM_NAME or the Mark Mersenne Twister Dirty node.
+	 */
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+	/**
+	 * Compares the engines too, so that replication and property comparisons see draws. The seed, stream and draw
+	 * count settle it unless the draw count is unknown.
 	 */
-	FORCEINLINE FVector GetCone(const FVector& Dir, const double HorizontalConeHalfAngleRad, const double VerticalConeHalfAngleRad) const
+	bool Identical(const FMersenneTwister* Other, uint32 PortFlags) const
 	{
-		if (VerticalConeHalfAngleRad > 0.0 && HorizontalConeHalfAngleRad > 0.0)
+		if (InitialSeed != Other->InitialSeed || bIsInitialized != Other->bIsInitialized || StreamIndex != Other->StreamIndex
+			|| Engine.GetDrawCount() != Other->Engine.GetDrawCount())
 		{
-			const double RandU = GetFraction<double>();
-			const double RandV = GetFraction<double>();
-
-			// Get spherical coords that have an even distribution over the unit sphere
-			// Method described at http://mathworld.wolfram.com/SpherePointPicking.html	
-			const double Theta = 2.0 * UE_DOUBLE_PI * RandU;
-			double Phi = FMath::Acos(2.0 * RandV - 1.0);
-
-			// restrict phi to [0, ConeHalfAngleRad]
-			// where ConeHalfAngleRad is now a function of Theta
-			// (specifically, radius of an ellipse as a function of angle)
-			// function is ellipse function (x/a)^2 + (y/b)^2 = 1, converted to polar coords
-			double ConeHalfAngleRad = FMath::Square(FMath::Cos(Theta) / VerticalConeHalfAngleRad) + FMath::Square(FMath::Sin(Theta) / HorizontalConeHalfAngleRad);
-			ConeHalfAngleRad = FMath::Sqrt(1.0 / ConeHalfAngleRad);
-
-			// clamp to make a cone instead of a sphere
-			Phi = FMath::Fmod(Phi, ConeHalfAngleRad);
-
-			// get axes we need to rotate around
-			const FMatrix DirMat = FRotationMatrix(Dir.Rotation());
-			// note the axis translation, since we want the variation to be around X
-			const FVector DirZ = DirMat.GetUnitAxis(EAxis::X);
-			const FVector DirY = DirMat.GetUnitAxis(EAxis::Y);
-
-			FVector Result = Dir.RotateAngleAxis(FMath::RadiansToDegrees(Phi), DirY);
-			Result = Result.RotateAngleAxis(FMath::RadiansToDegrees(Theta), DirZ);
-
-			// ensure it's a unit vector (might not have been passed in that way)
-			Result = Result.GetSafeNormal();
-
-			return Result;
+			return false;
 		}
 
-		return Dir.GetSafeNormal();
+		return !HasUnknownDrawCount() || Engine == Other->Engine;
 	}
 
-	/**
-	 * @param Numerator Numerator
-	 * @param Denominator Denominator
-	 * @return Success
-	*/
-	template <typename T>
-	typename TEnableIf<TIsArithmetic<T>::Value && !TIsFloatingPoint<T>::Value, bool>::Type
-	RandomFromFraction(const T Numerator, const T Denominator) const
+private:
+	FORCEINLINE FEngineType& GetEngine() const
+	{
+		ensure(bIsInitialized);
+		return Engine;
+	}
+
+	FORCEINLINE bool IsCompact() const
 	{
-		return RandHelper(Denominator) < Numerator;
+		return StreamIndex == 0 && Engine.GetDrawCount() <= MaxCompactDrawCount;
 	}
 
 	/**
-	 * A version of RandomFromFraction that throws an error if Numerator or Denominator is out of range.
-	 * @param Numerator Numerator
-	 * @param Denominator Denominator
-	 * @return Success
-	*/
-	bool RandomFromFractionChecked(const int32 Numerator, const int32 Denominator) const
+	 * @return Whether the twister was loaded without a draw count, which then no longer identifies its state.
+	 */
+	FORCEINLINE bool HasUnknownDrawCount() const
 	{
-		check(Numerator >= 0)
-		check(Numerator <= Denominator)
-		check(Denominator > 0)
-
-		return RandomFromFraction(Numerator, Denominator);
+		return Engine.GetDrawCount() >= UnknownDrawCount;
 	}
 
-	// Fisher-Yates
-	template <typename T>
-	void Shuffle(T& List, const typename T::SizeType StartIndex = 0, typename T::SizeType EndIndex = INDEX_NONE)
+	/**
+	 * Reads the layout FArchive serialization wrote before PortableMersenneTwister: the seed, the buffer of MSVC's
+	 * std::mt19937_64 (2 * StateSize words and an unsigned int index) and the initialized flag.
+	 */
+	void SerializeMSVCLayout(FArchive& Ar)
 	{
-		check(StartIndex >= 0)
-		check(StartIndex < EndIndex)
-		check(EndIndex <= List.Num())
+		check(Ar.IsLoading());
+
+		constexpr int32 BufferSize = 2 * FEngineType::StateSize;
+		uint64 Buffer[BufferSize];
+		uint32 BufferIndex = 0;
 
-		if (EndIndex == INDEX_NONE)
+		Ar << InitialSeed;
+		for (uint64& Word : Buffer)
 		{
-			EndIndex = List.Num();
+			Ar << Word;
 		}
+		Ar << BufferIndex;
+		Ar << bIsInitialized;
 
-		for (int32 Index = StartIndex; Index < EndIndex - 1; ++Index)
+		StreamIndex = 0;
+
+		if (BufferIndex > BufferSize)
 		{
-			CollectionSwap(List, Index, RandomRange(Index, EndIndex - 1));
+			Ar.SetError();
+			Engine.Seed(InitialSeed);
+			return;
 		}
-	}
 
-	// Array Swap
-	template <typename T>
-	static void CollectionSwap(TArray<T>& Array, const typename TArray<T>::SizeType IndexA,
-	                           const typename TArray<T>::SizeType IndexB)
-	{
-		// ignores sanity checks in TArray::Swap()
-		Array.SwapMemory(IndexA, IndexB);
-	}
-
-	// Other Container Type Swap
-	template <typename T>
-	static void CollectionSwap(T& Collection, const typename T::SizeType IndexA, const typename T::SizeType IndexB)
-	{
-		T Temp = MoveTempIfPossible(Collection[IndexA]);
-		Collection[IndexA] = MoveTempIfPossible(Collection[IndexB]);
-		Collection[IndexB] = MoveTempIfPossible(Temp);
-	}
+		// Buffer[BufferIndex] is the next word to be returned, and the StateSize words before it, wrapping around the
+		// buffer, are the ones it and those after it are generated from
+		uint64 State[FEngineType::StateSize];
+		for (int32 I = 0; I < FEngineType::StateSize; ++I)
+		{
+			State[I] = Buffer[(BufferIndex + FEngineType::StateSize + I) % BufferSize];
+		}
 
-	// Serialization
-	friend FArchive& operator<<(FArchive& Ar, FMersenneTwister& MersenneTwister)
-	{
-		return Ar << MersenneTwister.InitialSeed << MersenneTwister.Engine << MersenneTwister.bIsInitialized;
+		Engine.SetState(State, 0, UnknownDrawCount);
 	}
 
-	bool Serialize(FArchive& Ar)
+	/**
+	 * Re-derives the engine state from the initial seed and a draw count written in compact form.
+	 */
+	bool Replay(const uint64 DrawCount)
 	{
-		Ar << *this;
-		return true;
-	}
+		Engine.Seed(InitialSeed);
 
-	friend void operator<<(FStructuredArchive::FSlot Slot, FMersenneTwister& MersenneTwister)
-	{
-		Slot << MersenneTwister.InitialSeed;
-		Slot << MersenneTwister.Engine;
-		Slot << MersenneTwister.bIsInitialized;
-	}
+		if (StreamIndex != 0 || DrawCount > MaxCompactDrawCount)
+		{
+			StreamIndex = 0;
+			return false;
+		}
 
-	bool Serialize(const FStructuredArchive::FSlot Slot)
-	{
-		Slot << *this;
+		Engine.Discard(DrawCount);
 		return true;
 	}
 };
 
-const FName RandomAccessToEmptyArrayWarning = FName("RandomAccessToEmptyArrayWarning");
+template <>
+struct TStructOpsTypeTraits<FMersenneTwister> : TStructOpsTypeTraitsBase2<FMersenneTwister>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithStructuredSerializer = true,
+		WithPostSerialize = true,
+		WithIdentical = true,
+		WithNetSerializer = true,
+		WithNetDeltaSerializer = true,
+	};
+};
 
 UCLASS()
-class APOLOGUECORE_API UMersenneTwisterLibrary : public UBlueprintFunctionLibrary
+class APOLOGUECORE_API UMersenneTwisterLibrary : public UApologueRandomLibrary
 {
 	GENERATED_BODY()
 
-	static bool EnsureInitialized(const FMersenneTwister& MersenneTwister)
-	{
-		if (MersenneTwister.IsInitialized())
-		{
-			return true;
-		}
-
-		ThrowBlueprintException();
-		return false;
-	}
-
-	static void ThrowBlueprintException()
-	{
-		const UObject* ActiveObject = nullptr;
-		const FBlueprintExceptionInfo Info(EBlueprintExceptionType::NonFatalError);
-		FFrame& StackFrame = *(FBlueprintContextTracker::Get().GetCurrentScriptStackWritable().Last());
-		FBlueprintCoreDelegates::ThrowScriptException(ActiveObject, StackFrame, Info);
-	}
-
 public:
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister")
 	static FORCEINLINE bool GetInitialSeed(UPARAM(Ref) const FMersenneTwister& MersenneTwister, int64& InitialSeed)
@@ -514,17 +527,36 @@ public:
 	}
 
 	/**
-	 * Obtains a random bool.
+	 * Marks a replicated twister dirty for the push model. Call it after drawing from a twister that is a replicated
+	 * property, since draws change none of its properties.
 	 */
-	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random Bool")
-	static FORCEINLINE bool RandBool(UPARAM(Ref) const FMersenneTwister& MersenneTwister)
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="Apologue|Random|Mersenne Twister")
+	static FORCEINLINE void MarkMersenneTwisterDirty(UPARAM(Ref) FMersenneTwister& MersenneTwister)
 	{
-		if (EnsureInitialized(MersenneTwister))
+		// see execMarkMersenneTwisterDirty for implementation
+		check(0);
+	}
+
+	/**
+	 * Derives Num twisters that never overlap this one or each other, e.g. one per parallel task.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister")
+	static FORCEINLINE void Split(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const int32 Num, TArray<FMersenneTwister>& Streams)
+	{
+		Streams.Reset();
+		if (EnsureInitialized(MersenneTwister) && Num > 0)
 		{
-			return MersenneTwister.RandHelper(2) == 1;
+			MersenneTwister.Split(Num, Streams);
 		}
+	}
 
-		return false;
+	/**
+	 * Obtains a random bool.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random Bool")
+	static FORCEINLINE bool RandBool(UPARAM(Ref) const FMersenneTwister& MersenneTwister)
+	{
+		return GenericRandBool(MersenneTwister);
 	}
 
 	/**
@@ -533,12 +565,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random Range (Integer)")
 	static FORCEINLINE int32 RandRange_Int32(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const int32 Min, const int32 Max)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.RandomRange(Min, Max);
-		}
-
-		return 0;
+		return GenericRandRange(MersenneTwister, Min, Max);
 	}
 
 	/**
@@ -547,12 +574,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random Range (Integer64)")
 	static FORCEINLINE int64 RandRange_Int64(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const int64 Min, const int64 Max)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.RandomRange(Min, Max);
-		}
-
-		return 0;
+		return GenericRandRange(MersenneTwister, Min, Max);
 	}
 
 	/**
@@ -561,12 +583,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random Range (Float)")
 	static FORCEINLINE double RandRange_Double(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const double Min, const double Max)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.RandomRange(Min, Max);
-		}
-
-		return 0.0;
+		return GenericRandRange(MersenneTwister, Min, Max);
 	}
 
 	/** 
@@ -598,18 +615,75 @@ public:
 		check(0);
 	}
 
+	/**
+	 * Moves a random sample of Count elements, in random order, to the front of the array. Costs O(Count) rather than
+	 * a full shuffle.
+	 *
+	 * @param MersenneTwister	The random stream.
+	 * @param TargetArray		The array.
+	 * @param Count				The number of elements to sample.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="Apologue|Random|Mersenne Twister", meta=(ArrayParm="TargetArray", Keywords="random sample"))
+	static FORCEINLINE void PartialShuffleArray(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const TArray<int32>& TargetArray, const int32 Count)
+	{
+		// see execPartialShuffleArray for implementation
+		check(0);
+	}
+
+	/**
+	 * Picks Count distinct indices in [0, Num) in random order, in O(Count).
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", meta=(Keywords="random sample"))
+	static FORCEINLINE TArray<int32> SampleIndices(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const int32 Num, const int32 Count)
+	{
+		return GenericSampleIndices(MersenneTwister, Num, Count);
+	}
+
 	/**
 	 * Obtains a random value in [0.0, 1.0).
 	 */
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister")
 	static FORCEINLINE double RandomFraction(UPARAM(Ref) const FMersenneTwister& MersenneTwister)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.GetFraction<double>();
-		}
+		return GenericRandomFraction(MersenneTwister);
+	}
+
+	/**
+	 * Obtains a normally distributed value.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", meta=(Keywords="gaussian"))
+	static FORCEINLINE double RandomNormal(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const double Mean = 0.0, const double StandardDeviation = 1.0)
+	{
+		return GenericRandomNormal(MersenneTwister, Mean, StandardDeviation);
+	}
+
+	/**
+	 * Obtains an exponentially distributed value, such as the time until an event that happens Rate times per unit of
+	 * time on average.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister")
+	static FORCEINLINE double RandomExponential(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const double Rate = 1.0)
+	{
+		return GenericRandomExponential(MersenneTwister, Rate);
+	}
 
-		return 0.0;
+	/**
+	 * Obtains a Poisson distributed count, such as the number of events in a span in which Mean of them happen on
+	 * average.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister")
+	static FORCEINLINE int64 RandomPoisson(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const double Mean)
+	{
+		return GenericRandomPoisson(MersenneTwister, Mean);
+	}
+
+	/**
+	 * Obtains the number of successes in Trials trials that each succeed with the given probability.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister")
+	static FORCEINLINE int32 RandomBinomial(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const int32 Trials, const double Probability)
+	{
+		return GenericRandomBinomial(MersenneTwister, Trials, Probability);
 	}
 
 	/**
@@ -618,12 +692,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister")
 	static FORCEINLINE FVector RandomUnitVector(UPARAM(Ref) const FMersenneTwister& MersenneTwister)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.GetUnitVector();
-		}
-
-		return FVector::ZeroVector;
+		return GenericRandomUnitVector(MersenneTwister);
 	}
 
 	/**
@@ -632,12 +701,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random Point in Unit Circle")
 	static FORCEINLINE FVector2D RandomPointInUnitCircle(UPARAM(Ref) const FMersenneTwister& MersenneTwister)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.GetPointInUnitCircle();
-		}
-
-		return FVector2D::ZeroVector;
+		return GenericRandomPointInUnitCircle(MersenneTwister);
 	}
 
 	/**
@@ -646,12 +710,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random Point in Unit Sphere")
 	static FORCEINLINE FVector RandomPointInUnitSphere(UPARAM(Ref) const FMersenneTwister& MersenneTwister)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.GetPointInUnitSphere();
-		}
-
-		return FVector::ZeroVector;
+		return GenericRandomPointInUnitSphere(MersenneTwister);
 	}
 
 	/**
@@ -660,12 +719,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random Point in Bounding Box")
 	static FORCEINLINE FVector RandomPointInBoundingBox(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const FVector& Center, const FVector& HalfSize)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.GetPointInBoundingBox(Center, HalfSize);
-		}
-
-		return FVector::ZeroVector;
+		return GenericRandomPointInBoundingBox(MersenneTwister, Center, HalfSize);
 	}
 
 	/**
@@ -674,12 +728,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random Point in Box")
 	static FORCEINLINE FVector RandomPointInBox(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const FBox& Box)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.GetPointInBox(Box);
-		}
-
-		return FVector::ZeroVector;
+		return GenericRandomPointInBox(MersenneTwister, Box);
 	}
 
 	/**
@@ -693,12 +742,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random Cone")
 	static FORCEINLINE FVector RandomCone(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const FVector& Direction, const double HalfAngle)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.GetCone(Direction, FMath::DegreesToRadians(HalfAngle));
-		}
-
-		return FVector::ZeroVector;
+		return GenericRandomCone(MersenneTwister, Direction, HalfAngle);
 	}
 
 	/**
@@ -714,84 +758,22 @@ public:
 	static FORCEINLINE FVector GetConeWithVertical(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const FVector& Direction, const double HalfAngle,
 	                                               const double VerticalHalfAngle)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.GetCone(Direction, FMath::DegreesToRadians(HalfAngle), FMath::DegreesToRadians(VerticalHalfAngle));
-		}
-
-		return FVector::ZeroVector;
+		return GenericRandomCone(MersenneTwister, Direction, HalfAngle, VerticalHalfAngle);
 	}
 
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random from Fraction (Integer)")
 	static FORCEINLINE int32 RandomFromFraction_Int32(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const int32 Numerator, const int32 Denominator)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.RandomFromFraction(Numerator, Denominator);
-		}
-
-		return 0;
+		return GenericRandomFromFraction(MersenneTwister, Numerator, Denominator);
 	}
 
 	UFUNCTION(BlueprintCallable, Category="Apologue|Random|Mersenne Twister", DisplayName="Random from Fraction (Integer64)")
 	static FORCEINLINE int64 RandomFromFraction_Int64(UPARAM(Ref) const FMersenneTwister& MersenneTwister, const int64 Numerator, const int64 Denominator)
 	{
-		if (EnsureInitialized(MersenneTwister))
-		{
-			return MersenneTwister.RandomFromFraction(Numerator, Denominator);
-		}
-
-		return 0;
+		return GenericRandomFromFraction(MersenneTwister, Numerator, Denominator);
 	}
 
 private:
-	// ReSharper disable CppParameterMayBeConstPtrOrRef
-	static FORCEINLINE void GenericRandArray(void* TargetArray, const FArrayProperty* ArrayProperty, FMersenneTwister* MersenneTwister, void* OutElement, int32* OutIndex)
-	// ReSharper restore CppParameterMayBeConstPtrOrRef
-	{
-		*OutIndex = INDEX_NONE;
-		if (!TargetArray || !MersenneTwister)
-		{
-			return;
-		}
-
-		FScriptArrayHelper ArrayHelper(ArrayProperty, TargetArray);
-		const FProperty* InnerProp = ArrayProperty->Inner;
-
-		if (ArrayHelper.Num() > 0)
-		{
-			const int32 Index = MersenneTwister->RandHelper(ArrayHelper.Num());
-
-			InnerProp->CopySingleValueToScriptVM(OutElement, ArrayHelper.GetRawPtr(Index));
-			*OutIndex = Index;
-			return;
-		}
-
-		FFrame::KismetExecutionMessage(*FString::Printf(TEXT("Attempted to access random index from empty array!")), ELogVerbosity::Warning, RandomAccessToEmptyArrayWarning);
-		InnerProp->InitializeValue(OutElement);
-	}
-
-	// ReSharper disable CppParameterMayBeConstPtrOrRef
-	static FORCEINLINE void GenericShuffleArray(void* TargetArray, const FArrayProperty* ArrayProperty, FMersenneTwister* MersenneTwister)
-	// ReSharper restore CppParameterMayBeConstPtrOrRef
-	{
-		if (!TargetArray || !MersenneTwister)
-		{
-			return;
-		}
-
-		FScriptArrayHelper ArrayHelper(ArrayProperty, TargetArray);
-		const int32 LastIndex = ArrayHelper.Num() - 1;
-		for (int32 i = 0; i <= LastIndex; ++i)
-		{
-			const int32 Index = MersenneTwister->RandomRange(i, LastIndex);
-			if (i != Index)
-			{
-				ArrayHelper.SwapValues(i, Index);
-			}
-		}
-	}
-
 	DECLARE_FUNCTION(execRandomElementInArray)
 	{
 		Stack.MostRecentProperty = nullptr;
@@ -844,4 +826,44 @@ private:
 			GenericShuffleArray(ArrayAddr, ArrayProperty, MersenneTwister);
 		P_NATIVE_END;
 	}
+
+	DECLARE_FUNCTION(execPartialShuffleArray)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		FMersenneTwister* MersenneTwister = reinterpret_cast<FMersenneTwister*>(Stack.MostRecentPropertyAddress);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FIntProperty, Count);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+			MARK_PROPERTY_DIRTY(Stack.Object, ArrayProperty);
+			GenericShuffleArray(ArrayAddr, ArrayProperty, MersenneTwister, Count);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execMarkMersenneTwisterDirty)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FStructProperty>(nullptr);
+		const FStructProperty* TwisterProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+			if (TwisterProperty)
+			{
+				MARK_PROPERTY_DIRTY(Stack.Object, TwisterProperty);
+			}
+		P_NATIVE_END;
+	}
 };
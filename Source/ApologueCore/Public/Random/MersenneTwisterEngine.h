@@ -0,0 +1,184 @@
+// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Portable 64-bit Mersenne Twister (MT19937-64).
+ *
+ * Produces exactly the same sequence as std::mt19937_64 for the same seed, but keeps its state in a form that is
+ * identical on every platform and standard library so that it can be inspected and serialized.
+ *
+ * The state is a ring of the last StateSize generated words; each draw replaces the oldest word with the next one.
+ */
+class FMersenneTwisterEngine
+{
+public:
+	typedef uint64 result_type;
+
+	static constexpr int32 StateSize = 312;
+	static constexpr int32 ShiftSize = 156;
+	static constexpr uint64 DefaultSeed = 5489;
+	static constexpr int32 JumpDistanceLog2 = 128;
+
+private:
+	static constexpr uint64 MatrixA = 0xB5026F5AA96619E9ull;
+	static constexpr uint64 UpperMask = 0xFFFFFFFF80000000ull;
+	static constexpr uint64 LowerMask = 0x000000007FFFFFFFull;
+
+	uint64 State[StateSize];
+
+	// Position of the oldest word in State
+	int32 Index = 0;
+
+	// Number of words drawn since the engine was last seeded or jumped
+	uint64 DrawCount = 0;
+
+public:
+	FMersenneTwisterEngine()
+	{
+		Seed(DefaultSeed);
+	}
+
+	explicit FMersenneTwisterEngine(const uint64 InSeed)
+	{
+		Seed(InSeed);
+	}
+
+	void Seed(const uint64 InSeed)
+	{
+		State[0] = InSeed;
+		for (int32 I = 1; I < StateSize; ++I)
+		{
+			State[I] = 6364136223846793005ull * (State[I - 1] ^ (State[I - 1] >> 62)) + I;
+		}
+
+		Index = 0;
+		DrawCount = 0;
+	}
+
+	FORCEINLINE uint64 Next()
+	{
+		++DrawCount;
+		return Temper(Step());
+	}
+
+	/**
+	 * Advances the engine as if Count words had been drawn.
+	 */
+	void Discard(uint64 Count)
+	{
+		while (Count-- > 0)
+		{
+			Next();
+		}
+	}
+
+	/**
+	 * Advances the engine by 2^JumpDistanceLog2 words and restarts the draw count. Jumping repeatedly from one seed gives
+	 * non-overlapping substreams. Costs about as much as drawing a few million words, so jump when setting streams up
+	 * rather than while drawing.
+	 */
+	APOLOGUECORE_API void Jump();
+
+	FORCEINLINE int32 GetStateIndex() const
+	{
+		return Index;
+	}
+
+	FORCEINLINE uint64 GetDrawCount() const
+	{
+		return DrawCount;
+	}
+
+	/**
+	 * @return The state words in ring order; the oldest word is at GetStateIndex().
+	 */
+	FORCEINLINE TConstArrayView<uint64> GetState() const
+	{
+		return MakeArrayView(State, StateSize);
+	}
+
+	void SetState(const TConstArrayView<uint64> InState, const int32 InIndex, const uint64 InDrawCount)
+	{
+		check(InState.Num() == StateSize);
+		check(InIndex >= 0 && InIndex < StateSize);
+
+		FMemory::Memcpy(State, InState.GetData(), sizeof(State));
+		Index = InIndex;
+		DrawCount = InDrawCount;
+	}
+
+	// UniformRandomBitGenerator
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return MAX_uint64; }
+	FORCEINLINE result_type operator()() { return Next(); }
+
+	friend bool operator==(const FMersenneTwisterEngine& A, const FMersenneTwisterEngine& B)
+	{
+		for (int32 I = 0; I < StateSize; ++I)
+		{
+			if (A.State[(A.Index + I) % StateSize] != B.State[(B.Index + I) % StateSize])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	friend bool operator!=(const FMersenneTwisterEngine& A, const FMersenneTwisterEngine& B)
+	{
+		return !(A == B);
+	}
+
+	// Serialization of the raw state
+	friend FArchive& operator<<(FArchive& Ar, FMersenneTwisterEngine& Engine)
+	{
+		for (int32 I = 0; I < StateSize; ++I)
+		{
+			Ar << Engine.State[I];
+		}
+
+		Ar << Engine.Index;
+		Ar << Engine.DrawCount;
+
+		if (Ar.IsLoading() && (Engine.Index < 0 || Engine.Index >= StateSize))
+		{
+			Ar.SetError();
+			Engine.Seed(DefaultSeed);
+		}
+
+		return Ar;
+	}
+
+private:
+	/**
+	 * Replaces the oldest word with the next one.
+	 *
+	 * @return The new word before tempering.
+	 */
+	FORCEINLINE uint64 Step()
+	{
+		const int32 NextIndex = Index + 1 == StateSize ? 0 : Index + 1;
+		const int32 ShiftIndex = Index + ShiftSize >= StateSize ? Index + ShiftSize - StateSize : Index + ShiftSize;
+
+		const uint64 Bits = (State[Index] & UpperMask) | (State[NextIndex] & LowerMask);
+		const uint64 Word = State[ShiftIndex] ^ (Bits >> 1) ^ ((Bits & 1) ? MatrixA : 0);
+
+		State[Index] = Word;
+		Index = NextIndex;
+
+		return Word;
+	}
+
+	static FORCEINLINE uint64 Temper(uint64 Word)
+	{
+		Word ^= (Word >> 29) & 0x5555555555555555ull;
+		Word ^= (Word << 17) & 0x71D67FFFEDA60000ull;
+		Word ^= (Word << 37) & 0xFFF7EEE000000000ull;
+		Word ^= Word >> 43;
+		return Word;
+	}
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ApologuePrimaryDataAsset.h"
 #include "ApologueStatFunction.h"
 #include "UObject/Object.h"
 #include "ApologueStat.generated.h"
@@ -13,7 +14,7 @@ class UApologueStatFunctionContext;
  * 
  */
 UCLASS(BlueprintType)
-class APOLOGUECORE_API UApologueStat final : public UDataAsset
+class APOLOGUECORE_API UApologueStat final : public UApologuePrimaryDataAsset
 {
 	GENERATED_BODY()
 
@@ -24,8 +25,14 @@ class APOLOGUECORE_API UApologueStat final : public UDataAsset
 	TObjectPtr<UApologueStatFunction> Function;
 	
 public:
+	static const FPrimaryAssetType PrimaryAssetType;
+
 	const FText& GetDisplayName() const { return DisplayName; }
 	
 	UFUNCTION(BlueprintPure)
 	int32 GetValue(const int32 BaseValue, const UApologueStatFunctionContext* Context) const;
+
+protected:
+	// UApologuePrimaryDataAsset
+	virtual FPrimaryAssetType GetApologueAssetType() const override { return PrimaryAssetType; }
 };
@@ -0,0 +1,24 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueStatContainer.h"
+#include "Event/ApologueEventContext.h"
+#include "ApologueStatChangedEventContext.generated.h"
+
+/**
+ * Context for the event a stat container broadcasts when its stats change.
+ */
+UCLASS(BlueprintType)
+class APOLOGUECORE_API UApologueStatChangedEventContext : public UApologueEventContext
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly)
+	TObjectPtr<UApologueStatContainer> Container;
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FApologueStatChange> Changes;
+};
@@ -0,0 +1,103 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueStatTable.h"
+#include "UObject/Object.h"
+#include "ApologueStatContainer.generated.h"
+
+class UApologueEvent;
+class UApologueStatContainer;
+
+USTRUCT(BlueprintType)
+struct APOLOGUECORE_API FApologueStatChange
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	TSoftObjectPtr<UApologueStat> Stat;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 OldValue = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NewValue = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FApologueStatsChangedDelegate, UApologueStatContainer*, Container, const TArray<FApologueStatChange>&, Changes);
+
+/**
+ * Stat table that records which stats were written and notifies listeners once per frame
+ * with every stat whose value changed since the last notification.
+ *
+ * Containers outside a world have no frame to be flushed at; their changes stay pending until FlushChanges is called.
+ */
+UCLASS(BlueprintType)
+class APOLOGUECORE_API UApologueStatContainer : public UObject
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess))
+	FApologueStatTable Table;
+
+	// Optional event broadcast through the outer's IApologueEventBroadcasterInterface alongside OnStatsChanged.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(AllowPrivateAccess))
+	TSoftObjectPtr<UApologueEvent> ChangedEvent;
+
+	// One bit per table entry, set on the first change of that entry since the last flush
+	TBitArray<> DirtyStats;
+
+	// Value of each dirty entry before its first change since the last flush
+	TArray<int32> OldValues;
+
+	bool bIsFlushQueued = false;
+
+	// Set once the missing world has been reported for the pending changes
+	bool bHasWarnedNoWorld = false;
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FApologueStatsChangedDelegate OnStatsChanged;
+
+	const FApologueStatTable& GetTable() const { return Table; }
+
+	/**
+	 * Replaces the table without notifying listeners and discards any pending changes.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Stat|Stat Container")
+	void Initialize(const FApologueStatTable& InTable);
+
+	UFUNCTION(BlueprintPure, Category="Apologue|Stat|Stat Container", meta=(AutoCreateRefTerm="Stat"))
+	UPARAM(DisplayName="bSuccess") bool TryGet(const TSoftObjectPtr<UApologueStat>& Stat, int32& OutValue) const;
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Stat|Stat Container", meta=(AutoCreateRefTerm="Stat"))
+	UPARAM(DisplayName="bSuccess") bool TrySet(const TSoftObjectPtr<UApologueStat>& Stat, const int32 NewValue);
+
+	UFUNCTION(BlueprintCallable, Category="Apologue|Stat|Stat Container", meta=(AutoCreateRefTerm="Stat"))
+	UPARAM(DisplayName="bSuccess") bool TryAdd(const TSoftObjectPtr<UApologueStat>& Stat, const int32 Delta);
+
+	/**
+	 * @return Whether the next flush will report any changes. Stats that were changed and then set back to their previous value are not pending.
+	 */
+	UFUNCTION(BlueprintPure, Category="Apologue|Stat|Stat Container")
+	bool HasPendingChanges() const;
+
+	/**
+	 * Delivers pending changes immediately instead of waiting for the end of the frame.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Apologue|Stat|Stat Container")
+	void FlushChanges();
+
+	/**
+	 * Moves the pending changes into OutChanges without notifying anyone.
+	 * Stats that were changed and then set back to their previous value are not reported.
+	 */
+	void ConsumeChanges(TArray<FApologueStatChange>& OutChanges);
+
+private:
+	void SetValueAt(const int32 Index, const int32 NewValue);
+
+	// Resizes DirtyStats and OldValues to the table, which entries are matched with by index
+	void SyncDirtyStats();
+};
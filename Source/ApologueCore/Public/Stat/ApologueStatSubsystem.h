@@ -0,0 +1,30 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ApologueStatSubsystem.generated.h"
+
+class UApologueStatContainer;
+
+/**
+ * Delivers the changes of every stat container written to during the frame, once per container, at the end of the frame.
+ */
+UCLASS()
+class APOLOGUECORE_API UApologueStatSubsystem final : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	TArray<TWeakObjectPtr<UApologueStatContainer>> PendingContainers;
+
+	// Swapped with PendingContainers while flushing so containers written to by listeners are delivered next frame
+	TArray<TWeakObjectPtr<UApologueStatContainer>> FlushingContainers;
+
+public:
+	void QueueFlush(UApologueStatContainer* Container);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+};
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "ApologueCoreCustomVersion.h"
+
 #include "ApologueStatTable.generated.h"
 
 class UApologueStat;
@@ -29,6 +31,16 @@ struct FApologueStatTableEntry
 	{
 	}
 
+	friend bool operator==(const FApologueStatTableEntry& A, const FApologueStatTableEntry& B)
+	{
+		return A.Stat == B.Stat && A.Value == B.Value;
+	}
+
+	friend bool operator!=(const FApologueStatTableEntry& A, const FApologueStatTableEntry& B)
+	{
+		return !(A == B);
+	}
+
 	// Serialization
 	friend FArchive& operator<<(FArchive& Ar, FApologueStatTableEntry& StatTypeValue)
 	{
@@ -57,6 +69,68 @@ struct FApologueStatTableEntry
 };
 
 
+// Immutable view of a stat table's entries at the time it was captured.
+// Snapshots share the table's buffer until its next write, which copies the entries rather than changing them.
+struct FApologueStatTableSnapshot
+{
+	typedef TSharedPtr<const TArray<FApologueStatTableEntry>, ESPMode::ThreadSafe> FEntriesPtr;
+
+	FApologueStatTableSnapshot()
+	{
+	}
+
+	explicit FApologueStatTableSnapshot(const FEntriesPtr& InEntries)
+		: Entries(InEntries)
+	{
+	}
+
+	bool IsValid() const
+	{
+		return Entries.IsValid();
+	}
+
+	int32 Num() const
+	{
+		return Entries.IsValid() ? Entries->Num() : 0;
+	}
+
+	bool TryGet(const TSoftObjectPtr<UApologueStat>& Stat, int32& OutValue) const
+	{
+		if (Entries.IsValid())
+		{
+			if (const FApologueStatTableEntry* EntryPtr = Entries->FindByPredicate([&Stat](const FApologueStatTableEntry& Entry)-> bool
+			{
+				return Entry.Stat == Stat;
+			}))
+			{
+				OutValue = EntryPtr->Value;
+				return true;
+			}
+		}
+
+		OutValue = int32();
+		return false;
+	}
+
+	bool SharesBufferWith(const FApologueStatTableSnapshot& Other) const
+	{
+		return Entries.IsValid() && Entries == Other.Entries;
+	}
+
+private:
+	friend struct FApologueStatTable;
+
+	FEntriesPtr Entries;
+};
+
+/**
+ * Stats and their values, in the order they were added.
+ *
+ * The entries are shared copy-on-write with snapshots and with copies of the table, so capturing, restoring and
+ * copying a table only copy a pointer, and the first write after one of them copies the entries. They are therefore
+ * not a reflected property: the table is saved, replicated, compared and exported as text by its own serializers,
+ * and is edited through the Make node or UApologueStatContainer rather than the details panel.
+ */
 USTRUCT(BlueprintType,
 	meta=(HasNativeMake="/Script/ApologueCore.ApologueStatTableFunctionLibrary:Make", HasNativeBreak="/Script/ApologueCore.ApologueStatTableFunctionLibrary:Break"))
 struct FApologueStatTable
@@ -66,8 +140,43 @@ struct FApologueStatTable
 	friend class UApologueStatTableFunctionLibrary;
 
 private:
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess))
-	TArray<FApologueStatTableEntry> Entries;
+	typedef TSharedPtr<TArray<FApologueStatTableEntry>, ESPMode::ThreadSafe> FEntriesPtr;
+
+	// Null until the first write and after Reset
+	FEntriesPtr Entries;
+
+	// Tables saved before NativeStatTable held their entries in this property; moved into Entries once loaded
+	UPROPERTY()
+	TArray<FApologueStatTableEntry> Entries_DEPRECATED;
+
+	const TArray<FApologueStatTableEntry>& GetEntries() const
+	{
+		static const TArray<FApologueStatTableEntry> NoEntries;
+		return Entries.IsValid() ? *Entries : NoEntries;
+	}
+
+	// Copies the entries first if a snapshot or another table still shares them
+	TArray<FApologueStatTableEntry>& GetMutableEntries()
+	{
+		if (!Entries.IsValid())
+		{
+			Entries = MakeShared<TArray<FApologueStatTableEntry>, ESPMode::ThreadSafe>();
+		}
+		else if (!Entries.IsUnique())
+		{
+			Entries = MakeShared<TArray<FApologueStatTableEntry>, ESPMode::ThreadSafe>(*Entries);
+		}
+
+		return *Entries;
+	}
+
+	static const FArrayProperty* GetEntriesProperty()
+	{
+		// The deprecated property is reflected without its suffix
+		static const FArrayProperty* Property = FindFProperty<FArrayProperty>(StaticStruct(), TEXT("Entries"));
+		check(Property);
+		return Property;
+	}
 
 public:
 	FApologueStatTable()
@@ -76,14 +185,14 @@ public:
 
 	explicit FApologueStatTable(const TArray<TSoftObjectPtr<UApologueStat>>& Stats, const int32 DefaultValue, const bool bKeepExistingValues = false)
 	{
-		Entries = TArray<FApologueStatTableEntry>();
-		Entries.Reserve(Stats.Num());
+		TArray<FApologueStatTableEntry> NewEntries;
+		NewEntries.Reserve(Stats.Num());
 
 		for (const TSoftObjectPtr<UApologueStat>& Stat : Stats)
 		{
 			if (!bKeepExistingValues)
 			{
-				Entries.Add(FApologueStatTableEntry(Stat, DefaultValue));
+				NewEntries.Add(FApologueStatTableEntry(Stat, DefaultValue));
 				continue;
 			}
 
@@ -93,8 +202,10 @@ public:
 				Value = DefaultValue;
 			}
 
-			Entries.Add(FApologueStatTableEntry(Stat, Value));
+			NewEntries.Add(FApologueStatTableEntry(Stat, Value));
 		}
+
+		Entries = MakeShared<TArray<FApologueStatTableEntry>, ESPMode::ThreadSafe>(MoveTemp(NewEntries));
 	}
 
 	explicit FApologueStatTable(const TArray<FApologueStatTableEntry>& InEntries)
@@ -103,14 +214,14 @@ public:
 		{
 			if (ensure(!TrySet(Entry.Stat, Entry.Value)))
 			{
-				Entries.Add(Entry);
+				GetMutableEntries().Add(Entry);
 			}
 		}
 	}
 
 	bool IsValid() const
 	{
-		return !Entries.IsEmpty();
+		return !GetEntries().IsEmpty();
 	}
 
 	void Reset()
@@ -120,31 +231,27 @@ public:
 
 	bool Has(const TSoftObjectPtr<UApologueStat>& Stat) const
 	{
-		return !!Entries.FindByPredicate([&Stat](const FApologueStatTableEntry& Entry)-> bool
-		{
-			return Entry.Stat == Stat;
-		});
+		return IndexOf(Stat) != INDEX_NONE;
 	}
 
+	/**
+	 * The returned reference is only valid until the table is next captured, restored or copied.
+	 */
 	int32& Get(const TSoftObjectPtr<UApologueStat>& StatType)
 	{
-		FApologueStatTableEntry* EntryPtr = Entries.FindByPredicate([&StatType](const FApologueStatTableEntry& Entry)-> bool
-		{
-			return Entry.Stat == StatType;
-		});
+		const int32 Index = IndexOf(StatType);
+		check(Index != INDEX_NONE);
 
-		check(EntryPtr);
-		return EntryPtr->Value;
+		// The caller may write through the returned reference
+		return GetMutableEntries()[Index].Value;
 	}
 
 	bool TryGet(const TSoftObjectPtr<UApologueStat>& Stat, int32& OutValue) const
 	{
-		if (const FApologueStatTableEntry* EntryPtr = Entries.FindByPredicate([&Stat](const FApologueStatTableEntry& Entry)-> bool
-		{
-			return Entry.Stat == Stat;
-		}))
+		const int32 Index = IndexOf(Stat);
+		if (Index != INDEX_NONE)
 		{
-			OutValue = EntryPtr->Value;
+			OutValue = GetEntries()[Index].Value;
 			return true;
 		}
 
@@ -154,21 +261,41 @@ public:
 
 	bool TrySet(const TSoftObjectPtr<UApologueStat>& Stat, const int32& NewValue)
 	{
-		if (FApologueStatTableEntry* EntryPtr = Entries.FindByPredicate([&Stat](const FApologueStatTableEntry& Entry)-> bool
+		const int32 Index = IndexOf(Stat);
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		SetValueAt(Index, NewValue);
+		return true;
+	}
+
+	int32 IndexOf(const TSoftObjectPtr<UApologueStat>& Stat) const
+	{
+		return GetEntries().IndexOfByPredicate([&Stat](const FApologueStatTableEntry& Entry)-> bool
 		{
 			return Entry.Stat == Stat;
-		}))
+		});
+	}
+
+	const FApologueStatTableEntry& GetEntry(const int32 Index) const
+	{
+		return GetEntries()[Index];
+	}
+
+	void SetValueAt(const int32 Index, const int32 NewValue)
+	{
+		// Writing the same value does not copy the entries
+		if (GetEntries()[Index].Value != NewValue)
 		{
-			EntryPtr->Value = NewValue;
-			return true;
+			GetMutableEntries()[Index].Value = NewValue;
 		}
-
-		return false;
 	}
 
 	void ForEach(const TFunctionRef<void (const TSoftObjectPtr<UApologueStat>& Stat, const int32& Value)>& Function) const
 	{
-		for (const FApologueStatTableEntry& Entry : Entries)
+		for (const FApologueStatTableEntry& Entry : GetEntries())
 		{
 			Function(Entry.Stat, Entry.Value);
 		}
@@ -176,7 +303,7 @@ public:
 
 	void ForEach(const TFunctionRef<void (const TSoftObjectPtr<UApologueStat>& StatType, int32& Value)>& Function)
 	{
-		for (FApologueStatTableEntry& Entry : Entries)
+		for (FApologueStatTableEntry& Entry : GetMutableEntries())
 		{
 			Function(Entry.Stat, Entry.Value);
 		}
@@ -184,11 +311,12 @@ public:
 
 	bool Validate() const
 	{
+		const TArray<FApologueStatTableEntry>& Values = GetEntries();
 		for (int32 I = 0; I < Num(); ++I)
 		{
 			for (int32 J = I + 1; J < Num(); ++J)
 			{
-				if (Entries[I].Stat == Entries[J].Stat)
+				if (Values[I].Stat == Values[J].Stat)
 				{
 					return false;
 				}
@@ -198,10 +326,10 @@ public:
 		return true;
 	}
 
-	void GetValues(TArray<int32>& OutValues)
+	void GetValues(TArray<int32>& OutValues) const
 	{
 		OutValues.Reset(Num());
-		for (FApologueStatTableEntry& Entry : Entries)
+		for (const FApologueStatTableEntry& Entry : GetEntries())
 		{
 			OutValues.Add(Entry.Value);
 		}
@@ -210,7 +338,7 @@ public:
 	int32 GetTotal() const
 	{
 		int32 Total = 0;
-		for (const FApologueStatTableEntry& Entry : Entries)
+		for (const FApologueStatTableEntry& Entry : GetEntries())
 		{
 			Total += Entry.Value;
 		}
@@ -219,13 +347,13 @@ public:
 
 	int32 Num() const
 	{
-		return Entries.Num();
+		return GetEntries().Num();
 	}
 
 	float GetAverage() const
 	{
 		float Total = 0;
-		for (const FApologueStatTableEntry& Entry : Entries)
+		for (const FApologueStatTableEntry& Entry : GetEntries())
 		{
 			Total += Entry.Value;
 		}
@@ -235,11 +363,11 @@ public:
 	int32 GetMaxValue() const
 	{
 		int32 Max = TNumericLimits<int32>::Min();
-		for (int32 Index = 0; Index < Num(); ++Index)
+		for (const FApologueStatTableEntry& Entry : GetEntries())
 		{
-			if (Entries[Index].Value > Max)
+			if (Entry.Value > Max)
 			{
-				Max = Entries[Index].Value;
+				Max = Entry.Value;
 			}
 		}
 		return Max;
@@ -248,11 +376,11 @@ public:
 	int32 GetMinValue() const
 	{
 		int32 Min = TNumericLimits<int32>::Max();
-		for (int32 Index = 0; Index < Num(); ++Index)
+		for (const FApologueStatTableEntry& Entry : GetEntries())
 		{
-			if (Entries[Index].Value < Min)
+			if (Entry.Value < Min)
 			{
-				Min = Entries[Index].Value;
+				Min = Entry.Value;
 			}
 		}
 		return Min;
@@ -262,20 +390,20 @@ public:
 	{
 		int32 Max = TNumericLimits<int32>::Min();
 		OutMaxStats.Reset();
-		for (int32 Index = 0; Index < Num(); ++Index)
+		for (const FApologueStatTableEntry& Entry : GetEntries())
 		{
-			if (Entries[Index].Value < Max)
+			if (Entry.Value < Max)
 			{
 				continue;
 			}
 
-			if (Entries[Index].Value > Max)
+			if (Entry.Value > Max)
 			{
 				OutMaxStats.Reset();
 			}
 
-			Max = Entries[Index].Value;
-			OutMaxStats.Add(Entries[Index].Stat);
+			Max = Entry.Value;
+			OutMaxStats.Add(Entry.Stat);
 		}
 
 		return Max;
@@ -285,47 +413,186 @@ public:
 	{
 		int32 Min = TNumericLimits<int32>::Max();
 		OutMinStats.Reset();
-		for (int32 Index = 0; Index < Num(); ++Index)
+		for (const FApologueStatTableEntry& Entry : GetEntries())
 		{
-			if (Entries[Index].Value > Min)
+			if (Entry.Value > Min)
 			{
 				continue;
 			}
 
-			if (Entries[Index].Value < Min)
+			if (Entry.Value < Min)
 			{
 				OutMinStats.Reset();
 			}
 
-			Min = Entries[Index].Value;
-			OutMinStats.Add(Entries[Index].Stat);
+			Min = Entry.Value;
+			OutMinStats.Add(Entry.Stat);
 		}
 
 		return Min;
 	}
 
+	/**
+	 * Captures the current entries by sharing them with the table. The table's next write copies them.
+	 */
+	FApologueStatTableSnapshot CaptureSnapshot() const
+	{
+		if (!Entries.IsValid())
+		{
+			// Empty tables share no buffer, so give the snapshot its own
+			return FApologueStatTableSnapshot(MakeShared<const TArray<FApologueStatTableEntry>, ESPMode::ThreadSafe>());
+		}
+
+		return FApologueStatTableSnapshot(Entries);
+	}
+
+	/**
+	 * Restores the entries from a snapshot by sharing its buffer. The table's next write copies them.
+	 */
+	void RestoreSnapshot(const FApologueStatTableSnapshot& Snapshot)
+	{
+		check(Snapshot.IsValid());
+
+		// Never written through while the snapshot holds it, since writes copy shared entries first
+		Entries = ConstCastSharedPtr<TArray<FApologueStatTableEntry>>(Snapshot.Entries);
+	}
+
 	// Serialization
 	friend FArchive& operator<<(FArchive& Ar, FApologueStatTable& StatTable)
 	{
-		return Ar << StatTable.Entries;
+		Ar.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+
+		if (Ar.IsLoading())
+		{
+			TArray<FApologueStatTableEntry> LoadedEntries;
+			Ar << LoadedEntries;
+			StatTable.Entries = MakeShared<TArray<FApologueStatTableEntry>, ESPMode::ThreadSafe>(MoveTemp(LoadedEntries));
+		}
+		else
+		{
+			// Saving does not write to the entries, so they are not copied even if shared
+			Ar << const_cast<TArray<FApologueStatTableEntry>&>(StatTable.GetEntries());
+		}
+
+		return Ar;
 	}
 
 	bool Serialize(FArchive& Ar)
 	{
+		// Tables saved before the native format were tagged; returning false loads them that way
+		Ar.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+		if (Ar.IsLoading() && Ar.CustomVer(FApologueCoreCustomVersion::GUID) < FApologueCoreCustomVersion::NativeStatTable)
+		{
+			return false;
+		}
+
 		Ar << *this;
 		return true;
 	}
 
 	friend void operator<<(const FStructuredArchive::FSlot Slot, FApologueStatTable& StatTable)
 	{
-		Slot << StatTable.Entries;
+		FArchive& UnderlyingArchive = Slot.GetUnderlyingArchive();
+		UnderlyingArchive.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+
+		if (UnderlyingArchive.IsLoading())
+		{
+			TArray<FApologueStatTableEntry> LoadedEntries;
+			Slot << LoadedEntries;
+			StatTable.Entries = MakeShared<TArray<FApologueStatTableEntry>, ESPMode::ThreadSafe>(MoveTemp(LoadedEntries));
+		}
+		else
+		{
+			Slot << const_cast<TArray<FApologueStatTableEntry>&>(StatTable.GetEntries());
+		}
 	}
 
 	bool Serialize(const FStructuredArchive::FSlot Slot)
 	{
+		FArchive& UnderlyingArchive = Slot.GetUnderlyingArchive();
+		UnderlyingArchive.UsingCustomVersion(FApologueCoreCustomVersion::GUID);
+		if (UnderlyingArchive.IsLoading() && UnderlyingArchive.CustomVer(FApologueCoreCustomVersion::GUID) < FApologueCoreCustomVersion::NativeStatTable)
+		{
+			return false;
+		}
+
 		Slot << *this;
 		return true;
 	}
+
+	void PostSerialize(const FArchive& Ar)
+	{
+		if (Ar.IsLoading() && Ar.CustomVer(FApologueCoreCustomVersion::GUID) < FApologueCoreCustomVersion::NativeStatTable)
+		{
+			Entries = MakeShared<TArray<FApologueStatTableEntry>, ESPMode::ThreadSafe>(MoveTemp(Entries_DEPRECATED));
+			Entries_DEPRECATED.Empty();
+		}
+	}
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		Ar << *this;
+		bOutSuccess = !Ar.IsError();
+		return true;
+	}
+
+	bool Identical(const FApologueStatTable* Other, const uint32 PortFlags) const
+	{
+		return Entries == Other->Entries || GetEntries() == Other->GetEntries();
+	}
+
+	/**
+	 * Written in the same form the reflected Entries property was, so that text from before NativeStatTable still imports.
+	 */
+	bool ExportTextItem(FString& ValueStr, const FApologueStatTable& DefaultValue, UObject* Parent, const int32 PortFlags, UObject* ExportRootScope) const
+	{
+		ValueStr += TEXT("(Entries=");
+		GetEntriesProperty()->ExportTextItem_Direct(ValueStr, &GetEntries(), &DefaultValue.GetEntries(), Parent, PortFlags, ExportRootScope);
+		ValueStr += TEXT(")");
+		return true;
+	}
+
+	bool ImportTextItem(const TCHAR*& Buffer, const int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText)
+	{
+		static const TCHAR Prefix[] = TEXT("(Entries=");
+		const TCHAR* Text = Buffer;
+		if (FCString::Strnicmp(Text, Prefix, UE_ARRAY_COUNT(Prefix) - 1) != 0)
+		{
+			return false;
+		}
+
+		TArray<FApologueStatTableEntry> ImportedEntries;
+		Text = GetEntriesProperty()->ImportText_Direct(Text + UE_ARRAY_COUNT(Prefix) - 1, &ImportedEntries, Parent, PortFlags, ErrorText);
+		if (!Text)
+		{
+			return false;
+		}
+
+		FParse::Next(&Text);
+		if (*Text != TEXT(')'))
+		{
+			return false;
+		}
+
+		Buffer = Text + 1;
+		Entries = MakeShared<TArray<FApologueStatTableEntry>, ESPMode::ThreadSafe>(MoveTemp(ImportedEntries));
+		return true;
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FApologueStatTable> : TStructOpsTypeTraitsBase2<FApologueStatTable>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithStructuredSerializer = true,
+		WithPostSerialize = true,
+		WithNetSerializer = true,
+		WithIdentical = true,
+		WithExportTextItem = true,
+		WithImportTextItem = true,
+	};
 };
 
 UCLASS()
@@ -344,7 +611,7 @@ public:
 	UFUNCTION(BlueprintPure, Category="Pokémon Stat Table", meta=(NativeBreakFunc))
 	static void Break(const FApologueStatTable& StatTable, UPARAM(DisplayName="Data") TArray<FApologueStatTableEntry>& OutData)
 	{
-		OutData = StatTable.Entries;
+		OutData = StatTable.GetEntries();
 	}
 
 	UFUNCTION(BlueprintPure, Category="Pokémon Stat Table", meta=(AutoCreateRefTerm="StatType"))
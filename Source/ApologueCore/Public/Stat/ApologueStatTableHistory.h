@@ -0,0 +1,100 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ApologueStatTable.h"
+
+/**
+ * Fixed-capacity ring of per-tick stat table snapshots, used for rollback and undo.
+ * Capturing and restoring a tick copy nothing for tables that have not changed in between,
+ * since consecutive snapshots of an unchanged table share one buffer.
+ */
+class FApologueStatTableHistory
+{
+	struct FTickSnapshot
+	{
+		int64 Tick = INDEX_NONE;
+		FApologueStatTableSnapshot Snapshot;
+	};
+
+	TArray<FTickSnapshot> Frames;
+
+	int64 NewestTick = INDEX_NONE;
+
+public:
+	explicit FApologueStatTableHistory(const int32 Capacity)
+	{
+		check(Capacity > 0);
+		Frames.SetNum(Capacity);
+	}
+
+	int32 GetCapacity() const
+	{
+		return Frames.Num();
+	}
+
+	int64 GetNewestTick() const
+	{
+		return NewestTick;
+	}
+
+	int64 GetOldestTick() const
+	{
+		return NewestTick == INDEX_NONE ? INDEX_NONE : FMath::Max<int64>(0, NewestTick - Frames.Num() + 1);
+	}
+
+	/**
+	 * Records the table's state for the given tick, overwriting the oldest tick once the ring is full.
+	 */
+	void Capture(const int64 Tick, const FApologueStatTable& Table)
+	{
+		check(Tick >= 0);
+
+		FTickSnapshot& Frame = Frames[Tick % Frames.Num()];
+		Frame.Tick = Tick;
+		Frame.Snapshot = Table.CaptureSnapshot();
+
+		NewestTick = FMath::Max(NewestTick, Tick);
+	}
+
+	const FApologueStatTableSnapshot* Find(const int64 Tick) const
+	{
+		if (Tick < 0)
+		{
+			return nullptr;
+		}
+
+		const FTickSnapshot& Frame = Frames[Tick % Frames.Num()];
+		return Frame.Tick == Tick ? &Frame.Snapshot : nullptr;
+	}
+
+	/**
+	 * Restores the table to its state at the given tick.
+	 * Newer ticks are left in place and are overwritten as they are re-simulated and captured again.
+	 *
+	 * @return False if the tick is no longer (or was never) in the history.
+	 */
+	bool Restore(const int64 Tick, FApologueStatTable& Table) const
+	{
+		const FApologueStatTableSnapshot* Snapshot = Find(Tick);
+		if (!Snapshot)
+		{
+			return false;
+		}
+
+		Table.RestoreSnapshot(*Snapshot);
+		return true;
+	}
+
+	void Reset()
+	{
+		for (FTickSnapshot& Frame : Frames)
+		{
+			Frame.Tick = INDEX_NONE;
+			Frame.Snapshot = FApologueStatTableSnapshot();
+		}
+
+		NewestTick = INDEX_NONE;
+	}
+};
@@ -0,0 +1,161 @@
+﻿#if WITH_TESTS
+
+#include "Random/ApologueAliasTable.h"
+
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/TestHarnessAdapter.h"
+
+TEST_CASE_NAMED(FApologueAliasTableTest, "ApologueCore::AliasTable", "[Apologue][ApologueCore][AliasTable]")
+{
+	constexpr uint64 Seed = 0xDEADBEEF;
+
+	// Largest difference between the sampled frequency of each index and its probability
+	auto MeasureError = [](const FApologueAliasTable& Table, const FMersenneTwister& Twister, const int32 Samples)
+	{
+		TArray<int32> Counts;
+		Counts.SetNumZeroed(Table.Num());
+		for (int32 i = 0; i < Samples; i++)
+		{
+			Counts[Table.Sample(Twister)]++;
+		}
+
+		double MaxError = 0.0;
+		for (int32 Index = 0; Index < Table.Num(); Index++)
+		{
+			MaxError = FMath::Max(MaxError, FMath::Abs(static_cast<double>(Counts[Index]) / Samples - Table.GetProbability(Index)));
+		}
+
+		return MaxError;
+	};
+
+	SECTION("Distribution")
+	{
+		FMersenneTwister Twister;
+		Twister.Initialize(Seed);
+
+		const FApologueAliasTable Table(TArray<double>{1.0, 2.0, 3.0, 4.0, 0.0, 10.0});
+		CHECK(Table.GetProbability(5) == 0.5);
+		CHECK(MeasureError(Table, Twister, 200000) < 0.005);
+
+		bool bPickedZeroWeight = false;
+		for (int32 i = 0; i < 10000; i++)
+		{
+			bPickedZeroWeight |= Table.Sample(Twister) == 4;
+		}
+
+		CHECK(!bPickedZeroWeight);
+	}
+
+	SECTION("Degenerate Weights")
+	{
+		FMersenneTwister Twister;
+		Twister.Initialize(Seed);
+
+		CHECK(FApologueAliasTable().Sample(Twister) == INDEX_NONE);
+		CHECK(FApologueAliasTable(TArray<double>{0.0, -1.0}).Sample(Twister) == INDEX_NONE);
+		CHECK(FApologueAliasTable(TArray<double>{3.0}).Sample(Twister) == 0);
+	}
+
+	SECTION("Batched Rebuild")
+	{
+		FMersenneTwister Twister;
+		Twister.Initialize(Seed);
+
+		FApologueAliasTable Table(TArray<double>{1.0, 1.0, 1.0});
+		Table.SetWeight(0, 5.0);
+		Table.AddWeight(2.0);
+		Table.RemoveWeightAtSwap(1);
+		CHECK(Table.IsDirty());
+
+		Table.Rebuild();
+		CHECK(!Table.IsDirty());
+		CHECK(Table.Num() == 3);
+		CHECK(Table.GetWeight(1) == 2.0);
+		CHECK(Table.GetTotalWeight() == 8.0);
+		CHECK(MeasureError(Table, Twister, 100000) < 0.005);
+	}
+
+	SECTION("Deferred Blueprint Rebuild")
+	{
+		FMersenneTwister Twister;
+		Twister.Initialize(Seed);
+
+		FApologueAliasTable Table(TArray<double>{1.0, 0.0, 0.0});
+		UApologueAliasTableLibrary::SetAliasTableWeight(Table, 0, 0.0);
+		UApologueAliasTableLibrary::SetAliasTableWeight(Table, 2, 1.0);
+		CHECK(Table.IsDirty());
+
+		// The first sample after the changes rebuilds the table once
+		CHECK(UApologueAliasTableLibrary::SampleAliasTable(Table, Twister) == 2);
+		CHECK_FALSE(Table.IsDirty());
+	}
+
+	SECTION("Serialization")
+	{
+		FApologueAliasTable TableA(TArray<double>{1.0, 2.0, 3.0, 4.0});
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		FApologueAliasTable::StaticStruct()->SerializeItem(Writer, &TableA, nullptr);
+
+		FApologueAliasTable TableB;
+		FMemoryReader Reader(Bytes);
+		FApologueAliasTable::StaticStruct()->SerializeItem(Reader, &TableB, nullptr);
+
+		CHECK(!Reader.IsError());
+		CHECK(TableB.Num() == TableA.Num());
+
+		FMersenneTwister TwisterA;
+		TwisterA.Initialize(Seed);
+		FMersenneTwister TwisterB;
+		TwisterB.Initialize(Seed);
+
+		bool bMatches = true;
+		for (int32 i = 0; i < 1000; i++)
+		{
+			bMatches &= TableA.Sample(TwisterA) == TableB.Sample(TwisterB);
+		}
+
+		CHECK(bMatches);
+	}
+
+	SECTION("Corrupt Aliases")
+	{
+		const FApologueAliasTable TableA(TArray<double>{1.0, 2.0, 3.0, 4.0});
+
+		// Save a copy whose aliases point past the weights
+		FApologueAliasTable Corrupt = TableA;
+		const FArrayProperty* AliasesProperty = FindFProperty<FArrayProperty>(FApologueAliasTable::StaticStruct(), TEXT("Aliases"));
+		REQUIRE(AliasesProperty != nullptr);
+		*AliasesProperty->ContainerPtrToValuePtr<TArray<int32>>(&Corrupt) = {7, 7, 7};
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		FApologueAliasTable::StaticStruct()->SerializeItem(Writer, &Corrupt, nullptr);
+
+		FApologueAliasTable TableB;
+		FMemoryReader Reader(Bytes);
+		FApologueAliasTable::StaticStruct()->SerializeItem(Reader, &TableB, nullptr);
+
+		// Rebuilt from the weights, which is not an error
+		CHECK(!Reader.IsError());
+		CHECK_FALSE(TableB.IsDirty());
+		CHECK(TableB.Num() == TableA.Num());
+
+		FMersenneTwister TwisterA;
+		TwisterA.Initialize(Seed);
+		FMersenneTwister TwisterB;
+		TwisterB.Initialize(Seed);
+
+		bool bMatches = true;
+		for (int32 i = 0; i < 1000; i++)
+		{
+			bMatches &= TableA.Sample(TwisterA) == TableB.Sample(TwisterB);
+		}
+
+		CHECK(bMatches);
+	}
+}
+
+#endif
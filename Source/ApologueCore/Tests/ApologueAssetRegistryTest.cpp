@@ -0,0 +1,102 @@
+﻿#if WITH_TESTS
+
+#include "ApologueAssetRegistry.h"
+#include "ApologueCoreTestTypes.h"
+#include "Event/ApologueEvent.h"
+#include "Event/ApologueEventDispatcher.h"
+#include "Flag/ApologueFlag.h"
+#include "Stat/ApologueStat.h"
+
+#include "Engine/Engine.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeExit.h"
+#include "Tests/TestHarnessAdapter.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace ApologueAssetRegistryTest
+{
+	// Laid out as a saved asset: the only object of its package, and named after it
+	template <typename T>
+	TStrongObjectPtr<T> MakePackageAsset(const TCHAR* PackageName)
+	{
+		UPackage* Package = CreatePackage(PackageName);
+		return TStrongObjectPtr<T>(NewObject<T>(Package, FName(FPackageName::GetShortName(PackageName)), RF_Public | RF_Transient));
+	}
+
+	void SetParent(UApologueEvent* Event, UApologueEvent* Parent)
+	{
+		const FObjectProperty* Property = FindFProperty<FObjectProperty>(UApologueEvent::StaticClass(), TEXT("Parent"));
+		check(Property);
+		Property->SetObjectPropertyValue_InContainer(Event, Parent);
+		Event->RefreshAncestors();
+	}
+}
+
+TEST_CASE_NAMED(FApologueAssetRegistryTest, "ApologueCore::AssetRegistry", "[Apologue][ApologueCore][AssetRegistry]")
+{
+	using namespace ApologueAssetRegistryTest;
+
+	SECTION("Primary Asset Id")
+	{
+		// Same name, different folders
+		const TStrongObjectPtr<UApologueEvent> EventA = MakePackageAsset<UApologueEvent>(TEXT("/Temp/ApologueAssetRegistryTest/A/Event"));
+		const TStrongObjectPtr<UApologueEvent> EventB = MakePackageAsset<UApologueEvent>(TEXT("/Temp/ApologueAssetRegistryTest/B/Event"));
+		CHECK(EventA->GetPrimaryAssetId() == FPrimaryAssetId(UApologueEvent::PrimaryAssetType, TEXT("/Temp/ApologueAssetRegistryTest/A/Event")));
+		CHECK(EventA->GetPrimaryAssetId() != EventB->GetPrimaryAssetId());
+
+		const TStrongObjectPtr<UApologueStat> Stat = MakePackageAsset<UApologueStat>(TEXT("/Temp/ApologueAssetRegistryTest/Stat"));
+		CHECK(Stat->GetPrimaryAssetId() == FPrimaryAssetId(UApologueStat::PrimaryAssetType, TEXT("/Temp/ApologueAssetRegistryTest/Stat")));
+
+		const TStrongObjectPtr<UApologueFlag> Flag = MakePackageAsset<UApologueFlag>(TEXT("/Temp/ApologueAssetRegistryTest/Flag"));
+		CHECK(Flag->GetPrimaryAssetId() == FPrimaryAssetId(UApologueFlag::PrimaryAssetType, TEXT("/Temp/ApologueAssetRegistryTest/Flag")));
+
+		// Assets created at runtime share the transient package
+		const TStrongObjectPtr<UApologueEvent> TransientA(NewObject<UApologueEvent>(GetTransientPackage()));
+		const TStrongObjectPtr<UApologueEvent> TransientB(NewObject<UApologueEvent>(GetTransientPackage()));
+		CHECK(TransientA->GetPrimaryAssetId().IsValid());
+		CHECK(TransientA->GetPrimaryAssetId() != TransientB->GetPrimaryAssetId());
+	}
+
+	SECTION("Find")
+	{
+		REQUIRE(GEngine != nullptr);
+		UApologueAssetRegistry* AssetRegistry = GEngine->GetEngineSubsystem<UApologueAssetRegistry>();
+		REQUIRE(AssetRegistry != nullptr);
+
+		// Loaded assets resolve whether cached or not, and unloaded ones never load
+		const TStrongObjectPtr<UApologueEvent> Loaded(NewObject<UApologueEvent>(GetTransientPackage()));
+		CHECK(AssetRegistry->Find(TSoftObjectPtr<UApologueEvent>(Loaded.Get())) == Loaded.Get());
+
+		const TSoftObjectPtr<UApologueEvent> Unloaded(FSoftObjectPath(TEXT("/Temp/ApologueAssetRegistryTest/Unloaded.Unloaded")));
+		CHECK(AssetRegistry->Find(Unloaded) == nullptr);
+
+		// As the preload would, cache an event under a path nothing else resolves
+		const FMapProperty* Property = FindFProperty<FMapProperty>(UApologueAssetRegistry::StaticClass(), TEXT("ResolvedAssets"));
+		REQUIRE(Property != nullptr);
+		TMap<FSoftObjectPath, TObjectPtr<UObject>>& ResolvedAssets = *Property->ContainerPtrToValuePtr<TMap<FSoftObjectPath, TObjectPtr<UObject>>>(AssetRegistry);
+
+		const TStrongObjectPtr<UApologueEvent> Preloaded(NewObject<UApologueEvent>(GetTransientPackage()));
+		const TStrongObjectPtr<UApologueEvent> Parent(NewObject<UApologueEvent>(GetTransientPackage()));
+		SetParent(Preloaded.Get(), Parent.Get());
+
+		ResolvedAssets.Add(Unloaded.ToSoftObjectPath(), Preloaded.Get());
+		ON_SCOPE_EXIT
+		{
+			ResolvedAssets.Remove(Unloaded.ToSoftObjectPath());
+		};
+
+		CHECK(AssetRegistry->Find(Unloaded) == Preloaded.Get());
+
+		// The dispatcher finds the ancestors of events through the cache
+		const TStrongObjectPtr<UApologueTestEventListener> OnParent(NewObject<UApologueTestEventListener>(GetTransientPackage()));
+		OnParent->AddCallback(Parent.Get(), 0, 0);
+
+		FApologueEventDispatcher Dispatcher;
+		REQUIRE(Dispatcher.RegisterListener(OnParent.Get()));
+		CHECK(Dispatcher.Broadcast(Unloaded, nullptr) == 1);
+		CHECK(OnParent->NumCalls == 1);
+	}
+}
+
+#endif
@@ -0,0 +1,304 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#if WITH_TESTS
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+/**
+ * Timing result of a single benchmark case. Extra metrics (allocation counts, throughput, ...) go in Metrics.
+ */
+struct FApologueBenchmarkResult
+{
+	FString Name;
+	int64 Iterations = 0;
+	double TotalSeconds = 0.0;
+	double NanosecondsPerIteration = 0.0;
+	TMap<FString, double> Metrics;
+};
+
+/**
+ * Runs benchmark cases and writes their results as JSON so they can be compared between plugin versions.
+ *
+ * Results are written to <ProjectSaved>/Benchmarks/<Suite>.json, or to the directory given by -ApologueBenchmarkDir=.
+ */
+class FApologueBenchmarkSuite
+{
+	FString SuiteName;
+	TArray<FApologueBenchmarkResult> Results;
+
+	// Cases that could not run here, with the reason, so comparisons can tell them from removed cases
+	TMap<FString, FString> SkippedCases;
+
+public:
+	explicit FApologueBenchmarkSuite(const FString& InSuiteName)
+		: SuiteName(InSuiteName)
+	{
+	}
+
+	const TArray<FApologueBenchmarkResult>& GetResults() const
+	{
+		return Results;
+	}
+
+	/**
+	 * Times Iterations calls of Function after a short warm-up.
+	 */
+	template <typename FunctionType>
+	FApologueBenchmarkResult& Run(const FString& Name, const int64 Iterations, FunctionType&& Function)
+	{
+		check(Iterations > 0);
+
+		const int64 WarmUpIterations = FMath::Clamp<int64>(Iterations / 10, 1, 1000);
+		for (int64 Index = 0; Index < WarmUpIterations; ++Index)
+		{
+			Function();
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			Function();
+		}
+		const uint64 EndCycles = FPlatformTime::Cycles64();
+
+		FApologueBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+		Result.Name = Name;
+		Result.Iterations = Iterations;
+		Result.TotalSeconds = FPlatformTime::ToSeconds64(EndCycles - StartCycles);
+		Result.NanosecondsPerIteration = Result.TotalSeconds * 1.0e9 / static_cast<double>(Iterations);
+		return Result;
+	}
+
+	void Skip(const FString& Name, const FString& Reason)
+	{
+		SkippedCases.Add(Name, Reason);
+	}
+
+	const TMap<FString, FString>& GetSkippedCases() const
+	{
+		return SkippedCases;
+	}
+
+	FString GetOutputFilename() const
+	{
+		FString Directory;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("ApologueBenchmarkDir="), Directory))
+		{
+			Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"));
+		}
+
+		return FPaths::Combine(Directory, SuiteName + TEXT(".json"));
+	}
+
+	bool WriteJson() const
+	{
+		const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("suite"), SuiteName);
+		Root->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+		Root->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+
+		if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("ApologueCore")))
+		{
+			Root->SetStringField(TEXT("pluginVersion"), Plugin->GetDescriptor().VersionName);
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Cases;
+		for (const FApologueBenchmarkResult& Result : Results)
+		{
+			const TSharedRef<FJsonObject> Case = MakeShared<FJsonObject>();
+			Case->SetStringField(TEXT("name"), Result.Name);
+			Case->SetNumberField(TEXT("iterations"), static_cast<double>(Result.Iterations));
+			Case->SetNumberField(TEXT("totalSeconds"), Result.TotalSeconds);
+			Case->SetNumberField(TEXT("nsPerIteration"), Result.NanosecondsPerIteration);
+
+			for (const TPair<FString, double>& Metric : Result.Metrics)
+			{
+				Case->SetNumberField(Metric.Key, Metric.Value);
+			}
+
+			Cases.Add(MakeShared<FJsonValueObject>(Case));
+		}
+		Root->SetArrayField(TEXT("cases"), Cases);
+
+		TArray<TSharedPtr<FJsonValue>> Skipped;
+		for (const TPair<FString, FString>& SkippedCase : SkippedCases)
+		{
+			const TSharedRef<FJsonObject> Case = MakeShared<FJsonObject>();
+			Case->SetStringField(TEXT("name"), SkippedCase.Key);
+			Case->SetStringField(TEXT("reason"), SkippedCase.Value);
+			Skipped.Add(MakeShared<FJsonValueObject>(Case));
+		}
+		Root->SetArrayField(TEXT("skipped"), Skipped);
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		if (!FJsonSerializer::Serialize(Root, Writer))
+		{
+			return false;
+		}
+
+		return FFileHelper::SaveStringToFile(Json, *GetOutputFilename());
+	}
+};
+
+/**
+ * Forwarding allocator that counts heap allocations. Installed as GMalloc for the lifetime of an
+ * FApologueScopedAllocationCounter; allocations from other threads during that time are counted too.
+ */
+class FApologueCountingMalloc final : public FMalloc
+{
+	FMalloc* Inner;
+
+public:
+	std::atomic<int64> NumAllocations{0};
+
+	explicit FApologueCountingMalloc(FMalloc* InInner)
+		: Inner(InInner)
+	{
+	}
+
+	virtual void* Malloc(const SIZE_T Count, const uint32 Alignment) override
+	{
+		NumAllocations.fetch_add(1, std::memory_order_relaxed);
+		return Inner->Malloc(Count, Alignment);
+	}
+
+	virtual void* TryMalloc(const SIZE_T Count, const uint32 Alignment) override
+	{
+		NumAllocations.fetch_add(1, std::memory_order_relaxed);
+		return Inner->TryMalloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, const SIZE_T Count, const uint32 Alignment) override
+	{
+		if (Count > 0)
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		return Inner->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void* TryRealloc(void* Original, const SIZE_T Count, const uint32 Alignment) override
+	{
+		if (Count > 0)
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		return Inner->TryRealloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override
+	{
+		Inner->Free(Original);
+	}
+
+	virtual SIZE_T QuantizeSize(const SIZE_T Count, const uint32 Alignment) override
+	{
+		return Inner->QuantizeSize(Count, Alignment);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return Inner->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual void Trim(const bool bTrimThreadCaches) override
+	{
+		Inner->Trim(bTrimThreadCaches);
+	}
+
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		Inner->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		Inner->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return Inner->IsInternallyThreadSafe();
+	}
+
+	virtual bool ValidateHeap() override
+	{
+		return Inner->ValidateHeap();
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return TEXT("ApologueCountingMalloc");
+	}
+};
+
+class FApologueScopedAllocationCounter
+{
+	FMalloc* PreviousMalloc;
+	FApologueCountingMalloc CountingMalloc;
+
+public:
+	FApologueScopedAllocationCounter()
+		: PreviousMalloc(GMalloc)
+		, CountingMalloc(GMalloc)
+	{
+		GMalloc = &CountingMalloc;
+	}
+
+	~FApologueScopedAllocationCounter()
+	{
+		GMalloc = PreviousMalloc;
+	}
+
+	int64 GetNumAllocations() const
+	{
+		return CountingMalloc.NumAllocations.load(std::memory_order_relaxed);
+	}
+};
+
+/**
+ * @return The average number of heap allocations per call of Function.
+ */
+template <typename FunctionType>
+double ApologueBenchmarkCountAllocations(const int64 Iterations, FunctionType&& Function)
+{
+	check(Iterations > 0);
+
+	const FApologueScopedAllocationCounter Counter;
+	for (int64 Index = 0; Index < Iterations; ++Index)
+	{
+		Function();
+	}
+
+	return static_cast<double>(Counter.GetNumAllocations()) / static_cast<double>(Iterations);
+}
+
+/**
+ * Keeps the compiler from discarding a value computed only for timing purposes.
+ */
+template <typename T>
+FORCEINLINE void ApologueBenchmarkKeep(const T& Value)
+{
+	static volatile uint8 Sink;
+	Sink = *reinterpret_cast<const volatile uint8*>(&Value);
+}
+
+#endif
@@ -0,0 +1,149 @@
+﻿// Copyright (c) 2024 David Jacquish
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Event/ApologueEventBroadcasterInterface.h"
+#include "Event/ApologueEventContext.h"
+#include "Event/ApologueEventListenerInterface.h"
+#include "Event/ApologueEventSortHandler.h"
+#include "Stat/ApologueStatContainer.h"
+#include "Stat/ApologueStatFunction.h"
+#include "ApologueCoreTestTypes.generated.h"
+
+// Types used only by the tests and benchmarks. They are declared in every build, since UHT generates code for every
+// UCLASS it parses regardless of the preprocessor state, and only their uses are compiled out without WITH_TESTS.
+// HideDropdown and Transient keep them out of class pickers and saved data.
+
+/**
+ * Native stat function used by the tests and benchmarks: BaseValue * Multiplier + Offset.
+ */
+UCLASS(HideDropdown, NotBlueprintable, Transient)
+class UApologueTestStatFunction final : public UApologueStatFunction
+{
+	GENERATED_BODY()
+
+public:
+	int32 Multiplier = 2;
+	int32 Offset = 5;
+
+	virtual int32 GetValue_Implementation(const TSoftObjectPtr<UApologueStat>& Stat, const int32 BaseValue, const UApologueStatFunctionContext* Context) override
+	{
+		return BaseValue * Multiplier + Offset;
+	}
+};
+
+UCLASS(HideDropdown, NotBlueprintable, Transient)
+class UApologueTestEventContext : public UApologueEventContext
+{
+	GENERATED_BODY()
+
+public:
+	int32 Payload = 0;
+};
+
+UCLASS(HideDropdown, NotBlueprintable, Transient)
+class UApologueTestEventContextDerived final : public UApologueTestEventContext
+{
+	GENERATED_BODY()
+
+public:
+	FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * Orders listeners by descending object ID.
+ */
+UCLASS(HideDropdown, NotBlueprintable, Transient)
+class UApologueTestEventSortHandler final : public UApologueEventSortHandler
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Sort_Implementation(TArray<UObject*>& Objects) override
+	{
+		Objects.Sort([](const UObject& A, const UObject& B)
+		{
+			return A.GetUniqueID() > B.GetUniqueID();
+		});
+	}
+};
+
+/**
+ * Listener whose callbacks count their calls and optionally cancel the event or record the payloads of their contexts.
+ */
+UCLASS(HideDropdown, NotBlueprintable, Transient)
+class UApologueTestEventListener final : public UObject, public IApologueEventListenerInterface
+{
+	GENERATED_BODY()
+
+public:
+	TArray<FApologueEventCallbackParam> CallbackParams;
+
+	int32 NumCalls = 0;
+
+	bool bCancelsEvent = false;
+
+	bool bRecordsPayloads = false;
+
+	TArray<int32> Payloads;
+
+	void AddCallback(const TSoftObjectPtr<UApologueEvent>& Event, const int32 Priority, const int32 SubPriority)
+	{
+		FApologueEventCallbackParam& CallbackParam = CallbackParams.AddDefaulted_GetRef();
+		CallbackParam.Event = Event;
+		CallbackParam.Priority = Priority;
+		CallbackParam.SubPriority = SubPriority;
+		CallbackParam.Callback.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UApologueTestEventListener, OnEvent));
+	}
+
+	UFUNCTION()
+	void OnEvent(const UApologueEventContext* Context)
+	{
+		++NumCalls;
+
+		if (bRecordsPayloads)
+		{
+			const UApologueTestEventContext* TestContext = Cast<UApologueTestEventContext>(Context);
+			Payloads.Add(TestContext ? TestContext->Payload : INDEX_NONE);
+		}
+
+		if (bCancelsEvent && Context)
+		{
+			const_cast<UApologueEventContext*>(Context)->Cancel();
+		}
+	}
+
+	// IApologueEventListenerInterface
+	virtual void EventListener_GetCallbacks_Implementation(TArray<FApologueEventCallbackParam>& OutCallbackParams) override
+	{
+		OutCallbackParams = CallbackParams;
+	}
+};
+
+/**
+ * Outer for stat containers that records, in order, the events they broadcast through it and the notifications it receives.
+ */
+UCLASS(HideDropdown, NotBlueprintable, Transient)
+class UApologueTestStatChangeRecorder final : public UObject, public IApologueEventBroadcasterInterface
+{
+	GENERATED_BODY()
+
+public:
+	TArray<FString> Calls;
+
+	TArray<FApologueStatChange> LastChanges;
+
+	UFUNCTION()
+	void OnStatsChanged(UApologueStatContainer* Container, const TArray<FApologueStatChange>& Changes)
+	{
+		Calls.Add(TEXT("Delegate"));
+		LastChanges = Changes;
+	}
+
+	// IApologueEventBroadcasterInterface
+	virtual void EventBroadcaster_BroadcastEvent_Implementation(const TSoftObjectPtr<UApologueEvent>& Event, const UApologueEventContext* Context) override
+	{
+		Calls.Add(TEXT("Event"));
+	}
+};
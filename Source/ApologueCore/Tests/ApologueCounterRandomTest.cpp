@@ -0,0 +1,130 @@
+﻿#if WITH_TESTS
+
+#include "Random/ApologueCounterRandom.h"
+
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/TestHarnessAdapter.h"
+
+TEST_CASE_NAMED(FApologueCounterRandomTest, "ApologueCore::CounterRandom", "[Apologue][ApologueCore][CounterRandom]")
+{
+	constexpr uint64 Seed = 0xDEADBEEF;
+
+	SECTION("Reference Output")
+	{
+		// Known answers of Philox4x32-10 from the Random123 distribution, two 32-bit lanes per word
+		uint64 Block[FApologuePhiloxEngine::WordsPerBlock];
+
+		FApologuePhiloxEngine::Generate(0, 0, 0, Block);
+		CHECK(Block[0] == 0xE169C58D6627E8D5ull);
+		CHECK(Block[1] == 0x9B00DBD8BC57AC4Cull);
+
+		FApologuePhiloxEngine::Generate(MAX_uint64, MAX_uint64, MAX_uint64, Block);
+		CHECK(Block[0] == 0x41C83B0E408F276Dull);
+		CHECK(Block[1] == 0x6D5451FDA20BC7C6ull);
+
+		FApologuePhiloxEngine::Generate(0x299F31D0A4093822ull, 0x0370734413198A2Eull, 0x85A308D3243F6A88ull, Block);
+		CHECK(Block[0] == 0x94FDCCEBD16CFE09ull);
+		CHECK(Block[1] == 0x24126EA15001E420ull);
+	}
+
+	SECTION("Order Independent")
+	{
+		FApologueCounterRandom Random;
+		Random.Initialize(Seed);
+
+		TArray<uint64> Forward;
+		for (uint64 Subject = 0; Subject < 16; Subject++)
+		{
+			Forward.Add(Random.At(Subject, 7).RandHelper(MAX_uint64));
+		}
+
+		bool bMatches = true;
+		for (int32 Subject = 15; Subject >= 0; Subject--)
+		{
+			bMatches &= Random.At(Subject, 7).RandHelper(MAX_uint64) == Forward[Subject];
+			bMatches &= Random.GetWord(Subject, 7) == Forward[Subject];
+		}
+
+		CHECK(bMatches);
+		CHECK(Forward[0] != Forward[1]);
+	}
+
+	SECTION("Property Serialization")
+	{
+		// Streams are pure functions of the seed, so the saved properties give back the same draws
+		FApologueCounterRandom Saved;
+		Saved.Initialize(Seed);
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		FApologueCounterRandom::StaticStruct()->SerializeItem(Writer, &Saved, nullptr);
+
+		FApologueCounterRandom Loaded;
+		FMemoryReader Reader(Bytes);
+		FApologueCounterRandom::StaticStruct()->SerializeItem(Reader, &Loaded, nullptr);
+
+		CHECK(!Reader.IsError());
+		CHECK(Loaded.IsInitialized());
+
+		const FApologueCounterStream SavedStream = Saved.At(3, 5, 1);
+		const FApologueCounterStream LoadedStream = Loaded.At(3, 5, 1);
+		bool bMatches = true;
+		for (int32 i = 0; i < 17; i++)
+		{
+			bMatches &= LoadedStream.RandHelper(MAX_uint64) == SavedStream.RandHelper(MAX_uint64);
+		}
+
+		CHECK(bMatches);
+	}
+
+	SECTION("Keys Differ")
+	{
+		FApologueCounterRandom Random;
+		Random.Initialize(Seed);
+
+		FApologueCounterRandom Other;
+		Other.Initialize(Seed + 1);
+
+		const uint64 Word = Random.GetWord(3, 5, 0);
+		CHECK(Word != Random.GetWord(4, 5, 0));
+		CHECK(Word != Random.GetWord(3, 6, 0));
+		CHECK(Word != Random.GetWord(3, 5, 1));
+		CHECK(Word != Other.GetWord(3, 5, 0));
+	}
+
+	SECTION("Discard and Fill")
+	{
+		FApologuePhiloxEngine Drawn(Seed, 1, MAX_uint64 - 3);
+		FApologuePhiloxEngine Discarded(Seed, 1, MAX_uint64 - 3);
+		Drawn.Next();
+		Discarded.Next();
+		for (int32 i = 0; i < 13; i++)
+		{
+			Drawn.Next();
+		}
+
+		// Crosses the low counter word into the high one
+		Discarded.Discard(13);
+		CHECK(Drawn.Next() == Discarded.Next());
+
+		FApologuePhiloxEngine Filled(Seed);
+		FApologuePhiloxEngine Scalar(Seed);
+		Filled.Next();
+		Scalar.Next();
+
+		uint64 Words[11];
+		Filled.Fill(MakeArrayView(Words));
+
+		bool bMatches = true;
+		for (const uint64 Word : Words)
+		{
+			bMatches &= Word == Scalar.Next();
+		}
+
+		CHECK(bMatches);
+		CHECK(Filled.Next() == Scalar.Next());
+	}
+}
+
+#endif
@@ -0,0 +1,161 @@
+﻿#if WITH_TESTS
+
+#include "Random/ApologueDiceExpression.h"
+
+#include "Tests/TestHarnessAdapter.h"
+
+TEST_CASE_NAMED(FApologueDiceExpressionTest, "ApologueCore::DiceExpression", "[Apologue][ApologueCore][DiceExpression]")
+{
+	constexpr uint64 Seed = 0xDEADBEEF;
+
+	SECTION("Parse")
+	{
+		FApologueDiceExpression Expression;
+		REQUIRE(FApologueDiceExpression::Parse(TEXT(" 3d6 + 2 "), Expression));
+		REQUIRE(Expression.Dice.Num() == 1);
+		CHECK(Expression.Dice[0].Count == 3);
+		CHECK(Expression.Dice[0].Sides == 6);
+		CHECK(Expression.Modifier == 2);
+		CHECK(Expression.ToString() == TEXT("3d6+2"));
+
+		REQUIRE(FApologueDiceExpression::Parse(TEXT("d20-1D4-1+d%"), Expression));
+		REQUIRE(Expression.Dice.Num() == 3);
+		CHECK(Expression.Dice[0].Count == 1);
+		CHECK(Expression.Dice[1].Count == -1);
+		CHECK(Expression.Dice[2].Sides == 100);
+		CHECK(Expression.Modifier == -1);
+		CHECK(Expression.ToString() == TEXT("1d20-1d4+1d100-1"));
+
+		REQUIRE(FApologueDiceExpression::Parse(TEXT("-4"), Expression));
+		CHECK(Expression.Dice.IsEmpty());
+		CHECK(Expression.ToString() == TEXT("-4"));
+
+		// Invalid notation leaves the expression untouched
+		const TCHAR* Invalid[] = {TEXT(""), TEXT("3d"), TEXT("3d0"), TEXT("2d6*3"), TEXT("3x6"), TEXT("+"), TEXT("99999999999d6")};
+		for (const TCHAR* Notation : Invalid)
+		{
+			CHECK(!FApologueDiceExpression::Parse(Notation, Expression));
+		}
+
+		CHECK(Expression.ToString() == TEXT("-4"));
+	}
+
+	SECTION("Roll")
+	{
+		FMersenneTwister Twister;
+		Twister.Initialize(Seed);
+
+		FApologueDiceExpression Expression;
+		REQUIRE(FApologueDiceExpression::Parse(TEXT("3d6+2-1d4"), Expression));
+		CHECK(Expression.GetMin() == 1);
+		CHECK(Expression.GetMax() == 19);
+		CHECK(Expression.GetMean() == 10.0);
+
+		constexpr int32 Rolls = 100000;
+		int64 Total = 0;
+		bool bIsInRange = true;
+		for (int32 i = 0; i < Rolls; i++)
+		{
+			const int64 Roll = Expression.Roll(Twister);
+			bIsInRange &= Roll >= Expression.GetMin() && Roll <= Expression.GetMax();
+			Total += Roll;
+		}
+
+		CHECK(bIsInRange);
+		CHECK(FMath::Abs(static_cast<double>(Total) / Rolls - Expression.GetMean()) < 0.05);
+	}
+
+	SECTION("Batched Dice")
+	{
+		FMersenneTwister Twister;
+		Twister.Initialize(Seed);
+
+		// 2d6 shares one word between its dice, and must still follow the triangle of sums
+		constexpr int32 Rolls = 360000;
+		int32 Sums[13] = {};
+		for (int32 i = 0; i < Rolls; i++)
+		{
+			Sums[Twister.RollDice(2, 6)]++;
+		}
+
+		for (int32 Sum = 2; Sum <= 12; Sum++)
+		{
+			const int32 Expected = Rolls / 36 * (6 - FMath::Abs(Sum - 7));
+			CHECK(FMath::Abs(Sums[Sum] - Expected) < Expected / 20);
+		}
+
+		// Four to a word, and a leftover die rolled alone
+		double Total = 0.0;
+		for (int32 i = 0; i < 100000; i++)
+		{
+			Total += Twister.RollDice(7, 6);
+		}
+
+		CHECK(FMath::Abs(Total / 100000 - 24.5) < 0.05);
+		CHECK(Twister.RollDice(0, 6) == 0);
+		CHECK(Twister.RollDice(5, 1) == 5);
+	}
+
+	SECTION("Distributions")
+	{
+		FMersenneTwister Twister;
+		Twister.Initialize(Seed);
+
+		FApologueDiceExpression Expression;
+		REQUIRE(FApologueDiceExpression::Parse(TEXT("Normal(10, 2.5) + binomial(20, 0.25) - 3"), Expression));
+		CHECK(Expression.Dice.IsEmpty());
+		CHECK(Expression.Modifier == -3);
+		REQUIRE(Expression.Distributions.Num() == 2);
+		CHECK(Expression.Distributions[0].Distribution == EApologueDiceDistribution::Normal);
+		CHECK(Expression.Distributions[0].Mean == 10.0);
+		CHECK(Expression.Distributions[0].StandardDeviation == 2.5);
+		CHECK(Expression.Distributions[1].Distribution == EApologueDiceDistribution::Binomial);
+		CHECK(Expression.Distributions[1].Trials == 20);
+		CHECK(Expression.Distributions[1].Probability == 0.25);
+		CHECK(Expression.GetMean() == 12.0);
+		CHECK(Expression.ToString() == TEXT("normal(10,2.5)+binomial(20,0.25)-3"));
+
+		// Dice come first when written back, and subtracted distributions keep their sign
+		REQUIRE(FApologueDiceExpression::Parse(TEXT("-binomial(4,0.1)+2d6"), Expression));
+		CHECK(Expression.GetMin() == -2);
+		CHECK(Expression.GetMax() == 12);
+		CHECK(Expression.ToString() == TEXT("2d6-binomial(4,0.1)"));
+
+		FApologueDiceExpression ReadBack;
+		REQUIRE(FApologueDiceExpression::Parse(Expression.ToString(), ReadBack));
+		CHECK(ReadBack.ToString() == Expression.ToString());
+
+		REQUIRE(FApologueDiceExpression::Parse(TEXT("normal(10,2.5)+binomial(20,0.25)"), Expression));
+		constexpr int32 Rolls = 100000;
+		int64 Total = 0;
+		for (int32 i = 0; i < Rolls; i++)
+		{
+			Total += Expression.Roll(Twister);
+		}
+
+		CHECK(FMath::Abs(static_cast<double>(Total) / Rolls - Expression.GetMean()) < 0.05);
+
+		const TCHAR* Invalid[] = {TEXT("normal(1,-1)"), TEXT("normal(1)"), TEXT("normal(1,2"), TEXT("normal(inf,1)"), TEXT("binomial(5,1.5)"), TEXT("binomial(2.5,0.5)"), TEXT("binomial(-1,0.5)"), TEXT("uniform(1,2)")};
+		for (const TCHAR* Notation : Invalid)
+		{
+			CHECK(!FApologueDiceExpression::Parse(Notation, Expression));
+		}
+	}
+
+	SECTION("Extreme Count")
+	{
+		FMersenneTwister Twister;
+		Twister.Initialize(Seed);
+
+		// Blueprint can set counts that notation cannot express
+		FApologueDiceExpression Expression;
+		FApologueDiceTerm& Term = Expression.Dice.AddDefaulted_GetRef();
+		Term.Count = MIN_int32;
+		Term.Sides = 1;
+		CHECK(Expression.Roll(Twister) == MIN_int32);
+		CHECK(Expression.GetMin() == MIN_int32);
+		CHECK(Expression.ToString() == TEXT("-2147483648d1"));
+	}
+}
+
+#endif
@@ -0,0 +1,109 @@
+﻿#if WITH_TESTS
+
+#include "Event/ApologueEventArena.h"
+
+#include "Tests/TestHarnessAdapter.h"
+
+TEST_CASE_NAMED(FApologueEventArenaTest, "ApologueCore::Event::Arena", "[Apologue][ApologueCore][Event]")
+{
+	SECTION("Scopes")
+	{
+		FApologueEventArena Arena(1024);
+		{
+			FApologueEventArena::FScope Scope(Arena);
+			CHECK(FApologueEventArena::GetCurrent() == &Arena);
+
+			uint8* First = static_cast<uint8*>(Arena.Allocate(100, 16));
+			FMemory::Memset(First, 1, 100);
+
+			// On top of the arena, so it grows in place
+			uint8* Grown = static_cast<uint8*>(Arena.Reallocate(First, 100, 400, 16, 100));
+			CHECK(Grown == First);
+			CHECK(Grown[99] == 1);
+			CHECK(Arena.GetNumBytesUsed() == 400);
+
+			{
+				FApologueEventArena::FScope Nested(Arena);
+				CHECK(Arena.GetNumOpenScopes() == 2);
+				FMemory::Memset(Arena.Allocate(800, 16), 2, 800);
+				CHECK(Arena.GetNumBlocks() == 2);
+
+				uint8* Moved = static_cast<uint8*>(Arena.Reallocate(Grown, 400, 600, 16, 400));
+				CHECK(Moved != Grown);
+				CHECK(Moved[99] == 1);
+			}
+
+			// Closing the nested scope releases everything allocated in it
+			CHECK(Arena.GetNumBytesUsed() == 400);
+
+			Arena.Free(Grown, 400);
+			CHECK(Arena.GetNumBytesUsed() == 0);
+		}
+
+		CHECK(FApologueEventArena::GetCurrent() == nullptr);
+	}
+
+	SECTION("Reset")
+	{
+		FApologueEventArena Arena(1024);
+		{
+			FApologueEventArena::FScope Scope(Arena);
+			for (int32 Index = 0; Index < 8; ++Index)
+			{
+				Arena.Allocate(512, 16);
+			}
+		}
+
+		CHECK(Arena.GetNumBlocks() > 1);
+
+		const int64 PeakBytesUsed = Arena.GetPeakBytesUsed();
+		Arena.Reset();
+		CHECK(Arena.GetNumBlocks() == 1);
+
+		// The merged block holds another frame like the last
+		{
+			FApologueEventArena::FScope Scope(Arena);
+			for (int32 Index = 0; Index < 8; ++Index)
+			{
+				Arena.Allocate(512, 16);
+			}
+		}
+
+		CHECK(Arena.GetNumBlocks() == 1);
+		CHECK(Arena.GetPeakBytesUsed() == PeakBytesUsed);
+	}
+
+	SECTION("Allocator")
+	{
+		FApologueEventArena Arena;
+		{
+			FApologueEventArena::FScope Scope(Arena);
+
+			TArray<int32, FApologueEventArenaAllocator> Values;
+			for (int32 Index = 0; Index < 1000; ++Index)
+			{
+				Values.Add(Index);
+			}
+
+			CHECK(Arena.GetNumBytesUsed() >= 1000 * static_cast<int64>(sizeof(int32)));
+
+			bool bInOrder = true;
+			for (int32 Index = 0; Index < Values.Num(); ++Index)
+			{
+				bInOrder &= Values[Index] == Index;
+			}
+
+			CHECK(bInOrder);
+		}
+
+		CHECK(Arena.GetNumBytesUsed() == 0);
+
+		// With no arena open, arrays fall back to the heap
+		TArray<int32, FApologueEventArenaAllocator> Values;
+		Values.Add(1);
+		CHECK(Values[0] == 1);
+		CHECK(Arena.GetNumBytesUsed() == 0);
+	}
+}
+
+#endif
@@ -0,0 +1,202 @@
+﻿#if WITH_TESTS
+
+#include "ApologueBenchmark.h"
+#include "ApologueCoreTestTypes.h"
+#include "Event/ApologueEvent.h"
+#include "Event/ApologueEventDispatcher.h"
+#include "Random/MersenneTwister.h"
+
+#include "Algo/StableSort.h"
+#include "Tests/TestHarnessAdapter.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectArray.h"
+
+namespace ApologueEventBenchmark
+{
+	constexpr int32 CallbacksPerListener = 4;
+	constexpr int64 SampleIterations = 100;
+
+	TStrongObjectPtr<UApologueEvent> MakeEvent(UApologueEventSortHandler* SortHandler = nullptr)
+	{
+		TStrongObjectPtr<UApologueEvent> Event(NewObject<UApologueEvent>(GetTransientPackage()));
+
+		const FObjectProperty* Property = FindFProperty<FObjectProperty>(UApologueEvent::StaticClass(), TEXT("SortHandler"));
+		check(Property);
+		Property->SetObjectPropertyValue_InContainer(Event.Get(), SortHandler);
+
+		return Event;
+	}
+
+	/**
+	 * Counts the callbacks a broadcast of Event runs up to and including the first one that cancels it, ordered by
+	 * priority and then by registration the way the dispatcher orders them.
+	 */
+	int32 CountCallbacksUntilCanceled(const TArray<const UApologueTestEventListener*>& RegistrationOrder, const UApologueEvent* Event)
+	{
+		struct FCallback
+		{
+			int32 Priority;
+			int32 SubPriority;
+			bool bCancelsEvent;
+		};
+
+		TArray<FCallback> Callbacks;
+		for (const UApologueTestEventListener* Listener : RegistrationOrder)
+		{
+			for (const FApologueEventCallbackParam& CallbackParam : Listener->CallbackParams)
+			{
+				if (CallbackParam.Event.ToSoftObjectPath() == FSoftObjectPath(Event))
+				{
+					Callbacks.Add({CallbackParam.Priority, CallbackParam.SubPriority, Listener->bCancelsEvent});
+				}
+			}
+		}
+
+		Algo::StableSort(Callbacks, [](const FCallback& A, const FCallback& B)
+		{
+			return A.Priority == B.Priority ? A.SubPriority > B.SubPriority : A.Priority > B.Priority;
+		});
+
+		const int32 CancelIndex = Callbacks.IndexOfByPredicate([](const FCallback& Callback)
+		{
+			return Callback.bCancelsEvent;
+		});
+
+		return CancelIndex == INDEX_NONE ? Callbacks.Num() : CancelIndex + 1;
+	}
+
+	int64 GetIterations(const int32 NumListeners)
+	{
+		return FMath::Max<int64>(100, 1000000 / (NumListeners * CallbacksPerListener));
+	}
+
+	/**
+	 * Times the broadcast, then measures heap allocations and UObjects created per broadcast and the cost of collecting them.
+	 */
+	void RunBroadcastCase(FApologueBenchmarkSuite& Suite, const FString& Name, const int64 Iterations, const FApologueEventDispatcher& Dispatcher,
+	                      const TSoftObjectPtr<UApologueEvent>& Event, const TFunctionRef<const UApologueEventContext*()>& MakeContext)
+	{
+		const int32 CallbacksPerBroadcast = Dispatcher.Broadcast(Event, MakeContext());
+
+		auto Broadcast = [&]
+		{
+			ApologueBenchmarkKeep(Dispatcher.Broadcast(Event, MakeContext()));
+		};
+
+		FApologueBenchmarkResult& Result = Suite.Run(Name, Iterations, Broadcast);
+
+		const int32 NumObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+		const double AllocationsPerBroadcast = ApologueBenchmarkCountAllocations(SampleIterations, Broadcast);
+		const int32 NumObjectsAfter = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+		const double GCStartSeconds = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		const double GCSeconds = FPlatformTime::Seconds() - GCStartSeconds;
+
+		Result.Metrics.Add(TEXT("broadcastsPerSecond"), 1.0e9 / Result.NanosecondsPerIteration);
+		Result.Metrics.Add(TEXT("callbacksPerBroadcast"), CallbacksPerBroadcast);
+		Result.Metrics.Add(TEXT("nsPerCallback"), Result.NanosecondsPerIteration / FMath::Max(1, CallbacksPerBroadcast));
+		Result.Metrics.Add(TEXT("allocationsPerBroadcast"), AllocationsPerBroadcast);
+		Result.Metrics.Add(TEXT("uobjectsPerBroadcast"), static_cast<double>(NumObjectsAfter - NumObjectsBefore) / SampleIterations);
+		Result.Metrics.Add(TEXT("gcSeconds"), GCSeconds);
+	}
+}
+
+TEST_CASE_NAMED(FApologueEventBenchmark, "ApologueCore::Benchmark::Event", "[Apologue][ApologueCore][Benchmark]")
+{
+	using namespace ApologueEventBenchmark;
+
+	FApologueBenchmarkSuite Suite(TEXT("ApologueEvent"));
+
+	FMersenneTwister MersenneTwister;
+	MersenneTwister.Initialize(0xDEADBEEF);
+
+	const TStrongObjectPtr<UApologueTestEventSortHandler> SortHandler(NewObject<UApologueTestEventSortHandler>(GetTransientPackage()));
+	const TStrongObjectPtr<UApologueEvent> Event = MakeEvent();
+	const TStrongObjectPtr<UApologueEvent> SortedEvent = MakeEvent(SortHandler.Get());
+	const TStrongObjectPtr<UApologueEvent> OtherEvent = MakeEvent();
+	const TStrongObjectPtr<UApologueTestEventContext> SharedContext(NewObject<UApologueTestEventContext>(GetTransientPackage()));
+
+	for (const int32 NumListeners : {10, 100, 1000, 10000})
+	{
+		FApologueEventDispatcher Dispatcher;
+		TArray<TStrongObjectPtr<UApologueTestEventListener>> Listeners;
+
+		for (int32 ListenerIndex = 0; ListenerIndex < NumListeners; ++ListenerIndex)
+		{
+			UApologueTestEventListener* Listener = NewObject<UApologueTestEventListener>(GetTransientPackage());
+			for (int32 CallbackIndex = 0; CallbackIndex < CallbacksPerListener; ++CallbackIndex)
+			{
+				// Mixed priorities with plenty of ties, spread over the benchmarked events and one that is never broadcast
+				const UApologueEvent* CallbackEvent = CallbackIndex == CallbacksPerListener - 1 ? OtherEvent.Get() : CallbackIndex % 2 ? SortedEvent.Get() : Event.Get();
+				Listener->AddCallback(CallbackEvent, MersenneTwister.RandomRange(-2, 2), MersenneTwister.RandomRange(0, 3));
+			}
+
+			REQUIRE(Dispatcher.RegisterListener(Listener));
+			Listeners.Emplace(Listener);
+		}
+
+		const int64 Iterations = GetIterations(NumListeners);
+		const FString Suffix = FString::Printf(TEXT("/%dx%d"), NumListeners, CallbacksPerListener);
+
+		RunBroadcastCase(Suite, TEXT("Broadcast") + Suffix, Iterations, Dispatcher, Event.Get(), [&]() -> const UApologueEventContext*
+		{
+			return SharedContext.Get();
+		});
+
+		RunBroadcastCase(Suite, TEXT("Broadcast.Sorted") + Suffix, Iterations, Dispatcher, SortedEvent.Get(), [&]() -> const UApologueEventContext*
+		{
+			return SharedContext.Get();
+		});
+
+		int32 ContextIndex = 0;
+		RunBroadcastCase(Suite, TEXT("Broadcast.NewContext") + Suffix, Iterations, Dispatcher, Event.Get(), [&]() -> const UApologueEventContext*
+		{
+			return ++ContextIndex % 2
+				       ? NewObject<UApologueTestEventContext>(GetTransientPackage())
+				       : NewObject<UApologueTestEventContextDerived>(GetTransientPackage());
+		});
+
+		// Cancel halfway through the priority order
+		const int32 NumCallbacks = Dispatcher.GetNumCallbacks(Event.Get());
+		UApologueTestEventListener* Canceler = Listeners[NumListeners / 2].Get();
+		Canceler->bCancelsEvent = true;
+		Dispatcher.RefreshListener(Canceler);
+		REQUIRE(Dispatcher.GetNumCallbacks(Event.Get()) == NumCallbacks);
+
+		// Refreshing registered the canceler again, after everyone else
+		TArray<const UApologueTestEventListener*> RegistrationOrder;
+		for (const TStrongObjectPtr<UApologueTestEventListener>& Listener : Listeners)
+		{
+			if (Listener.Get() != Canceler)
+			{
+				RegistrationOrder.Add(Listener.Get());
+			}
+		}
+		RegistrationOrder.Add(Canceler);
+
+		const UApologueEventContext* CanceledContext = NewObject<UApologueTestEventContext>(GetTransientPackage());
+		const int32 NumCanceledCallbacks = Dispatcher.Broadcast(Event.Get(), CanceledContext);
+		CHECK(CanceledContext->IsCanceled());
+		CHECK(NumCanceledCallbacks == CountCallbacksUntilCanceled(RegistrationOrder, Event.Get()));
+
+		RunBroadcastCase(Suite, TEXT("Broadcast.Canceled") + Suffix, Iterations, Dispatcher, Event.Get(), [&]() -> const UApologueEventContext*
+		{
+			return NewObject<UApologueTestEventContext>(GetTransientPackage());
+		});
+
+		// Listener churn: one listener leaving and rejoining at the current population
+		UApologueTestEventListener* ChurnListener = Listeners.Last().Get();
+		Suite.Run(TEXT("RegisterUnregister") + Suffix, FMath::Max<int64>(10, Iterations / 10), [&]
+		{
+			Dispatcher.UnregisterListener(ChurnListener);
+			Dispatcher.RegisterListener(ChurnListener);
+		});
+
+		CHECK(Dispatcher.GetNumListeners() == NumListeners);
+	}
+
+	CHECK(Suite.WriteJson());
+}
+
+#endif
@@ -0,0 +1,270 @@
+﻿#if WITH_TESTS
+
+#include "ApologueCoreTestTypes.h"
+#include "Event/ApologueEvent.h"
+#include "Event/ApologueEventDispatcher.h"
+
+#include "Tests/TestHarnessAdapter.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace ApologueEventDispatcherTest
+{
+	TStrongObjectPtr<UApologueEvent> MakeEvent()
+	{
+		return TStrongObjectPtr<UApologueEvent>(NewObject<UApologueEvent>(GetTransientPackage()));
+	}
+
+	void SetPriority(UApologueEvent* Event, const EApologueEventPriority Priority)
+	{
+		const FEnumProperty* Property = FindFProperty<FEnumProperty>(UApologueEvent::StaticClass(), TEXT("Priority"));
+		check(Property);
+		*Property->ContainerPtrToValuePtr<EApologueEventPriority>(Event) = Priority;
+	}
+
+	void SetParent(UApologueEvent* Event, UApologueEvent* Parent)
+	{
+		const FObjectProperty* Property = FindFProperty<FObjectProperty>(UApologueEvent::StaticClass(), TEXT("Parent"));
+		check(Property);
+		Property->SetObjectPropertyValue_InContainer(Event, Parent);
+		Event->RefreshAncestors();
+	}
+
+	const UApologueEventContext* MakeContext(const int32 Payload)
+	{
+		UApologueTestEventContext* Context = NewObject<UApologueTestEventContext>(GetTransientPackage());
+		Context->Payload = Payload;
+		return Context;
+	}
+}
+
+TEST_CASE_NAMED(FApologueEventDispatcherTest, "ApologueCore::Event::Dispatcher", "[Apologue][ApologueCore][Event]")
+{
+	using namespace ApologueEventDispatcherTest;
+
+	const TStrongObjectPtr<UApologueEvent> Event = MakeEvent();
+
+	const TStrongObjectPtr<UApologueTestEventListener> Low(NewObject<UApologueTestEventListener>(GetTransientPackage()));
+	Low->AddCallback(Event.Get(), 0, 0);
+
+	const TStrongObjectPtr<UApologueTestEventListener> High(NewObject<UApologueTestEventListener>(GetTransientPackage()));
+	High->AddCallback(Event.Get(), 1, 0);
+
+	FApologueEventDispatcher Dispatcher;
+	REQUIRE(Dispatcher.RegisterListener(Low.Get()));
+	REQUIRE(Dispatcher.RegisterListener(High.Get()));
+	CHECK(!Dispatcher.RegisterListener(High.Get()));
+
+	SECTION("Priority")
+	{
+		High->bCancelsEvent = true;
+		Dispatcher.RefreshListener(High.Get());
+
+		const UApologueEventContext* Context = NewObject<UApologueTestEventContext>(GetTransientPackage());
+		CHECK(Dispatcher.Broadcast(Event.Get(), Context) == 1);
+		CHECK(High->NumCalls == 1);
+		CHECK(Low->NumCalls == 0);
+	}
+
+	SECTION("Unregister")
+	{
+		Dispatcher.UnregisterListener(High.Get());
+
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr) == 1);
+		CHECK(High->NumCalls == 0);
+		CHECK(Low->NumCalls == 1);
+	}
+
+	SECTION("Slots")
+	{
+		TArray<TStrongObjectPtr<UApologueTestEventListener>> Others;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			Others.Emplace(NewObject<UApologueTestEventListener>(GetTransientPackage()));
+			Others.Last()->AddCallback(Event.Get(), -1, Index);
+			REQUIRE(Dispatcher.RegisterListener(Others.Last().Get()));
+		}
+
+		// Unregistering leaves the callback in the list, where it no longer matches its slot
+		Dispatcher.UnregisterListener(Others[0].Get());
+		CHECK(Dispatcher.GetNumDeadCallbacks() == 1);
+		CHECK(Dispatcher.GetNumCallbacks(Event.Get()) == 5);
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr) == 5);
+		CHECK(Others[0]->NumCalls == 0);
+
+		// The slot is reused under a new generation, so the old callback stays dead
+		REQUIRE(Dispatcher.RegisterListener(Others[0].Get()));
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr) == 6);
+		CHECK(Others[0]->NumCalls == 1);
+
+		CHECK(Dispatcher.CompactDeadCallbacks(1) == 1);
+		CHECK(Dispatcher.GetNumDeadCallbacks() == 0);
+		CHECK(Dispatcher.GetNumCallbacks(Event.Get()) == 6);
+
+		// A list is compacted at once when half of it is dead
+		Dispatcher.UnregisterListener(Others[1].Get());
+		Dispatcher.UnregisterListener(Others[2].Get());
+		CHECK(Dispatcher.GetNumDeadCallbacks() == 2);
+		Dispatcher.UnregisterListener(Others[3].Get());
+		CHECK(Dispatcher.GetNumDeadCallbacks() == 0);
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr) == 3);
+	}
+
+	SECTION("Several Callbacks")
+	{
+		// One listener owning most of a list, so that unregistering it compacts the list partway through its callbacks
+		const TStrongObjectPtr<UApologueTestEventListener> Many(NewObject<UApologueTestEventListener>(GetTransientPackage()));
+		for (int32 Index = 0; Index < 5; ++Index)
+		{
+			Many->AddCallback(Event.Get(), -1, Index);
+		}
+
+		const TStrongObjectPtr<UApologueTestEventListener> Other(NewObject<UApologueTestEventListener>(GetTransientPackage()));
+		Other->AddCallback(Event.Get(), 2, 0);
+
+		REQUIRE(Dispatcher.RegisterListener(Many.Get()));
+		REQUIRE(Dispatcher.RegisterListener(Other.Get()));
+		CHECK(Dispatcher.GetNumCallbacks(Event.Get()) == 8);
+
+		Dispatcher.UnregisterListener(Many.Get());
+		CHECK(Dispatcher.GetNumCallbacks(Event.Get()) == 3);
+		CHECK(Dispatcher.GetNumDeadCallbacks() == 0);
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr) == 3);
+
+		// Fewer than half dead leaves them for later compaction, counted once each
+		const TStrongObjectPtr<UApologueTestEventListener> Pair(NewObject<UApologueTestEventListener>(GetTransientPackage()));
+		Pair->AddCallback(Event.Get(), -2, 0);
+		Pair->AddCallback(Event.Get(), -2, 1);
+		for (int32 Index = 0; Index < 3; ++Index)
+		{
+			Other->AddCallback(Event.Get(), 3, Index);
+		}
+
+		Dispatcher.RefreshListener(Other.Get());
+		Dispatcher.CompactDeadCallbacks(1);
+		REQUIRE(Dispatcher.RegisterListener(Pair.Get()));
+		Dispatcher.UnregisterListener(Pair.Get());
+		CHECK(Dispatcher.GetNumDeadCallbacks() == 2);
+		CHECK(Dispatcher.GetNumCallbacks(Event.Get()) == 6);
+	}
+
+	SECTION("Garbage")
+	{
+		const TStrongObjectPtr<UApologueTestEventListener> Destroyed(NewObject<UApologueTestEventListener>(GetTransientPackage()));
+		Destroyed->AddCallback(Event.Get(), 2, 0);
+		REQUIRE(Dispatcher.RegisterListener(Destroyed.Get()));
+
+		// Still registered until the next collection, but no longer called
+		Destroyed->MarkAsGarbage();
+		CHECK(Dispatcher.GetNumListeners() == 3);
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr) == 2);
+		CHECK(Destroyed->NumCalls == 0);
+		CHECK(Low->NumCalls == 1);
+
+		Destroyed->ClearGarbage();
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr) == 3);
+		CHECK(Destroyed->NumCalls == 1);
+	}
+
+	SECTION("Garbage Collection")
+	{
+		// Referenced by nothing but the dispatcher, which does not keep it alive
+		UApologueTestEventListener* Unreachable = NewObject<UApologueTestEventListener>(GetTransientPackage());
+		Unreachable->AddCallback(Event.Get(), 2, 0);
+		REQUIRE(Dispatcher.RegisterListener(Unreachable));
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr) == 3);
+		Unreachable = nullptr;
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		CHECK(Dispatcher.GetNumListeners() == 2);
+		CHECK(Dispatcher.GetNumDeadCallbacks() == 1);
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr) == 2);
+	}
+
+	SECTION("Hierarchy")
+	{
+		// Event is-a Parent is-a Grandparent
+		const TStrongObjectPtr<UApologueEvent> Grandparent = MakeEvent();
+		const TStrongObjectPtr<UApologueEvent> Parent = MakeEvent();
+		SetParent(Parent.Get(), Grandparent.Get());
+		SetParent(Event.Get(), Parent.Get());
+		CHECK(Event->GetAncestors() == TArray<FSoftObjectPath>({FSoftObjectPath(Parent.Get()), FSoftObjectPath(Grandparent.Get())}));
+
+		const TStrongObjectPtr<UApologueTestEventListener> OnParent(NewObject<UApologueTestEventListener>(GetTransientPackage()));
+		OnParent->AddCallback(Parent.Get(), 2, 0);
+
+		// Between High and Low
+		const TStrongObjectPtr<UApologueTestEventListener> OnGrandparent(NewObject<UApologueTestEventListener>(GetTransientPackage()));
+		OnGrandparent->AddCallback(Grandparent.Get(), 0, 1);
+
+		REQUIRE(Dispatcher.RegisterListener(OnParent.Get()));
+		REQUIRE(Dispatcher.RegisterListener(OnGrandparent.Get()));
+
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr) == 4);
+		CHECK(Dispatcher.Broadcast(Parent.Get(), nullptr) == 2);
+		CHECK(OnParent->NumCalls == 2);
+		CHECK(OnGrandparent->NumCalls == 2);
+		CHECK(High->NumCalls == 1);
+
+		// The merged lists run in priority order, so canceling at the grandparent's callback stops before Low
+		OnGrandparent->bCancelsEvent = true;
+		CHECK(Dispatcher.Broadcast(Event.Get(), MakeContext(0)) == 3);
+		CHECK(High->NumCalls == 2);
+		CHECK(Low->NumCalls == 1);
+
+		// A loop through the event ends its ancestors before it repeats
+		SetParent(Grandparent.Get(), Event.Get());
+		Event->RefreshAncestors();
+		CHECK(Event->GetAncestors().Num() == 2);
+	}
+
+	SECTION("Queued")
+	{
+		const TStrongObjectPtr<UApologueEvent> UrgentEvent = MakeEvent();
+		SetPriority(UrgentEvent.Get(), EApologueEventPriority::High);
+		SetPriority(Event.Get(), EApologueEventPriority::Low);
+
+		Low->bRecordsPayloads = true;
+		Low->AddCallback(UrgentEvent.Get(), 0, 0);
+		Dispatcher.RefreshListener(Low.Get());
+
+		// Kept alive by the test; a subsystem reports queued contexts to the garbage collector
+		TArray<TStrongObjectPtr<const UApologueEventContext>> Contexts;
+		for (int32 Payload = 0; Payload < 3; ++Payload)
+		{
+			Contexts.Emplace(MakeContext(Payload));
+			CHECK(Dispatcher.BroadcastOrEnqueue(Event.Get(), Contexts.Last().Get()) == 0);
+		}
+
+		Contexts.Emplace(MakeContext(3));
+		CHECK(Dispatcher.BroadcastOrEnqueue(UrgentEvent.Get(), Contexts.Last().Get()) == 0);
+		CHECK(Dispatcher.GetNumQueued() == 4);
+		CHECK(Low->NumCalls == 0);
+
+		// A zero budget still runs one broadcast per call, with all of its callbacks
+		FApologueEventDispatchStats Stats = Dispatcher.DispatchQueued(0.0);
+		CHECK(Stats.NumDispatched == 1);
+		CHECK(Stats.NumCarriedOver == 3);
+		CHECK(Low->Payloads == TArray<int32>({3}));
+
+		Stats = Dispatcher.DispatchQueued(0.0);
+		CHECK(Stats.NumDispatched == 1);
+		CHECK(High->NumCalls == 1);
+		CHECK(Low->Payloads == TArray<int32>({3, 0}));
+
+		Stats = Dispatcher.DispatchQueued(60.0);
+		CHECK(Stats.NumDispatched == 2);
+		CHECK(Stats.NumCarriedOver == 0);
+		CHECK(Stats.OverrunSeconds == 0.0);
+		CHECK(Low->Payloads == TArray<int32>({3, 0, 1, 2}));
+		CHECK(Dispatcher.GetNumQueued() == 0);
+
+		// Critical events never wait
+		SetPriority(Event.Get(), EApologueEventPriority::Critical);
+		CHECK(Dispatcher.BroadcastOrEnqueue(Event.Get(), MakeContext(4)) == 2);
+		CHECK(Dispatcher.GetNumQueued() == 0);
+		CHECK(Low->Payloads.Last() == 4);
+	}
+}
+
+#endif
@@ -0,0 +1,105 @@
+﻿#if WITH_TESTS
+
+#include "ApologueCoreTestTypes.h"
+#include "Event/ApologueEvent.h"
+#include "Event/ApologueEventIngress.h"
+
+#include "Async/ParallelFor.h"
+#include "Tests/TestHarnessAdapter.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace ApologueEventIngressTest
+{
+	struct FPayload
+	{
+		int32 Producer = 0;
+		int32 Sequence = 0;
+	};
+
+	const UApologueEventContext* MakeContext(UObject* Outer, const FPayload& Payload)
+	{
+		UApologueTestEventContext* Context = NewObject<UApologueTestEventContext>(Outer);
+		Context->Payload = Payload.Producer * 10000 + Payload.Sequence;
+		return Context;
+	}
+}
+
+TEST_CASE_NAMED(FApologueEventIngressTest, "ApologueCore::Event::Ingress", "[Apologue][ApologueCore][Event]")
+{
+	using namespace ApologueEventIngressTest;
+
+	const TStrongObjectPtr<UApologueEvent> Event(NewObject<UApologueEvent>(GetTransientPackage()));
+	UObject* Outer = GetTransientPackage();
+
+	SECTION("Producers")
+	{
+		constexpr int32 NumProducers = 8;
+		constexpr int32 NumPerProducer = 1000;
+
+		FApologueEventIngress Ingress(NumProducers * NumPerProducer);
+		ParallelFor(NumProducers, [&](const int32 Producer)
+		{
+			for (int32 Sequence = 0; Sequence < NumPerProducer; ++Sequence)
+			{
+				FPayload Payload;
+				Payload.Producer = Producer;
+				Payload.Sequence = Sequence;
+				verify(Ingress.Push<&MakeContext>(Event.Get(), Payload));
+			}
+		});
+
+		// Each producer's events come out in the order it pushed them
+		TArray<int32> NextSequence;
+		NextSequence.SetNumZeroed(NumProducers);
+		int32 NumOutOfOrder = 0;
+
+		const int32 NumDrained = Ingress.Drain(Outer, MAX_int32, [&](const TSoftObjectPtr<UApologueEvent>& DrainedEvent, const UApologueEventContext* Context)
+		{
+			const UApologueTestEventContext* TestContext = Cast<UApologueTestEventContext>(Context);
+			if (DrainedEvent.ToSoftObjectPath() != FSoftObjectPath(Event.Get()) || !TestContext)
+			{
+				++NumOutOfOrder;
+				return;
+			}
+
+			const int32 Producer = TestContext->Payload / 10000;
+			if (TestContext->Payload % 10000 != NextSequence[Producer]++)
+			{
+				++NumOutOfOrder;
+			}
+		});
+
+		CHECK(NumDrained == NumProducers * NumPerProducer);
+		CHECK(NumOutOfOrder == 0);
+		CHECK(Ingress.GetNumDropped() == 0);
+	}
+
+	SECTION("Full")
+	{
+		FApologueEventIngress Ingress(3);
+		REQUIRE(Ingress.GetCapacity() == 4);
+
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			CHECK(Ingress.Push(Event.Get()));
+		}
+
+		CHECK(!Ingress.Push(Event.Get()));
+		CHECK(Ingress.GetNumDropped() == 1);
+
+		// Draining in batches frees slots for the next lap
+		int32 NumWithoutContext = 0;
+		auto CountWithoutContext = [&](const TSoftObjectPtr<UApologueEvent>&, const UApologueEventContext* Context)
+		{
+			NumWithoutContext += Context == nullptr;
+		};
+
+		CHECK(Ingress.Drain(Outer, 3, CountWithoutContext) == 3);
+		CHECK(Ingress.Push<&MakeContext>(Event.Get(), FPayload()));
+		CHECK(Ingress.Drain(Outer, MAX_int32, CountWithoutContext) == 2);
+		CHECK(Ingress.Drain(Outer, MAX_int32, CountWithoutContext) == 0);
+		CHECK(NumWithoutContext == 4);
+	}
+}
+
+#endif
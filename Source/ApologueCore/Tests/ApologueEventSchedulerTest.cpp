@@ -0,0 +1,116 @@
+﻿#if WITH_TESTS
+
+#include "Event/ApologueEvent.h"
+#include "Event/ApologueEventScheduler.h"
+
+#include "Tests/TestHarnessAdapter.h"
+#include "UObject/StrongObjectPtr.h"
+
+TEST_CASE_NAMED(FApologueEventSchedulerTest, "ApologueCore::Event::Scheduler", "[Apologue][ApologueCore][Event]")
+{
+	const TStrongObjectPtr<UApologueEvent> Event(NewObject<UApologueEvent>(GetTransientPackage()));
+
+	// Whole-second ticks, so that delays convert to ticks exactly
+	FApologueEventScheduler Scheduler(1.0);
+
+	int32 NumBroadcasts = 0;
+	auto CountBroadcasts = [&](const TSoftObjectPtr<UApologueEvent>&, const UApologueEventContext*)
+	{
+		++NumBroadcasts;
+	};
+
+	SECTION("Delayed")
+	{
+		FApologueEventTimerHandle Handle = Scheduler.Schedule(Event.Get(), nullptr, 5.0);
+		CHECK(Scheduler.IsScheduled(Handle));
+		CHECK(Scheduler.GetTimeRemaining(Handle) == 5.0);
+
+		CHECK(Scheduler.Advance(4.5, CountBroadcasts) == 0);
+		CHECK(Scheduler.Advance(0.5, CountBroadcasts) == 1);
+		CHECK(NumBroadcasts == 1);
+		CHECK(!Scheduler.IsScheduled(Handle));
+		CHECK(Scheduler.GetNumScheduled() == 0);
+
+		// Cancelling a handle that already ran does nothing
+		Scheduler.Cancel(Handle);
+		CHECK(!Handle.IsValid());
+	}
+
+	SECTION("Periodic")
+	{
+		FApologueEventTimerHandle Handle = Scheduler.Schedule(Event.Get(), nullptr, 2.0, 3.0);
+		CHECK(Scheduler.Advance(11.0, CountBroadcasts) == 4);
+		CHECK(Scheduler.IsScheduled(Handle));
+		CHECK(Scheduler.GetTimeRemaining(Handle) == 3.0);
+
+		Scheduler.Cancel(Handle);
+		CHECK(!Scheduler.IsScheduled(Handle));
+		CHECK(Scheduler.Advance(100.0, CountBroadcasts) == 0);
+		CHECK(NumBroadcasts == 4);
+	}
+
+	SECTION("Cancel")
+	{
+		TArray<FApologueEventTimerHandle> Handles;
+		for (int32 Index = 0; Index < 100; ++Index)
+		{
+			Handles.Add(Scheduler.Schedule(Event.Get(), nullptr, 10.0));
+		}
+
+		for (int32 Index = 0; Index < Handles.Num(); Index += 2)
+		{
+			Scheduler.Cancel(Handles[Index]);
+		}
+
+		// Freed entries are reused under new serials, so stale handles stay invalid
+		const FApologueEventTimerHandle Reused = Scheduler.Schedule(Event.Get(), nullptr, 10.0);
+		CHECK(Scheduler.IsScheduled(Reused));
+		CHECK(!Scheduler.IsScheduled(Handles[98]));
+
+		CHECK(Scheduler.Advance(10.0, CountBroadcasts) == 51);
+		CHECK(Scheduler.GetNumScheduled() == 0);
+	}
+
+	SECTION("Cancel While Due")
+	{
+		// The first broadcast of the tick cancels the other, which then does not run
+		FApologueEventTimerHandle Handles[2];
+		Handles[0] = Scheduler.Schedule(Event.Get(), nullptr, 1.0);
+		Handles[1] = Scheduler.Schedule(Event.Get(), nullptr, 1.0);
+
+		CHECK(Scheduler.Advance(1.0, [&](const TSoftObjectPtr<UApologueEvent>&, const UApologueEventContext*)
+		{
+			++NumBroadcasts;
+			Scheduler.Cancel(Handles[0]);
+			Scheduler.Cancel(Handles[1]);
+		}) == 1);
+
+		CHECK(NumBroadcasts == 1);
+		CHECK(Scheduler.GetNumScheduled() == 0);
+	}
+
+	SECTION("Levels")
+	{
+		// The first and last delays of each level of the wheel
+		const double Delays[] = {255.0, 256.0, 65535.0, 65536.0, 16777215.0, 16777216.0 + 3.0};
+		for (const double Delay : Delays)
+		{
+			Scheduler.Schedule(Event.Get(), nullptr, Delay);
+		}
+
+		double Now = 0.0;
+		int32 NumEarly = 0;
+		for (const double Delay : Delays)
+		{
+			// Up to one tick before the delay, then the tick it falls due on
+			NumEarly += Scheduler.Advance(Delay - 1.0 - Now, CountBroadcasts);
+			CHECK(Scheduler.Advance(1.0, CountBroadcasts) == 1);
+			Now = Delay;
+		}
+
+		CHECK(NumEarly == 0);
+		CHECK(NumBroadcasts == UE_ARRAY_COUNT(Delays));
+	}
+}
+
+#endif
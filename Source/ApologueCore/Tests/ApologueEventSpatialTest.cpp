@@ -0,0 +1,131 @@
+﻿#if WITH_TESTS
+
+#include "ApologueCoreTestTypes.h"
+#include "Event/ApologueEvent.h"
+#include "Event/ApologueEventDispatcher.h"
+
+#include "Tests/TestHarnessAdapter.h"
+#include "UObject/StrongObjectPtr.h"
+
+TEST_CASE_NAMED(FApologueEventSpatialTest, "ApologueCore::Event::Spatial", "[Apologue][ApologueCore][Event]")
+{
+	const TStrongObjectPtr<UApologueEvent> Event(NewObject<UApologueEvent>(GetTransientPackage()));
+
+	FApologueEventDispatcher Dispatcher;
+	Dispatcher.SetCellSize(1000.0);
+
+	// Near and Far straddle a cell boundary from Center; Unplaced has no location
+	TStrongObjectPtr<UApologueTestEventListener> Center(NewObject<UApologueTestEventListener>());
+	TStrongObjectPtr<UApologueTestEventListener> Near(NewObject<UApologueTestEventListener>());
+	TStrongObjectPtr<UApologueTestEventListener> Far(NewObject<UApologueTestEventListener>());
+	TStrongObjectPtr<UApologueTestEventListener> Unplaced(NewObject<UApologueTestEventListener>());
+
+	Center->AddCallback(Event.Get(), 0, 0);
+	Near->AddCallback(Event.Get(), 10, 0);
+	Far->AddCallback(Event.Get(), 20, 0);
+	Unplaced->AddCallback(Event.Get(), 30, 0);
+
+	for (UApologueTestEventListener* Listener : {Center.Get(), Near.Get(), Far.Get(), Unplaced.Get()})
+	{
+		REQUIRE(Dispatcher.RegisterListener(Listener));
+	}
+
+	REQUIRE(Dispatcher.SetListenerLocation(Center.Get(), FVector(0.0, 0.0, 0.0)));
+	REQUIRE(Dispatcher.SetListenerLocation(Near.Get(), FVector(-300.0, 0.0, 0.0)));
+	REQUIRE(Dispatcher.SetListenerLocation(Far.Get(), FVector(5000.0, 0.0, 0.0)));
+
+	SECTION("Sphere")
+	{
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, FApologueEventScope::Sphere(FVector::ZeroVector, 500.0)) == 2);
+		CHECK(Center->NumCalls == 1);
+		CHECK(Near->NumCalls == 1);
+		CHECK(Far->NumCalls == 0);
+		CHECK(Unplaced->NumCalls == 0);
+
+		// Within the sphere's bounds but not the sphere
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, FApologueEventScope::Sphere(FVector(4700.0, 300.0, 300.0), 400.0)) == 0);
+
+		// The everywhere scope reaches listeners with and without a location
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, FApologueEventScope()) == 4);
+	}
+
+	SECTION("Box")
+	{
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, FApologueEventScope::Box(FBox(FVector(-100.0), FVector(6000.0)))) == 2);
+		CHECK(Center->NumCalls == 1);
+		CHECK(Near->NumCalls == 0);
+		CHECK(Far->NumCalls == 1);
+
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, FApologueEventScope::Box(FBox(ForceInit))) == 0);
+	}
+
+	SECTION("Priority")
+	{
+		// Near outranks Center, and canceling stops the broadcast just as it does everywhere
+		Near->bCancelsEvent = true;
+
+		const TStrongObjectPtr<UApologueTestEventContext> Context(NewObject<UApologueTestEventContext>());
+		CHECK(Dispatcher.Broadcast(Event.Get(), Context.Get(), FApologueEventScope::Sphere(FVector::ZeroVector, 500.0)) == 1);
+		CHECK(Near->NumCalls == 1);
+		CHECK(Center->NumCalls == 0);
+	}
+
+	SECTION("Move")
+	{
+		const FApologueEventScope Scope = FApologueEventScope::Sphere(FVector::ZeroVector, 500.0);
+
+		// Into the sphere from another cell, then within its cell
+		REQUIRE(Dispatcher.SetListenerLocation(Far.Get(), FVector(200.0, 0.0, 0.0)));
+		REQUIRE(Dispatcher.SetListenerLocation(Near.Get(), FVector(-900.0, 0.0, 0.0)));
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, Scope) == 2);
+		CHECK(Near->NumCalls == 0);
+		CHECK(Far->NumCalls == 1);
+
+		// Refreshing keeps the location, unregistering and clearing forget it
+		Dispatcher.RefreshListener(Far.Get());
+		CHECK(Dispatcher.FindListenerLocation(Far.Get()) != nullptr);
+
+		Dispatcher.ClearListenerLocation(Far.Get());
+		Dispatcher.UnregisterListener(Center.Get());
+		CHECK(Dispatcher.FindListenerLocation(Center.Get()) == nullptr);
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, Scope) == 0);
+
+		// Only registered listeners can be placed
+		CHECK(!Dispatcher.SetListenerLocation(Center.Get(), FVector::ZeroVector));
+	}
+
+	SECTION("Large Scope")
+	{
+		// Far more cells than are occupied; the grid visits the occupied ones instead
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, FApologueEventScope::Sphere(FVector::ZeroVector, 1.0e12)) == 3);
+
+		REQUIRE(Dispatcher.SetListenerLocation(Far.Get(), FVector(1.0e15, 0.0, 0.0)));
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, FApologueEventScope::Sphere(FVector::ZeroVector, 1.0e12)) == 2);
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, FApologueEventScope::Sphere(FVector(1.0e15, 0.0, 0.0), 1.0)) == 1);
+
+		// Clamped to the outermost cell on every axis, which the walk over cells must stop at
+		REQUIRE(Dispatcher.SetListenerLocation(Near.Get(), FVector(1.0e15)));
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, FApologueEventScope::Box(FBox(FVector(1.0e15 - 1.0), FVector(1.0e15 + 1.0)))) == 1);
+		CHECK(Near->NumCalls == 1);
+
+		REQUIRE(Dispatcher.SetListenerLocation(Near.Get(), FVector(-1.0e15)));
+		CHECK(Dispatcher.Broadcast(Event.Get(), nullptr, FApologueEventScope::Box(FBox(FVector(-1.0e15 - 1.0), FVector(-1.0e15 + 1.0)))) == 1);
+		CHECK(Near->NumCalls == 2);
+	}
+
+	SECTION("Queued")
+	{
+		const FEnumProperty* Property = FindFProperty<FEnumProperty>(UApologueEvent::StaticClass(), TEXT("Priority"));
+		REQUIRE(Property);
+		*Property->ContainerPtrToValuePtr<EApologueEventPriority>(Event.Get()) = EApologueEventPriority::Low;
+
+		// The scope is kept with the queued broadcast
+		CHECK(Dispatcher.BroadcastOrEnqueue(Event.Get(), nullptr, FApologueEventScope::Sphere(FVector(5000.0, 0.0, 0.0), 10.0)) == 0);
+		CHECK(Dispatcher.DispatchQueued(60.0).NumDispatched == 1);
+		CHECK(Far->NumCalls == 1);
+		CHECK(Center->NumCalls == 0);
+		CHECK(Unplaced->NumCalls == 0);
+	}
+}
+
+#endif
@@ -0,0 +1,549 @@
+﻿#if WITH_TESTS
+
+#include "ApologueBenchmark.h"
+#include "Engine/NetSerialization.h"
+#include "Random/ApologueCounterRandom.h"
+#include "Random/ApologueRandomStream.h"
+#include "Random/MersenneTwister.h"
+
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/TestHarnessAdapter.h"
+
+namespace ApologueRandomBenchmark
+{
+	constexpr uint64 Seed = 0xDEADBEEF;
+	constexpr int64 DrawIterations = 1000000;
+	constexpr double ConeHalfAngleRad = 0.5;
+
+	const int32 BatchSizes[] = {16, 256, 4096};
+
+	FApologueBenchmarkResult& AddDrawsPerSecond(FApologueBenchmarkResult& Result, const int64 DrawsPerIteration)
+	{
+		Result.Metrics.Add(TEXT("drawsPerSecond"), 1.0e9 * DrawsPerIteration / Result.NanosecondsPerIteration);
+		return Result;
+	}
+
+	/**
+	 * Times every path of FApologueRandom on one engine, one value at a time and in batches.
+	 */
+	template <typename EngineType>
+	void RunEngineCases(FApologueBenchmarkSuite& Suite, const FString& EngineName, EngineType& Engine)
+	{
+		const FString Prefix = TEXT("Engine.") + EngineName + TEXT(".");
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("Word"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(Engine());
+		}), 1);
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("RandHelper"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(FApologueRandom::RandHelper(Engine, 1000));
+		}), 1);
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("RandomRange.Int"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(FApologueRandom::RandomRange(Engine, -1000, 1000));
+		}), 1);
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("RandomRange.Float"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(FApologueRandom::RandomRange(Engine, -1.0f, 1.0f));
+		}), 1);
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("GetUnitVector"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(FApologueRandom::GetUnitVector(Engine));
+		}), 1);
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("GetCone"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(FApologueRandom::GetCone(Engine, FVector::ForwardVector, ConeHalfAngleRad));
+		}), 1);
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("GetNormal"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(FApologueRandom::GetNormal(Engine));
+		}), 1);
+
+		for (const int32 BatchSize : BatchSizes)
+		{
+			const int64 Iterations = FMath::Max<int64>(100, DrawIterations / BatchSize);
+			const FString Suffix = FString::Printf(TEXT("/%d"), BatchSize);
+
+			TArray<uint64> Words;
+			Words.SetNumUninitialized(BatchSize);
+			AddDrawsPerSecond(Suite.Run(Prefix + TEXT("FillWords") + Suffix, Iterations, [&]
+			{
+				FApologueRandom::FillWords(Engine, MakeArrayView(Words));
+				ApologueBenchmarkKeep(Words[0]);
+			}), BatchSize).Metrics.Add(TEXT("batchSize"), BatchSize);
+
+			TArray<int32> Ints;
+			Ints.SetNumUninitialized(BatchSize);
+			AddDrawsPerSecond(Suite.Run(Prefix + TEXT("FillRange.Int") + Suffix, Iterations, [&]
+			{
+				FApologueRandom::FillRange(Engine, MakeArrayView(Ints), -1000, 1000);
+				ApologueBenchmarkKeep(Ints[0]);
+			}), BatchSize).Metrics.Add(TEXT("batchSize"), BatchSize);
+
+			TArray<float> Floats;
+			Floats.SetNumUninitialized(BatchSize);
+			AddDrawsPerSecond(Suite.Run(Prefix + TEXT("FillRange.Float") + Suffix, Iterations, [&]
+			{
+				FApologueRandom::FillRange(Engine, MakeArrayView(Floats), -1.0f, 1.0f);
+				ApologueBenchmarkKeep(Floats[0]);
+			}), BatchSize).Metrics.Add(TEXT("batchSize"), BatchSize);
+
+			TArray<FVector> Vectors;
+			Vectors.SetNumUninitialized(BatchSize);
+			AddDrawsPerSecond(Suite.Run(Prefix + TEXT("FillUnitVectors") + Suffix, Iterations, [&]
+			{
+				FApologueRandom::FillUnitVectors(Engine, MakeArrayView(Vectors));
+				ApologueBenchmarkKeep(Vectors[0]);
+			}), BatchSize).Metrics.Add(TEXT("batchSize"), BatchSize);
+
+			AddDrawsPerSecond(Suite.Run(Prefix + TEXT("FillCone") + Suffix, Iterations, [&]
+			{
+				FApologueRandom::FillCone(Engine, MakeArrayView(Vectors), FVector::ForwardVector, ConeHalfAngleRad);
+				ApologueBenchmarkKeep(Vectors[0]);
+			}), BatchSize).Metrics.Add(TEXT("batchSize"), BatchSize);
+
+			TArray<int32> List;
+			for (int32 Index = 0; Index < BatchSize; ++Index)
+			{
+				List.Add(Index);
+			}
+
+			Suite.Run(Prefix + TEXT("Shuffle") + Suffix, Iterations, [&]
+			{
+				FApologueRandom::Shuffle(Engine, List);
+				ApologueBenchmarkKeep(List[0]);
+			}).Metrics.Add(TEXT("batchSize"), BatchSize);
+		}
+	}
+
+	/**
+	 * Times the public paths of a stream type, which add the wrapper's dispatch to the engine's cost.
+	 */
+	template <typename StreamType>
+	void RunStreamCases(FApologueBenchmarkSuite& Suite, const FString& StreamName, const StreamType& Stream)
+	{
+		const FString Prefix = TEXT("Stream.") + StreamName + TEXT(".");
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("RandHelper"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(Stream.RandHelper(1000));
+		}), 1);
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("RandomRange.Int"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(Stream.RandomRange(-1000, 1000));
+		}), 1);
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("RandomRange.Float"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(Stream.RandomRange(-1.0f, 1.0f));
+		}), 1);
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("GetUnitVector"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(Stream.GetUnitVector());
+		}), 1);
+
+		AddDrawsPerSecond(Suite.Run(Prefix + TEXT("GetCone"), DrawIterations, [&]
+		{
+			ApologueBenchmarkKeep(Stream.GetCone(FVector::ForwardVector, ConeHalfAngleRad));
+		}), 1);
+
+		TArray<int32> List;
+		for (int32 Index = 0; Index < 256; ++Index)
+		{
+			List.Add(Index);
+		}
+
+		Suite.Run(Prefix + TEXT("Shuffle/256"), DrawIterations / 256, [&]
+		{
+			Stream.Shuffle(List);
+			ApologueBenchmarkKeep(List[0]);
+		});
+	}
+
+	/**
+	 * Chi-square statistic of bucket counts against equally likely buckets.
+	 */
+	double ChiSquare(const TConstArrayView<int64> Counts)
+	{
+		int64 Total = 0;
+		for (const int64 Count : Counts)
+		{
+			Total += Count;
+		}
+
+		const double Expected = static_cast<double>(Total) / Counts.Num();
+		double Statistic = 0.0;
+		for (const int64 Count : Counts)
+		{
+			Statistic += FMath::Square(Count - Expected) / Expected;
+		}
+
+		return Statistic;
+	}
+
+	/**
+	 * @return The value a chi-square statistic exceeds with a probability of about 3e-7, by the Wilson-Hilferty
+	 * approximation; seeds are fixed, so a case over it is a broken engine rather than bad luck.
+	 */
+	double ChiSquareLimit(const int32 DegreesOfFreedom)
+	{
+		constexpr double Z = 5.0;
+		const double Scale = 2.0 / (9.0 * DegreesOfFreedom);
+		return DegreesOfFreedom * FMath::Pow(1.0 - Scale + Z * FMath::Sqrt(Scale), 3.0);
+	}
+
+	/**
+	 * Statistics of one engine's output, each chi-square against its limit or a z-score against 5.
+	 */
+	struct FQualityReport
+	{
+		// RandHelper(100) buckets
+		double RangeChiSquare = 0.0;
+
+		// Top and bottom bytes of raw words
+		double HighByteChiSquare = 0.0;
+		double LowByteChiSquare = 0.0;
+
+		// Consecutive RandHelper(16) pairs
+		double PairChiSquare = 0.0;
+
+		// Orderings of a shuffled list of four
+		double PermutationChiSquare = 0.0;
+
+		// Largest deviation of any bit of raw words from one half
+		double MaxBitZ = 0.0;
+
+		double FractionMeanZ = 0.0;
+		double UnitVectorMeanZ = 0.0;
+		double NormalMeanZ = 0.0;
+		double NormalVarianceZ = 0.0;
+	};
+
+	constexpr int32 QualitySamples = 1 << 20;
+
+	template <typename EngineType>
+	FQualityReport MeasureQuality(EngineType& Engine)
+	{
+		FQualityReport Report;
+
+		TArray<int64> Counts;
+		Counts.SetNumZeroed(100);
+		for (int32 Index = 0; Index < QualitySamples; ++Index)
+		{
+			++Counts[FApologueRandom::RandHelper(Engine, 100)];
+		}
+		Report.RangeChiSquare = ChiSquare(Counts);
+
+		// Raw words go through FillWords, the path batched engines speed up
+		TArray<int64> HighBytes, LowBytes, Bits;
+		HighBytes.SetNumZeroed(256);
+		LowBytes.SetNumZeroed(256);
+		Bits.SetNumZeroed(64);
+
+		uint64 Words[FApologueRandom::FillChunkSize];
+		for (int32 Start = 0; Start < QualitySamples; Start += FApologueRandom::FillChunkSize)
+		{
+			FApologueRandom::FillWords(Engine, MakeArrayView(Words));
+			for (const uint64 Word : Words)
+			{
+				++HighBytes[Word >> 56];
+				++LowBytes[Word & 0xFF];
+				for (int32 Bit = 0; Bit < 64; ++Bit)
+				{
+					Bits[Bit] += (Word >> Bit) & 1;
+				}
+			}
+		}
+		Report.HighByteChiSquare = ChiSquare(HighBytes);
+		Report.LowByteChiSquare = ChiSquare(LowBytes);
+
+		for (const int64 Ones : Bits)
+		{
+			const double Z = (Ones - QualitySamples / 2.0) / FMath::Sqrt(QualitySamples / 4.0);
+			Report.MaxBitZ = FMath::Max(Report.MaxBitZ, FMath::Abs(Z));
+		}
+
+		Counts.Reset();
+		Counts.SetNumZeroed(256);
+		for (int32 Index = 0; Index < QualitySamples; ++Index)
+		{
+			const int32 First = FApologueRandom::RandHelper(Engine, 16);
+			++Counts[First * 16 + FApologueRandom::RandHelper(Engine, 16)];
+		}
+		Report.PairChiSquare = ChiSquare(Counts);
+
+		Counts.Reset();
+		Counts.SetNumZeroed(256);
+		for (int32 Index = 0; Index < QualitySamples / 4; ++Index)
+		{
+			TArray<int32> List = {0, 1, 2, 3};
+			FApologueRandom::Shuffle(Engine, List);
+			++Counts[List[0] * 64 + List[1] * 16 + List[2] * 4 + List[3]];
+		}
+
+		// Only the 24 orderings of four distinct elements can occur
+		TArray<int64> Permutations;
+		for (const int64 Count : Counts)
+		{
+			if (Count > 0)
+			{
+				Permutations.Add(Count);
+			}
+		}
+		Report.PermutationChiSquare = Permutations.Num() == 24 ? ChiSquare(Permutations) : MAX_dbl;
+
+		double FractionSum = 0.0;
+		FVector VectorSum = FVector::ZeroVector;
+		double NormalSum = 0.0, NormalSquareSum = 0.0;
+		for (int32 Index = 0; Index < QualitySamples; ++Index)
+		{
+			FractionSum += FApologueRandom::GetFraction<double>(Engine);
+			VectorSum += FApologueRandom::GetUnitVector(Engine);
+
+			const double Normal = FApologueRandom::GetStandardNormal(Engine);
+			NormalSum += Normal;
+			NormalSquareSum += Normal * Normal;
+		}
+
+		Report.FractionMeanZ = FMath::Abs(FractionSum / QualitySamples - 0.5) / FMath::Sqrt(1.0 / 12.0 / QualitySamples);
+		Report.UnitVectorMeanZ = VectorSum.GetAbsMax() / QualitySamples / FMath::Sqrt(1.0 / 3.0 / QualitySamples);
+
+		const double NormalMean = NormalSum / QualitySamples;
+		const double NormalVariance = NormalSquareSum / QualitySamples - NormalMean * NormalMean;
+		Report.NormalMeanZ = FMath::Abs(NormalMean) * FMath::Sqrt(static_cast<double>(QualitySamples));
+		Report.NormalVarianceZ = FMath::Abs(NormalVariance - 1.0) / FMath::Sqrt(2.0 / QualitySamples);
+
+		return Report;
+	}
+}
+
+TEST_CASE_NAMED(FApologueRandomBenchmark, "ApologueCore::Benchmark::Random", "[Apologue][ApologueCore][Benchmark]")
+{
+	using namespace ApologueRandomBenchmark;
+
+	FApologueBenchmarkSuite Suite(TEXT("ApologueRandom"));
+
+	{
+		FMersenneTwisterEngine Engine(Seed);
+		RunEngineCases(Suite, TEXT("MersenneTwister"), Engine);
+	}
+	{
+		FApologueXoshiro256StarStarEngine Engine(Seed);
+		RunEngineCases(Suite, TEXT("Xoshiro256StarStar"), Engine);
+	}
+	{
+		FApologueXoshiro256StarStarX4Engine Engine(Seed);
+		RunEngineCases(Suite, TEXT("Xoshiro256StarStarX4"), Engine);
+	}
+	{
+		FApologuePCG64Engine Engine(Seed);
+		RunEngineCases(Suite, TEXT("PCG64"), Engine);
+	}
+	{
+		FApologueSFC64Engine Engine(Seed);
+		RunEngineCases(Suite, TEXT("SFC64"), Engine);
+	}
+	{
+		FApologuePhiloxEngine Engine(Seed);
+		RunEngineCases(Suite, TEXT("Philox"), Engine);
+	}
+
+	FMersenneTwister MersenneTwister;
+	MersenneTwister.Initialize(Seed);
+	RunStreamCases(Suite, TEXT("MersenneTwister"), MersenneTwister);
+
+	for (const EApologueRandomEngine EngineType : {EApologueRandomEngine::Xoshiro256StarStar, EApologueRandomEngine::PCG64, EApologueRandomEngine::SFC64})
+	{
+		FApologueRandomStream Stream(EngineType);
+		Stream.Initialize(Seed);
+		RunStreamCases(Suite, TEXT("RandomStream.") + StaticEnum<EApologueRandomEngine>()->GetNameStringByValue(static_cast<int64>(EngineType)), Stream);
+	}
+
+	FApologueCounterRandom CounterRandom;
+	CounterRandom.Initialize(Seed);
+	RunStreamCases(Suite, TEXT("CounterStream"), CounterRandom.At(0, 0));
+
+	// The Blueprint node, through the same call ProcessEvent makes for any native function
+	UFunction* ShuffleFunction = UMersenneTwisterLibrary::StaticClass()->FindFunctionByName(TEXT("ShuffleArray"));
+	REQUIRE(ShuffleFunction);
+
+	const FStructProperty* TwisterProperty = CastField<FStructProperty>(ShuffleFunction->FindPropertyByName(TEXT("MersenneTwister")));
+	const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(ShuffleFunction->FindPropertyByName(TEXT("TargetArray")));
+	REQUIRE(TwisterProperty);
+	REQUIRE(ArrayProperty);
+
+	UObject* Library = UMersenneTwisterLibrary::StaticClass()->GetDefaultObject();
+	for (const int32 BatchSize : BatchSizes)
+	{
+		TArray<uint8> Params;
+		Params.SetNumZeroed(ShuffleFunction->ParmsSize);
+		ShuffleFunction->InitializeStruct(Params.GetData());
+
+		TwisterProperty->ContainerPtrToValuePtr<FMersenneTwister>(Params.GetData())->Initialize(Seed);
+		TArray<int32>& List = *ArrayProperty->ContainerPtrToValuePtr<TArray<int32>>(Params.GetData());
+		for (int32 Index = 0; Index < BatchSize; ++Index)
+		{
+			List.Add(Index);
+		}
+
+		Suite.Run(FString::Printf(TEXT("Blueprint.ShuffleArray/%d"), BatchSize), FMath::Max<int64>(100, DrawIterations / BatchSize), [&]
+		{
+			Library->ProcessEvent(ShuffleFunction, Params.GetData());
+		}).Metrics.Add(TEXT("batchSize"), BatchSize);
+
+		CHECK(List.Num() == BatchSize);
+		ShuffleFunction->DestroyStruct(Params.GetData());
+	}
+
+	// Serialization round trips
+	for (int32 Index = 0; Index < 1000; ++Index)
+	{
+		MersenneTwister.RandHelper(MAX_uint64);
+	}
+
+	TArray<uint8> Bytes;
+	Suite.Run(TEXT("Serialize.MersenneTwister"), 10000, [&]
+	{
+		Bytes.Reset();
+		FMemoryWriter Writer(Bytes);
+		Writer << MersenneTwister;
+
+		FMersenneTwister ReadTwister;
+		FMemoryReader Reader(Bytes);
+		Reader << ReadTwister;
+		ApologueBenchmarkKeep(ReadTwister.GetDrawCount());
+	}).Metrics.Add(TEXT("bytes"), Bytes.Num());
+
+	FApologueRandomStream RandomStream;
+	RandomStream.Initialize(Seed);
+	Suite.Run(TEXT("Serialize.RandomStream"), 100000, [&]
+	{
+		Bytes.Reset();
+		FMemoryWriter Writer(Bytes);
+		Writer << RandomStream;
+
+		FApologueRandomStream ReadStream;
+		FMemoryReader Reader(Bytes);
+		Reader << ReadStream;
+		ApologueBenchmarkKeep(ReadStream.IsInitialized());
+	}).Metrics.Add(TEXT("bytes"), Bytes.Num());
+
+	// A connected client is sent the draws made since the last acknowledged update
+	int64 NumBits = 0;
+	FMersenneTwister Client;
+	TSharedPtr<INetDeltaBaseState> Base;
+	Suite.Run(TEXT("NetDeltaSerialize.MersenneTwister.Incremental"), 100000, [&]
+	{
+		MersenneTwister.RandHelper(MAX_uint64);
+
+		FBitWriter Writer(0, true);
+		TSharedPtr<INetDeltaBaseState> NewState;
+		FNetDeltaSerializeInfo WriteParms;
+		WriteParms.Writer = &Writer;
+		WriteParms.OldState = Base.Get();
+		WriteParms.NewState = &NewState;
+		MersenneTwister.NetDeltaSerialize(WriteParms);
+		Base = NewState;
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		FNetDeltaSerializeInfo ReadParms;
+		ReadParms.Reader = &Reader;
+		Client.NetDeltaSerialize(ReadParms);
+		NumBits = Writer.GetNumBits();
+	}).Metrics.Add(TEXT("bits"), NumBits);
+
+	CHECK(Client.Identical(&MersenneTwister, 0));
+
+	// A new client replays every draw from the seed
+	Suite.Run(TEXT("NetSerialize.MersenneTwister.Replay"), 1000, [&]
+	{
+		FBitWriter Writer(0, true);
+		bool bSuccess = false;
+		MersenneTwister.NetSerialize(Writer, nullptr, bSuccess);
+
+		FMersenneTwister NewClient;
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		NewClient.NetSerialize(Reader, nullptr, bSuccess);
+		ApologueBenchmarkKeep(NewClient.GetDrawCount());
+	}).Metrics.Add(TEXT("drawCount"), static_cast<double>(MersenneTwister.GetDrawCount()));
+
+	CHECK(Suite.WriteJson());
+}
+
+TEST_CASE_NAMED(FApologueRandomQualityTest, "ApologueCore::Random::Quality", "[Apologue][ApologueCore][Random]")
+{
+	using namespace ApologueRandomBenchmark;
+
+	auto CheckQuality = [&](const FQualityReport& Report)
+	{
+		CHECK(Report.RangeChiSquare < ChiSquareLimit(99));
+		CHECK(Report.HighByteChiSquare < ChiSquareLimit(255));
+		CHECK(Report.LowByteChiSquare < ChiSquareLimit(255));
+		CHECK(Report.PairChiSquare < ChiSquareLimit(255));
+		CHECK(Report.PermutationChiSquare < ChiSquareLimit(23));
+		CHECK(Report.MaxBitZ < 5.0);
+		CHECK(Report.FractionMeanZ < 5.0);
+		CHECK(Report.UnitVectorMeanZ < 5.0);
+		CHECK(Report.NormalMeanZ < 5.0);
+		CHECK(Report.NormalVarianceZ < 5.0);
+	};
+
+	SECTION("Mersenne Twister")
+	{
+		FMersenneTwisterEngine Engine(Seed);
+		CheckQuality(MeasureQuality(Engine));
+	}
+
+	SECTION("xoshiro256**")
+	{
+		FApologueXoshiro256StarStarEngine Engine(Seed);
+		CheckQuality(MeasureQuality(Engine));
+	}
+
+	SECTION("xoshiro256** x4")
+	{
+		FApologueXoshiro256StarStarX4Engine Engine(Seed);
+		CheckQuality(MeasureQuality(Engine));
+	}
+
+	SECTION("PCG64")
+	{
+		FApologuePCG64Engine Engine(Seed);
+		CheckQuality(MeasureQuality(Engine));
+	}
+
+	SECTION("SFC64")
+	{
+		FApologueSFC64Engine Engine(Seed);
+		CheckQuality(MeasureQuality(Engine));
+	}
+
+	SECTION("Philox")
+	{
+		FApologuePhiloxEngine Engine(Seed);
+		CheckQuality(MeasureQuality(Engine));
+	}
+
+	SECTION("Chi-Square Limit")
+	{
+		// Against tabulated quantiles at p = 1e-6 and 1e-7, which bracket the limit
+		CHECK(ChiSquareLimit(23) > 70.5);
+		CHECK(ChiSquareLimit(23) < 76.9);
+		CHECK(ChiSquareLimit(255) > 377.1);
+		CHECK(ChiSquareLimit(255) < 390.2);
+	}
+}
+
+#endif
@@ -0,0 +1,830 @@
+﻿#if WITH_TESTS
+
+#include "Random/ApologueRandomStream.h"
+#include "Random/ApologueReservoir.h"
+
+#include "Algo/Count.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/TestHarnessAdapter.h"
+
+TEST_CASE_NAMED(FApologueRandomStreamTest, "ApologueCore::RandomStream", "[Apologue][ApologueCore][RandomStream]")
+{
+	constexpr uint64 Seed = 0xDEADBEEF;
+	const EApologueRandomEngine EngineTypes[] = {EApologueRandomEngine::Xoshiro256StarStar, EApologueRandomEngine::PCG64, EApologueRandomEngine::SFC64};
+
+	SECTION("Reference Output")
+	{
+		// First outputs of xoshiro256** from the state {1, 2, 3, 4}
+		const uint64 InitialState[] = {1, 2, 3, 4};
+		FApologueXoshiro256StarStarEngine Engine;
+		REQUIRE(Engine.SetState(InitialState));
+
+		CHECK(Engine.Next() == 11520ull);
+		CHECK(Engine.Next() == 0ull);
+		CHECK(Engine.Next() == 1509978240ull);
+		CHECK(Engine.Next() == 1215971899390074240ull);
+
+		const uint64 ZeroState[] = {0, 0, 0, 0};
+		CHECK(!Engine.SetState(ZeroState));
+	}
+
+	SECTION("Consistent Seeding")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream StreamA(EngineType);
+			StreamA.Initialize(Seed);
+
+			FApologueRandomStream StreamB(EngineType);
+			StreamB.Initialize(Seed);
+
+			for (int32 i = 0; i < 16; i++)
+			{
+				CHECK(StreamA.RandHelper(MAX_uint64) == StreamB.RandHelper(MAX_uint64));
+			}
+		}
+	}
+
+	SECTION("Engines Differ")
+	{
+		FApologueRandomStream Xoshiro(EApologueRandomEngine::Xoshiro256StarStar);
+		Xoshiro.Initialize(Seed);
+
+		FApologueRandomStream PCG(EApologueRandomEngine::PCG64);
+		PCG.Initialize(Seed);
+
+		CHECK(Xoshiro.RandHelper(MAX_uint64) != PCG.RandHelper(MAX_uint64));
+	}
+
+	SECTION("Reset")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream Stream(EngineType);
+			Stream.Initialize(Seed);
+			const uint64 First = Stream.RandHelper(MAX_uint64);
+			Stream.RandHelper(MAX_uint64);
+
+			Stream.Reset();
+			CHECK(Stream.RandHelper(MAX_uint64) == First);
+		}
+	}
+
+	SECTION("Serialization")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream StreamA(EngineType);
+			StreamA.Initialize(Seed);
+			for (int32 i = 0; i < 17; i++)
+			{
+				StreamA.GetFraction<double>();
+			}
+
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			Writer << StreamA;
+
+			FApologueRandomStream StreamB;
+			FMemoryReader Reader(Bytes);
+			Reader << StreamB;
+
+			CHECK(!Reader.IsError());
+			CHECK(StreamB.IsInitialized());
+			CHECK(StreamB.GetEngineType() == EngineType);
+			CHECK(StreamB.GetInitialSeed() == StreamA.GetInitialSeed());
+			CHECK(StreamB.RandHelper(MAX_uint64) == StreamA.RandHelper(MAX_uint64));
+		}
+	}
+
+	SECTION("Property Serialization")
+	{
+		// Stream properties go through the native format, so their draws survive a round trip, substreams included
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream Parent(EngineType);
+			Parent.Initialize(Seed);
+
+			TArray<FApologueRandomStream> Streams;
+			Parent.Split(2, Streams);
+			Streams.Add(Parent);
+
+			for (FApologueRandomStream& StreamA : Streams)
+			{
+				for (int32 i = 0; i < 17; i++)
+				{
+					StreamA.RandHelper(MAX_uint64);
+				}
+
+				TArray<uint8> Bytes;
+				FMemoryWriter Writer(Bytes);
+				FApologueRandomStream::StaticStruct()->SerializeItem(Writer, &StreamA, nullptr);
+
+				FApologueRandomStream StreamB;
+				FMemoryReader Reader(Bytes);
+				FApologueRandomStream::StaticStruct()->SerializeItem(Reader, &StreamB, nullptr);
+
+				CHECK(!Reader.IsError());
+				CHECK(StreamB.GetEngineType() == EngineType);
+				CHECK(StreamB.GetStreamIndex() == StreamA.GetStreamIndex());
+				CHECK(StreamB.Identical(&StreamA, 0));
+				CHECK(StreamB.RandHelper(MAX_uint64) == StreamA.RandHelper(MAX_uint64));
+			}
+		}
+	}
+
+	SECTION("Tagged Layout")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream Saved(EngineType);
+			Saved.Initialize(Seed);
+			Saved.RandHelper(MAX_uint64);
+
+			// As saved before the portable format, when only the properties were written
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			FApologueRandomStream::StaticStruct()->SerializeTaggedProperties(Writer, reinterpret_cast<uint8*>(&Saved), FApologueRandomStream::StaticStruct(), nullptr);
+
+			FMemoryReader Reader(Bytes);
+			Reader.SetCustomVersion(FApologueCoreCustomVersion::GUID, FApologueCoreCustomVersion::BeforeCustomVersionWasAdded, TEXT("ApologueCore"));
+
+			FApologueRandomStream Loaded;
+			FApologueRandomStream::StaticStruct()->SerializeItem(Reader, &Loaded, nullptr);
+
+			// The engine was not saved, so the stream starts over on the saved engine rather than the default one
+			FApologueRandomStream Reference(EngineType);
+			Reference.Initialize(Seed);
+
+			CHECK(!Reader.IsError());
+			CHECK(Loaded.GetEngineType() == EngineType);
+			CHECK(Loaded.RandHelper(MAX_uint64) == Reference.RandHelper(MAX_uint64));
+		}
+	}
+
+	SECTION("Property Writes")
+	{
+		FApologueRandomStream Stream;
+		Stream.Initialize(Seed);
+
+		// As the details panel, a text import or property replication would write them, without the stream's methods
+		const FEnumProperty* EngineTypeProperty = FindFProperty<FEnumProperty>(FApologueRandomStream::StaticStruct(), TEXT("EngineType"));
+		const FInt64Property* SeedProperty = FindFProperty<FInt64Property>(FApologueRandomStream::StaticStruct(), TEXT("InitialSeed"));
+		REQUIRE(EngineTypeProperty);
+		REQUIRE(SeedProperty);
+
+		*EngineTypeProperty->ContainerPtrToValuePtr<EApologueRandomEngine>(&Stream) = EApologueRandomEngine::PCG64;
+
+		FApologueRandomStream PCG(EApologueRandomEngine::PCG64);
+		PCG.Initialize(Seed);
+		CHECK(Stream.RandHelper(MAX_uint64) == PCG.RandHelper(MAX_uint64));
+
+		SeedProperty->SetPropertyValue_InContainer(&Stream, static_cast<int64>(Seed + 1));
+
+		FApologueRandomStream Reseeded(EApologueRandomEngine::PCG64);
+		Reseeded.Initialize(Seed + 1);
+		CHECK(Stream.RandHelper(MAX_uint64) == Reseeded.RandHelper(MAX_uint64));
+	}
+
+	SECTION("Net Serialization")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream Server(EngineType);
+			Server.Initialize(Seed);
+			for (int32 i = 0; i < 100; i++)
+			{
+				Server.RandHelper(MAX_uint64);
+			}
+
+			FBitWriter Writer(0, true);
+			bool bSuccess = false;
+			Server.NetSerialize(Writer, nullptr, bSuccess);
+			CHECK(bSuccess);
+
+			FApologueRandomStream Client;
+			FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+			Client.NetSerialize(Reader, nullptr, bSuccess);
+
+			CHECK(bSuccess);
+			CHECK(!Reader.IsError());
+			CHECK(Client.Identical(&Server, 0));
+			CHECK(Client.RandHelper(MAX_uint64) == Server.RandHelper(MAX_uint64));
+
+			// Draws are seen by property comparisons
+			Server.RandHelper(MAX_uint64);
+			CHECK_FALSE(Client.Identical(&Server, 0));
+		}
+	}
+
+	SECTION("Four Lane Engine")
+	{
+		FApologueXoshiro256StarStarEngine Scalar(Seed);
+		FApologueXoshiro256StarStarX4Engine Lanes(Seed);
+		FApologueXoshiro256StarStarX4Engine Filled(Seed);
+
+		// Start mid-step so the fill has to finish the current step first
+		Lanes.Next();
+		Filled.Next();
+
+		TArray<uint64> Words;
+		Words.SetNumUninitialized(1001);
+		Filled.Fill(Words);
+
+		bool bMatchesNext = true;
+		bool bMatchesScalar = Scalar.Next() == FApologueXoshiro256StarStarX4Engine(Seed).Next();
+		for (int32 i = 0; i < Words.Num(); i++)
+		{
+			const uint64 Word = Lanes.Next();
+			bMatchesNext &= Word == Words[i];
+
+			// Lane 0 is every fourth word, counting the one drawn before the fill
+			if ((i + 1) % FApologueXoshiro256StarStarX4Engine::NumLanes == 0)
+			{
+				bMatchesScalar &= Word == Scalar.Next();
+			}
+		}
+
+		CHECK(bMatchesNext);
+		CHECK(bMatchesScalar);
+		CHECK(Lanes == Filled);
+	}
+
+	SECTION("Bulk Fill")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream Stream(EngineType);
+			Stream.Initialize(Seed);
+
+			TArray<int32> Integers;
+			Integers.SetNumUninitialized(1000);
+			Stream.FillRange(MakeArrayView(Integers), -3, 3);
+			CHECK(FMath::Min(Integers) == -3);
+			CHECK(FMath::Max(Integers) == 3);
+
+			TArray<float> Fractions;
+			Fractions.SetNumUninitialized(1000);
+			Stream.FillFraction(MakeArrayView(Fractions));
+			CHECK(FMath::Min(Fractions) >= 0.f);
+			CHECK(FMath::Max(Fractions) < 1.f);
+
+			TArray<bool> Bools;
+			Bools.SetNumUninitialized(1000);
+			Stream.FillBools(Bools);
+			const int32 NumTrue = Algo::Count(Bools, true);
+			CHECK(NumTrue > 400);
+			CHECK(NumTrue < 600);
+		}
+	}
+
+	SECTION("Platform Independent Sampling")
+	{
+		// Fixed by the plugin's own sampling algorithms, so these hold on every platform and standard library
+		FApologueRandomStream Stream(EApologueRandomEngine::Xoshiro256StarStar);
+		Stream.Initialize(Seed);
+
+		for (const int32 Expected : {5, 3, 2, 2, 6, 4, 6, 2})
+		{
+			CHECK(Stream.RandomRange(1, 6) == Expected);
+		}
+
+		CHECK(Stream.GetFraction<double>() == 0.9076456947665853);
+		CHECK(Stream.GetFraction<float>() == 0.659068704f);
+	}
+
+	SECTION("Scalar Matches Bulk")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream ScalarStream(EngineType);
+			ScalarStream.Initialize(Seed);
+
+			FApologueRandomStream BulkStream(EngineType);
+			BulkStream.Initialize(Seed);
+
+			TArray<int64> Integers;
+			Integers.SetNumUninitialized(1000);
+			BulkStream.FillRange(MakeArrayView(Integers), -1000, MAX_int64 / 3);
+
+			TArray<double> Fractions;
+			Fractions.SetNumUninitialized(1000);
+			BulkStream.FillFraction(MakeArrayView(Fractions));
+
+			bool bMatches = true;
+			for (const int64 Integer : Integers)
+			{
+				bMatches &= ScalarStream.RandomRange<int64>(-1000, MAX_int64 / 3) == Integer;
+			}
+
+			for (const double Fraction : Fractions)
+			{
+				bMatches &= ScalarStream.GetFraction<double>() == Fraction;
+			}
+
+			CHECK(bMatches);
+			CHECK(ScalarStream.RandHelper(MAX_uint64) == BulkStream.RandHelper(MAX_uint64));
+		}
+	}
+
+	SECTION("Jump Ahead")
+	{
+		// Jumping and drawing commute, since both are powers of the same transition
+		FApologueXoshiro256StarStarEngine XoshiroA(Seed);
+		FApologueXoshiro256StarStarEngine XoshiroB(Seed);
+		for (int32 i = 0; i < 100; i++)
+		{
+			XoshiroA.Next();
+		}
+
+		XoshiroA.Jump();
+		XoshiroB.Jump();
+		for (int32 i = 0; i < 100; i++)
+		{
+			XoshiroB.Next();
+		}
+
+		CHECK(XoshiroA == XoshiroB);
+
+		// Lane 0 of the four lane engine jumps like the scalar engine
+		FApologueXoshiro256StarStarX4Engine FourLane(Seed);
+		FApologueXoshiro256StarStarEngine Scalar(Seed);
+		FourLane.Jump();
+		Scalar.Jump();
+		CHECK(FourLane.Next() == Scalar.Next());
+
+		for (const uint64 Delta : {0ull, 1ull, 1000ull, 12345ull})
+		{
+			FApologuePCG64Engine Advanced(Seed);
+			Advanced.Advance(Delta);
+
+			FApologuePCG64Engine Drawn(Seed);
+			for (uint64 i = 0; i < Delta; i++)
+			{
+				Drawn.Next();
+			}
+
+			CHECK(Advanced == Drawn);
+		}
+
+		FApologuePCG64Engine Jumped(Seed);
+		FApologuePCG64Engine Advanced(Seed);
+		Jumped.Jump();
+		Advanced.Advance(MAX_uint64);
+		Advanced.Advance(1);
+		CHECK(Jumped == Advanced);
+	}
+
+	SECTION("Split")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream Stream(EngineType);
+			Stream.Initialize(Seed);
+			const uint64 ParentFirst = Stream.RandHelper(MAX_uint64);
+
+			TArray<FApologueRandomStream> Streams;
+			Stream.Split(3, Streams);
+			REQUIRE(Streams.Num() == 3);
+
+			TArray<uint64> Firsts;
+			for (int32 i = 0; i < Streams.Num(); i++)
+			{
+				CHECK(Streams[i].GetEngineType() == EngineType);
+				CHECK(Streams[i].GetStreamIndex() == i + 1);
+				Firsts.Add(Streams[i].RandHelper(MAX_uint64));
+			}
+
+			CHECK(Firsts[0] != ParentFirst);
+			CHECK(Firsts[0] != Firsts[1]);
+			CHECK(Firsts[1] != Firsts[2]);
+
+			// Substreams follow from the seed alone, so they can be re-derived one at a time
+			TArray<FApologueRandomStream> Grandchildren;
+			Streams[0].Split(1, Grandchildren);
+			CHECK(Grandchildren[0].RandHelper(MAX_uint64) == Firsts[1]);
+
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			Writer << Streams[2];
+
+			FApologueRandomStream Loaded;
+			FMemoryReader Reader(Bytes);
+			Reader << Loaded;
+
+			CHECK(!Reader.IsError());
+			CHECK(Loaded.RandHelper(MAX_uint64) == Streams[2].RandHelper(MAX_uint64));
+
+			Loaded.Reset();
+			CHECK(Loaded.RandHelper(MAX_uint64) == Firsts[2]);
+		}
+	}
+
+	SECTION("Closed Form Geometry")
+	{
+		FApologueRandomStream Stream;
+		Stream.Initialize(Seed);
+
+		// A fixed number of words per sample, so later draws don't depend on earlier geometry
+		FApologueRandomStream Skipped;
+		Skipped.Initialize(Seed);
+
+		Stream.GetUnitVector();
+		Stream.GetPointInUnitCircle();
+		Stream.GetPointInUnitSphere();
+		Stream.GetCone(FVector::UpVector, UE_DOUBLE_HALF_PI);
+		for (int32 i = 0; i < 2 + 2 + 3 + 2; i++)
+		{
+			Skipped.RandHelper(MAX_uint64);
+		}
+
+		CHECK(Stream.RandHelper(MAX_uint64) == Skipped.RandHelper(MAX_uint64));
+
+		bool bInRange = true;
+		for (int32 i = 0; i < 1000; i++)
+		{
+			bInRange &= FMath::IsNearlyEqual(Stream.GetUnitVector().Size(), 1.0);
+			bInRange &= Stream.GetPointInUnitCircle().Size() <= 1.0;
+			bInRange &= Stream.GetPointInUnitSphere().Size() <= 1.0;
+		}
+
+		CHECK(bInRange);
+	}
+
+	SECTION("Cones")
+	{
+		FApologueRandomStream Stream;
+		Stream.Initialize(Seed);
+
+		for (const FVector& Dir : {FVector(1.0, 2.0, 3.0), FVector::UpVector, FVector::DownVector})
+		{
+			const double HalfAngle = FMath::DegreesToRadians(20.0);
+			const double VerticalHalfAngle = FMath::DegreesToRadians(5.0);
+			const FVector Forward = Dir.GetSafeNormal();
+
+			bool bInCone = true;
+			for (int32 i = 0; i < 1000; i++)
+			{
+				const FVector Vector = Stream.GetCone(Dir, HalfAngle);
+				bInCone &= FMath::IsNearlyEqual(Vector.Size(), 1.0);
+				bInCone &= (Vector | Forward) >= FMath::Cos(HalfAngle) - UE_KINDA_SMALL_NUMBER;
+
+				const FVector Elliptical = Stream.GetCone(Dir, HalfAngle, VerticalHalfAngle);
+				bInCone &= (Elliptical | Forward) >= FMath::Cos(HalfAngle) - UE_KINDA_SMALL_NUMBER;
+			}
+
+			CHECK(bInCone);
+		}
+
+		CHECK(Stream.GetCone(FVector::ZeroVector, 1.0).IsZero());
+		CHECK(Stream.GetCone(FVector(2.0, 0.0, 0.0), 0.0) == FVector::ForwardVector);
+	}
+
+	SECTION("Batched Geometry")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream ScalarStream(EngineType);
+			ScalarStream.Initialize(Seed);
+			FApologueRandomStream BulkStream(EngineType);
+			BulkStream.Initialize(Seed);
+
+			// Crosses a chunk boundary of the Fill functions
+			constexpr int32 Num = 300;
+			const FVector Dir(0.0, 1.0, 1.0);
+			const double HalfAngle = 0.3;
+
+			TArray<FVector> Vectors;
+			Vectors.SetNumUninitialized(Num);
+			TArray<FVector2D> Points;
+			Points.SetNumUninitialized(Num);
+
+			bool bMatches = true;
+
+			BulkStream.FillUnitVectors(Vectors);
+			for (const FVector& Vector : Vectors)
+			{
+				bMatches &= ScalarStream.GetUnitVector() == Vector;
+			}
+
+			BulkStream.FillPointsInUnitCircle(Points);
+			for (const FVector2D& Point : Points)
+			{
+				bMatches &= ScalarStream.GetPointInUnitCircle() == Point;
+			}
+
+			BulkStream.FillPointsInUnitSphere(Vectors);
+			for (const FVector& Vector : Vectors)
+			{
+				bMatches &= ScalarStream.GetPointInUnitSphere() == Vector;
+			}
+
+			BulkStream.FillCone(Vectors, Dir, HalfAngle);
+			for (const FVector& Vector : Vectors)
+			{
+				bMatches &= ScalarStream.GetCone(Dir, HalfAngle) == Vector;
+			}
+
+			BulkStream.FillCone(Vectors, Dir, HalfAngle, HalfAngle * 0.5);
+			for (const FVector& Vector : Vectors)
+			{
+				bMatches &= ScalarStream.GetCone(Dir, HalfAngle, HalfAngle * 0.5) == Vector;
+			}
+
+			CHECK(bMatches);
+			CHECK(ScalarStream.RandHelper(MAX_uint64) == BulkStream.RandHelper(MAX_uint64));
+		}
+	}
+
+	SECTION("Shuffle")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream Stream(EngineType);
+			Stream.Initialize(Seed);
+
+			// Every element lands in every position about equally often, through all the batch sizes of the shuffle
+			constexpr int32 Num = 8;
+			constexpr int32 Trials = 40000;
+			int32 Counts[Num][Num] = {};
+			for (int32 Trial = 0; Trial < Trials; Trial++)
+			{
+				TArray<int32> List = {0, 1, 2, 3, 4, 5, 6, 7};
+				Stream.Shuffle(List);
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					Counts[Index][List[Index]]++;
+				}
+			}
+
+			bool bIsUniform = true;
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				for (int32 Element = 0; Element < Num; Element++)
+				{
+					bIsUniform &= FMath::Abs(Counts[Index][Element] - Trials / Num) < Trials / Num / 10;
+				}
+			}
+
+			CHECK(bIsUniform);
+
+			TArray<int32> Large;
+			for (int32 Index = 0; Index < 100000; Index++)
+			{
+				Large.Add(Index);
+			}
+
+			Stream.Shuffle(Large);
+			Large.Sort();
+
+			bool bIsPermutation = true;
+			for (int32 Index = 0; Index < Large.Num(); Index++)
+			{
+				bIsPermutation &= Large[Index] == Index;
+			}
+
+			CHECK(bIsPermutation);
+		}
+	}
+
+	SECTION("Partial Shuffle")
+	{
+		FApologueRandomStream Stream;
+		Stream.Initialize(Seed);
+
+		TArray<int32> List;
+		for (int32 Index = 0; Index < 1000; Index++)
+		{
+			List.Add(Index);
+		}
+
+		Stream.PartialShuffle(List, 10);
+		List.Sort();
+
+		bool bIsPermutation = true;
+		for (int32 Index = 0; Index < List.Num(); Index++)
+		{
+			bIsPermutation &= List[Index] == Index;
+		}
+
+		CHECK(bIsPermutation);
+
+		// Every element is sampled about equally often
+		constexpr int32 Trials = 50000;
+		int32 Counts[10] = {};
+		for (int32 Trial = 0; Trial < Trials; Trial++)
+		{
+			TArray<int32> Small = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+			Stream.PartialShuffle(Small, 3);
+			for (int32 Index = 0; Index < 3; Index++)
+			{
+				Counts[Small[Index]]++;
+			}
+		}
+
+		for (const int32 Count : Counts)
+		{
+			CHECK(FMath::Abs(Count - Trials * 3 / 10) < Trials * 3 / 100);
+		}
+	}
+
+	SECTION("Sample Indices")
+	{
+		FApologueRandomStream Stream;
+		Stream.Initialize(Seed);
+
+		TArray<int32> Indices;
+		Stream.SampleIndices(MAX_int32, 100, Indices);
+		REQUIRE(Indices.Num() == 100);
+		CHECK(TSet<int32>(Indices).Num() == 100);
+
+		Stream.SampleIndices(5, 5, Indices);
+		Indices.Sort();
+		CHECK(Indices == TArray<int32>({0, 1, 2, 3, 4}));
+
+		Stream.SampleIndices(5, 0, Indices);
+		CHECK(Indices.IsEmpty());
+
+		// Both the set and its order are uniform
+		constexpr int32 Trials = 60000;
+		int32 FirstCounts[6] = {};
+		for (int32 Trial = 0; Trial < Trials; Trial++)
+		{
+			Stream.SampleIndices(6, 2, Indices);
+			FirstCounts[Indices[0]]++;
+		}
+
+		for (const int32 Count : FirstCounts)
+		{
+			CHECK(FMath::Abs(Count - Trials / 6) < Trials / 60);
+		}
+	}
+
+	SECTION("Reservoir")
+	{
+		FApologueRandomStream Stream;
+		Stream.Initialize(Seed);
+
+		TApologueReservoir<int32> Short(10);
+		for (int32 Element = 0; Element < 4; Element++)
+		{
+			CHECK(Short.Add(Stream, Element));
+		}
+
+		CHECK(Short.GetSamples().Num() == 4);
+
+		// Every element of the sequence is kept about equally often
+		constexpr int32 Num = 20;
+		constexpr int32 Trials = 30000;
+		int32 Counts[Num] = {};
+		TApologueReservoir<int32> Reservoir(4);
+		for (int32 Trial = 0; Trial < Trials; Trial++)
+		{
+			Reservoir.Reset();
+			for (int32 Element = 0; Element < Num; Element++)
+			{
+				Reservoir.Add(Stream, Element);
+			}
+
+			for (const int32 Sample : Reservoir.GetSamples())
+			{
+				Counts[Sample]++;
+			}
+		}
+
+		for (const int32 Count : Counts)
+		{
+			CHECK(FMath::Abs(Count - Trials * 4 / Num) < Trials * 4 / Num / 10);
+		}
+
+		// Skipping ahead rejects the same elements Add() would
+		Reservoir.Reset();
+		int64 Taken = 0;
+		for (int32 Element = 0; Element < 100000; Element++)
+		{
+			if (Reservoir.GetNumToSkip() > 0)
+			{
+				const int64 Skipped = FMath::Min<int64>(Reservoir.GetNumToSkip(), 100000 - Element);
+				Reservoir.Skip(Skipped);
+				Element += static_cast<int32>(Skipped) - 1;
+				continue;
+			}
+
+			Taken += Reservoir.Add(Stream, Element) ? 1 : 0;
+		}
+
+		CHECK(Reservoir.GetNumSeen() == 100000);
+		CHECK(Taken < 200);
+	}
+
+	SECTION("Distributions")
+	{
+		FApologueRandomStream Stream;
+		Stream.Initialize(Seed);
+
+		// Sample mean and variance against the distribution's
+		auto CheckMoments = [](auto&& Draw, const double Mean, const double Variance)
+		{
+			constexpr int32 Samples = 200000;
+			double Sum = 0.0;
+			double SumOfSquares = 0.0;
+			for (int32 i = 0; i < Samples; i++)
+			{
+				const double Value = Draw();
+				Sum += Value;
+				SumOfSquares += Value * Value;
+			}
+
+			const double SampleMean = Sum / Samples;
+			const double SampleVariance = SumOfSquares / Samples - SampleMean * SampleMean;
+			CHECK(FMath::Abs(SampleMean - Mean) < 5.0 * FMath::Sqrt(Variance / Samples) + 1e-9);
+			CHECK(FMath::Abs(SampleVariance / FMath::Max(Variance, 1e-9) - 1.0) < 0.03);
+		};
+
+		CheckMoments([&Stream] { return Stream.GetNormal(); }, 0.0, 1.0);
+		CheckMoments([&Stream] { return Stream.GetNormal(10.0, 3.0); }, 10.0, 9.0);
+		CheckMoments([&Stream] { return Stream.GetExponential(2.0); }, 0.5, 0.25);
+
+		// Both sides of each algorithm switch
+		for (const double Mean : {0.5, 9.5, 10.0, 250.0})
+		{
+			CheckMoments([&Stream, Mean] { return static_cast<double>(Stream.GetPoisson(Mean)); }, Mean, Mean);
+		}
+
+		for (const double Probability : {0.1, 0.4, 0.9})
+		{
+			for (const int32 Trials : {20, 1000})
+			{
+				CheckMoments([&Stream, Trials, Probability] { return static_cast<double>(Stream.GetBinomial(Trials, Probability)); },
+				             Trials * Probability, Trials * Probability * (1.0 - Probability));
+			}
+		}
+
+		CHECK(Stream.GetPoisson(0.0) == 0);
+		CHECK(Stream.GetBinomial(0, 0.5) == 0);
+		CHECK(Stream.GetBinomial(7, 0.0) == 0);
+		CHECK(Stream.GetBinomial(7, 1.0) == 7);
+	}
+
+	SECTION("Batched Distributions")
+	{
+		for (const EApologueRandomEngine EngineType : EngineTypes)
+		{
+			FApologueRandomStream ScalarStream(EngineType);
+			ScalarStream.Initialize(Seed);
+
+			FApologueRandomStream BulkStream(EngineType);
+			BulkStream.Initialize(Seed);
+
+			TArray<double> Normals;
+			Normals.SetNumUninitialized(1000);
+			BulkStream.FillNormal(MakeArrayView(Normals), 1.0, 2.0);
+
+			TArray<float> Exponentials;
+			Exponentials.SetNumUninitialized(1000);
+			BulkStream.FillExponential(MakeArrayView(Exponentials), 3.0);
+
+			TArray<int64> Poissons;
+			Poissons.SetNumUninitialized(1000);
+			BulkStream.FillPoisson(MakeArrayView(Poissons), 42.0);
+
+			TArray<int32> Binomials;
+			Binomials.SetNumUninitialized(1000);
+			BulkStream.FillBinomial(MakeArrayView(Binomials), 500, 0.3);
+
+			bool bMatches = true;
+			for (const double Normal : Normals)
+			{
+				bMatches &= ScalarStream.GetNormal(1.0, 2.0) == Normal;
+			}
+
+			for (const float Exponential : Exponentials)
+			{
+				bMatches &= static_cast<float>(ScalarStream.GetExponential(3.0)) == Exponential;
+			}
+
+			for (const int64 Poisson : Poissons)
+			{
+				bMatches &= ScalarStream.GetPoisson(42.0) == Poisson;
+			}
+
+			for (const int32 Binomial : Binomials)
+			{
+				bMatches &= ScalarStream.GetBinomial(500, 0.3) == Binomial;
+			}
+
+			CHECK(bMatches);
+			CHECK(ScalarStream.RandHelper(MAX_uint64) == BulkStream.RandHelper(MAX_uint64));
+		}
+	}
+
+	SECTION("Footprint")
+	{
+		CHECK(sizeof(FApologueRandomStream) <= 64);
+	}
+}
+
+#endif
@@ -0,0 +1,65 @@
+﻿#if WITH_TESTS
+
+#include "Random/ApologueRandomSubsystem.h"
+
+#include "UObject/StrongObjectPtr.h"
+#include "Tests/TestHarnessAdapter.h"
+
+TEST_CASE_NAMED(FApologueRandomSubsystemTest, "ApologueCore::RandomSubsystem", "[Apologue][ApologueCore][RandomSubsystem]")
+{
+	constexpr uint64 Seed = 0xDEADBEEF;
+
+	const TStrongObjectPtr<UApologueRandomSubsystem> Subsystem(NewObject<UApologueRandomSubsystem>(GetTransientPackage()));
+	Subsystem->SetWorldSeed(Seed);
+
+	const uint64 LootKey = UApologueRandomSubsystem::MakeTaskKey(TEXT("Loot"));
+	const uint64 TerrainKey = UApologueRandomSubsystem::MakeTaskKey(TEXT("Terrain"));
+
+	SECTION("Task Keys")
+	{
+		CHECK(LootKey == UApologueRandomSubsystem::MakeTaskKey(FString(TEXT("Loot"))));
+		CHECK(LootKey != TerrainKey);
+
+		// Streams depend on the world seed, the task and the item
+		const uint64 Word = Subsystem->GetStream(LootKey, 3).RandHelper(MAX_uint64);
+		CHECK(Word == Subsystem->GetStream(LootKey, 3).RandHelper(MAX_uint64));
+		CHECK(Word != Subsystem->GetStream(LootKey, 4).RandHelper(MAX_uint64));
+		CHECK(Word != Subsystem->GetStream(TerrainKey, 3).RandHelper(MAX_uint64));
+		CHECK(Word == UApologueRandomSubsystem::MakeTaskRandom(Seed, LootKey).At(3, 0).RandHelper(MAX_uint64));
+
+		Subsystem->SetWorldSeed(Seed + 1);
+		CHECK(Word != Subsystem->GetStream(LootKey, 3).RandHelper(MAX_uint64));
+	}
+
+	SECTION("Parallel Determinism")
+	{
+		constexpr int32 Num = 10000;
+		auto Generate = [](const int32 Index, const FApologueCounterStream& Stream)
+		{
+			// Uneven work per item, so workers finish out of order
+			uint64 Sum = 0;
+			for (int32 Draw = 0; Draw < 1 + Index % 17; Draw++)
+			{
+				Sum += Stream.RandHelper(MAX_uint64);
+			}
+
+			return Sum;
+		};
+
+		TArray<uint64> Serial;
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Serial.Add(Generate(Index, Subsystem->GetStream(LootKey, Index)));
+		}
+
+		TArray<uint64> Parallel;
+		Subsystem->ParallelGenerate(LootKey, Num, Parallel, Generate);
+		CHECK(Parallel == Serial);
+
+		TArray<uint64> SingleThreaded;
+		Subsystem->ParallelGenerate(LootKey, Num, SingleThreaded, Generate, EParallelForFlags::ForceSingleThread);
+		CHECK(SingleThreaded == Serial);
+	}
+}
+
+#endif
@@ -0,0 +1,158 @@
+﻿#if WITH_TESTS
+
+#include "ApologueBenchmark.h"
+#include "ApologueCoreTestTypes.h"
+#include "Stat/ApologueStat.h"
+#include "Stat/ApologueStatTable.h"
+
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/TestHarnessAdapter.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace ApologueStatBenchmark
+{
+	// Content/Stat/ExampleStatFunc_Health
+	const TCHAR* BlueprintStatFunctionPath = TEXT("/ApologueCore/Stat/ExampleStatFunc_Health.ExampleStatFunc_Health_C");
+
+	void SetStatFunction(UApologueStat* Stat, UApologueStatFunction* Function)
+	{
+		const FObjectProperty* Property = FindFProperty<FObjectProperty>(UApologueStat::StaticClass(), TEXT("Function"));
+		check(Property);
+		Property->SetObjectPropertyValue_InContainer(Stat, Function);
+	}
+
+	TStrongObjectPtr<UApologueStat> MakeStat(UApologueStatFunction* Function)
+	{
+		TStrongObjectPtr<UApologueStat> Stat(NewObject<UApologueStat>(GetTransientPackage()));
+		SetStatFunction(Stat.Get(), Function);
+		return Stat;
+	}
+
+	int64 GetIterations(const int32 TableSize)
+	{
+		return FMath::Max<int64>(1000, 1000000 / TableSize);
+	}
+}
+
+TEST_CASE_NAMED(FApologueStatBenchmark, "ApologueCore::Benchmark::Stat", "[Apologue][ApologueCore][Benchmark]")
+{
+	using namespace ApologueStatBenchmark;
+
+	FApologueBenchmarkSuite Suite(TEXT("ApologueStat"));
+
+	const TStrongObjectPtr<UApologueTestStatFunction> NativeFunction(NewObject<UApologueTestStatFunction>(GetTransientPackage()));
+
+	for (const int32 TableSize : {4, 16, 64, 256})
+	{
+		TArray<TStrongObjectPtr<UApologueStat>> Stats;
+		TArray<FApologueStatTableEntry> Data;
+		for (int32 Index = 0; Index < TableSize; ++Index)
+		{
+			Stats.Add(MakeStat(NativeFunction.Get()));
+			Data.Add(FApologueStatTableEntry(Stats.Last().Get(), Index));
+		}
+
+		FApologueStatTable Table = UApologueStatTableFunctionLibrary::Make(Data);
+		REQUIRE(Table.Num() == TableSize);
+
+		const int64 Iterations = GetIterations(TableSize);
+		const FString Suffix = FString::Printf(TEXT("/%d"), TableSize);
+
+		int32 Cursor = 0;
+		Suite.Run(TEXT("StatTable.TryGet") + Suffix, Iterations, [&]
+		{
+			int32 Value;
+			Table.TryGet(Data[Cursor].Stat, Value);
+			Cursor = (Cursor + 1) % TableSize;
+			ApologueBenchmarkKeep(Value);
+		});
+
+		Suite.Run(TEXT("StatTable.TrySet") + Suffix, Iterations, [&]
+		{
+			Table.TrySet(Data[Cursor].Stat, Cursor);
+			Cursor = (Cursor + 1) % TableSize;
+		});
+
+		Suite.Run(TEXT("StatTable.GetTotal") + Suffix, Iterations, [&]
+		{
+			ApologueBenchmarkKeep(Table.GetTotal());
+		});
+
+		Suite.Run(TEXT("StatTable.GetAverage") + Suffix, Iterations, [&]
+		{
+			ApologueBenchmarkKeep(Table.GetAverage());
+		});
+
+		Suite.Run(TEXT("StatTable.GetMaxValue") + Suffix, Iterations, [&]
+		{
+			ApologueBenchmarkKeep(Table.GetMaxValue());
+		});
+
+		TArray<TSoftObjectPtr<UApologueStat>> MaxStats;
+		Suite.Run(TEXT("StatTable.GetMaxStats") + Suffix, Iterations, [&]
+		{
+			ApologueBenchmarkKeep(Table.GetMaxStats(MaxStats));
+		});
+
+		Suite.Run(TEXT("StatTable.CaptureSnapshot") + Suffix, Iterations, [&]
+		{
+			ApologueBenchmarkKeep(Table.CaptureSnapshot());
+		});
+
+		TArray<uint8> Bytes;
+		Suite.Run(TEXT("StatTable.SerializeRoundTrip") + Suffix, Iterations / 10, [&]
+		{
+			Bytes.Reset();
+			FMemoryWriter Writer(Bytes);
+			Writer << Table;
+
+			FApologueStatTable ReadTable;
+			FMemoryReader Reader(Bytes);
+			Reader << ReadTable;
+			ApologueBenchmarkKeep(ReadTable.Num());
+		}).Metrics.Add(TEXT("bytes"), Bytes.Num());
+
+		Suite.Run(TEXT("StatTable.Make") + Suffix, Iterations / 10, [&]
+		{
+			ApologueBenchmarkKeep(UApologueStatTableFunctionLibrary::Make(Data).Num());
+		});
+
+		TArray<FApologueStatTableEntry> BrokenData;
+		Suite.Run(TEXT("StatTable.Break") + Suffix, Iterations / 10, [&]
+		{
+			UApologueStatTableFunctionLibrary::Break(Table, BrokenData);
+			ApologueBenchmarkKeep(BrokenData.Num());
+		});
+
+		CHECK(Table.Validate());
+	}
+
+	const TStrongObjectPtr<UApologueStat> NativeStat = MakeStat(NativeFunction.Get());
+	CHECK(NativeStat->GetValue(10, nullptr) == 10 * NativeFunction->Multiplier + NativeFunction->Offset);
+
+	int32 BaseValue = 0;
+	Suite.Run(TEXT("Stat.GetValue.Native"), 1000000, [&]
+	{
+		ApologueBenchmarkKeep(NativeStat->GetValue(++BaseValue, nullptr));
+	});
+
+	if (UClass* BlueprintFunctionClass = LoadClass<UApologueStatFunction>(nullptr, BlueprintStatFunctionPath))
+	{
+		const TStrongObjectPtr<UApologueStatFunction> BlueprintFunction(NewObject<UApologueStatFunction>(GetTransientPackage(), BlueprintFunctionClass));
+		const TStrongObjectPtr<UApologueStat> BlueprintStat = MakeStat(BlueprintFunction.Get());
+
+		Suite.Run(TEXT("Stat.GetValue.Blueprint"), 100000, [&]
+		{
+			ApologueBenchmarkKeep(BlueprintStat->GetValue(++BaseValue, nullptr));
+		});
+	}
+	else
+	{
+		Suite.Skip(TEXT("Stat.GetValue.Blueprint"), FString::Printf(TEXT("%s not found"), BlueprintStatFunctionPath));
+	}
+
+	CHECK(Suite.WriteJson());
+}
+
+#endif
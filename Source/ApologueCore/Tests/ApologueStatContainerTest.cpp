@@ -0,0 +1,140 @@
+﻿#if WITH_TESTS
+
+#include "ApologueCoreTestTypes.h"
+#include "Event/ApologueEvent.h"
+#include "Stat/ApologueStat.h"
+#include "Stat/ApologueStatContainer.h"
+
+#include "Tests/TestHarnessAdapter.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace ApologueStatContainerTest
+{
+	TSoftObjectPtr<UApologueStat> MakeStat(const TCHAR* Name)
+	{
+		return TSoftObjectPtr<UApologueStat>(FSoftObjectPath(FString::Printf(TEXT("/Game/Stat/%s.%s"), Name, Name)));
+	}
+
+	void SetChangedEvent(UApologueStatContainer* Container, const TSoftObjectPtr<UApologueEvent>& Event)
+	{
+		const FSoftObjectProperty* Property = FindFProperty<FSoftObjectProperty>(UApologueStatContainer::StaticClass(), TEXT("ChangedEvent"));
+		check(Property);
+		*Property->ContainerPtrToValuePtr<TSoftObjectPtr<UApologueEvent>>(Container) = Event;
+	}
+
+	// Replaces the table the way loading or the details panel do, bypassing Initialize
+	void SetTableProperty(UApologueStatContainer* Container, const FApologueStatTable& Table)
+	{
+		const FStructProperty* Property = FindFProperty<FStructProperty>(UApologueStatContainer::StaticClass(), TEXT("Table"));
+		check(Property);
+		*Property->ContainerPtrToValuePtr<FApologueStatTable>(Container) = Table;
+	}
+}
+
+TEST_CASE_NAMED(FApologueStatContainerTest, "ApologueCore::Stat::Container", "[Apologue][ApologueCore][Stat]")
+{
+	using namespace ApologueStatContainerTest;
+
+	const TSoftObjectPtr<UApologueStat> Strength = MakeStat(TEXT("Strength"));
+	const TSoftObjectPtr<UApologueStat> Agility = MakeStat(TEXT("Agility"));
+	const TSoftObjectPtr<UApologueStat> Magic = MakeStat(TEXT("Magic"));
+
+	// Outered to an object in no world, so nothing is flushed until the test asks for it
+	const TStrongObjectPtr<UApologueTestStatChangeRecorder> Recorder(NewObject<UApologueTestStatChangeRecorder>(GetTransientPackage()));
+	UApologueStatContainer* Container = NewObject<UApologueStatContainer>(Recorder.Get());
+	Container->Initialize(FApologueStatTable({Strength, Agility, Magic}, 10));
+	Container->OnStatsChanged.AddDynamic(Recorder.Get(), &UApologueTestStatChangeRecorder::OnStatsChanged);
+
+	SECTION("Order")
+	{
+		Container->TrySet(Magic, 12);
+		Container->TrySet(Strength, 11);
+		Container->TryAdd(Strength, 4);
+
+		// Set back to its value at the last flush, so not reported
+		Container->TrySet(Agility, 20);
+		Container->TrySet(Agility, 10);
+
+		Container->FlushChanges();
+
+		// Changes come in table order, each with its value at the last flush
+		const TArray<FApologueStatChange>& Changes = Recorder->LastChanges;
+		REQUIRE(Changes.Num() == 2);
+		CHECK(Changes[0].Stat == Strength);
+		CHECK(Changes[0].OldValue == 10);
+		CHECK(Changes[0].NewValue == 15);
+		CHECK(Changes[1].Stat == Magic);
+		CHECK(Changes[1].OldValue == 10);
+		CHECK(Changes[1].NewValue == 12);
+
+		// Nothing pending, nothing delivered
+		Container->FlushChanges();
+		CHECK(Recorder->Calls.Num() == 1);
+	}
+
+	SECTION("Event")
+	{
+		const TStrongObjectPtr<UApologueEvent> Event(NewObject<UApologueEvent>(GetTransientPackage()));
+		SetChangedEvent(Container, Event.Get());
+
+		Container->TrySet(Strength, 11);
+		Container->FlushChanges();
+
+		// The event goes out through the outer before the delegate fires
+		CHECK(Recorder->Calls == TArray<FString>({TEXT("Event"), TEXT("Delegate")}));
+	}
+
+	SECTION("No World")
+	{
+		CHECK(Container->GetWorld() == nullptr);
+
+		Container->TrySet(Strength, 11);
+		Container->TrySet(Agility, 12);
+
+		// Kept rather than dropped
+		CHECK(Container->HasPendingChanges());
+		CHECK(Recorder->Calls.IsEmpty());
+
+		TArray<FApologueStatChange> Changes;
+		Container->ConsumeChanges(Changes);
+		CHECK(Changes.Num() == 2);
+		CHECK_FALSE(Container->HasPendingChanges());
+		CHECK(Recorder->Calls.IsEmpty());
+	}
+
+	SECTION("Set Back")
+	{
+		Container->TrySet(Strength, 11);
+		Container->TrySet(Strength, 10);
+		CHECK_FALSE(Container->HasPendingChanges());
+
+		TArray<FApologueStatChange> Changes;
+		Container->ConsumeChanges(Changes);
+		CHECK(Changes.IsEmpty());
+	}
+
+	SECTION("Resized")
+	{
+		Container->TrySet(Strength, 11);
+
+		const TSoftObjectPtr<UApologueStat> Luck = MakeStat(TEXT("Luck"));
+		SetTableProperty(Container, FApologueStatTable({Strength, Agility, Magic, Luck}, 11));
+
+		// The write made before the table grew is still reported
+		CHECK(Container->HasPendingChanges());
+
+		TArray<FApologueStatChange> Changes;
+		Container->ConsumeChanges(Changes);
+		REQUIRE(Changes.Num() == 1);
+		CHECK(Changes[0].Stat == Strength);
+		CHECK(Changes[0].OldValue == 10);
+		CHECK(Changes[0].NewValue == 11);
+
+		Container->TrySet(Luck, 12);
+		Container->ConsumeChanges(Changes);
+		REQUIRE(Changes.Num() == 1);
+		CHECK(Changes[0].Stat == Luck);
+	}
+}
+
+#endif
@@ -0,0 +1,147 @@
+﻿#if WITH_TESTS
+
+#include "Stat/ApologueStat.h"
+#include "Stat/ApologueStatTable.h"
+#include "Stat/ApologueStatTableHistory.h"
+
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/TestHarnessAdapter.h"
+
+namespace ApologueStatTableTest
+{
+	TSoftObjectPtr<UApologueStat> MakeStat(const TCHAR* Name)
+	{
+		return TSoftObjectPtr<UApologueStat>(FSoftObjectPath(FString::Printf(TEXT("/Game/Stat/%s.%s"), Name, Name)));
+	}
+
+	int32 GetValue(const FApologueStatTableSnapshot& Snapshot, const TSoftObjectPtr<UApologueStat>& Stat)
+	{
+		int32 Value;
+		return Snapshot.TryGet(Stat, Value) ? Value : INDEX_NONE;
+	}
+}
+
+TEST_CASE_NAMED(FApologueStatTableTest, "ApologueCore::Stat::Table", "[Apologue][ApologueCore][Stat]")
+{
+	using namespace ApologueStatTableTest;
+
+	const TSoftObjectPtr<UApologueStat> Strength = MakeStat(TEXT("Strength"));
+	const TSoftObjectPtr<UApologueStat> Agility = MakeStat(TEXT("Agility"));
+
+	FApologueStatTable Table({Strength, Agility}, 10);
+
+	SECTION("Snapshot")
+	{
+		const FApologueStatTableSnapshot First = Table.CaptureSnapshot();
+		const FApologueStatTableSnapshot Unchanged = Table.CaptureSnapshot();
+		CHECK(Unchanged.SharesBufferWith(First));
+
+		Table.TrySet(Strength, 15);
+		const FApologueStatTableSnapshot Changed = Table.CaptureSnapshot();
+		CHECK_FALSE(Changed.SharesBufferWith(First));
+		CHECK(GetValue(First, Strength) == 10);
+		CHECK(GetValue(Changed, Strength) == 15);
+
+		// Writing the same value is not a change
+		Table.TrySet(Strength, 15);
+		CHECK(Table.CaptureSnapshot().SharesBufferWith(Changed));
+	}
+
+	SECTION("Restore")
+	{
+		const FApologueStatTableSnapshot Snapshot = Table.CaptureSnapshot();
+
+		Table.TrySet(Strength, 15);
+		Table.Get(Agility) = 20;
+		Table.RestoreSnapshot(Snapshot);
+
+		int32 Value;
+		CHECK((Table.TryGet(Strength, Value) && Value == 10));
+		CHECK((Table.TryGet(Agility, Value) && Value == 10));
+		CHECK(Table.CaptureSnapshot().SharesBufferWith(Snapshot));
+	}
+
+	SECTION("Restore then write")
+	{
+		const FApologueStatTableSnapshot Snapshot = Table.CaptureSnapshot();
+
+		Table.TrySet(Strength, 15);
+		Table.RestoreSnapshot(Snapshot);
+
+		// The table shares the snapshot's buffer again, so this write must not show through the snapshot
+		Table.TrySet(Strength, 30);
+		CHECK(GetValue(Snapshot, Strength) == 10);
+		CHECK(GetValue(Table.CaptureSnapshot(), Strength) == 30);
+	}
+
+	SECTION("Copy")
+	{
+		FApologueStatTable Copy = Table;
+		CHECK(Copy.CaptureSnapshot().SharesBufferWith(Table.CaptureSnapshot()));
+
+		Copy.TrySet(Strength, 30);
+
+		int32 Value;
+		CHECK((Table.TryGet(Strength, Value) && Value == 10));
+		CHECK((Copy.TryGet(Strength, Value) && Value == 30));
+		CHECK_FALSE(FApologueStatTable::StaticStruct()->CompareScriptStruct(&Copy, &Table, 0));
+
+		Copy.TrySet(Strength, 10);
+		CHECK(FApologueStatTable::StaticStruct()->CompareScriptStruct(&Copy, &Table, 0));
+	}
+
+	SECTION("Text")
+	{
+		FString Text;
+		FApologueStatTable::StaticStruct()->ExportText(Text, &Table, nullptr, nullptr, PPF_None, nullptr);
+
+		FApologueStatTable Imported;
+		FApologueStatTable::StaticStruct()->ImportText(*Text, &Imported, nullptr, PPF_None, GWarn, FApologueStatTable::StaticStruct()->GetName());
+
+		int32 Value;
+		CHECK((Imported.TryGet(Agility, Value) && Value == 10));
+		CHECK(Imported.Num() == 2);
+	}
+
+	SECTION("Load")
+	{
+		FApologueStatTable Saved({Strength, Agility}, 50);
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		FApologueStatTable::StaticStruct()->SerializeItem(Writer, &Saved, nullptr);
+
+		const FApologueStatTableSnapshot BeforeLoad = Table.CaptureSnapshot();
+
+		FMemoryReader Reader(Bytes);
+		FApologueStatTable::StaticStruct()->SerializeItem(Reader, &Table, nullptr);
+
+		const FApologueStatTableSnapshot AfterLoad = Table.CaptureSnapshot();
+		CHECK_FALSE(AfterLoad.SharesBufferWith(BeforeLoad));
+		CHECK(GetValue(AfterLoad, Strength) == 50);
+		CHECK(GetValue(BeforeLoad, Strength) == 10);
+	}
+
+	SECTION("History")
+	{
+		FApologueStatTableHistory History(4);
+		for (int64 Tick = 0; Tick < 6; ++Tick)
+		{
+			Table.TrySet(Strength, static_cast<int32>(Tick));
+			History.Capture(Tick, Table);
+		}
+
+		CHECK(History.GetNewestTick() == 5);
+		CHECK(History.GetOldestTick() == 2);
+		CHECK(History.Find(1) == nullptr);
+
+		CHECK(History.Restore(3, Table));
+
+		int32 Value;
+		CHECK((Table.TryGet(Strength, Value) && Value == 3));
+		CHECK_FALSE(History.Restore(0, Table));
+	}
+}
+
+#endif
@@ -3,6 +3,11 @@
 #include "Random/MersenneTwister.h"
 
 #include "Containers/UnrealString.h"
+#include "Engine/NetSerialization.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "Tests/TestHarnessAdapter.h"
 
 TEST_CASE_NAMED(FMersenneTwisterTest, "ApologueCore::MersenneTwister", "[Apologue][ApologueCore][MersenneTwister]")
@@ -86,6 +91,399 @@ TEST_CASE_NAMED(FMersenneTwisterTest, "ApologueCore::MersenneTwister", "[Apologu
 		
 		CHECK(TwisterB.RandHelper(Rand) == TwisterC.RandHelper(Rand));
 	}
+
+	SECTION("Matches Standard Library")
+	{
+		for (const uint64 Seed : {FMersenneTwisterEngine::DefaultSeed, 0ull, 0xDEADBEEFull, MAX_uint64})
+		{
+			std::mt19937_64 StandardEngine(Seed);
+			FMersenneTwisterEngine Engine(Seed);
+
+			bool bMatches = true;
+			for (int32 i = 0; i < 10000 && bMatches; i++)
+			{
+				bMatches = StandardEngine() == Engine.Next();
+			}
+
+			CHECK(bMatches);
+		}
+	}
+
+	SECTION("Compact and Full State Serialization")
+	{
+		constexpr uint64 Seed = 0xDEADBEEF;
+
+		for (const uint64 DrawCount : {0ull, 17ull, FMersenneTwister::MaxCompactDrawCount, FMersenneTwister::MaxCompactDrawCount + 1})
+		{
+			FMersenneTwister TwisterA;
+			TwisterA.Initialize(Seed);
+
+			for (uint64 i = 0; i < DrawCount; i++)
+			{
+				TwisterA.RandHelper(2);
+			}
+
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			Writer << TwisterA;
+
+			FMersenneTwister TwisterB;
+			FMemoryReader Reader(Bytes);
+			Reader << TwisterB;
+
+			CHECK(!Reader.IsError());
+			CHECK(TwisterB.IsInitialized());
+			CHECK(TwisterB.GetDrawCount() == TwisterA.GetDrawCount());
+			CHECK(TwisterB.RandHelper(MAX_uint64) == TwisterA.RandHelper(MAX_uint64));
+
+			// Compact form is the seed and draw count; the full state is over 2 KB
+			CHECK((Bytes.Num() < 64) == (TwisterA.GetDrawCount() <= FMersenneTwister::MaxCompactDrawCount));
+		}
+	}
+
+	SECTION("Property Serialization")
+	{
+		constexpr uint64 Seed = 0xDEADBEEF;
+
+		// Twister properties go through the native format, so their draws survive a round trip
+		for (const uint64 DrawCount : {17ull, FMersenneTwister::MaxCompactDrawCount + 1})
+		{
+			FMersenneTwister TwisterA;
+			TwisterA.Initialize(Seed);
+			for (uint64 i = 0; i < DrawCount; i++)
+			{
+				TwisterA.RandHelper(2);
+			}
+
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			FMersenneTwister::StaticStruct()->SerializeItem(Writer, &TwisterA, nullptr);
+
+			FMersenneTwister TwisterB;
+			FMemoryReader Reader(Bytes);
+			FMersenneTwister::StaticStruct()->SerializeItem(Reader, &TwisterB, nullptr);
+
+			CHECK(!Reader.IsError());
+			CHECK(TwisterB.GetDrawCount() == TwisterA.GetDrawCount());
+			CHECK(TwisterB.RandHelper(MAX_uint64) == TwisterA.RandHelper(MAX_uint64));
+		}
+	}
+
+	SECTION("Tagged Layout")
+	{
+		constexpr uint64 Seed = 0xDEADBEEF;
+
+		FMersenneTwister Saved;
+		Saved.Initialize(Seed);
+		Saved.RandHelper(MAX_uint64);
+
+		// As saved before the portable format, when only the properties were written
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		FMersenneTwister::StaticStruct()->SerializeTaggedProperties(Writer, reinterpret_cast<uint8*>(&Saved), FMersenneTwister::StaticStruct(), nullptr);
+
+		FMemoryReader Reader(Bytes);
+		Reader.SetCustomVersion(FApologueCoreCustomVersion::GUID, FApologueCoreCustomVersion::BeforeCustomVersionWasAdded, TEXT("ApologueCore"));
+
+		FMersenneTwister Loaded;
+		FMersenneTwister::StaticStruct()->SerializeItem(Reader, &Loaded, nullptr);
+
+		// The engine was not saved, so the stream starts over
+		FMersenneTwister Reference;
+		Reference.Initialize(Seed);
+
+		CHECK(!Reader.IsError());
+		CHECK(Loaded.IsInitialized());
+		CHECK(Loaded.GetInitialSeed() == static_cast<int64>(Seed));
+		CHECK(Loaded.RandHelper(MAX_uint64) == Reference.RandHelper(MAX_uint64));
+	}
+
+	SECTION("MSVC Layout")
+	{
+		constexpr uint64 Seed = 0xDEADBEEF;
+		constexpr int32 StateSize = FMersenneTwisterEngine::StateSize;
+
+		// MSVC buffers 2 * StateSize words; the StateSize before its index generate the next draws. A fresh engine
+		// has its index at StateSize, and one drawn from StateSize + 10 times has it at 10.
+		for (const TPair<uint64, uint32>& Case : {TPair<uint64, uint32>(0, StateSize), TPair<uint64, uint32>(StateSize + 10, 10)})
+		{
+			FMersenneTwisterEngine Engine(Seed);
+			Engine.Discard(Case.Key);
+
+			uint64 Buffer[2 * StateSize] = {};
+			for (int32 I = 0; I < StateSize; ++I)
+			{
+				Buffer[(Case.Value + StateSize + I) % (2 * StateSize)] = Engine.GetState()[(Engine.GetStateIndex() + I) % StateSize];
+			}
+
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			int64 InitialSeed = Seed;
+			uint32 BufferIndex = Case.Value;
+			bool bIsInitialized = true;
+			Writer << InitialSeed;
+			for (uint64& Word : Buffer)
+			{
+				Writer << Word;
+			}
+			Writer << BufferIndex;
+			Writer << bIsInitialized;
+
+			FMemoryReader Reader(Bytes);
+			Reader.SetCustomVersion(FApologueCoreCustomVersion::GUID, FApologueCoreCustomVersion::BeforeCustomVersionWasAdded, TEXT("ApologueCore"));
+
+			FMersenneTwister Loaded;
+			Reader << Loaded;
+
+			CHECK(!Reader.IsError());
+			CHECK(Reader.AtEnd());
+			CHECK(Loaded.IsInitialized());
+
+			// Same words from the oldest on, so the same draws from here on
+			TArray<uint64> LoadedState;
+			Loaded.GetState(LoadedState);
+
+			bool bMatches = LoadedState.Num() == StateSize;
+			for (int32 I = 0; I < StateSize && bMatches; ++I)
+			{
+				bMatches = LoadedState[(Loaded.GetStateIndex() + I) % StateSize] == Engine.GetState()[(Engine.GetStateIndex() + I) % StateSize];
+			}
+
+			CHECK(bMatches);
+		}
+	}
+
+	SECTION("Net Serialization")
+	{
+		constexpr uint64 Seed = 0xDEADBEEF;
+
+		// Round trips through the net format, returning the number of bits sent
+		auto Replicate = [](FMersenneTwister& Source, FMersenneTwister& Target)
+		{
+			FBitWriter Writer(0, true);
+			bool bSuccess = false;
+			Source.NetSerialize(Writer, nullptr, bSuccess);
+			CHECK(bSuccess);
+
+			FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+			Target.NetSerialize(Reader, nullptr, bSuccess);
+			CHECK(bSuccess);
+			CHECK(!Reader.IsError());
+			return Writer.GetNumBits();
+		};
+
+		FMersenneTwister Server;
+		Server.Initialize(Seed);
+		for (int32 i = 0; i < 100; i++)
+		{
+			Server.RandHelper(MAX_uint64);
+		}
+
+		FMersenneTwister Client;
+		CHECK(Replicate(Server, Client) <= 128);
+		CHECK(Client.Identical(&Server, 0));
+		CHECK(Client.RandHelper(MAX_uint64) == Server.RandHelper(MAX_uint64));
+
+		// A client holding the stream fast-forwards from its own draw count
+		for (int32 i = 0; i < 50; i++)
+		{
+			Server.RandHelper(MAX_uint64);
+		}
+
+		CHECK(!Client.Identical(&Server, 0));
+		Replicate(Server, Client);
+		CHECK(Client.GetDrawCount() == Server.GetDrawCount());
+		CHECK(Client.RandHelper(MAX_uint64) == Server.RandHelper(MAX_uint64));
+
+		// Split twisters send their raw state
+		TArray<FMersenneTwister> Streams;
+		Server.Split(1, Streams);
+		Streams[0].RandHelper(MAX_uint64);
+
+		FMersenneTwister SplitClient;
+		CHECK(Replicate(Streams[0], SplitClient) > FMersenneTwisterEngine::StateSize * 64);
+		CHECK(SplitClient.GetStreamIndex() == 1);
+		CHECK(SplitClient.RandHelper(MAX_uint64) == Streams[0].RandHelper(MAX_uint64));
+
+		// Uninitialized twisters replicate as such
+		FMersenneTwister Uninitialized;
+		Replicate(Uninitialized, Client);
+		CHECK(!Client.IsInitialized());
+	}
+
+	SECTION("Net Delta Serialization")
+	{
+		constexpr uint64 Seed = 0xDEADBEEF;
+
+		// Sends Source against Base, returning the number of bits sent, or 0 when there was nothing to send. Base
+		// becomes the sent state when bIsAcknowledged, and the update never arrives otherwise.
+		auto Replicate = [](FMersenneTwister& Source, FMersenneTwister& Target, TSharedPtr<INetDeltaBaseState>& Base, const bool bIsAcknowledged = true)
+		{
+			FBitWriter Writer(0, true);
+			TSharedPtr<INetDeltaBaseState> NewState;
+			FNetDeltaSerializeInfo WriteParms;
+			WriteParms.Writer = &Writer;
+			WriteParms.OldState = Base.Get();
+			WriteParms.NewState = &NewState;
+			if (!Source.NetDeltaSerialize(WriteParms))
+			{
+				return static_cast<int64>(0);
+			}
+
+			if (bIsAcknowledged)
+			{
+				Base = NewState;
+
+				FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+				FNetDeltaSerializeInfo ReadParms;
+				ReadParms.Reader = &Reader;
+				Target.NetDeltaSerialize(ReadParms);
+				CHECK(!Reader.IsError());
+			}
+
+			return Writer.GetNumBits();
+		};
+
+		auto Draw = [](FMersenneTwister& Twister, const uint64 Count)
+		{
+			const uint64 Target = Twister.GetDrawCount() + Count;
+			while (Twister.GetDrawCount() < Target)
+			{
+				Twister.RandHelper(MAX_uint64);
+			}
+		};
+
+		// Far enough along that NetSerialize would send the raw state
+		FMersenneTwister Server;
+		Server.Initialize(Seed);
+		Draw(Server, FMersenneTwister::MaxCompactDrawCount * 2);
+
+		FMersenneTwister Client;
+		TSharedPtr<INetDeltaBaseState> Base;
+		CHECK(Replicate(Server, Client, Base) > FMersenneTwisterEngine::StateSize * 64);
+		CHECK(Client.Identical(&Server, 0));
+
+		// Nothing drawn, nothing sent
+		CHECK(Replicate(Server, Client, Base) == 0);
+
+		// Draws since the acknowledged state, even when an update in between was lost
+		Draw(Server, 5);
+		CHECK(Replicate(Server, Client, Base, false) <= 32);
+		Draw(Server, 5);
+		CHECK(Replicate(Server, Client, Base) <= 32);
+		CHECK(Client.GetDrawCount() == Server.GetDrawCount());
+		CHECK(Client.RandHelper(MAX_uint64) == Server.RandHelper(MAX_uint64));
+		Replicate(Server, Client, Base);
+
+		// Too many draws to replay, and a new seed, send the whole twister
+		Draw(Server, FMersenneTwister::MaxCompactDrawCount + 1);
+		CHECK(Replicate(Server, Client, Base) > FMersenneTwisterEngine::StateSize * 64);
+		CHECK(Client.Identical(&Server, 0));
+
+		Server.Initialize(Seed + 1);
+		CHECK(Replicate(Server, Client, Base) > 64);
+		CHECK(Client.Identical(&Server, 0));
+		CHECK(Client.RandHelper(MAX_uint64) == Server.RandHelper(MAX_uint64));
+
+		// A receiver that is not at the base rejects the delta
+		Draw(Server, 3);
+		FBitWriter Writer(0, true);
+		TSharedPtr<INetDeltaBaseState> NewState;
+		FNetDeltaSerializeInfo WriteParms;
+		WriteParms.Writer = &Writer;
+		WriteParms.OldState = Base.Get();
+		WriteParms.NewState = &NewState;
+		REQUIRE(Server.NetDeltaSerialize(WriteParms));
+
+		FMersenneTwister Stranger;
+		Stranger.Initialize(Seed + 1);
+		Draw(Stranger, 1);
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		FNetDeltaSerializeInfo ReadParms;
+		ReadParms.Reader = &Reader;
+		Stranger.NetDeltaSerialize(ReadParms);
+		CHECK(Reader.IsError());
+	}
+
+	SECTION("Jump")
+	{
+		constexpr uint64 Seed = 0xDEADBEEF;
+
+		// Jumping and drawing commute, since both are powers of the same transition
+		FMersenneTwisterEngine EngineA(Seed);
+		EngineA.Discard(1000);
+		EngineA.Jump();
+
+		FMersenneTwisterEngine EngineB(Seed);
+		EngineB.Jump();
+		EngineB.Discard(1000);
+
+		CHECK(EngineA == EngineB);
+		CHECK(EngineA != FMersenneTwisterEngine(Seed));
+		CHECK(EngineB.GetDrawCount() == 1000);
+
+		// Known answers for the default seed 5489, computed offline by applying x^(2^128) mod x*P(x) to the seeded
+		// state one step at a time, with P derived afresh by Berlekamp-Massey rather than taken from the jump table.
+		// The same computation at 2^15 matches drawing 2^15 words.
+		FMersenneTwisterEngine Jumped;
+		Jumped.Jump();
+		CHECK(Jumped.Next() == 0xE56D89DC1AA743E5ull);
+		CHECK(Jumped.Next() == 0x91360E35228D4FB7ull);
+		CHECK(Jumped.Next() == 0x73AE22457D8336F0ull);
+	}
+
+	SECTION("Split")
+	{
+		constexpr uint64 Seed = 0xDEADBEEF;
+
+		FMersenneTwister Twister;
+		Twister.Initialize(Seed);
+		Twister.RandHelper(MAX_uint64);
+
+		TArray<FMersenneTwister> Streams;
+		Twister.Split(3, Streams);
+		REQUIRE(Streams.Num() == 3);
+
+		FMersenneTwister Reference;
+		Reference.Initialize(Seed);
+		const uint64 ParentFirst = Reference.RandHelper(MAX_uint64);
+
+		TArray<uint64> Firsts;
+		for (int32 i = 0; i < Streams.Num(); i++)
+		{
+			CHECK(Streams[i].GetStreamIndex() == i + 1);
+			CHECK(Streams[i].GetInitialSeed() == Twister.GetInitialSeed());
+			Firsts.Add(Streams[i].RandHelper(MAX_uint64));
+		}
+
+		CHECK(Firsts[0] != ParentFirst);
+		CHECK(Firsts[0] != Firsts[1]);
+		CHECK(Firsts[1] != Firsts[2]);
+
+		// Children start from their substream regardless of the parent's draws, and Reset returns there
+		TArray<FMersenneTwister> Again;
+		Reference.Split(1, Again);
+		CHECK(Again[0].RandHelper(MAX_uint64) == Firsts[0]);
+
+		Streams[1].Reset();
+		CHECK(Streams[1].RandHelper(MAX_uint64) == Firsts[1]);
+
+		// Split streams keep their substream through serialization
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		Writer << Streams[2];
+
+		FMersenneTwister Loaded;
+		FMemoryReader Reader(Bytes);
+		Reader << Loaded;
+
+		CHECK(!Reader.IsError());
+		CHECK(Loaded.GetStreamIndex() == 3);
+		CHECK(Loaded.RandHelper(MAX_uint64) == Streams[2].RandHelper(MAX_uint64));
+
+		Loaded.Reset();
+		CHECK(Loaded.RandHelper(MAX_uint64) == Firsts[2]);
+	}
 }
 
 #endif